@@ -0,0 +1,187 @@
+/********************************************************************************************
+* SHA3-derived functions: 4-way SHAKE128 with AVX2
+*
+* The Keccak-f[1600] permutation of fips202.c applied to four states at once,
+* lane i of every register holding a word of the i-th state.
+*
+*********************************************************************************************/  
+
+#include <stdint.h>
+#include <string.h>
+#include "fips202.h"
+#include "fips202x4.h"
+
+#if defined(USE_SIMD_DISPATCH)
+
+#include <immintrin.h>
+
+#define AVX2 __attribute__((target("avx2")))
+
+#define NROUNDS 24
+#define ROL(a, offset) _mm256_or_si256(_mm256_slli_epi64(a, offset), _mm256_srli_epi64(a, 64-(offset)))
+
+
+static const uint64_t KeccakF_RoundConstants[NROUNDS] = 
+{
+    (uint64_t)0x0000000000000001ULL,
+    (uint64_t)0x0000000000008082ULL,
+    (uint64_t)0x800000000000808aULL,
+    (uint64_t)0x8000000080008000ULL,
+    (uint64_t)0x000000000000808bULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008009ULL,
+    (uint64_t)0x000000000000008aULL,
+    (uint64_t)0x0000000000000088ULL,
+    (uint64_t)0x0000000080008009ULL,
+    (uint64_t)0x000000008000000aULL,
+    (uint64_t)0x000000008000808bULL,
+    (uint64_t)0x800000000000008bULL,
+    (uint64_t)0x8000000000008089ULL,
+    (uint64_t)0x8000000000008003ULL,
+    (uint64_t)0x8000000000008002ULL,
+    (uint64_t)0x8000000000000080ULL,
+    (uint64_t)0x000000000000800aULL,
+    (uint64_t)0x800000008000000aULL,
+    (uint64_t)0x8000000080008081ULL,
+    (uint64_t)0x8000000000008080ULL,
+    (uint64_t)0x0000000080000001ULL,
+    (uint64_t)0x8000000080008008ULL
+};
+
+// Rotation offsets of rho, for the word x+5*y.
+static const unsigned int KeccakF_RhoOffsets[25] = 
+{
+     0,  1, 62, 28, 27,
+    36, 44,  6, 55, 20,
+     3, 10, 43, 25, 39,
+    41, 45, 15, 21,  8,
+    18,  2, 61, 56, 14
+};
+
+
+static AVX2 void KeccakF1600_StatePermute4x(__m256i *s)
+{
+  __m256i B[25], C[5], D;
+  int round, x, y;
+
+  for (round = 0; round < NROUNDS; round++) {
+    // theta
+    for (x = 0; x < 5; x++) {
+      C[x] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(s[x], s[x+5]), _mm256_xor_si256(s[x+10], s[x+15])), s[x+20]);
+    }
+    for (x = 0; x < 5; x++) {
+      D = _mm256_xor_si256(C[(x+4)%5], ROL(C[(x+1)%5], 1));
+      for (y = 0; y < 25; y += 5) {
+        s[x+y] = _mm256_xor_si256(s[x+y], D);
+      }
+    }
+    // rho and pi: B[y, 2x+3y] = ROL(s[x, y], r[x, y])
+    for (x = 0; x < 5; x++) {
+      for (y = 0; y < 5; y++) {
+        B[y + 5*((2*x + 3*y) % 5)] = ROL(s[x + 5*y], KeccakF_RhoOffsets[x + 5*y]);
+      }
+    }
+    // chi
+    for (y = 0; y < 25; y += 5) {
+      for (x = 0; x < 5; x++) {
+        s[x+y] = _mm256_xor_si256(B[x+y], _mm256_andnot_si256(B[(x+1)%5 + y], B[(x+2)%5 + y]));
+      }
+    }
+    // iota
+    s[0] = _mm256_xor_si256(s[0], _mm256_set1_epi64x((long long)KeccakF_RoundConstants[round]));
+  }
+}
+
+
+static AVX2 void keccakx4_absorb(__m256i *s, unsigned int r, const unsigned char *m0, const unsigned char *m1, const unsigned char *m2, const unsigned char *m3, 
+                                 unsigned long long int mlen, unsigned char p)
+{
+  unsigned long long i;
+  unsigned char t[4][200];
+  uint64_t w[4];
+
+  for (i = 0; i < 25; i++)
+    s[i] = _mm256_setzero_si256();
+
+  while (mlen >= r) 
+  {
+    for (i = 0; i < r / 8; ++i) {
+      memcpy(&w[0], m0 + 8 * i, 8);
+      memcpy(&w[1], m1 + 8 * i, 8);
+      memcpy(&w[2], m2 + 8 * i, 8);
+      memcpy(&w[3], m3 + 8 * i, 8);
+      s[i] = _mm256_xor_si256(s[i], _mm256_loadu_si256((const __m256i *)w));
+    }
+    KeccakF1600_StatePermute4x(s);
+    mlen -= r;
+    m0 += r; m1 += r; m2 += r; m3 += r;
+  }
+
+  memset(t, 0, sizeof(t));
+  memcpy(t[0], m0, mlen);
+  memcpy(t[1], m1, mlen);
+  memcpy(t[2], m2, mlen);
+  memcpy(t[3], m3, mlen);
+  for (i = 0; i < 4; i++) {
+    t[i][mlen] = p;
+    t[i][r - 1] |= 128;
+  }
+  for (i = 0; i < r / 8; ++i) {
+    memcpy(&w[0], t[0] + 8 * i, 8);
+    memcpy(&w[1], t[1] + 8 * i, 8);
+    memcpy(&w[2], t[2] + 8 * i, 8);
+    memcpy(&w[3], t[3] + 8 * i, 8);
+    s[i] = _mm256_xor_si256(s[i], _mm256_loadu_si256((const __m256i *)w));
+  }
+}
+
+
+static AVX2 void keccakx4_squeezeblocks(unsigned char *h0, unsigned char *h1, unsigned char *h2, unsigned char *h3, unsigned long long int nblocks, 
+                                        __m256i *s, unsigned int r)
+{
+  unsigned int i;
+  uint64_t w[4];
+
+  while (nblocks > 0) 
+  {
+    KeccakF1600_StatePermute4x(s);
+    for (i = 0; i < (r>>3); i++)
+    {
+      _mm256_storeu_si256((__m256i *)w, s[i]);
+      memcpy(h0 + 8 * i, &w[0], 8);            // Little-endian words, as store64() in fips202.c
+      memcpy(h1 + 8 * i, &w[1], 8);
+      memcpy(h2 + 8 * i, &w[2], 8);
+      memcpy(h3 + 8 * i, &w[3], 8);
+    }
+    h0 += r; h1 += r; h2 += r; h3 += r;
+    nblocks--;
+  }
+}
+
+
+AVX2 void shake128x4(unsigned char *out0, unsigned char *out1, unsigned char *out2, unsigned char *out3, unsigned long long outlen,
+                     const unsigned char *in0, const unsigned char *in1, const unsigned char *in2, const unsigned char *in3, unsigned long long inlen)
+{
+  __m256i s[25];
+  unsigned char t[4][SHAKE128_RATE];
+  unsigned long long nblocks = outlen/SHAKE128_RATE;
+
+  /* Absorb input */
+  keccakx4_absorb(s, SHAKE128_RATE, in0, in1, in2, in3, inlen, 0x1F);
+
+  /* Squeeze output */
+  keccakx4_squeezeblocks(out0, out1, out2, out3, nblocks, s, SHAKE128_RATE);
+
+  outlen -= nblocks*SHAKE128_RATE;
+  if (outlen) 
+  {
+    keccakx4_squeezeblocks(t[0], t[1], t[2], t[3], 1, s, SHAKE128_RATE);
+    memcpy(out0 + nblocks*SHAKE128_RATE, t[0], outlen);
+    memcpy(out1 + nblocks*SHAKE128_RATE, t[1], outlen);
+    memcpy(out2 + nblocks*SHAKE128_RATE, t[2], outlen);
+    memcpy(out3 + nblocks*SHAKE128_RATE, t[3], outlen);
+  }
+}
+
+#endif
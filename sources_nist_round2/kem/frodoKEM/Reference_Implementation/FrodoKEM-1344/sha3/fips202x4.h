@@ -0,0 +1,16 @@
+#ifndef FIPS202X4_H
+#define FIPS202X4_H
+
+#include <stdint.h>
+#include "../config.h"
+
+#if defined(USE_SIMD_DISPATCH)
+
+// Four independent SHAKE128 instances of equal input and output lengths, one per 64-bit
+// lane of the AVX2 registers. Same output as four shake128() calls. Requires AVX2.
+void shake128x4(unsigned char *out0, unsigned char *out1, unsigned char *out2, unsigned char *out3, unsigned long long outlen,
+                const unsigned char *in0, const unsigned char *in1, const unsigned char *in2, const unsigned char *in3, unsigned long long inlen);
+
+#endif
+
+#endif
@@ -7,54 +7,54 @@
 #include <string.h>
 #include "frodo_macrify.h"
 
-#define min(x, y) (((x) < (y)) ? (x) : (y))
-
 
 void frodo_pack(unsigned char *out, const size_t outlen, const uint16_t *in, const size_t inlen, const unsigned char lsb) 
 { // Pack the input uint16 vector into a char output vector, copying lsb bits from each input element. 
   // If inlen * lsb / 8 > outlen, only outlen * 8 bits are copied.
-    memset(out, 0, outlen);
-
+  // The elements are gathered into a 64-bit word, which is then flushed a byte at a time.
+    const uint16_t mask = (uint16_t)((1U << lsb) - 1);
+    uint64_t w = 0;          // the bits not yet copied are the lower "bits" bits of w
+    unsigned int bits = 0;
     size_t i = 0;            // whole bytes already filled in
     size_t j = 0;            // whole uint16_t already copied
-    uint16_t w = 0;          // the leftover, not yet copied
-    unsigned char bits = 0;  // the number of lsb in w
 
-    while (i < outlen && (j < inlen || ((j == inlen) && (bits > 0)))) {
-        /*
-        in: |        |        |********|********|
-                              ^
-                              j
-        w : |   ****|
-                ^
-               bits
-        out:|**|**|**|**|**|**|**|**|* |
-                                    ^^
-                                    ib
-        */
-        unsigned char b = 0;  // bits in out[i] already filled in
-        while (b < 8) {
-            int nbits = min(8 - b, bits);
-            uint16_t mask = (1 << nbits) - 1;
-            unsigned char t = (w >> (bits - nbits)) & mask;  // the bits to copy from w to out
-            out[i] = out[i] + (t << (8 - b - nbits));
-            b += nbits;
-            bits -= nbits;
-            w &= ~(mask << bits);  // not strictly necessary; mostly for debugging
+    memset(out, 0, outlen);
 
-            if (bits == 0) {
-                if (j < inlen) {
-                    w = in[j];
-                    bits = lsb;
-                    j++;
-                } else {
-                    break;  // the input vector is exhausted
-                }
+    if (lsb == 16) {         // plain big-endian copy
+        for (; j < inlen && i + 2 <= outlen; j++, i += 2) {
+            out[i] = (unsigned char)(in[j] >> 8);
+            out[i + 1] = (unsigned char)in[j];
+        }
+    } else if (lsb == 15) {  // 8 elements to 15 bytes, through two 60-bit words
+        for (; j + 8 <= inlen && i + 15 <= outlen; j += 8, i += 15) {
+            uint64_t hi = 0, lo = 0;
+            unsigned int k;
+            for (k = 0; k < 4; k++) {
+                hi = (hi << 15) | (in[j + k] & mask);
+                lo = (lo << 15) | (in[j + 4 + k] & mask);
+            }
+            hi = (hi << 4) | (lo >> 56);
+            for (k = 0; k < 8; k++) {
+                out[i + k] = (unsigned char)(hi >> (56 - 8*k));
+            }
+            for (k = 0; k < 7; k++) {
+                out[i + 8 + k] = (unsigned char)(lo >> (48 - 8*k));
             }
         }
-        if (b == 8) {  // out[i] is filled in
-            i++;
+    }
+
+    while (i < outlen && j < inlen) {
+        while (bits <= 64 - (unsigned int)lsb && j < inlen) {
+            w = (w << lsb) | (in[j++] & mask);
+            bits += lsb;
         }
+        while (bits >= 8 && i < outlen) {
+            bits -= 8;
+            out[i++] = (unsigned char)(w >> bits);
+        }
+    }
+    if (bits > 0 && i < outlen) {  // the last byte is padded with zeros
+        out[i] = (unsigned char)(w << (8 - bits));
     }
 }
 
@@ -62,48 +62,50 @@ void frodo_pack(unsigned char *out, const size_t outlen, const uint16_t *in, con
 void frodo_unpack(uint16_t *out, const size_t outlen, const unsigned char *in, const size_t inlen, const unsigned char lsb) 
 { // Unpack the input char vector into a uint16_t output vector, copying lsb bits
   // for each output element from input. outlen must be at least ceil(inlen * 8 / lsb).
-    memset(out, 0, outlen * sizeof(uint16_t));
-
+  // The bytes are gathered into a 64-bit word, from which the elements are then extracted.
+    const uint16_t mask = (uint16_t)((1U << lsb) - 1);
+    uint64_t w = 0;          // the bits not yet copied are the lower "bits" bits of w
+    unsigned int bits = 0;
     size_t i = 0;            // whole uint16_t already filled in
     size_t j = 0;            // whole bytes already copied
-    unsigned char w = 0;     // the leftover, not yet copied
-    unsigned char bits = 0;  // the number of lsb bits of w
 
-    while (i < outlen && (j < inlen || ((j == inlen) && (bits > 0)))) {
-        /*
-        in: |  |  |  |  |  |  |**|**|...
-                              ^
-                              j
-        w : | *|
-              ^
-              bits
-        out:|   *****|   *****|   ***  |        |...
-                              ^   ^
-                              i   b
-        */
-        unsigned char b = 0;  // bits in out[i] already filled in
-        while (b < lsb) {
-            int nbits = min(lsb - b, bits);
-            uint16_t mask = (1 << nbits) - 1;
-            unsigned char t = (w >> (bits - nbits)) & mask;  // the bits to copy from w to out
-            out[i] = out[i] + (t << (lsb - b - nbits));
-            b += nbits;
-            bits -= nbits;
-            w &= ~(mask << bits);  // not strictly necessary; mostly for debugging
+    memset(out, 0, outlen * sizeof(uint16_t));
 
-            if (bits == 0) {
-                if (j < inlen) {
-                    w = in[j];
-                    bits = 8;
-                    j++;
-                } else {
-                    break;  // the input vector is exhausted
-                }
+    if (lsb == 16) {         // plain big-endian copy
+        for (; i < outlen && j + 2 <= inlen; i++, j += 2) {
+            out[i] = (uint16_t)((in[j] << 8) | in[j + 1]);
+        }
+    } else if (lsb == 15) {  // 15 bytes to 8 elements, through two 60-bit words
+        for (; i + 8 <= outlen && j + 15 <= inlen; i += 8, j += 15) {
+            uint64_t hi = 0, lo = 0;
+            unsigned int k;
+            for (k = 0; k < 8; k++) {
+                hi = (hi << 8) | in[j + k];
+            }
+            for (k = 0; k < 7; k++) {
+                lo = (lo << 8) | in[j + 8 + k];
+            }
+            lo |= (hi & 0xF) << 56;
+            hi >>= 4;
+            for (k = 0; k < 4; k++) {
+                out[i + k] = (uint16_t)(hi >> (45 - 15*k)) & mask;
+                out[i + 4 + k] = (uint16_t)(lo >> (45 - 15*k)) & mask;
             }
         }
-        if (b == lsb) {  // out[i] is filled in
-            i++;
+    }
+
+    while (i < outlen && j < inlen) {
+        while (bits <= 56 && j < inlen) {
+            w = (w << 8) | in[j++];
+            bits += 8;
         }
+        while (bits >= lsb && i < outlen) {
+            bits -= lsb;
+            out[i++] = (uint16_t)(w >> bits) & mask;
+        }
+    }
+    if (bits > 0 && i < outlen) {  // the input is exhausted: the leftover bits are the top bits of the last element
+        out[i] = (uint16_t)(w << (lsb - bits)) & mask;
     }
 }
 
@@ -13,6 +13,45 @@
 
 #ifndef USE_OPENSSL
 
+#if defined(USE_SIMD_DISPATCH) && !defined(AES_ENABLE_NI)
+#include <immintrin.h>
+
+// ECB encryption with AES-NI, eight blocks in flight to hide the latency of AESENC.
+// The round keys are the standard key expansion produced by aes128/256_load_schedule_c().
+static __attribute__((target("aes,sse2")))
+void aes_ecb_enc_ni(const uint8_t *plaintext, const size_t plaintext_len, const uint8_t *schedule, const unsigned int nrounds, uint8_t *ciphertext) {
+    __m128i rk[15], x[8];
+    size_t nblocks = plaintext_len / 16, block = 0;
+    unsigned int r, k;
+
+    for (r = 0; r <= nrounds; r++) {
+        rk[r] = _mm_loadu_si128((const __m128i *)(schedule + 16 * r));
+    }
+    for (; block + 8 <= nblocks; block += 8) {
+        for (k = 0; k < 8; k++) {
+            x[k] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(plaintext + 16 * (block + k))), rk[0]);
+        }
+        for (r = 1; r < nrounds; r++) {
+            for (k = 0; k < 8; k++) {
+                x[k] = _mm_aesenc_si128(x[k], rk[r]);
+            }
+        }
+        for (k = 0; k < 8; k++) {
+            _mm_storeu_si128((__m128i *)(ciphertext + 16 * (block + k)), _mm_aesenclast_si128(x[k], rk[nrounds]));
+        }
+    }
+    for (; block < nblocks; block++) {
+        x[0] = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(plaintext + 16 * block)), rk[0]);
+        for (r = 1; r < nrounds; r++) {
+            x[0] = _mm_aesenc_si128(x[0], rk[r]);
+        }
+        _mm_storeu_si128((__m128i *)(ciphertext + 16 * block), _mm_aesenclast_si128(x[0], rk[nrounds]));
+    }
+}
+
+#define AES_NI_DISPATCH
+#endif
+
 void AES128_load_schedule(const uint8_t *key, uint8_t *schedule) {
 #ifdef AES_ENABLE_NI
     aes128_load_schedule_ni(key, schedule);
@@ -33,6 +72,12 @@ static inline void aes128_enc(const uint8_t *plaintext, const uint8_t *schedule,
 
 void AES128_ECB_enc_sch(const uint8_t *plaintext, const size_t plaintext_len, const uint8_t *schedule, uint8_t *ciphertext) {
     assert(plaintext_len % 16 == 0);
+#ifdef AES_NI_DISPATCH
+    if (CPU_HAS_AESNI()) {
+        aes_ecb_enc_ni(plaintext, plaintext_len, schedule, 10, ciphertext);
+        return;
+    }
+#endif
     for (size_t block = 0; block < plaintext_len / 16; block++) {
         aes128_enc(plaintext + (16 * block), schedule, ciphertext + (16 * block));
     }
@@ -64,6 +109,12 @@ static inline void aes256_enc(const uint8_t *plaintext, const uint8_t *schedule,
 
 void AES256_ECB_enc_sch(const uint8_t *plaintext, const size_t plaintext_len, const uint8_t *schedule, uint8_t *ciphertext) {
     assert(plaintext_len % 16 == 0);
+#ifdef AES_NI_DISPATCH
+    if (CPU_HAS_AESNI()) {
+        aes_ecb_enc_ni(plaintext, plaintext_len, schedule, 14, ciphertext);
+        return;
+    }
+#endif
     for (size_t block = 0; block < plaintext_len / 16; block++) {
         aes256_enc(plaintext + (16 * block), schedule, ciphertext + (16 * block));
     }
@@ -74,6 +74,24 @@
 #endif
 
 
+// Selecting multi-threaded matrix arithmetic (POSIX threads), NUM_THREADS slices of A per operation
+#if defined(_USE_THREADS_)
+    #define USE_THREADS
+    #if !defined(NUM_THREADS)
+        #define NUM_THREADS 4
+    #endif
+#endif
+
+
+// Selecting the x64 backends (AES-NI, AVX2), enabled at run time when the CPU supports them
+// Defining _NO_SIMD_DISPATCH_ leaves only the portable code
+#if (TARGET == TARGET_AMD64) && (defined(__GNUC__) || defined(__clang__)) && !defined(_NO_SIMD_DISPATCH_)
+    #define USE_SIMD_DISPATCH
+    #define CPU_HAS_AESNI()    __builtin_cpu_supports("aes")
+    #define CPU_HAS_AVX2()     __builtin_cpu_supports("avx2")
+#endif
+
+
 // Macro to avoid compiler warnings when detecting unreferenced parameters
 #define UNREFERENCED_PARAMETER(PAR) ((void)(PAR))
 
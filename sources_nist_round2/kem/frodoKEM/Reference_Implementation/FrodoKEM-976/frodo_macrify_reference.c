@@ -8,144 +8,352 @@
     #include "aes/aes.h"
 #elif defined (USE_SHAKE128_FOR_A)
     #include "sha3/fips202.h"
+    #include "sha3/fips202x4.h"
 #endif    
 
+#if defined(USE_THREADS)
+    #include <pthread.h>
+    #include <stdlib.h>
+#endif
 
-int frodo_mul_add_as_plus_e(uint16_t *out, const uint16_t *s, const uint16_t *e, const uint8_t *seed_A) 
-{ // Generate-and-multiply: generate matrix A (N x N) row-wise, multiply by s on the right.
-  // Inputs: s, e (N x N_BAR)
-  // Output: out = A*s + e (N x N_BAR)
+#if defined(USE_SIMD_DISPATCH) && (PARAMS_PARALLEL == 4) && (PARAMS_N % 16 == 0)
+    #define FRODO_AVX2_KERNELS
+    #include <immintrin.h>
+#endif
 
-    
-    int i, j, k;
-    
-    
-#ifdef SMALL_STACK
-     int16_t* A = (int16_t*) calloc( sizeof(int16_t), PARAMS_N * PARAMS_N );
+
+// Matrix A is never stored in full: it is generated PARAMS_PARALLEL rows at a time into a
+// small buffer and multiplied immediately. The products are taken modulo 2^16, so the order
+// of the additions does not change the output.
+
+typedef struct {
+#if defined(USE_AES128_FOR_A)
+    int16_t a_row_temp[PARAMS_PARALLEL * PARAMS_N];   // Plaintext blocks (i, j, 0, ..., 0)
+#if !defined(USE_OPENSSL)
+    uint8_t aes_key_schedule[16*11];
 #else
-   int16_t A[PARAMS_N * PARAMS_N] = {0};
+    EVP_CIPHER_CTX *aes_key_schedule;
 #endif
+#elif defined(USE_SHAKE128_FOR_A)
+    uint8_t seed_A_separated[2 + BYTES_SEED_A];
+#endif
+} frodo_gen_a_t;
 
-       
-#if defined(USE_AES128_FOR_A)    // Matrix A generation using AES128, done per 128-bit block
 
-    size_t A_len = PARAMS_N * PARAMS_N * sizeof(int16_t);    
-    for (i = 0; i < PARAMS_N; i++) {                        
+static void frodo_gen_a_init(frodo_gen_a_t *gen, const uint8_t *seed_A)
+{ // Set up the generation of A from seed_A
+#if defined(USE_AES128_FOR_A)
+    int i, j;
+
+    memset(gen->a_row_temp, 0, sizeof(gen->a_row_temp));
+    for (i = 0; i < PARAMS_PARALLEL; i++) {
         for (j = 0; j < PARAMS_N; j += PARAMS_STRIPE_STEP) {
-            A[i*PARAMS_N + j] = i;                              // Loading values in the little-endian order
-            A[i*PARAMS_N + j + 1] = j;                                  
+            gen->a_row_temp[i*PARAMS_N + j + 1] = j;        // Loading values in the little-endian order
         }
     }
-    
 #if !defined(USE_OPENSSL)
-
-    uint8_t aes_key_schedule[16*11];
-    AES128_load_schedule(seed_A, aes_key_schedule);  
-    AES128_ECB_enc_sch((uint8_t*)A, A_len, aes_key_schedule, (uint8_t*)A);
+    AES128_load_schedule(seed_A, gen->aes_key_schedule);
 #else
+    if (!(gen->aes_key_schedule = EVP_CIPHER_CTX_new())) handleErrors();
+    if (1 != EVP_EncryptInit_ex(gen->aes_key_schedule, EVP_aes_128_ecb(), NULL, seed_A, NULL)) handleErrors();
+#endif
+#elif defined(USE_SHAKE128_FOR_A)
+    memcpy(&gen->seed_A_separated[2], seed_A, BYTES_SEED_A);
+#endif
+}
+
+
+static void frodo_gen_a_rows(int16_t *A, const int row, frodo_gen_a_t *gen)
+{ // Generate rows row, ..., row+PARAMS_PARALLEL-1 of A
+    int i;
 
-    EVP_CIPHER_CTX *aes_key_schedule;    
+#if defined(USE_AES128_FOR_A)    // Matrix A generation using AES128, done per 128-bit block
+    int j;
+    size_t A_len = PARAMS_PARALLEL * PARAMS_N * sizeof(int16_t);
+    for (i = 0; i < PARAMS_PARALLEL; i++) {
+        for (j = 0; j < PARAMS_N; j += PARAMS_STRIPE_STEP) {
+            gen->a_row_temp[i*PARAMS_N + j] = row + i;      // Loading values in the little-endian order
+        }
+    }
+#if !defined(USE_OPENSSL)
+    AES128_ECB_enc_sch((uint8_t*)gen->a_row_temp, A_len, gen->aes_key_schedule, (uint8_t*)A);
+#else
     int len;
-    if (!(aes_key_schedule = EVP_CIPHER_CTX_new())) handleErrors();    
-    if (1 != EVP_EncryptInit_ex(aes_key_schedule, EVP_aes_128_ecb(), NULL, seed_A, NULL)) handleErrors();    
-    if (1 != EVP_EncryptUpdate(aes_key_schedule, (uint8_t*)A, &len, (uint8_t*)A, A_len)) handleErrors();
+    if (1 != EVP_EncryptUpdate(gen->aes_key_schedule, (uint8_t*)A, &len, (uint8_t*)gen->a_row_temp, A_len)) handleErrors();
 #endif
 #elif defined(USE_SHAKE128_FOR_A)  // Matrix A generation using SHAKE128, done per 16*N-bit row
+    uint16_t* seed_A_origin = (uint16_t*)&gen->seed_A_separated;
+#if defined(FRODO_AVX2_KERNELS)
+    if (CPU_HAS_AVX2()) {                                       // Four rows at once, one per Keccak lane
+        uint8_t seeds[PARAMS_PARALLEL][2 + BYTES_SEED_A];
+        for (i = 0; i < PARAMS_PARALLEL; i++) {
+            memcpy(seeds[i], gen->seed_A_separated, sizeof(seeds[i]));
+            seeds[i][0] = (uint8_t)(row + i);                   // Loading values in the little-endian order
+            seeds[i][1] = (uint8_t)((row + i) >> 8);
+        }
+        shake128x4((unsigned char*)A, (unsigned char*)(A + PARAMS_N), (unsigned char*)(A + 2*PARAMS_N), (unsigned char*)(A + 3*PARAMS_N), 
+                   (unsigned long long)(2*PARAMS_N), seeds[0], seeds[1], seeds[2], seeds[3], 2 + BYTES_SEED_A);
+        return;
+    }
+#endif
+    for (i = 0; i < PARAMS_PARALLEL; i++) {
+        seed_A_origin[0] = (uint16_t)(row + i);
+        shake128((unsigned char*)(A + i*PARAMS_N), (unsigned long long)(2*PARAMS_N), gen->seed_A_separated, 2 + BYTES_SEED_A);
+    }
+#endif
+}
 
-    uint8_t seed_A_separated[2 + BYTES_SEED_A];
-    uint16_t* seed_A_origin = (uint16_t*)&seed_A_separated;
-    memcpy(&seed_A_separated[2], seed_A, BYTES_SEED_A);
-    for (i = 0; i < PARAMS_N; i++) {
-        seed_A_origin[0] = (uint16_t) i;
-        shake128((unsigned char*)(A + i*PARAMS_N), (unsigned long long)(2*PARAMS_N), seed_A_separated, 2 + BYTES_SEED_A);
+
+static void frodo_gen_a_free(frodo_gen_a_t *gen)
+{ // Release the generator state
+#if defined(USE_AES128_FOR_A)
+    AES128_free_schedule(gen->aes_key_schedule);
+#else
+    (void)gen;
+#endif
+}
+
+
+#if defined(FRODO_AVX2_KERNELS)
+
+static __attribute__((target("avx2"))) void frodo_mul_add_as_rows_avx2(uint16_t *out, const int16_t *A, const uint16_t *s)
+{ // out[r][k] += <A[r], s[k]> for the PARAMS_PARALLEL rows held in A, 16 products per instruction
+    int j, k, r;
+
+    for (k = 0; k < PARAMS_NBAR; k++) {
+        __m256i acc[PARAMS_PARALLEL];
+        for (r = 0; r < PARAMS_PARALLEL; r++) {
+            acc[r] = _mm256_setzero_si256();
+        }
+        for (j = 0; j < PARAMS_N; j += 16) {
+            __m256i sk = _mm256_loadu_si256((const __m256i*)&s[k*PARAMS_N + j]);
+            for (r = 0; r < PARAMS_PARALLEL; r++) {
+                __m256i a = _mm256_loadu_si256((const __m256i*)&A[r*PARAMS_N + j]);
+                acc[r] = _mm256_add_epi16(acc[r], _mm256_mullo_epi16(a, sk));
+            }
+        }
+        for (r = 0; r < PARAMS_PARALLEL; r++) {                 // Horizontal sums modulo 2^16
+            __m128i t = _mm_add_epi16(_mm256_castsi256_si128(acc[r]), _mm256_extracti128_si256(acc[r], 1));
+            t = _mm_add_epi16(t, _mm_shuffle_epi32(t, 0x4E));
+            t = _mm_add_epi16(t, _mm_shuffle_epi32(t, 0xB1));
+            t = _mm_add_epi16(t, _mm_srli_epi32(t, 16));
+            out[r*PARAMS_NBAR + k] += (uint16_t)_mm_cvtsi128_si32(t);
+        }
     }
+}
+
+
+static __attribute__((target("avx2"))) void frodo_mul_add_sa_rows_avx2(uint16_t *out, const int16_t *A, const uint16_t *s, const int row)
+{ // out[k] += sum_r s[k][row + r]*A[r] for the PARAMS_PARALLEL rows held in A
+    int j, k, r;
+
+    for (k = 0; k < PARAMS_NBAR; k++) {
+        __m256i sp[PARAMS_PARALLEL];
+        for (r = 0; r < PARAMS_PARALLEL; r++) {
+            sp[r] = _mm256_set1_epi16((int16_t)s[k*PARAMS_N + row + r]);
+        }
+        for (j = 0; j < PARAMS_N; j += 16) {
+            __m256i o = _mm256_loadu_si256((const __m256i*)&out[k*PARAMS_N + j]);
+            for (r = 0; r < PARAMS_PARALLEL; r++) {
+                __m256i a = _mm256_loadu_si256((const __m256i*)&A[r*PARAMS_N + j]);
+                o = _mm256_add_epi16(o, _mm256_mullo_epi16(sp[r], a));
+            }
+            _mm256_storeu_si256((__m256i*)&out[k*PARAMS_N + j], o);
+        }
+    }
+}
+
+#endif
+
+
+static void frodo_mul_add_as_range(uint16_t *out, const uint16_t *s, const uint8_t *seed_A, const int row_start, const int row_end)
+{ // out[i] += A[i]*s for the rows row_start <= i < row_end of A (multiples of PARAMS_PARALLEL)
+    int i, j, k, r;
+    int16_t A[PARAMS_PARALLEL * PARAMS_N];                      // PARAMS_PARALLEL rows of A
+    frodo_gen_a_t gen;
+
+    frodo_gen_a_init(&gen, seed_A);
+
+#if defined(FRODO_AVX2_KERNELS)
+    int use_avx2 = CPU_HAS_AVX2();
+#endif
+
+    for (i = row_start; i < row_end; i += PARAMS_PARALLEL) {
+        frodo_gen_a_rows(A, i, &gen);
+#if defined(FRODO_AVX2_KERNELS)
+        if (use_avx2) {
+            frodo_mul_add_as_rows_avx2(&out[i*PARAMS_NBAR], A, s);
+            continue;
+        }
 #endif
+        for (r = 0; r < PARAMS_PARALLEL; r++) {
+            for (k = 0; k < PARAMS_NBAR; k++) {
+                uint16_t sum = 0;
+                for (j = 0; j < PARAMS_N; j++) {                                
+                    sum += A[r*PARAMS_N + j] * s[k*PARAMS_N + j];  
+                }
+                out[(i+r)*PARAMS_NBAR + k] += sum;              // No need to reduce modulo 2^15, extra bits are taken care of during packing later on.
+            }
+        }
+    }
     
+    frodo_gen_a_free(&gen);
+}
+
 
-    memcpy(out, e, PARAMS_NBAR * PARAMS_N * sizeof(uint16_t));  
+static void frodo_mul_add_sa_range(uint16_t *out, const uint16_t *s, const uint8_t *seed_A, const int row_start, const int row_end)
+{ // out += s'[., i]*A[i] for the rows row_start <= i < row_end of A (multiples of PARAMS_PARALLEL)
+    int i, j, k, r;
+    int16_t A[PARAMS_PARALLEL * PARAMS_N];                      // PARAMS_PARALLEL rows of A
+    frodo_gen_a_t gen;
 
-    for (i = 0; i < PARAMS_N; i++) {                            // Matrix multiplication-addition A*s + e
+    frodo_gen_a_init(&gen, seed_A);
+
+#if defined(FRODO_AVX2_KERNELS)
+    int use_avx2 = CPU_HAS_AVX2();
+#endif
+
+    for (i = row_start; i < row_end; i += PARAMS_PARALLEL) {
+        frodo_gen_a_rows(A, i, &gen);
+#if defined(FRODO_AVX2_KERNELS)
+        if (use_avx2) {
+            frodo_mul_add_sa_rows_avx2(out, A, s, i);
+            continue;
+        }
+#endif
         for (k = 0; k < PARAMS_NBAR; k++) {
-            uint16_t sum = 0;
-            for (j = 0; j < PARAMS_N; j++) {                                
-                sum += A[i*PARAMS_N + j] * s[k*PARAMS_N + j];  
+            for (r = 0; r < PARAMS_PARALLEL; r++) {
+                uint16_t sp = s[k*PARAMS_N + i + r];
+                for (j = 0; j < PARAMS_N; j++) {
+                    out[k*PARAMS_N + j] += sp * A[r*PARAMS_N + j];  // No need to reduce modulo 2^15, extra bits are taken care of during packing later on.
+                }
             }
-            out[i*PARAMS_NBAR + k] += sum;                      // Adding e. No need to reduce modulo 2^15, extra bits are taken care of during packing later on.
         }
     }
-    
-#if defined(USE_AES128_FOR_A)
-    AES128_free_schedule(aes_key_schedule);
+
+    frodo_gen_a_free(&gen);
+}
+
+
+#if defined(USE_THREADS)
+
+// Each worker generates and consumes its own slice of the rows of A. For A*s the slices
+// write disjoint rows of the output; for s'*A every worker but the first accumulates into
+// a private N_BAR x N buffer that is added to the output after the join.
+
+typedef struct {
+    uint16_t *out;
+    const uint16_t *s;
+    const uint8_t *seed_A;
+    int row_start, row_end;
+} frodo_mul_job_t;
+
+
+static void *frodo_mul_add_as_worker(void *arg)
+{
+    frodo_mul_job_t *job = (frodo_mul_job_t*)arg;
+    frodo_mul_add_as_range(job->out, job->s, job->seed_A, job->row_start, job->row_end);
+    return NULL;
+}
+
+
+static void *frodo_mul_add_sa_worker(void *arg)
+{
+    frodo_mul_job_t *job = (frodo_mul_job_t*)arg;
+    frodo_mul_add_sa_range(job->out, job->s, job->seed_A, job->row_start, job->row_end);
+    return NULL;
+}
+
+
+static void frodo_mul_add_parallel(void *(*worker)(void *), frodo_mul_job_t *jobs, int njobs)
+{ // Run jobs[1..njobs-1] on their own threads and jobs[0] on the calling thread.
+  // A job whose thread cannot be created is run on the calling thread instead.
+    pthread_t tid[NUM_THREADS];
+    int started[NUM_THREADS] = {0};
+    int t;
+
+    for (t = 1; t < njobs; t++) {
+        started[t] = (pthread_create(&tid[t], NULL, worker, &jobs[t]) == 0);
+    }
+    worker(&jobs[0]);
+    for (t = 1; t < njobs; t++) {
+        if (started[t]) {
+            pthread_join(tid[t], NULL);
+        } else {
+            worker(&jobs[t]);
+        }
+    }
+}
+
+
+static int frodo_mul_split(frodo_mul_job_t *jobs, uint16_t *out, const uint16_t *s, const uint8_t *seed_A)
+{ // Split the rows of A in up to NUM_THREADS slices of whole PARAMS_PARALLEL blocks
+    int blocks = PARAMS_N / PARAMS_PARALLEL;
+    int per_job = (blocks + NUM_THREADS - 1) / NUM_THREADS;
+    int t, row = 0;
+
+    for (t = 0; t < NUM_THREADS && row < PARAMS_N; t++) {
+        jobs[t].out = out;
+        jobs[t].s = s;
+        jobs[t].seed_A = seed_A;
+        jobs[t].row_start = row;
+        row += per_job * PARAMS_PARALLEL;
+        jobs[t].row_end = (row < PARAMS_N) ? row : PARAMS_N;
+    }
+    return t;
+}
+
+#endif
+
+
+int frodo_mul_add_as_plus_e(uint16_t *out, const uint16_t *s, const uint16_t *e, const uint8_t *seed_A) 
+{ // Generate-and-multiply: generate matrix A (N x N) row-wise, multiply by s on the right.
+  // Inputs: s, e (N x N_BAR)
+  // Output: out = A*s + e (N x N_BAR)
+    memcpy(out, e, PARAMS_NBAR * PARAMS_N * sizeof(uint16_t));  // Adding e
+
+#if defined(USE_THREADS)
+    frodo_mul_job_t jobs[NUM_THREADS];
+    int njobs = frodo_mul_split(jobs, out, s, seed_A);
+    frodo_mul_add_parallel(frodo_mul_add_as_worker, jobs, njobs);
+#else
+    frodo_mul_add_as_range(out, s, seed_A, 0, PARAMS_N);
 #endif
-    
-    
-    #ifdef SMALL_STACK
-    free(A);
-    #endif
-    
     return 1;
 }
 
 
 int frodo_mul_add_sa_plus_e(uint16_t *out, const uint16_t *s, const uint16_t *e, const uint8_t *seed_A) 
-{ // Generate-and-multiply: generate matrix A (N x N) column-wise, multiply by s' on the left.
+{ // Generate-and-multiply: generate matrix A (N x N) row-wise, multiply by s' on the left.
   // Inputs: s', e' (N_BAR x N)
   // Output: out = s'*A + e' (N_BAR x N)
-    int i, j, k;
-    
-    #ifdef SMALL_STACK
-    int16_t* A = (int16_t*) calloc( sizeof(int16_t), PARAMS_N * PARAMS_N );
-    #else
-    int16_t A[PARAMS_N * PARAMS_N] = {0};
-    #endif
-    
-#if defined(USE_AES128_FOR_A)    // Matrix A generation using AES128, done per 128-bit block                                       
-    size_t A_len = PARAMS_N * PARAMS_N * sizeof(int16_t);      
-    for (i = 0; i < PARAMS_N; i++) {                        
-        for (j = 0; j < PARAMS_N; j += PARAMS_STRIPE_STEP) {
-            A[i*PARAMS_N + j] = i;                              // Loading values in the little-endian order
-            A[i*PARAMS_N + j + 1] = j;                                  
-        }
+    memcpy(out, e, PARAMS_NBAR * PARAMS_N * sizeof(uint16_t));  // Adding e
+
+#if defined(USE_THREADS)
+    int i, t;
+    frodo_mul_job_t jobs[NUM_THREADS];
+    int njobs = frodo_mul_split(jobs, out, s, seed_A);
+    uint16_t *partial = NULL;
+
+    if (njobs > 1) {
+        partial = (uint16_t*)calloc((size_t)(njobs - 1) * PARAMS_NBAR * PARAMS_N, sizeof(uint16_t));
     }
-    
-#if !defined(USE_OPENSSL)
-    uint8_t aes_key_schedule[16*11];
-    AES128_load_schedule(seed_A, aes_key_schedule);  
-    AES128_ECB_enc_sch((uint8_t*)A, A_len, aes_key_schedule, (uint8_t*)A);
-#else
-    EVP_CIPHER_CTX *aes_key_schedule;    
-    int len;
-    if (!(aes_key_schedule = EVP_CIPHER_CTX_new())) handleErrors();    
-    if (1 != EVP_EncryptInit_ex(aes_key_schedule, EVP_aes_128_ecb(), NULL, seed_A, NULL)) handleErrors();    
-    if (1 != EVP_EncryptUpdate(aes_key_schedule, (uint8_t*)A, &len, (uint8_t*)A, A_len)) handleErrors();
-#endif
-#elif defined (USE_SHAKE128_FOR_A)  // Matrix A generation using SHAKE128, done per 16*N-bit row
-    uint8_t seed_A_separated[2 + BYTES_SEED_A];
-    uint16_t* seed_A_origin = (uint16_t*)&seed_A_separated;
-    memcpy(&seed_A_separated[2], seed_A, BYTES_SEED_A);
-    for (i = 0; i < PARAMS_N; i++) {
-        seed_A_origin[0] = (uint16_t) i;
-        shake128((unsigned char*)(A + i*PARAMS_N), (unsigned long long)(2*PARAMS_N), seed_A_separated, 2 + BYTES_SEED_A);
+    if (partial == NULL) {                                      // Single slice, or no memory for the partial sums
+        frodo_mul_add_sa_range(out, s, seed_A, 0, PARAMS_N);
+        return 1;
     }
-#endif
-    memcpy(out, e, PARAMS_NBAR * PARAMS_N * sizeof(uint16_t));
-
-    for (i = 0; i < PARAMS_N; i++) {                            // Matrix multiplication-addition A*s + e
-        for (k = 0; k < PARAMS_NBAR; k++) {
-            uint16_t sum = 0;
-            for (j = 0; j < PARAMS_N; j++) {                                
-                sum += A[j*PARAMS_N + i] * s[k*PARAMS_N + j];  
-            }
-            out[k*PARAMS_N + i] += sum;                         // Adding e. No need to reduce modulo 2^15, extra bits are taken care of during packing later on.
+    for (t = 1; t < njobs; t++) {
+        jobs[t].out = &partial[(t - 1) * PARAMS_NBAR * PARAMS_N];
+    }
+    frodo_mul_add_parallel(frodo_mul_add_sa_worker, jobs, njobs);
+    for (t = 1; t < njobs; t++) {
+        for (i = 0; i < PARAMS_NBAR * PARAMS_N; i++) {
+            out[i] += jobs[t].out[i];
         }
     }
-    
-#if defined(USE_AES128_FOR_A)
-    AES128_free_schedule(aes_key_schedule);
-#endif
-    
-    #ifdef SMALL_STACK
-    free(A);
+    free(partial);
+#else
+    frodo_mul_add_sa_range(out, s, seed_A, 0, PARAMS_N);
 #endif
     return 1;
 }
@@ -38,18 +38,37 @@ int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 }
 
 /*************************************************
-* Name:        crypto_kem_enc
+* Name:        crypto_kem_expand_pk
+*
+* Description: Expands a public key for repeated encapsulation:
+*              precomputes the NTT-domain polynomials and the
+*              hash of the public key
+*
+* Arguments:   - crypto_kem_expanded_pk *epk: pointer to output expanded public key
+*              - const unsigned char *pk:     pointer to input public key (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_expand_pk(crypto_kem_expanded_pk *epk, const unsigned char *pk)
+{
+  cpapke_expand_pk(&epk->cpa, pk);
+  shake256(epk->pkh, NEWHOPE_SYMBYTES, pk, NEWHOPE_CCAKEM_PUBLICKEYBYTES);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_enc_expanded
 *
 * Description: Generates cipher text and shared
-*              secret for given public key
+*              secret for given expanded public key
 *
-* Arguments:   - unsigned char *ct:       pointer to output cipher text (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
-*              - unsigned char *ss:       pointer to output shared secret (an already allocated array of CRYPTO_BYTES bytes)
-*              - const unsigned char *pk: pointer to input public key (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+* Arguments:   - unsigned char *ct:                  pointer to output cipher text (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
+*              - unsigned char *ss:                  pointer to output shared secret (an already allocated array of CRYPTO_BYTES bytes)
+*              - const crypto_kem_expanded_pk *epk:  pointer to input expanded public key
 *
 * Returns 0 (success)
 **************************************************/
-int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+int crypto_kem_enc_expanded(unsigned char *ct, unsigned char *ss, const crypto_kem_expanded_pk *epk)
 {
   unsigned char k_coins_d[3*NEWHOPE_SYMBYTES];                                                /* Will contain key, coins, qrom-hash */
   unsigned char buf[2*NEWHOPE_SYMBYTES];
@@ -58,10 +77,11 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
   randombytes(buf,NEWHOPE_SYMBYTES);
 
   shake256(buf,NEWHOPE_SYMBYTES,buf,NEWHOPE_SYMBYTES);                                        /* Don't release system RNG output */
-  shake256(buf+NEWHOPE_SYMBYTES, NEWHOPE_SYMBYTES, pk, NEWHOPE_CCAKEM_PUBLICKEYBYTES);        /* Multitarget countermeasure for coins + contributory KEM */
+  for(i=0;i<NEWHOPE_SYMBYTES;i++)                                                             /* Multitarget countermeasure for coins + contributory KEM */
+    buf[NEWHOPE_SYMBYTES+i] = epk->pkh[i];
   shake256(k_coins_d, 3*NEWHOPE_SYMBYTES, buf, 2*NEWHOPE_SYMBYTES);
 
-  cpapke_enc(ct, buf, pk, k_coins_d+NEWHOPE_SYMBYTES);                                        /* coins are in k_coins_d+NEWHOPE_SYMBYTES */
+  cpapke_enc_expanded(ct, buf, &epk->cpa, k_coins_d+NEWHOPE_SYMBYTES);                        /* coins are in k_coins_d+NEWHOPE_SYMBYTES */
 
   for(i=0;i<NEWHOPE_SYMBYTES;i++)
     ct[i+NEWHOPE_CPAPKE_CIPHERTEXTBYTES] = k_coins_d[i+2*NEWHOPE_SYMBYTES];                   /* copy Targhi-Unruh hash into ct */
@@ -71,6 +91,26 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
   return 0;
 }
 
+/*************************************************
+* Name:        crypto_kem_enc
+*
+* Description: Generates cipher text and shared
+*              secret for given public key
+*
+* Arguments:   - unsigned char *ct:       pointer to output cipher text (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
+*              - unsigned char *ss:       pointer to output shared secret (an already allocated array of CRYPTO_BYTES bytes)
+*              - const unsigned char *pk: pointer to input public key (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{
+  crypto_kem_expanded_pk epk;
+
+  crypto_kem_expand_pk(&epk, pk);
+  return crypto_kem_enc_expanded(ct, ss, &epk);
+}
+
 /*************************************************
 * Name:        crypto_kem_dec
 *
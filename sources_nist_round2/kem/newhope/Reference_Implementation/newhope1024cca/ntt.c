@@ -3,6 +3,11 @@
 #include "params.h"
 #include "reduce.h"
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && !defined(NEWHOPE_NO_AVX2)
+#define NEWHOPE_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+
 #if (NEWHOPE_N == 512)
 /************************************************************
 * Name:        bitrev_table
@@ -99,6 +104,137 @@ void bitrev_vector(uint16_t* poly)
     }
 }
 
+#if defined(NEWHOPE_AVX2_DISPATCH)
+
+/* 
+ * AVX2 versions of mul_coefficients and ntt, selected at run time.
+ * They compute exactly what the scalar code computes, including the lazy
+ * reductions and the truncation to 16 bits between levels, so they work
+ * on 32-bit lanes: 16 coefficients are handled as two halves of 8.
+ */
+
+#define AVX2 __attribute__((target("avx2")))
+
+static AVX2 __m256i load8_avx2(const uint16_t *p)
+{
+  return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)p));
+}
+
+static AVX2 void store8_avx2(uint16_t *p, __m256i x)
+{
+  x = _mm256_and_si256(x, _mm256_set1_epi32(0xFFFF));
+  x = _mm256_permute4x64_epi64(_mm256_packus_epi32(x, x), 0x08);
+  _mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(x));
+}
+
+/* Same as montgomery_reduce() on each lane */
+static AVX2 __m256i montgomery_reduce_avx2(__m256i a)
+{
+  __m256i u = _mm256_mullo_epi32(a, _mm256_set1_epi32(12287));
+  u = _mm256_and_si256(u, _mm256_set1_epi32((1<<18)-1));
+  u = _mm256_mullo_epi32(u, _mm256_set1_epi32(NEWHOPE_Q));
+  return _mm256_srli_epi32(_mm256_add_epi32(a, u), 18);
+}
+
+/* x % NEWHOPE_Q for 0 <= x < 2^17 */
+static AVX2 __m256i mod_q_avx2(__m256i x)
+{
+  __m256i q = _mm256_set1_epi32(NEWHOPE_Q);
+  __m256i t = _mm256_srli_epi32(_mm256_mullo_epi32(x, _mm256_set1_epi32((1<<28)/NEWHOPE_Q)), 28);
+  x = _mm256_sub_epi32(x, _mm256_mullo_epi32(t, q));
+  return _mm256_sub_epi32(x, _mm256_and_si256(_mm256_cmpgt_epi32(x, _mm256_set1_epi32(NEWHOPE_Q-1)), q));
+}
+
+static AVX2 void butterfly_avx2(__m256i *lo, __m256i *hi, __m256i w, int reduce)
+{
+  __m256i t = *lo;
+
+  *lo = _mm256_add_epi32(t, *hi);
+  if(reduce)
+    *lo = mod_q_avx2(*lo);
+  *hi = _mm256_sub_epi32(_mm256_add_epi32(t, _mm256_set1_epi32(3*NEWHOPE_Q)), *hi);
+  *hi = montgomery_reduce_avx2(_mm256_mullo_epi32(w, *hi));
+}
+
+static AVX2 void mul_coefficients_avx2(uint16_t* poly, const uint16_t* factors)
+{
+  unsigned int i;
+
+  for(i = 0; i < NEWHOPE_N; i += 8)
+    store8_avx2(poly+i, montgomery_reduce_avx2(_mm256_mullo_epi32(load8_avx2(poly+i), load8_avx2(factors+i))));
+}
+
+static AVX2 void ntt_avx2(uint16_t * a, const uint16_t* omega)
+{
+  int level, distance, start, j, k;
+
+  for(level = 0; (1<<level) < NEWHOPE_N; level++)
+  {
+    int reduce = level & 1; /* Odd levels reduce the sums, even levels are lazy */
+    distance = (1<<level);
+
+    if(distance >= 8)
+    {
+      /* The twiddle factor is the same across a block of 2*distance coefficients */
+      for(start = 0; start < NEWHOPE_N; start += 2*distance)
+      {
+        __m256i w = _mm256_set1_epi32(omega[start/(2*distance)]);
+        for(j = start; j < start+distance; j += 8)
+        {
+          __m256i lo = load8_avx2(a+j), hi = load8_avx2(a+j+distance);
+          butterfly_avx2(&lo, &hi, w, reduce);
+          store8_avx2(a+j, lo);
+          store8_avx2(a+j+distance, hi);
+        }
+      }
+    }
+    else
+    {
+      /* Both halves of each butterfly lie in the same 8 coefficients: gather the
+       * lower halves of 16 coefficients in one register and the upper halves in
+       * another, then scatter them back */
+      int lopos[4], idx_lo[8], idx_hi[8], idx_inv[8], hi_mask[8], twiddle[8];
+      __m256i vlo, vhi, vinv, vinv1, vmask;
+
+      for(j = 0, k = 0; j < 8; j++)
+        if(!(j & distance))
+          lopos[k++] = j;
+      for(j = 0; j < 8; j++)
+      {
+        idx_lo[j]  = lopos[j&3];
+        idx_hi[j]  = lopos[j&3] + distance;
+        idx_inv[j] = (j & (distance-1)) | ((j >> (level+1)) << level);        /* index of the butterfly in lopos */
+        hi_mask[j] = (j & distance) ? -1 : 0;
+        twiddle[j] = ((j < 4) ? lopos[j] : 8 + lopos[j-4]) / (2*distance);
+      }
+      vlo   = _mm256_loadu_si256((const __m256i *)idx_lo);
+      vhi   = _mm256_loadu_si256((const __m256i *)idx_hi);
+      vinv  = _mm256_loadu_si256((const __m256i *)idx_inv);
+      vinv1 = _mm256_add_epi32(vinv, _mm256_set1_epi32(4));
+      vmask = _mm256_loadu_si256((const __m256i *)hi_mask);
+
+      for(start = 0; start < NEWHOPE_N; start += 16)
+      {
+        const uint16_t *om = omega + start/(2*distance);
+        __m256i x0 = load8_avx2(a+start), x1 = load8_avx2(a+start+8);
+        __m256i lo = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(x0, vlo), _mm256_permutevar8x32_epi32(x1, vlo), 0xF0);
+        __m256i hi = _mm256_blend_epi32(_mm256_permutevar8x32_epi32(x0, vhi), _mm256_permutevar8x32_epi32(x1, vhi), 0xF0);
+        __m256i w  = _mm256_setr_epi32(om[twiddle[0]], om[twiddle[1]], om[twiddle[2]], om[twiddle[3]],
+                                       om[twiddle[4]], om[twiddle[5]], om[twiddle[6]], om[twiddle[7]]);
+
+        butterfly_avx2(&lo, &hi, w, reduce);
+
+        x0 = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(lo, vinv),  _mm256_permutevar8x32_epi32(hi, vinv),  vmask);
+        x1 = _mm256_blendv_epi8(_mm256_permutevar8x32_epi32(lo, vinv1), _mm256_permutevar8x32_epi32(hi, vinv1), vmask);
+        store8_avx2(a+start, x0);
+        store8_avx2(a+start+8, x1);
+      }
+    }
+  }
+}
+
+#endif
+
 /*************************************************
 * Name:        mul_coefficients
 * 
@@ -112,6 +248,14 @@ void mul_coefficients(uint16_t* poly, const uint16_t* factors)
 {
     unsigned int i;
 
+#if defined(NEWHOPE_AVX2_DISPATCH)
+    if(__builtin_cpu_supports("avx2"))
+    {
+      mul_coefficients_avx2(poly, factors);
+      return;
+    }
+#endif
+
     for(i = 0; i < NEWHOPE_N; i++)
       poly[i] = montgomery_reduce((poly[i] * factors[i]));
 }
@@ -134,6 +278,13 @@ void ntt(uint16_t * a, const uint16_t* omega)
   int i, start, j, jTwiddle, distance;
   uint16_t temp, W;
 
+#if defined(NEWHOPE_AVX2_DISPATCH)
+  if(__builtin_cpu_supports("avx2"))
+  {
+    ntt_avx2(a, omega);
+    return;
+  }
+#endif
 
   for(i=0;i<9;i+=2)
   {
@@ -186,6 +337,13 @@ ntt(uint16_t * a, const uint16_t* omega)
   int i, start, j, jTwiddle, distance;
   uint16_t temp, W;
 
+#if defined(NEWHOPE_AVX2_DISPATCH)
+  if(__builtin_cpu_supports("avx2"))
+  {
+    ntt_avx2(a, omega);
+    return;
+  }
+#endif
 
   for(i=0;i<10;i+=2)
   {
@@ -123,31 +123,46 @@ void cpapke_keypair(unsigned char *pk,
 }
 
 /*************************************************
-* Name:        cpapke_enc
+* Name:        cpapke_expand_pk
+* 
+* Description: Decodes the public key and samples the public
+*              polynomial a from its seed, for use by any number
+*              of calls to cpapke_enc_expanded
+*
+* Arguments:   - cpapke_expanded_pk *epk: pointer to output expanded public key
+*              - const unsigned char *pk: pointer to input public key
+**************************************************/
+void cpapke_expand_pk(cpapke_expanded_pk *epk,
+                      const unsigned char *pk)
+{
+  unsigned char publicseed[NEWHOPE_SYMBYTES];
+
+  decode_pk(&epk->bhat, publicseed, pk);
+  gen_a(&epk->ahat, publicseed);
+}
+
+/*************************************************
+* Name:        cpapke_enc_expanded
 * 
 * Description: Encryption function of
 *              the CPA public-key encryption scheme underlying
-*              the NewHope KEMs
+*              the NewHope KEMs, under an expanded public key
 *
-* Arguments:   - unsigned char *c:          pointer to output ciphertext
-*              - const unsigned char *m:    pointer to input message (of length NEWHOPE_SYMBYTES bytes)
-*              - const unsigned char *pk:   pointer to input public key
-*              - const unsigned char *coin: pointer to input random coins used as seed
-*                                           to deterministically generate all randomness
+* Arguments:   - unsigned char *c:                pointer to output ciphertext
+*              - const unsigned char *m:          pointer to input message (of length NEWHOPE_SYMBYTES bytes)
+*              - const cpapke_expanded_pk *epk:   pointer to input expanded public key
+*              - const unsigned char *coin:       pointer to input random coins used as seed
+*                                                 to deterministically generate all randomness
 **************************************************/
-void cpapke_enc(unsigned char *c,
-                const unsigned char *m,
-                const unsigned char *pk,
-                const unsigned char *coin)
+void cpapke_enc_expanded(unsigned char *c,
+                         const unsigned char *m,
+                         const cpapke_expanded_pk *epk,
+                         const unsigned char *coin)
 {
-  poly sprime, eprime, vprime, ahat, bhat, eprimeprime, uhat, v;
-  unsigned char publicseed[NEWHOPE_SYMBYTES];
+  poly sprime, eprime, vprime, eprimeprime, uhat, v;
 
   poly_frommsg(&v, m);
 
-  decode_pk(&bhat, publicseed, pk);
-  gen_a(&ahat, publicseed);
-
   poly_sample(&sprime, coin, 0);
   poly_sample(&eprime, coin, 1);
   poly_sample(&eprimeprime, coin, 2);
@@ -155,10 +170,10 @@ void cpapke_enc(unsigned char *c,
   poly_ntt(&sprime);
   poly_ntt(&eprime);
 
-  poly_mul_pointwise(&uhat, &ahat, &sprime);
+  poly_mul_pointwise(&uhat, &epk->ahat, &sprime);
   poly_add(&uhat, &uhat, &eprime);
 
-  poly_mul_pointwise(&vprime, &bhat, &sprime);
+  poly_mul_pointwise(&vprime, &epk->bhat, &sprime);
   poly_invntt(&vprime);
 
   poly_add(&vprime, &vprime, &eprimeprime);
@@ -167,6 +182,30 @@ void cpapke_enc(unsigned char *c,
   encode_c(c, &uhat, &vprime);
 }
 
+/*************************************************
+* Name:        cpapke_enc
+* 
+* Description: Encryption function of
+*              the CPA public-key encryption scheme underlying
+*              the NewHope KEMs
+*
+* Arguments:   - unsigned char *c:          pointer to output ciphertext
+*              - const unsigned char *m:    pointer to input message (of length NEWHOPE_SYMBYTES bytes)
+*              - const unsigned char *pk:   pointer to input public key
+*              - const unsigned char *coin: pointer to input random coins used as seed
+*                                           to deterministically generate all randomness
+**************************************************/
+void cpapke_enc(unsigned char *c,
+                const unsigned char *m,
+                const unsigned char *pk,
+                const unsigned char *coin)
+{
+  cpapke_expanded_pk epk;
+
+  cpapke_expand_pk(&epk, pk);
+  cpapke_enc_expanded(c, m, &epk, coin);
+}
+
 
 /*************************************************
 * Name:        cpapke_dec
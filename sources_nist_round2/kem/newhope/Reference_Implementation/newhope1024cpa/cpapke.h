@@ -1,6 +1,17 @@
 #ifndef INDCPA_H
 #define INDCPA_H
 
+#include "poly.h"
+
+/* 
+ * Public key expanded for repeated encryption: the NTT-domain polynomials
+ * a (sampled from the public seed) and b (decoded from the public key)
+ */
+typedef struct {
+  poly ahat;
+  poly bhat;
+} cpapke_expanded_pk;
+
 void cpapke_keypair(unsigned char *pk, 
                     unsigned char *sk);
 
@@ -9,6 +20,14 @@ void cpapke_enc(unsigned char *c,
                const unsigned char *pk,
                const unsigned char *coins);
 
+void cpapke_expand_pk(cpapke_expanded_pk *epk,
+                      const unsigned char *pk);
+
+void cpapke_enc_expanded(unsigned char *c,
+                         const unsigned char *m,
+                         const cpapke_expanded_pk *epk,
+                         const unsigned char *coins);
+
 void cpapke_dec(unsigned char *m,
                const unsigned char *c,
                const unsigned char *sk);
@@ -26,18 +26,35 @@ int crypto_kem_keypair(unsigned char *pk, unsigned char *sk)
 }
 
 /*************************************************
-* Name:        crypto_kem_enc
+* Name:        crypto_kem_expand_pk
+*
+* Description: Expands a public key for repeated encapsulation:
+*              precomputes the NTT-domain polynomials
+*
+* Arguments:   - crypto_kem_expanded_pk *epk: pointer to output expanded public key
+*              - const unsigned char *pk:     pointer to input public key (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_expand_pk(crypto_kem_expanded_pk *epk, const unsigned char *pk)
+{
+  cpapke_expand_pk(&epk->cpa, pk);
+  return 0;
+}
+
+/*************************************************
+* Name:        crypto_kem_enc_expanded
 *
 * Description: Generates cipher text and shared
-*              secret for given public key
+*              secret for given expanded public key
 *
-* Arguments:   - unsigned char *ct:       pointer to output cipher text (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
-*              - unsigned char *ss:       pointer to output shared secret (an already allocated array of CRYPTO_BYTES bytes)
-*              - const unsigned char *pk: pointer to input public key (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+* Arguments:   - unsigned char *ct:                  pointer to output cipher text (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
+*              - unsigned char *ss:                  pointer to output shared secret (an already allocated array of CRYPTO_BYTES bytes)
+*              - const crypto_kem_expanded_pk *epk:  pointer to input expanded public key
 *
 * Returns 0 (success)
 **************************************************/
-int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+int crypto_kem_enc_expanded(unsigned char *ct, unsigned char *ss, const crypto_kem_expanded_pk *epk)
 {
   unsigned char buf[2*NEWHOPE_SYMBYTES];
 
@@ -45,12 +62,32 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
 
   shake256(buf,2*NEWHOPE_SYMBYTES,buf,NEWHOPE_SYMBYTES);                         /* Don't release system RNG output */
 
-  cpapke_enc(ct, buf, pk, buf+NEWHOPE_SYMBYTES);                                 /* coins are in buf+NEWHOPE_SYMBYTES */
+  cpapke_enc_expanded(ct, buf, &epk->cpa, buf+NEWHOPE_SYMBYTES);                 /* coins are in buf+NEWHOPE_SYMBYTES */
 
   shake256(ss, NEWHOPE_SYMBYTES, buf, NEWHOPE_SYMBYTES);                         /* hash pre-k to ss */
   return 0;
 }
 
+/*************************************************
+* Name:        crypto_kem_enc
+*
+* Description: Generates cipher text and shared
+*              secret for given public key
+*
+* Arguments:   - unsigned char *ct:       pointer to output cipher text (an already allocated array of CRYPTO_CIPHERTEXTBYTES bytes)
+*              - unsigned char *ss:       pointer to output shared secret (an already allocated array of CRYPTO_BYTES bytes)
+*              - const unsigned char *pk: pointer to input public key (an already allocated array of CRYPTO_PUBLICKEYBYTES bytes)
+*
+* Returns 0 (success)
+**************************************************/
+int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk)
+{
+  crypto_kem_expanded_pk epk;
+
+  crypto_kem_expand_pk(&epk, pk);
+  return crypto_kem_enc_expanded(ct, ss, &epk);
+}
+
 
 /*************************************************
 * Name:        crypto_kem_dec
@@ -2,6 +2,7 @@
 #define API_H
 
 #include "params.h"
+#include "cpapke.h"
 
 #define CRYPTO_SECRETKEYBYTES  NEWHOPE_CPAKEM_SECRETKEYBYTES
 #define CRYPTO_PUBLICKEYBYTES  NEWHOPE_CPAKEM_PUBLICKEYBYTES
@@ -22,4 +23,13 @@ int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk
 
 int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
 
+/* Public key expanded once for any number of encapsulations */
+typedef struct {
+  cpapke_expanded_pk cpa;
+} crypto_kem_expanded_pk;
+
+int crypto_kem_expand_pk(crypto_kem_expanded_pk *epk, const unsigned char *pk);
+
+int crypto_kem_enc_expanded(unsigned char *ct, unsigned char *ss, const crypto_kem_expanded_pk *epk);
+
 #endif
@@ -36,6 +36,7 @@ poly *berlekamp_massey(const FF2m *ff2m,
 {
     poly *ex = NULL;
     ff_unit *sigma = NULL, *beta = NULL, *varphi = NULL;
+    ff_unit *S_rev = NULL, *u = NULL;
     ff_unit *src0_ptr = NULL, *src1_ptr = NULL, *dst_ptr = NULL;
     ff_unit d, delta = 1;
     ff_unit inv = 0;
@@ -46,9 +47,18 @@ poly *berlekamp_massey(const FF2m *ff2m,
     sigma  = (ff_unit *)calloc(t+1, sizeof(ff_unit));
     beta   = (ff_unit *)calloc(t+1, sizeof(ff_unit));
     varphi = (ff_unit *)calloc(t+1, sizeof(ff_unit));
-    if (!sigma || !beta || !varphi) {
+    S_rev  = (ff_unit *)calloc(slen, sizeof(ff_unit));
+    u      = (ff_unit *)calloc(t+1, sizeof(ff_unit));
+    if (!sigma || !beta || !varphi || !S_rev || !u) {
         goto BMA_fail;
     }
+    /**
+     * S_rev is S in reverse order, so that the sum below is an
+     * element-wise product of sigma and S_rev[slen-1-i...]
+     **/
+    for (i=0; i<slen; i++) {
+        S_rev[slen-1-i] = S[i];
+    }
     sigma[0] = 1;   /* sigma(x) = 1 */
     beta[1] = 1;    /* beta(x) = x */
     *extended_error = 0;
@@ -59,17 +69,17 @@ poly *berlekamp_massey(const FF2m *ff2m,
          * d = \sum_{i}^{\min{i, t}} sigma_j * S_{i-j}
          **/
         v = CT_min(i, t);
+        ff2m->ff_mul_vec(ff2m, u, sigma, &S_rev[slen-1-i], v+1);
         for (d=0,j=0; j<=v; j++) {
-            d = ff2m->ff_add(ff2m, d,
-                             ff2m->ff_mul(ff2m, sigma[j], S[i-j]));
+            d = ff2m->ff_add(ff2m, d, u[j]);
         }
         /**
          * varphi(x) = delta.sigma(x) - d.beta(x)
          **/
+        ff2m->ff_mul_scalar_vec(ff2m, varphi, delta, sigma, t+1);
+        ff2m->ff_mul_scalar_vec(ff2m, u, d, beta, t+1);
         for (j=0; j<=t; j++) {
-            varphi[j] = ff2m->ff_add(ff2m,
-                                     ff2m->ff_mul(ff2m, delta, sigma[j]),
-                                     ff2m->ff_mul(ff2m, d, beta[j]));
+            varphi[j] = ff2m->ff_add(ff2m, varphi[j], u[j]);
         }
 
         d_eq_0 = CT_is_equal_zero((uint32_t)d);   /* d == 0? */
@@ -119,6 +129,14 @@ poly *berlekamp_massey(const FF2m *ff2m,
     *extended_error = CT_is_less_than(ex->degree, t - (R>>1));
     
 BMA_fail:
+    if (u) {
+        memset(u, 0, (t+1)*sizeof(ff_unit));
+        free(u);
+    }
+    if (S_rev) {
+        memset(S_rev, 0, slen*sizeof(ff_unit));
+        free(S_rev);
+    }
     if (varphi) {
         memset(varphi, 0, (t+1)*sizeof(ff_unit));
         free(varphi);
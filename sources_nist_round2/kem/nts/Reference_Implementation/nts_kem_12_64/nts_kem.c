@@ -33,6 +33,14 @@ typedef struct {
     uint8_t z[ NTS_KEM_KEY_SIZE ];
 } NTSKEM_private;
 
+/**
+ *  NTS-KEM decapsulation context, see nts_kem_ctx_from_sk
+ **/
+struct NTSKEM_ctx {
+    NTSKEM *nts_kem;            /* NTS-KEM object initialised from the private key */
+    ff_unit *H;                 /* Truncated parity-check matrix H*_m, column-major, see create_syndrome_table */
+};
+
 static const int kNTSKEMKeysize = NTS_KEM_KEY_SIZE;
 
 #define NTS_KEM_PARAM_A_REM		(((NTS_KEM_PARAM_A - (kNTSKEMKeysize << 3)) & MOD) >> 3)
@@ -41,6 +49,7 @@ static const int kNTSKEMKeysize = NTS_KEM_KEY_SIZE;
 poly* create_random_goppa_polynomial(const FF2m* ff2m, int degree);
 matrix_ff2* create_matrix_G(const NTSKEM* nts_kem,
                             const poly* Gz,
+                            matrix_ff2_arena* arena,
                             ff_unit *a,
                             ff_unit *h);
 void fisher_yates_shuffle(ff_unit *buffer);
@@ -48,6 +57,14 @@ void random_vector(uint32_t tau, uint32_t n, uint8_t *e);
 int compute_syndrome(const NTSKEM* nts_kem,
                      const uint8_t *c_ast,
                      ff_unit* s);
+ff_unit* create_syndrome_table(const NTSKEM* nts_kem);
+void compute_syndrome_from_table(const ff_unit* H,
+                                 const uint8_t *c_ast,
+                                 ff_unit* s);
+static int decapsulate(const NTSKEM *nts_kem,
+                       const ff_unit *H,
+                       const uint8_t *c_ast,
+                       uint8_t *k_r);
 void correct_error_and_recover_ke(const uint8_t* e_prime,
                                   const ff_unit* p,
                                   uint8_t *e,
@@ -87,6 +104,7 @@ int nts_kem_create(NTSKEM** nts_kem)
     NTSKEM_private *priv = NULL;
     NTSKEM *nts_kem_ptr = NULL;
     matrix_ff2 *Q = NULL;
+    matrix_ff2_arena *arena = NULL;
     
     *nts_kem = (NTSKEM *)malloc(sizeof(NTSKEM));
     if (!(*nts_kem))
@@ -152,7 +170,15 @@ int nts_kem_create(NTSKEM** nts_kem)
 #if defined(INTERMEDIATE_VALUES)
     fprintf(stdout, "# KGen Step 3. Construct a generator matrix G = [I_k | Q]\n");
 #endif
-    Q = create_matrix_G(nts_kem_ptr, Gz, a, h);
+    /**
+     * Both the parity-check matrix H and the matrix Q are taken
+     * from a single arena, released once the keys are serialised
+     **/
+    arena = create_matrix_ff2_arena(arena_size_matrix_ff2(NTS_KEM_PARAM_C, NTS_KEM_PARAM_N) +
+                                    arena_size_matrix_ff2(NTS_KEM_PARAM_K, NTS_KEM_PARAM_C));
+    if (!arena)
+        goto nts_kem_create_fail;
+    Q = create_matrix_G(nts_kem_ptr, Gz, arena, a, h);
     if (Q == NULL)
         goto nts_kem_create_fail;
     
@@ -198,6 +224,7 @@ nts_kem_create_fail:
     }
     
     free_matrix_ff2(Q);
+    release_matrix_ff2_arena(arena);
     if (status != NTS_KEM_SUCCESS) {
         if (nts_kem_ptr) {
             nts_kem_release(nts_kem_ptr);
@@ -503,6 +530,88 @@ int nts_kem_encapsulate(const uint8_t *pk,
     return status;
 }
 
+/**
+ *  Create a decapsulation context from a private key
+ *
+ *  @param[out] ctx     A pointer of the NTS-KEM context created
+ *  @param[in]  sk      The pointer to NTS-KEM private key
+ *  @param[in]  sk_size The size of the private key in bytes
+ *  @return NTS_KEM_SUCCESS on success, otherwise a negative error code
+ *          {@see nts_kem_errors.h}
+ **/
+int nts_kem_ctx_from_sk(NTSKEM_ctx **ctx,
+                        const uint8_t *sk,
+                        size_t sk_size)
+{
+    int status = NTS_KEM_BAD_MEMORY_ALLOCATION;
+    NTSKEM_ctx *ctx_ptr = NULL;
+    
+    if (!ctx || !sk)
+        return NTS_KEM_BAD_PARAMETERS;
+    
+    *ctx = (NTSKEM_ctx *)malloc(sizeof(NTSKEM_ctx));
+    if (!(*ctx))
+        goto nts_kem_ctx_fail;
+    ctx_ptr = *ctx;
+    ctx_ptr->nts_kem = NULL;
+    ctx_ptr->H = NULL;
+    
+    status = nts_kem_init_from_private_key(&ctx_ptr->nts_kem, sk, sk_size);
+    if (status != NTS_KEM_SUCCESS)
+        goto nts_kem_ctx_fail;
+    status = NTS_KEM_BAD_MEMORY_ALLOCATION;
+    
+    ctx_ptr->H = create_syndrome_table(ctx_ptr->nts_kem);
+    if (!ctx_ptr->H)
+        goto nts_kem_ctx_fail;
+    
+    status = NTS_KEM_SUCCESS;
+nts_kem_ctx_fail:
+    if (status != NTS_KEM_SUCCESS) {
+        nts_kem_ctx_release(ctx_ptr);
+        if (ctx)
+            *ctx = NULL;
+    }
+    
+    return status;
+}
+
+/**
+ *  Release a decapsulation context
+ *
+ *  @param[in] ctx  A pointer to an NTS-KEM context
+ **/
+void nts_kem_ctx_release(NTSKEM_ctx *ctx)
+{
+    if (ctx) {
+        if (ctx->H) {
+            memset(ctx->H, 0, 2*NTS_KEM_PARAM_T*NTS_KEM_PARAM_BC*sizeof(ff_unit));
+            free(ctx->H);
+        }
+        nts_kem_release(ctx->nts_kem);
+        free(ctx);
+    }
+}
+
+/**
+ *  NTS-KEM decapsulation with a decapsulation context
+ *
+ *  @param[in]  ctx     The pointer to NTS-KEM context
+ *  @param[in]  c_ast   The pointer to the NTS-KEM ciphertext
+ *  @param[out] k_r     The pointer to the encapsulated key
+ *  @return NTS_KEM_SUCCESS on success, otherwise a negative error code
+ *          {@see nts_kem_errors.h}
+ **/
+int nts_kem_decapsulate_ctx(const NTSKEM_ctx *ctx,
+                            const uint8_t *c_ast,
+                            uint8_t *k_r)
+{
+    if (!ctx)
+        return NTS_KEM_BAD_PARAMETERS;
+    
+    return decapsulate(ctx->nts_kem, ctx->H, c_ast, k_r);
+}
+
 /**
  *  NTS-KEM decapsulation
  *
@@ -517,17 +626,49 @@ int nts_kem_decapsulate(const uint8_t *sk,
                         size_t sk_size,
                         const uint8_t *c_ast,
                         uint8_t *k_r)
+{
+    int status;
+    NTSKEM *nts_kem = NULL;
+    
+    /**
+     * Construct an NTS object from private key
+     **/
+    status = nts_kem_init_from_private_key(&nts_kem, sk, sk_size);
+    if (status != NTS_KEM_SUCCESS)
+        return status;
+    
+    status = decapsulate(nts_kem, NULL, c_ast, k_r);
+    nts_kem_release(nts_kem);
+    
+    return status;
+}
+
+/**
+ *  NTS-KEM decapsulation given an NTS-KEM object holding the private key
+ *
+ *  @param[in]  nts_kem The pointer to NTS-KEM object
+ *  @param[in]  H       The syndrome table of nts_kem, or NULL to compute
+ *                      the syndromes directly from the private key
+ *  @param[in]  c_ast   The pointer to the NTS-KEM ciphertext
+ *  @param[out] k_r     The pointer to the encapsulated key
+ *  @return NTS_KEM_SUCCESS on success, otherwise a negative error code
+ *          {@see nts_kem_errors.h}
+ **/
+static int decapsulate(const NTSKEM *nts_kem,
+                       const ff_unit *H,
+                       const uint8_t *c_ast,
+                       uint8_t *k_r)
 {
     int32_t i, status = NTS_KEM_BAD_MEMORY_ALLOCATION;
     int32_t extended_error = 0;
     uint32_t checksum = 0, error_weight = 0;
-    NTSKEM *nts_kem = NULL;
     NTSKEM_private *priv = NULL;
     ff_unit *evals = NULL;
     poly *sigma_x = NULL;
     ff_unit syndromes[2*NTS_KEM_PARAM_T];
     uint8_t e[NTS_KEM_PARAM_CEIL_N_BYTE], e_prime[NTS_KEM_PARAM_CEIL_N_BYTE];
     uint8_t kr_in_buf[kNTSKEMKeysize + NTS_KEM_PARAM_CEIL_N_BYTE];
+    uint8_t k_e[kNTSKEMKeysize];
     size_t roots_size = 0;
     uint8_t xof_buf[kNTSKEMKeysize + NTS_KEM_PARAM_CEIL_N_BYTE];
     uint8_t c_buf[NTS_KEM_PARAM_CEIL_N_BYTE];
@@ -537,17 +678,11 @@ int nts_kem_decapsulate(const uint8_t *sk,
     const uint64_t *in_right_ptr = NULL;
     const uint64_t *e_ptr = NULL;
     
-    if (!k_r || !c_ast) {
+    if (!nts_kem || !k_r || !c_ast) {
         status = NTS_KEM_BAD_PARAMETERS;
         goto decapsulation_failure;
     }
     
-    /**
-     * Construct an NTS object from private key
-     **/
-    if (NTS_KEM_SUCCESS != nts_kem_init_from_private_key(&nts_kem, sk, sk_size))
-        goto decapsulation_failure;
-    
     priv = nts_kem->priv;
     
     /**
@@ -571,9 +706,14 @@ int nts_kem_decapsulate(const uint8_t *sk,
      * 1(c). Compute all 2*τ syndromes of c* as s = (c_b | c_c).(H*_m)^T,
      *       see Algorithm 2 in the supporting document
      */
-    status = compute_syndrome(nts_kem, c_ast, syndromes);
-    if (status != NTS_KEM_SUCCESS)
-        goto decapsulation_failure;
+    if (H) {
+        compute_syndrome_from_table(H, c_ast, syndromes);
+    }
+    else {
+        status = compute_syndrome(nts_kem, c_ast, syndromes);
+        if (status != NTS_KEM_SUCCESS)
+            goto decapsulation_failure;
+    }
     status = NTS_KEM_BAD_MEMORY_ALLOCATION; /* Reset the status value */
    
 #if defined(INTERMEDIATE_VALUES)
@@ -641,14 +781,18 @@ int nts_kem_decapsulate(const uint8_t *sk,
     /**
      * Step 2. Permute e_prime with permutation p to obtain e
      * Step 3. Consider e = (e_a | e_b | e_c), recover k_e = c_b - e_b
+     *
+     * k_e is recovered in a copy of c_b so that c_ast is left intact
+     * and the same ciphertext can be decapsulated again
      **/
-    correct_error_and_recover_ke(e_prime, priv->p, e, (uint8_t*)c_ast);
+    memcpy(k_e, c_ast, kNTSKEMKeysize);
+    correct_error_and_recover_ke(e_prime, priv->p, e, k_e);
     
 #if defined(INTERMEDIATE_VALUES)
     fprintf(stdout, "# Decap Step 2. Permute vector e_prime to obtain e\n");
     fprintf_uint8_vec(stdout, "e = ", e, NTS_KEM_PARAM_CEIL_N_BYTE, "\n");
     fprintf(stdout, "# Decap Step 3. Recover k_e\n");
-    fprintf_uint8_vec(stdout, "k_e = ", c_ast, NTS_KEM_KEY_SIZE, "\n");
+    fprintf_uint8_vec(stdout, "k_e = ", k_e, NTS_KEM_KEY_SIZE, "\n");
 #endif
     
     /**
@@ -671,7 +815,7 @@ int nts_kem_decapsulate(const uint8_t *sk,
      * Verify the equality of k_e and SHAKE256(e)
      **/
     for (checksum=0,i=0; i<kNTSKEMKeysize; i++) {
-        checksum += (c_ast[i] ^ kr_in_buf[i]);
+        checksum += (k_e[i] ^ kr_in_buf[i]);
     }
     /**
      * Weight check
@@ -709,6 +853,7 @@ int nts_kem_decapsulate(const uint8_t *sk,
     
 decapsulation_failure:
     memset(kr_in_buf, 0, kNTSKEMKeysize + NTS_KEM_PARAM_CEIL_N_BYTE);
+    memset(k_e, 0, kNTSKEMKeysize);
     memset(e, 0, NTS_KEM_PARAM_CEIL_N_BYTE);
     memset(e_prime, 0, NTS_KEM_PARAM_CEIL_N_BYTE);
     if (sigma_x) {
@@ -720,8 +865,6 @@ decapsulation_failure:
         memset(evals, 0, roots_size*sizeof(ff_unit));
         free(evals);
     }
-    if (nts_kem)
-        nts_kem_release(nts_kem);
     
     return status;
 }
@@ -849,6 +992,7 @@ poly* create_random_goppa_polynomial(const FF2m *ff2m, int degree)
  *
  *  @param[in]  nts_kem  The pointer to an NTS-KEM object
  *  @param[in]  Gz       The Goppa polynomial G(z)
+ *  @param[in]  arena    The arena from which H and Q are allocated
  *  @param[out] a        The vector containing all elements of
  *                       F_2^m, permuted by vector p
  *  @param[out] h        The evaluation of G(z) based on the
@@ -857,6 +1001,7 @@ poly* create_random_goppa_polynomial(const FF2m *ff2m, int degree)
  **/
 matrix_ff2* create_matrix_G(const NTSKEM* nts_kem,
                             const poly* Gz,
+                            matrix_ff2_arena* arena,
                             ff_unit *a,
                             ff_unit *h)
 {
@@ -927,7 +1072,7 @@ matrix_ff2* create_matrix_G(const NTSKEM* nts_kem,
      * 3(c) Transform H_m_hat to H (binary matrix) by applying
      *      operator B(.)^T on each component of H_m.
      **/
-    H = calloc_matrix_ff2(Gz->degree * priv->ff2m->m, (1 << priv->m));
+    H = calloc_matrix_ff2_from_arena(arena, Gz->degree * priv->ff2m->m, (1 << priv->m));
     if (!H)
         return NULL;
     for (i=0; i<NTS_KEM_PARAM_N; i++) h1[i] = 1; /* h1 stores h*b^j for some integer j */
@@ -938,8 +1083,8 @@ matrix_ff2* create_matrix_G(const NTSKEM* nts_kem,
              * the check matrix in F_{2^m}. The transform B(.) basically
              * converts a value to its binary equivalent.
              **/
+            f = priv->ff2m->ff_mul(priv->ff2m, h1[j], h[j]);
             e = priv->m; do { --e;
-                f = priv->ff2m->ff_mul(priv->ff2m, h1[j], h[j]);
                 if (f & (1 << e)) {
                     v_ptr = (packed_t *)row_ptr_matrix_ff2(H, (i*priv->m)+(priv->m-e-1));
                     bit_set(v_ptr, j);
@@ -1038,7 +1183,7 @@ matrix_ff2* create_matrix_G(const NTSKEM* nts_kem,
      * 3(e) Construct the generator matrix G = [I_k | Q] from
      *      the parity-check matrix H = [Q^T | I_{n-k}].
      **/
-    if (!(Q = calloc_matrix_ff2(NTS_KEM_PARAM_K, NTS_KEM_PARAM_C)))
+    if (!(Q = calloc_matrix_ff2_from_arena(arena, NTS_KEM_PARAM_K, NTS_KEM_PARAM_C)))
         return NULL;
     for (i=0; i<NTS_KEM_PARAM_C; i++) {
         v_ptr = (packed_t *)row_ptr_matrix_ff2(H, i);
@@ -1247,10 +1392,12 @@ int compute_syndrome(const NTSKEM* nts_kem,
                      const uint8_t *c_ast,
                      ff_unit* s)
 {
-    int32_t i, j, l;
+    int32_t i, j;
+    ff_unit v;
     FF2m *ff2m = NULL;
     NTSKEM_private *priv = NULL;
     ff_unit h[ NTS_KEM_PARAM_BC ];
+    ff_unit c[ NTS_KEM_PARAM_BC ];
     const packed_t *c_ptr = (const packed_t *)c_ast;
     
     if (!nts_kem || !nts_kem->priv)
@@ -1259,44 +1406,98 @@ int compute_syndrome(const NTSKEM* nts_kem,
     priv = (NTSKEM_private *)nts_kem->priv;
     ff2m = priv->ff2m;
     
+    /**
+     * c[j] is all ones if bit j of c* is set, zero otherwise,
+     * and h[j] = h_j.a_j^i for the i-th syndrome
+     **/
+    for (j=0; j<NTS_KEM_PARAM_BC; j++) {
+        c[j] = (ff_unit)(-(ff_unit)bit_value(c_ptr, j));
+    }
     memcpy(h, priv->h, sizeof(h));
-    memset(s, 0, (2*NTS_KEM_PARAM_T)*sizeof(ff_unit));
-    for (i=0; i<2*NTS_KEM_PARAM_T-1; i++) {
-        for (j=0,l=0; l<NTS_KEM_CIPHERTEXT_SIZE; l++) {
-            s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]);
-            h[j] = ff2m->ff_mul(ff2m, h[j], priv->a[j]); ++j;
-            s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]);
-            h[j] = ff2m->ff_mul(ff2m, h[j], priv->a[j]); ++j;
-            s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]);
-            h[j] = ff2m->ff_mul(ff2m, h[j], priv->a[j]); ++j;
-            s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]);
-            h[j] = ff2m->ff_mul(ff2m, h[j], priv->a[j]); ++j;
-            s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]);
-            h[j] = ff2m->ff_mul(ff2m, h[j], priv->a[j]); ++j;
-            s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]);
-            h[j] = ff2m->ff_mul(ff2m, h[j], priv->a[j]); ++j;
-            s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]);
-            h[j] = ff2m->ff_mul(ff2m, h[j], priv->a[j]); ++j;
-            s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]);
-            h[j] = ff2m->ff_mul(ff2m, h[j], priv->a[j]); ++j;
+    for (i=0; i<2*NTS_KEM_PARAM_T; i++) {
+        for (v=0,j=0; j<NTS_KEM_PARAM_BC; j++) {
+            v ^= (h[j] & c[j]);
         }
-    }
-    for (j=0,l=0; l<NTS_KEM_CIPHERTEXT_SIZE; l++) {
-        s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]); ++j;
-        s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]); ++j;
-        s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]); ++j;
-        s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]); ++j;
-        s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]); ++j;
-        s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]); ++j;
-        s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]); ++j;
-        s[i] = ff2m->ff_add(ff2m, s[i], bit_value(c_ptr, j)*h[j]); ++j;
+        s[i] = v;
+        if (i < 2*NTS_KEM_PARAM_T-1)
+            ff2m->ff_mul_vec(ff2m, h, h, priv->a, NTS_KEM_PARAM_BC);
     }
     
     memset(h, 0, sizeof(h));
+    memset(c, 0, sizeof(c));
 
     return NTS_KEM_SUCCESS;
 }
 
+/**
+ *  Precompute the truncated parity-check matrix H*_m
+ *
+ *  @note
+ *  Entry (i, j) is h_j.a_j^i for 0 <= i < 2τ and 0 <= j < n - a,
+ *  the term that compute_syndrome adds to syndrome i when bit j of
+ *  c* is set. It is stored column by column, H[j*2τ + i].
+ *
+ *  @param[in]  nts_kem   The pointer to NTS-KEM object
+ *  @return The table of 2τ(n - a) entries, NULL on failure
+ **/
+ff_unit* create_syndrome_table(const NTSKEM* nts_kem)
+{
+    int32_t i, j;
+    ff_unit h[ NTS_KEM_PARAM_BC ], *H = NULL;
+    FF2m *ff2m = NULL;
+    NTSKEM_private *priv = NULL;
+    
+    if (!nts_kem || !nts_kem->priv)
+        return NULL;
+    
+    priv = (NTSKEM_private *)nts_kem->priv;
+    ff2m = priv->ff2m;
+    
+    H = (ff_unit *)malloc(2*NTS_KEM_PARAM_T*NTS_KEM_PARAM_BC*sizeof(ff_unit));
+    if (!H)
+        return NULL;
+    
+    memcpy(h, priv->h, sizeof(h));
+    for (i=0; i<2*NTS_KEM_PARAM_T; i++) {
+        for (j=0; j<NTS_KEM_PARAM_BC; j++) {
+            H[j*2*NTS_KEM_PARAM_T + i] = h[j];
+        }
+        ff2m->ff_mul_vec(ff2m, h, h, priv->a, NTS_KEM_PARAM_BC);
+    }
+    memset(h, 0, sizeof(h));
+    
+    return H;
+}
+
+/**
+ *  Compute the syndrome vectors from the precomputed H*_m
+ *
+ *  @note
+ *  Same output as compute_syndrome, in constant time: every
+ *  column of H*_m is read and masked with its bit of c*.
+ *
+ *  @param[in]  H         The table from create_syndrome_table
+ *  @param[in]  c_ast     The pointer to the inpute ciphertext
+ *  @param[out] s         The computed 2*t syndromes
+ **/
+void compute_syndrome_from_table(const ff_unit* H,
+                                 const uint8_t *c_ast,
+                                 ff_unit* s)
+{
+    int32_t i, j;
+    ff_unit mask;
+    const packed_t *c_ptr = (const packed_t *)c_ast;
+    
+    memset(s, 0, (2*NTS_KEM_PARAM_T)*sizeof(ff_unit));
+    for (j=0; j<NTS_KEM_PARAM_BC; j++) {
+        mask = (ff_unit)(-(ff_unit)bit_value(c_ptr, j));
+        for (i=0; i<2*NTS_KEM_PARAM_T; i++) {
+            s[i] ^= (H[i] & mask);
+        }
+        H += 2*NTS_KEM_PARAM_T;
+    }
+}
+
 /**
  *  Permute the error and recover k_e
  *
@@ -309,7 +309,7 @@ ff_unit* additive_fft(const FF2m* ff2m, const poly *f)
     stack *S = NULL;
     item *obj = NULL, *ptr = NULL;
     ff_unit **G = NULL, **D = NULL;
-    ff_unit Gi, *w = NULL;
+    ff_unit *w = NULL, *Gi = NULL, *u = NULL;
     
     /**
      * Construct bases G and D for m=1,..,m-1
@@ -327,7 +327,9 @@ ff_unit* additive_fft(const FF2m* ff2m, const poly *f)
             goto fft_fail;
     }
 
-    if (!(w = (ff_unit *)calloc((1 << ff2m->m), sizeof(ff_unit))))
+    if (!(w = (ff_unit *)calloc((1 << ff2m->m), sizeof(ff_unit))) ||
+        !(Gi = (ff_unit *)calloc((1 << (ff2m->m-1)), sizeof(ff_unit))) ||
+        !(u = (ff_unit *)calloc((1 << (ff2m->m-1)), sizeof(ff_unit))))
         goto fft_fail;
     
     /* Prepare our stack */
@@ -387,11 +389,17 @@ ff_unit* additive_fft(const FF2m* ff2m, const poly *f)
      * that are obtained from the bases of G
      **/
     for (s=1; s<ff2m->m; s++) {
+        /**
+         * The twiddle factors of this level, Gi[j] is the
+         * element of the span of G[s-1] with index j
+         **/
+        for (j=0; j<(1 << s); j++) {
+            Gi[j] = _additive_fft_ff_value(ff2m, j, s, G[s-1]);
+        }
         for (i=0; i<(1 << ff2m->m); i+=(1 << (s+1))) {
+            ff2m->ff_mul_vec(ff2m, u, Gi, &w[(1<<s) + i], (1 << s));
             for (j=i; j<i+(1 << s); j++) {
-                Gi = _additive_fft_ff_value(ff2m, j-i, s, G[s-1]);
-                w[j] = ff2m->ff_add(ff2m, w[j],
-                                    ff2m->ff_mul(ff2m, Gi, w[(1<<s) + j]));
+                w[j] = ff2m->ff_add(ff2m, w[j], u[j-i]);
                 w[(1<<s) + j] = ff2m->ff_add(ff2m, w[(1<<s) + j], w[j]);
             }
         }
@@ -403,6 +411,14 @@ fft_fail:
         memset(w, 0, (1 << ff2m->m)*sizeof(ff_unit));
         free(w); w = NULL;
     }
+    if (Gi) {
+        memset(Gi, 0, (1 << (ff2m->m-1))*sizeof(ff_unit));
+        free(Gi);
+    }
+    if (u) {
+        memset(u, 0, (1 << (ff2m->m-1))*sizeof(ff_unit));
+        free(u);
+    }
     if (G && D) {
         for (i=0; i<ff2m->m-1; i++) {
             if (G[i]) {
@@ -12,6 +12,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include "ff.h"
+#if defined(__PCLMUL__)
+#include <wmmintrin.h>
+#endif
 
 ff_unit ff_add_m(const FF2m* ff2m, ff_unit a, ff_unit b)
 {
@@ -42,6 +45,11 @@ ff_unit ff_mul_13(const FF2m* ff2m, ff_unit a, ff_unit b)
 {
     uint32_t t;
     
+#if defined(__PCLMUL__)
+    /* Carry-less multiplication */
+    t = (uint32_t)_mm_cvtsi128_si32(_mm_clmulepi64_si128(_mm_cvtsi32_si128(a),
+                                                         _mm_cvtsi32_si128(b), 0));
+#else
     /* Perform shift-and-add multiplication */
     t  = a * (b & 1);
     t ^= (a * (b & 0x0002));
@@ -56,11 +64,47 @@ ff_unit ff_mul_13(const FF2m* ff2m, ff_unit a, ff_unit b)
     t ^= (a * (b & 0x0400));
     t ^= (a * (b & 0x0800));
     t ^= (a * (b & 0x1000));
+#endif
     
     /* Return the modulo reduction of t */
     return ff_reduce_13(t);
 }
 
+void ff_mul_vec_13(const FF2m* ff2m, ff_unit *c, const ff_unit *a, const ff_unit *b, int n)
+{
+    int32_t i, k;
+    uint32_t t, x, y;
+    
+    for (i=0; i<n; i++) {
+        x = a[i]; y = b[i];
+        for (t=0,k=0; k<13; k++) {
+            t ^= (x << k) & (0 - ((y >> k) & 1));
+        }
+        c[i] = ff_reduce_13(t);
+    }
+}
+
+void ff_mul_scalar_vec_13(const FF2m* ff2m, ff_unit *c, ff_unit a, const ff_unit *b, int n)
+{
+    int32_t i, k;
+    ff_unit t, y, ax[13];
+    
+    /**
+     * ax[k] = a.x^k, so that a.b is the sum of ax[k]
+     * over the bits k set in b and needs no reduction
+     **/
+    for (k=0; k<13; k++) {
+        ax[k] = ff_reduce_13((uint32_t)a << k);
+    }
+    for (i=0; i<n; i++) {
+        y = b[i];
+        for (t=0,k=0; k<13; k++) {
+            t ^= ax[k] & (ff_unit)(0 - ((y >> k) & 1));
+        }
+        c[i] = t;
+    }
+}
+
 ff_unit ff_sqr_13(const FF2m* ff2m, ff_unit a)
 {
     uint32_t b = a;
@@ -117,6 +161,8 @@ FF2m* ff_create()
     ff2m->ff_mul = &ff_mul_13;
     ff2m->ff_sqr = &ff_sqr_13;
     ff2m->ff_inv = &ff_inv_13;
+    ff2m->ff_mul_vec = &ff_mul_vec_13;
+    ff2m->ff_mul_scalar_vec = &ff_mul_scalar_vec_13;
 #if defined(INTERMEDIATE_VALUES)
     ff2m->log2poly = (ff_unit *)calloc(1<<ff2m->m, sizeof(ff_unit));
     ff2m->poly2log = (ff_unit *)calloc(1<<ff2m->m, sizeof(ff_unit));
@@ -165,6 +211,8 @@ void ff_release(FF2m* ff2m)
         ff2m->ff_mul = NULL;
         ff2m->ff_sqr = NULL;
         ff2m->ff_inv = NULL;
+        ff2m->ff_mul_vec = NULL;
+        ff2m->ff_mul_scalar_vec = NULL;
         free(ff2m);
     }
 }
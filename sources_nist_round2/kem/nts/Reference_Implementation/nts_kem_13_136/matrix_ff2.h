@@ -25,9 +25,24 @@ typedef struct {
     uint32_t ncols;     /* Number of columns in the matrix */
     uint32_t nblocks;   /* Number of 'packed_t's in use per row */
     uint32_t stride;    /* Bytes allocedd per row, 128-bit aligned */
+    uint32_t arena;     /* Non-zero if the matrix is owned by a matrix_ff2_arena */
     uint8_t* v;         /* Pointer to a buffer containing the matrix values */
 } matrix_ff2;
 
+/**
+ *  A bump allocator for F_2 matrices
+ *
+ *  @note
+ *  Matrices allocated from an arena share one aligned buffer, which
+ *  is released (and zeroed) as a whole with release_matrix_ff2_arena.
+ *  Calling free_matrix_ff2 on such a matrix is allowed and does nothing.
+ **/
+typedef struct {
+    uint8_t* base;      /* Pointer to the arena buffer, ALIGNMENT aligned */
+    size_t size;        /* Size of the arena buffer in bytes */
+    size_t used;        /* Number of bytes handed out so far */
+} matrix_ff2_arena;
+
 /**
  *  Allocate an (nrows x ncols) matrix F_2
  *
@@ -56,6 +71,40 @@ matrix_ff2* calloc_matrix_ff2(int nrows, int ncols);
  **/
 void free_matrix_ff2(matrix_ff2* M);
 
+/**
+ *  The number of bytes of arena needed by an (nrows x ncols) matrix F_2
+ *
+ *  @param[in] nrows    Number of rows
+ *  @param[in] ncols    Number of columns
+ *  @return The number of bytes
+ **/
+size_t arena_size_matrix_ff2(int nrows, int ncols);
+
+/**
+ *  Create an arena of matrices F_2
+ *
+ *  @param[in] size     The size of the arena in bytes, see arena_size_matrix_ff2
+ *  @return Pointer to the arena object
+ **/
+matrix_ff2_arena* create_matrix_ff2_arena(size_t size);
+
+/**
+ *  Zero and deallocate an arena, including all matrices allocated from it
+ *
+ *  @param[in] arena    Pointer to the arena object
+ **/
+void release_matrix_ff2_arena(matrix_ff2_arena* arena);
+
+/**
+ *  Allocate and zero an (nrows x ncols) matrix F_2 from an arena
+ *
+ *  @param[in] arena    Pointer to the arena object
+ *  @param[in] nrows    Number of rows
+ *  @param[in] ncols    Number of columns
+ *  @return Pointer to matrix object, NULL if the arena is exhausted
+ **/
+matrix_ff2* calloc_matrix_ff2_from_arena(matrix_ff2_arena* arena, int nrows, int ncols);
+
 /**
  *  Zero an F_2 matrix
  *
@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "api.h"
+#include "nts_kem.h"
 #include "ntskem_test.h"
 #include "random.h"
 
@@ -43,6 +44,7 @@ int testkem_nts(int iterations)
     int i, it = 0, status = 1;
     uint8_t *pk, *sk;
     uint8_t *encap_key, *decap_key, *ciphertext;
+    NTSKEM_ctx *ctx = NULL;
 #if !defined(DETERMINISTIC)
     FILE *fp = NULL;
 #endif
@@ -103,6 +105,14 @@ int testkem_nts(int iterations)
         
         status &= (0 == memcmp(encap_key, decap_key, CRYPTO_BYTES));
         
+        memset(decap_key, 0, CRYPTO_BYTES);
+        if (nts_kem_ctx_from_sk(&ctx, sk, CRYPTO_SECRETKEYBYTES) ||
+            nts_kem_decapsulate_ctx(ctx, ciphertext, decap_key))
+            status = 0;
+        nts_kem_ctx_release(ctx);
+        
+        status &= (0 == memcmp(encap_key, decap_key, CRYPTO_BYTES));
+        
         free(decap_key);
         free(encap_key);
         free(ciphertext);
@@ -23,6 +23,10 @@ typedef uint16_t ff_unit;
  *  The addition, multiplication, squaring and inversion operations
  *  are done without the use of any look-up tables. Only m = {12,13}
  *  cases are implemented at this stage.
+ *
+ *  The vector operations are written so that the compiler can
+ *  vectorise them; the decoder (syndromes, Berlekamp-Massey and
+ *  additive FFT) uses them for its inner loops.
  **/
 typedef struct FF2m {
     /**
@@ -68,6 +72,28 @@ typedef struct FF2m {
      **/
     ff_unit (*ff_inv)(const struct FF2m* ff2m, ff_unit a);
     
+    /**
+     *  Element-wise multiplication of two vectors over F_{2^m}
+     *
+     *  @param[in]  ff2m  Pointer to FF2m instance
+     *  @param[out] c     Output vector, c[i] = a[i].b[i], may alias a or b
+     *  @param[in]  a     Vector a
+     *  @param[in]  b     Vector b
+     *  @param[in]  n     Length of the vectors
+     **/
+    void (*ff_mul_vec)(const struct FF2m* ff2m, ff_unit *c, const ff_unit *a, const ff_unit *b, int n);
+    
+    /**
+     *  Multiplication of a vector by a scalar over F_{2^m}
+     *
+     *  @param[in]  ff2m  Pointer to FF2m instance
+     *  @param[out] c     Output vector, c[i] = a.b[i], may alias b
+     *  @param[in]  a     Scalar a
+     *  @param[in]  b     Vector b
+     *  @param[in]  n     Length of the vector
+     **/
+    void (*ff_mul_scalar_vec)(const struct FF2m* ff2m, ff_unit *c, ff_unit a, const ff_unit *b, int n);
+    
     /**
      *  Basis
      **/
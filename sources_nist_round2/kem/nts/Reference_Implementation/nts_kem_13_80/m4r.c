@@ -25,6 +25,9 @@
 #include "bits.h"
 #include "random.h"
 #include "m4r.h"
+#if M4R_NUM_THREADS > 1
+#include <pthread.h>
+#endif
 
 #define STRIPE_SIZE         8
 #define STRIPE_SIZE_LOG     3
@@ -203,6 +206,156 @@ static inline void _m4ri_add_rows_rev_from_gray_table(matrix_ff2* A,
     }
 }
 
+/**
+ *  Add the rows of Gray-code table T to the rows lo, ..., hi-1 of the
+ *  A->nrows - k rows outside of the stripe [r-k, r) of matrix A, i.e.
+ *  the rows of A numbered with the stripe skipped
+ **/
+static void _m4ri_add_rows_rev_from_gray_table_slice(matrix_ff2* A,
+                                                      const matrix_ff2 *T,
+                                                      uint32_t r,
+                                                      uint32_t c,
+                                                      uint32_t k,
+                                                      uint32_t lo,
+                                                      uint32_t hi)
+{
+    /* Rows above the stripe, [0, r-k) */
+    if (lo < r-k)
+        _m4ri_add_rows_rev_from_gray_table(A, T, (hi < r-k) ? hi : r-k, lo, c, k);
+    
+    /* Rows below the stripe, [r, A->nrows) */
+    if (hi > r-k)
+        _m4ri_add_rows_rev_from_gray_table(A, T, hi+k, ((lo > r-k) ? lo : r-k)+k, c, k);
+}
+
+#if M4R_NUM_THREADS > 1
+/**
+ *  A pool of M4R_NUM_THREADS-1 worker threads, which together with the
+ *  calling thread apply each Gray-code table to a share of the rows of A
+ **/
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t start;       /* Signalled when a new table is ready */
+    pthread_cond_t done;        /* Signalled when all workers are done */
+    uint32_t generation;        /* Incremented for each table */
+    int32_t pending;            /* Number of workers still busy */
+    int32_t quit;
+    int32_t nthreads;           /* Number of threads, including the caller */
+    matrix_ff2 *A;
+    const matrix_ff2 *T;
+    uint32_t r, c, k;
+} m4r_pool;
+
+typedef struct {
+    m4r_pool *pool;
+    int32_t id;
+    pthread_t thread;
+} m4r_worker;
+
+static void _m4ri_pool_slice(m4r_pool *pool, int32_t id)
+{
+    uint32_t n = pool->A->nrows - pool->k;
+    uint32_t lo = (uint32_t)(((uint64_t)n * id) / pool->nthreads);
+    uint32_t hi = (uint32_t)(((uint64_t)n * (id+1)) / pool->nthreads);
+    
+    _m4ri_add_rows_rev_from_gray_table_slice(pool->A, pool->T,
+                                             pool->r, pool->c, pool->k,
+                                             lo, hi);
+}
+
+static void* _m4ri_pool_worker(void *arg)
+{
+    m4r_worker *worker = (m4r_worker *)arg;
+    m4r_pool *pool = worker->pool;
+    uint32_t generation = 0;
+    
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->quit && pool->generation == generation)
+            pthread_cond_wait(&pool->start, &pool->lock);
+        if (pool->quit) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        generation = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+        
+        _m4ri_pool_slice(pool, worker->id);
+        
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+    
+    return NULL;
+}
+
+static void _m4ri_pool_start(m4r_pool *pool, m4r_worker *workers)
+{
+    int32_t i;
+    
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->quit = 0;
+    pool->nthreads = 1;
+    
+    /* If a thread cannot be created, carry on with fewer threads */
+    for (i=0; i<M4R_NUM_THREADS-1; i++) {
+        workers[i].pool = pool;
+        workers[i].id = i+1;
+        if (pthread_create(&workers[i].thread, NULL, _m4ri_pool_worker, &workers[i]))
+            break;
+        pool->nthreads++;
+    }
+}
+
+static void _m4ri_pool_run(m4r_pool *pool,
+                           matrix_ff2 *A,
+                           const matrix_ff2 *T,
+                           uint32_t r,
+                           uint32_t c,
+                           uint32_t k)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->A = A;
+    pool->T = T;
+    pool->r = r;
+    pool->c = c;
+    pool->k = k;
+    pool->pending = pool->nthreads-1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    
+    _m4ri_pool_slice(pool, 0);
+    
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending)
+        pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void _m4ri_pool_stop(m4r_pool *pool, m4r_worker *workers)
+{
+    int32_t i;
+    
+    pthread_mutex_lock(&pool->lock);
+    pool->quit = 1;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->lock);
+    for (i=0; i<pool->nthreads-1; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->lock);
+}
+#endif
+
 uint32_t _m4ri_gauss_submatrix(matrix_ff2* A,
                                uint32_t r,
                                uint32_t c,
@@ -253,9 +406,16 @@ uint32_t m4r_rref(matrix_ff2* A)
     int32_t r = 0, c = 0, rank = 0;
     int32_t k = STRIPE_SIZE, rk;
     matrix_ff2 *T = NULL;
+#if M4R_NUM_THREADS > 1
+    m4r_pool pool;
+    m4r_worker workers[M4R_NUM_THREADS-1];
+#endif
     
     if (!(T = alloc_matrix_ff2(sizeof(_gray_codes_lut8), A->ncols)))
         return 0;
+#if M4R_NUM_THREADS > 1
+    _m4ri_pool_start(&pool, workers);
+#endif
     
     r = A->nrows;
     c = A->ncols;
@@ -266,8 +426,11 @@ uint32_t m4r_rref(matrix_ff2* A)
         rk = _m4ri_gauss_submatrix(A, r, c, 0, k);
         if (rk > 0) {
             _m4ri_make_table_rev(T, A, r, c, rk);
-            _m4ri_add_rows_rev_from_gray_table(A, T, r-rk, 0, c, rk);
-            _m4ri_add_rows_rev_from_gray_table(A, T, A->nrows, r, c, rk);
+#if M4R_NUM_THREADS > 1
+            _m4ri_pool_run(&pool, A, T, r, c, rk);
+#else
+            _m4ri_add_rows_rev_from_gray_table_slice(A, T, r, c, rk, 0, A->nrows-rk);
+#endif
         }
         r -= rk;
         c -= rk;
@@ -276,6 +439,9 @@ uint32_t m4r_rref(matrix_ff2* A)
             --c;
     }
     
+#if M4R_NUM_THREADS > 1
+    _m4ri_pool_stop(&pool, workers);
+#endif
     free_matrix_ff2(T);
     
     return (uint32_t)rank;
@@ -26,6 +26,17 @@
 #include <stdint.h>
 #include "matrix_ff2.h"
 
+/**
+ *  Number of threads used by m4r_rref
+ *
+ *  Build with -DM4R_NUM_THREADS=n (n > 1) to split the row additions
+ *  from each Gray-code table over n threads. The result does not depend
+ *  on the number of threads.
+ **/
+#if !defined(M4R_NUM_THREADS)
+#define M4R_NUM_THREADS     1
+#endif
+
 /**
  *  Transform matrix into row-reduced echelon form
  *
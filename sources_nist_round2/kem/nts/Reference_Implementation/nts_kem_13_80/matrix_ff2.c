@@ -34,6 +34,7 @@ matrix_ff2* alloc_matrix_ff2(int nrows, int ncols)
         M->ncols = ncols;
         M->nblocks = (ncols + MOD) >> LOG2;
         M->stride = ALIGNMENT * (((M->nblocks * sizeof(packed_t)) + ALIGNMENT - 1) / ALIGNMENT);
+        M->arena = 0;
 #if defined(_WIN32)
         if (!(M->v = _aligned_malloc(M->stride * M->rows, ALIGNMENT)))
 #else
@@ -60,7 +61,7 @@ matrix_ff2* calloc_matrix_ff2(int nrows, int ncols)
 
 void free_matrix_ff2(matrix_ff2 *M)
 {
-    if (M) {
+    if (M && !M->arena) {
         if (M->v) {
 #if defined(_WIN32)
             _aligned_free(M->v);
@@ -74,6 +75,81 @@ void free_matrix_ff2(matrix_ff2 *M)
     }
 }
 
+size_t arena_size_matrix_ff2(int nrows, int ncols)
+{
+    size_t header, stride;
+    
+    header = ALIGNMENT * ((sizeof(matrix_ff2) + ALIGNMENT - 1) / ALIGNMENT);
+    stride = ALIGNMENT * (((((ncols + MOD) >> LOG2) * sizeof(packed_t)) + ALIGNMENT - 1) / ALIGNMENT);
+    
+    return header + (stride * nrows);
+}
+
+matrix_ff2_arena* create_matrix_ff2_arena(size_t size)
+{
+    matrix_ff2_arena *arena = NULL;
+    
+    arena = (matrix_ff2_arena *)malloc(sizeof(matrix_ff2_arena));
+    if (!arena)
+        return NULL;
+    arena->size = size;
+    arena->used = 0;
+#if defined(_WIN32)
+    if (!(arena->base = _aligned_malloc(size, ALIGNMENT)))
+#else
+    if (0 != posix_memalign((void **)&arena->base, ALIGNMENT, size))
+#endif
+    {
+        free(arena);
+        return NULL;
+    }
+    
+    return arena;
+}
+
+void release_matrix_ff2_arena(matrix_ff2_arena* arena)
+{
+    if (arena) {
+        if (arena->base) {
+            memset(arena->base, 0, arena->size);
+#if defined(_WIN32)
+            _aligned_free(arena->base);
+#else
+            free(arena->base);
+#endif
+            arena->base = NULL;
+        }
+        arena->size = arena->used = 0;
+        free(arena);
+    }
+}
+
+matrix_ff2* calloc_matrix_ff2_from_arena(matrix_ff2_arena* arena, int nrows, int ncols)
+{
+    size_t header, size;
+    matrix_ff2 *M = NULL;
+    
+    if (!arena || nrows <= 0 || ncols <= 0)
+        return NULL;
+    
+    header = ALIGNMENT * ((sizeof(matrix_ff2) + ALIGNMENT - 1) / ALIGNMENT);
+    size = arena_size_matrix_ff2(nrows, ncols);
+    if (size > arena->size - arena->used)
+        return NULL;
+    
+    M = (matrix_ff2 *)(arena->base + arena->used);
+    M->nrows = nrows;
+    M->ncols = ncols;
+    M->nblocks = (ncols + MOD) >> LOG2;
+    M->stride = ALIGNMENT * (((M->nblocks * sizeof(packed_t)) + ALIGNMENT - 1) / ALIGNMENT);
+    M->arena = 1;
+    M->v = arena->base + arena->used + header;
+    arena->used += size;
+    zero_matrix_ff2(M);
+    
+    return M;
+}
+
 void zero_matrix_ff2(matrix_ff2* M)
 {
     memset(M->v, 0, M->stride * M->nrows);
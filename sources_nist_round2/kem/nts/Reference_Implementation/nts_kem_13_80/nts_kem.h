@@ -27,6 +27,16 @@ typedef struct {
     void *priv;                 /* Private component */
 } NTSKEM;
 
+/**
+ *  NTS-KEM decapsulation context
+ *
+ *  An NTS-KEM object initialised from a private key, together with
+ *  the truncated parity-check matrix used to compute the syndromes.
+ *  It takes 2τ(n - a) field elements of memory, which is between
+ *  256KB and 1.1MB depending on the parameter set.
+ **/
+typedef struct NTSKEM_ctx NTSKEM_ctx;
+
 /**
  *  Initialise an NTS-KEM object with a given parameter
  *
@@ -101,4 +111,41 @@ int nts_kem_decapsulate(const uint8_t *sk,
                         const uint8_t *c_ast,
                         uint8_t *k_r);
 
+/**
+ *  Create a decapsulation context from a private key
+ *
+ *  @note
+ *  The private key is deserialised and H*_m is computed once, so that
+ *  nts_kem_decapsulate_ctx only has to decode each ciphertext.
+ *
+ *  @param[out] ctx     A pointer of the NTS-KEM context created
+ *  @param[in]  sk      The pointer to NTS-KEM private key
+ *  @param[in]  sk_size The size of the private key in bytes
+ *  @return NTS_KEM_SUCCESS on success, otherwise a negative error code
+ *          {@see nts_kem_errors.h}
+ **/
+int nts_kem_ctx_from_sk(NTSKEM_ctx **ctx,
+                        const uint8_t *sk,
+                        size_t sk_size);
+
+/**
+ *  NTS-KEM decapsulation with a decapsulation context
+ *
+ *  @param[in]  ctx     The pointer to NTS-KEM context
+ *  @param[in]  c_ast   The pointer to the NTS-KEM ciphertext
+ *  @param[out] k_r     The pointer to the encapsulated key
+ *  @return NTS_KEM_SUCCESS on success, otherwise a negative error code
+ *          {@see nts_kem_errors.h}
+ **/
+int nts_kem_decapsulate_ctx(const NTSKEM_ctx *ctx,
+                            const uint8_t *c_ast,
+                            uint8_t *k_r);
+
+/**
+ *  Release a decapsulation context
+ *
+ *  @param[in] ctx  A pointer to an NTS-KEM context
+ **/
+void nts_kem_ctx_release(NTSKEM_ctx *ctx);
+
 #endif /* __NTS_KEM_H */
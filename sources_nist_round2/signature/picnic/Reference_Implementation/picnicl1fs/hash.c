@@ -83,3 +83,85 @@ void HashUpdateIntLE(HashInstance* ctx, uint16_t x)
     HashUpdate(ctx, (uint8_t*)&outputBytesLE, sizeof(uint16_t));
 }
 
+void HashInit4(HashInstancex4* ctx, paramset_t* params, uint8_t hashPrefix)
+{
+    /* Rate of SHAKE128 (L1) or SHAKE256 (L3, L5) */
+    ctx->rate = (params->stateSizeBits == 128) ? 168 : 136;
+    ctx->byteIOIndex = 0;
+    KeccakP1600times4_InitializeAll(ctx->states);
+
+    if (hashPrefix != HASH_PREFIX_NONE) {
+        for (unsigned int i = 0; i < 4; i++) {
+            KeccakP1600times4_AddByte(ctx->states, i, hashPrefix, 0);
+        }
+        ctx->byteIOIndex = 1;
+    }
+}
+
+void HashUpdate4(HashInstancex4* ctx, const uint8_t** data, size_t byteLen)
+{
+    size_t offset = 0;
+
+    while (byteLen > 0) {
+        unsigned int len = ctx->rate - ctx->byteIOIndex;
+        if (len > byteLen) {
+            len = (unsigned int)byteLen;
+        }
+        for (unsigned int i = 0; i < 4; i++) {
+            KeccakP1600times4_AddBytes(ctx->states, i, data[i] + offset, ctx->byteIOIndex, len);
+        }
+        ctx->byteIOIndex += len;
+        offset += len;
+        byteLen -= len;
+
+        if (ctx->byteIOIndex == ctx->rate) {
+            KeccakP1600times4_PermuteAll_24rounds(ctx->states);
+            ctx->byteIOIndex = 0;
+        }
+    }
+}
+
+void HashUpdateIntLE4(HashInstancex4* ctx, const uint16_t* x)
+{
+    uint16_t outputBytesLE[4];
+    const uint8_t* data[4];
+
+    for (unsigned int i = 0; i < 4; i++) {
+        outputBytesLE[i] = toLittleEndian(x[i]);
+        data[i] = (const uint8_t*)&outputBytesLE[i];
+    }
+    HashUpdate4(ctx, data, sizeof(uint16_t));
+}
+
+void HashFinal4(HashInstancex4* ctx)
+{
+    /* SHAKE domain separation and padding, as in Keccak_HashFinal */
+    for (unsigned int i = 0; i < 4; i++) {
+        KeccakP1600times4_AddByte(ctx->states, i, 0x1F, ctx->byteIOIndex);
+        KeccakP1600times4_AddByte(ctx->states, i, 0x80, ctx->rate - 1);
+    }
+    KeccakP1600times4_PermuteAll_24rounds(ctx->states);
+    ctx->byteIOIndex = 0;
+}
+
+void HashSqueeze4(HashInstancex4* ctx, uint8_t** digest, size_t byteLen)
+{
+    size_t offset = 0;
+
+    while (byteLen > 0) {
+        if (ctx->byteIOIndex == ctx->rate) {
+            KeccakP1600times4_PermuteAll_24rounds(ctx->states);
+            ctx->byteIOIndex = 0;
+        }
+        unsigned int len = ctx->rate - ctx->byteIOIndex;
+        if (len > byteLen) {
+            len = (unsigned int)byteLen;
+        }
+        for (unsigned int i = 0; i < 4; i++) {
+            KeccakP1600times4_ExtractBytes(ctx->states, i, digest[i] + offset, ctx->byteIOIndex, len);
+        }
+        ctx->byteIOIndex += len;
+        offset += len;
+        byteLen -= len;
+    }
+}
@@ -225,12 +225,67 @@ int is_picnic2(picnic_params_t params)
     return 0;
 }
 
+struct picnic_context_t {
+    picnic_params_t params;
+    picnic_arena_t arena;   // Working memory of sign and verify, reset after each operation
+};
+
+picnic_context_t* picnic_context_new(picnic_params_t parameters)
+{
+    paramset_t paramset;
+
+    if (get_param_set(parameters, &paramset) != EXIT_SUCCESS) {
+        fprintf(stderr, "Failed to initialize parameter set\n");
+        fflush(stderr);
+        return NULL;
+    }
+
+    picnic_context_t* ctx = (picnic_context_t*)malloc(sizeof(picnic_context_t));
+    if (ctx == NULL || createArena(&ctx->arena, arenaSize(&paramset)) != 0) {
+        fprintf(stderr, "Failed to allocate memory\n");
+        fflush(stderr);
+        free(ctx);
+        return NULL;
+    }
+    ctx->params = parameters;
+
+    return ctx;
+}
+
+void picnic_context_free(picnic_context_t* ctx)
+{
+    if (ctx != NULL) {
+        freeArena(&ctx->arena);
+        free(ctx);
+    }
+}
+
 int picnic_sign(picnic_privatekey_t* sk, const uint8_t* message, size_t message_len,
                 uint8_t* signature, size_t* signature_len)
+{
+    picnic_context_t* ctx = picnic_context_new(sk->params);
+
+    if (ctx == NULL) {
+        return -1;
+    }
+    int ret = picnic_sign_ctx(ctx, sk, message, message_len, signature, signature_len);
+    picnic_context_free(ctx);
+
+    return ret;
+}
+
+int picnic_sign_ctx(picnic_context_t* ctx, picnic_privatekey_t* sk, const uint8_t* message, size_t message_len,
+                    uint8_t* signature, size_t* signature_len)
 {
     int ret;
     paramset_t paramset;
 
+    if (ctx->params != sk->params) {
+        fprintf(stderr, "Context and key use different parameter sets\n");
+        fflush(stderr);
+        return -1;
+    }
+
     ret = get_param_set(sk->params, &paramset);
     if (ret != EXIT_SUCCESS) {
         fprintf(stderr, "Failed to initialize parameter set\n");
@@ -246,7 +301,8 @@ int picnic_sign(picnic_privatekey_t* sk, const uint8_t* message, size_t message_
         }
 
         ret = sign_picnic1((uint32_t*)sk->data, (uint32_t*)sk->pk.ciphertext, (uint32_t*)sk->pk.plaintext, message,
-                           message_len, sig, &paramset);
+                           message_len, sig, &paramset, &ctx->arena);
+        resetArena(&ctx->arena);
         if (ret != EXIT_SUCCESS) {
             fprintf(stderr, "Failed to create signature\n");
             fflush(stderr);
@@ -274,7 +330,8 @@ int picnic_sign(picnic_privatekey_t* sk, const uint8_t* message, size_t message_
             return -1;
         }
         ret = sign_picnic2((uint32_t*)sk->data, (uint32_t*)sk->pk.ciphertext, (uint32_t*)sk->pk.plaintext, message,
-                           message_len, sig, &paramset);
+                           message_len, sig, &paramset, &ctx->arena);
+        resetArena(&ctx->arena);
         if (ret != EXIT_SUCCESS) {
             fprintf(stderr, "Failed to create signature\n");
             fflush(stderr);
@@ -348,10 +405,29 @@ size_t picnic_signature_size(picnic_params_t parameters)
 int picnic_verify(picnic_publickey_t* pk, const uint8_t* message, size_t message_len,
                   const uint8_t* signature, size_t signature_len)
 {
-    int ret;
+    picnic_context_t* ctx = picnic_context_new(pk->params);
+
+    if (ctx == NULL) {
+        return -1;
+    }
+    int ret = picnic_verify_ctx(ctx, pk, message, message_len, signature, signature_len);
+    picnic_context_free(ctx);
 
+    return ret;
+}
+
+int picnic_verify_ctx(picnic_context_t* ctx, picnic_publickey_t* pk, const uint8_t* message, size_t message_len,
+                      const uint8_t* signature, size_t signature_len)
+{
+    int ret;
     paramset_t paramset;
 
+    if (ctx->params != pk->params) {
+        fprintf(stderr, "Context and key use different parameter sets\n");
+        fflush(stderr);
+        return -1;
+    }
+
     ret = get_param_set(pk->params, &paramset);
     if (ret != EXIT_SUCCESS) {
         fprintf(stderr, "Failed to initialize parameter set\n");
@@ -376,7 +452,8 @@ int picnic_verify(picnic_publickey_t* pk, const uint8_t* message, size_t message
         }
 
         ret = verify(sig, (uint32_t*)pk->ciphertext,
-                     (uint32_t*)pk->plaintext, message, message_len, &paramset);
+                     (uint32_t*)pk->plaintext, message, message_len, &paramset, &ctx->arena);
+        resetArena(&ctx->arena);
         if (ret != EXIT_SUCCESS) {
             /* Signature is invalid, or verify function failed */
             freeSignature(sig, &paramset);
@@ -404,7 +481,8 @@ int picnic_verify(picnic_publickey_t* pk, const uint8_t* message, size_t message
         }
 
         ret = verify_picnic2(sig, (uint32_t*)pk->ciphertext,
-                             (uint32_t*)pk->plaintext, message, message_len, &paramset);
+                             (uint32_t*)pk->plaintext, message, message_len, &paramset, &ctx->arena);
+        resetArena(&ctx->arena);
         if (ret != EXIT_SUCCESS) {
             /* Signature is invalid, or verify function failed */
             freeSignature2(sig, &paramset);
@@ -151,6 +151,52 @@ size_t picnic_signature_size(picnic_params_t parameters);
 int picnic_verify(picnic_publickey_t* pk, const uint8_t* message, size_t message_len,
                   const uint8_t* signature, size_t signature_len);
 
+/**
+ * Working memory for repeated sign and verify operations.
+ * picnic_sign() and picnic_verify() allocate and free this memory on every
+ * call; callers that sign or verify many messages can create a context once
+ * and pass it to picnic_sign_ctx() and picnic_verify_ctx() instead. A context
+ * is tied to one parameter set and must not be used by two threads at once.
+ */
+typedef struct picnic_context_t picnic_context_t;
+
+/**
+ * Create a context for the given parameter set.
+ *
+ * @param[in] parameters The parameter set of the keys the context will be used with.
+ *
+ * @return The new context, or NULL on error. Release it with picnic_context_free().
+ */
+picnic_context_t* picnic_context_new(picnic_params_t parameters);
+
+/**
+ * Free a context created by picnic_context_new(). NULL is ignored.
+ */
+void picnic_context_free(picnic_context_t* ctx);
+
+/**
+ * Same as picnic_sign(), taking the working memory from ctx.
+ *
+ * @return Returns 0 for success, or a nonzero value indicating an error, or
+ * that ctx was created for a different parameter set than sk.
+ *
+ * @see picnic_sign(), picnic_context_new()
+ */
+int picnic_sign_ctx(picnic_context_t* ctx, picnic_privatekey_t* sk, const uint8_t* message, size_t message_len,
+                    uint8_t* signature, size_t* signature_len);
+
+/**
+ * Same as picnic_verify(), taking the working memory from ctx.
+ *
+ * @return Returns 0 for a valid signature, or a nonzero value indicating an
+ * error, an invalid signature, or that ctx was created for a different
+ * parameter set than pk.
+ *
+ * @see picnic_verify(), picnic_context_new()
+ */
+int picnic_verify_ctx(picnic_context_t* ctx, picnic_publickey_t* pk, const uint8_t* message, size_t message_len,
+                      const uint8_t* signature, size_t signature_len);
+
 /**
  * Serialize a public key.
  *
@@ -17,6 +17,12 @@
 #include <stdint.h>
 #include <stddef.h>
 
+/* Number of threads used to run the parallel MPC rounds of the Picnic
+ * (picnic1) sign and verify operations. Set with "make THREADS=n". */
+#ifndef PICNIC_NUM_THREADS
+#define PICNIC_NUM_THREADS 1
+#endif
+
 typedef enum {
     TRANSFORM_FS = 0,
     TRANSFORM_UR = 1,
@@ -56,8 +62,12 @@ typedef struct signature_t {
     uint8_t* salt;              // has length saltSizeBytes
 } signature_t;
 
-int sign_picnic1(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, signature_t* sig, paramset_t* params);
-int verify(signature_t* sig, const uint32_t* pubKey, const uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, paramset_t* params);
+struct picnic_arena_t;
+
+/* All working memory of sign_picnic1 and verify comes from arena, which the
+ * caller sizes with arenaSize() and frees or resets afterwards */
+int sign_picnic1(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, signature_t* sig, paramset_t* params, struct picnic_arena_t* arena);
+int verify(signature_t* sig, const uint32_t* pubKey, const uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, paramset_t* params, struct picnic_arena_t* arena);
 
 void allocateSignature(signature_t* sig, paramset_t* params);
 void freeSignature(signature_t* sig, paramset_t* params);
@@ -67,6 +77,9 @@ void printHex(const char* s, const uint8_t* data, size_t len);
 
 void LowMCEnc(const uint32_t* plaintext, uint32_t* output, uint32_t* key, paramset_t* params);
 
+/* output = matrix * state, over GF(2). output and state may be the same buffer. */
+void matrix_mul(uint32_t* output, const uint32_t* state, const uint32_t* matrix, paramset_t* params);
+
 /* Returns the number of bytes written on success, or -1 on error */
 int serializeSignature(const signature_t* sig, uint8_t* sigBytes, size_t sigBytesLen, paramset_t* params);
 /* Returns EXIT_SUCCESS on success or EXIT_FAILURE on error */
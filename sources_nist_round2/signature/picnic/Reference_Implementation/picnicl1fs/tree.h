@@ -28,7 +28,9 @@ typedef struct tree_t {
 /* The largest seed size is 256 bits, for the Picnic2-L5-FS parameter set. */
 #define MAX_SEED_SIZE_BYTES (32)
 
-tree_t* createTree(size_t numLeaves, size_t dataSize);
+/* The tree is allocated from arena, or from the heap if arena is NULL. Only
+ * trees allocated from the heap may be passed to freeTree. */
+tree_t* createTree(size_t numLeaves, size_t dataSize, picnic_arena_t* arena);
 void freeTree(tree_t* tree);
 uint8_t** getLeaves(tree_t* tree);
 /* Get one leaf, leafIndex must be in [0, tree->numLeaves -1] */
@@ -42,7 +44,7 @@ void printLeaves(tree_t* tree);
 
 /* Returns the number of bytes written to output.  A safe number of bytes for
  * callers to allocate is numLeaves*params->seedSizeBytes, or call revealSeedsSize. */
-tree_t* generateSeeds(size_t nSeeds, uint8_t* rootSeed, uint8_t* salt, size_t repIndex, paramset_t* params);
+tree_t* generateSeeds(size_t nSeeds, uint8_t* rootSeed, uint8_t* salt, size_t repIndex, paramset_t* params, picnic_arena_t* arena);
 size_t revealSeeds(tree_t* tree, uint16_t* hideList, size_t hideListSize, uint8_t* output, size_t outputLen, paramset_t* params);
 size_t revealSeedsSize(size_t numNodes, uint16_t* hideList, size_t hideListSize, paramset_t* params);
 int reconstructSeeds(tree_t* tree, uint16_t* hideList, size_t hideListSize, uint8_t* input, size_t inputLen, uint8_t* salt, size_t repIndex, paramset_t* params);
@@ -29,6 +29,9 @@
 #include "lowmc_constants.h"
 #include "picnic_types.h"
 #include "hash.h"
+#if PICNIC_NUM_THREADS > 1
+#include <pthread.h>
+#endif
 
 #define MAX(a, b) ((a) > (b)) ? (a) : (b)
 
@@ -104,25 +107,47 @@ void xor_array(uint32_t* out, const uint32_t * in1, const uint32_t * in2, uint32
     }
 }
 
-static void matrix_mul(
-    uint32_t* output,
-    uint32_t* state,
+/* Multiply count states by the matrix. Each row of the matrix is read once
+ * for all of the states, and the output bits are collected a byte at a time
+ * instead of being set one by one. */
+static void matrix_mul_states(
+    uint32_t** output,
+    const uint32_t** state,
     const uint32_t* matrix,
-    paramset_t* params)
+    paramset_t* params,
+    size_t count)
 {
     // Use temp to correctly handle the case when state = output
-    uint32_t prod[LOWMC_MAX_STATE_SIZE];
-    uint32_t temp[LOWMC_MAX_STATE_SIZE];
-
-    for (uint32_t i = 0; i < params->stateSizeBits; i++) {
-        for (uint32_t j = 0; j < params->stateSizeWords; j++) {
-            size_t index = i * params->stateSizeWords + j;
-            prod[j] = (state[j] & matrix[index]);
+    uint8_t temp[3][LOWMC_MAX_STATE_SIZE];
+    uint8_t outByte[3];
+
+    assert(count <= 3);
+
+    for (uint32_t i = 0; i < params->stateSizeBits; i += 8) {
+        memset(outByte, 0x00, sizeof(outByte));
+        for (uint32_t b = 0; b < 8; b++) {
+            const uint32_t* row = matrix + (i + b) * params->stateSizeWords;
+            for (size_t k = 0; k < count; k++) {
+                uint32_t prod = 0;
+                for (uint32_t j = 0; j < params->stateSizeWords; j++) {
+                    prod ^= state[k][j] & row[j];
+                }
+                outByte[k] |= parity(&prod, 1) << (7 - b);
+            }
+        }
+        for (size_t k = 0; k < count; k++) {
+            temp[k][i / 8] = outByte[k];
         }
-        setBit((uint8_t*)temp, i, parity(&prod[0], params->stateSizeWords));
-
     }
-    memcpy(output, &temp, params->stateSizeWords * sizeof(uint32_t));
+    for (size_t k = 0; k < count; k++) {
+        memcpy(output[k], temp[k], params->stateSizeBytes);
+    }
+}
+
+void matrix_mul(uint32_t* output, const uint32_t* state, const uint32_t* matrix,
+                paramset_t* params)
+{
+    matrix_mul_states(&output, &state, matrix, params, 1);
 }
 
 static void substitution(uint32_t* state, paramset_t* params)
@@ -286,7 +311,7 @@ void H3(const uint32_t* circuitOutput, const uint32_t* plaintext, uint32_t** vie
         const uint8_t* message, size_t messageByteLength,
         g_commitments_t* gs, paramset_t* params)
 {
-    uint8_t* hash = malloc(params->digestSizeBytes);
+    uint8_t hash[MAX_DIGEST_SIZE];
     HashInstance ctx;
 
     /* Depending on the number of rounds, we might not set part of the last
@@ -358,7 +383,6 @@ void H3(const uint32_t* circuitOutput, const uint32_t* plaintext, uint32_t** vie
 
 done:
 
-    free(hash);
     return;
 }
 
@@ -440,9 +464,12 @@ void mpc_substitution_verify(uint32_t* state[2], randomTape_t* rand, view_t* vie
 void mpc_matrix_mul(uint32_t* output[3], uint32_t* state[3], const uint32_t* matrix,
                     paramset_t* params, size_t players)
 {
+    const uint32_t* in[3];
+
     for (uint32_t player = 0; player < players; player++) {
-        matrix_mul(output[player], state[player], matrix, params);
+        in[player] = state[player];
     }
+    matrix_mul_states(output, in, matrix, params, players);
 }
 
 void mpc_LowMC_verify(view_t* view1, view_t* view2,
@@ -546,43 +573,196 @@ void verifyProof(const proof_t* proof, view_t* view1, view_t* view2,
     mpc_LowMC_verify(view1, view2, tape, (uint32_t*)tmp, plaintext, params, challenge);
 }
 
-int verify(signature_t* sig, const uint32_t* pubKey, const uint32_t* plaintext,
-           const uint8_t* message, size_t messageByteLength, paramset_t* params)
+/* A contiguous range of the parallel MPC rounds, processed by one job, with
+ * the job's own random tape and temporary buffer */
+typedef struct round_job_t {
+    int (*run)(void* ctx, struct round_job_t* job);
+    void* ctx;
+    uint32_t first;
+    uint32_t last;
+    randomTape_t tape;
+    uint8_t* tmp;
+    int status;
+} round_job_t;
+
+#if PICNIC_NUM_THREADS > 1
+/* The PICNIC_NUM_THREADS - 1 worker threads. They are started on the first
+ * call to run_rounds() and then wait on poolWork for the next set of jobs.
+ * All fields are protected by poolLock. */
+static struct {
+    round_job_t* jobs;
+    uint32_t njobs;
+    uint32_t next;
+    unsigned long batch;    /* Incremented for every set of jobs handed out */
+    uint32_t active;        /* Workers currently taking jobs */
+    uint32_t workers;       /* Workers that were started */
+    bool busy;              /* Set while a caller owns the pool */
+} pool;
+
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t poolWork = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t poolDone = PTHREAD_COND_INITIALIZER;
+static pthread_once_t poolOnce = PTHREAD_ONCE_INIT;
+
+/* Run jobs of the current set until none is left. Called with poolLock held,
+ * which is released while a job runs. */
+static void take_round_jobs(void)
 {
-    commitments_t* as = allocateCommitments(params, 0);
-    g_commitments_t* gs = allocateGCommitments(params);
+    while (pool.next < pool.njobs) {
+        round_job_t* job = &pool.jobs[pool.next++];
+        pthread_mutex_unlock(&poolLock);
+        job->status = job->run(job->ctx, job);
+        pthread_mutex_lock(&poolLock);
+    }
+}
 
-    uint32_t** viewOutputs = malloc(params->numMPCRounds * 3 * sizeof(uint32_t*));
-    const proof_t* proofs = sig->proofs;
+static void* round_job_thread(void* arg)
+{
+    unsigned long seen = 0;
 
-    const uint8_t* received_challengebits = sig->challengeBits;
-    int status = EXIT_SUCCESS;
-    uint8_t* computed_challengebits = NULL;
-    uint32_t* view3Slab = NULL;
+    (void)arg;
+    pthread_mutex_lock(&poolLock);
+    for (;;) {
+        while (pool.batch == seen) {
+            pthread_cond_wait(&poolWork, &poolLock);
+        }
+        seen = pool.batch;
+
+        pool.active++;
+        take_round_jobs();
+        if (--pool.active == 0) {
+            pthread_cond_signal(&poolDone);
+        }
+    }
+    return NULL;
+}
 
-    uint8_t* tmp = malloc(MAX(6 * params->stateSizeBytes, params->stateSizeBytes + params->andSizeBytes));
+static void start_round_threads(void)
+{
+    pthread_attr_t attr;
+    pthread_t thread;
 
-    randomTape_t* tape = (randomTape_t*)malloc(sizeof(randomTape_t));
+    if (pthread_attr_init(&attr) != 0) {
+        return;
+    }
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    for (uint32_t t = 1; t < PICNIC_NUM_THREADS; t++) {
+        if (pthread_create(&thread, &attr, round_job_thread, NULL) != 0) {
+            break;
+        }
+        pthread_mutex_lock(&poolLock);
+        pool.workers++;
+        pthread_mutex_unlock(&poolLock);
+    }
+    pthread_attr_destroy(&attr);
+}
 
-    allocateRandomTape(tape, params);
+/* Run the jobs on the worker threads and the calling thread. Returns false,
+ * without running any job, if there are no workers or another thread is
+ * using them. */
+static bool run_on_pool(round_job_t* jobs, uint32_t njobs)
+{
+    pthread_once(&poolOnce, start_round_threads);
 
-    view_t* view1s = malloc(params->numMPCRounds * sizeof(view_t));
-    view_t* view2s = malloc(params->numMPCRounds * sizeof(view_t));
+    pthread_mutex_lock(&poolLock);
+    if (pool.busy || pool.workers == 0) {
+        pthread_mutex_unlock(&poolLock);
+        return false;
+    }
+    pool.busy = true;
+    pool.jobs = jobs;
+    pool.njobs = njobs;
+    pool.next = 0;
+    pool.batch++;
+    pthread_cond_broadcast(&poolWork);
+
+    take_round_jobs();
+    /* The last jobs may still be running on the workers */
+    while (pool.active > 0) {
+        pthread_cond_wait(&poolDone, &poolLock);
+    }
+    pool.busy = false;
+    pthread_mutex_unlock(&poolLock);
+    return true;
+}
+#endif
 
-    /* Allocate a slab of memory for the 3rd view's output in each round */
-    view3Slab = malloc(params->stateSizeBytes * params->numMPCRounds);
-    uint32_t* view3Output = view3Slab;     /* pointer into the slab to the current 3rd view */
+/* Split the numMPCRounds parallel rounds into PICNIC_NUM_THREADS contiguous
+ * ranges and call run() on each. The rounds are independent, so the ranges
+ * are shared out between the calling thread and the worker threads, which
+ * are started on the first call and kept for later ones. If the workers
+ * could not be started, or are busy with the rounds of another thread, all
+ * ranges run on the calling thread.
+ * The scratch memory of every job is taken from the arena before any job
+ * starts, since the arena is not thread-safe. */
+static int run_rounds(int (*run)(void* ctx, round_job_t* job), void* ctx,
+                      size_t tmpSizeBytes, paramset_t* params, picnic_arena_t* arena)
+{
+    round_job_t jobs[PICNIC_NUM_THREADS];
+    int status = EXIT_SUCCESS;
+    bool done = false;
+
+    for (uint32_t t = 0; t < PICNIC_NUM_THREADS; t++) {
+        jobs[t].run = run;
+        jobs[t].ctx = ctx;
+        jobs[t].first = (params->numMPCRounds * t) / PICNIC_NUM_THREADS;
+        jobs[t].last = (params->numMPCRounds * (t + 1)) / PICNIC_NUM_THREADS;
+        allocateRandomTape(&jobs[t].tape, params, arena);
+        jobs[t].tmp = arenaAlloc(arena, tmpSizeBytes);
+        jobs[t].status = EXIT_SUCCESS;
+    }
 
-    for (size_t i = 0; i < params->numMPCRounds; i++) {
-        allocateView(&view1s[i], params);
-        allocateView(&view2s[i], params);
+#if PICNIC_NUM_THREADS > 1
+    done = run_on_pool(jobs, PICNIC_NUM_THREADS);
+#endif
+    if (!done) {
+        for (uint32_t t = 0; t < PICNIC_NUM_THREADS; t++) {
+            jobs[t].status = run(ctx, &jobs[t]);
+        }
+    }
+
+    for (uint32_t t = 0; t < PICNIC_NUM_THREADS; t++) {
+        if (jobs[t].status != EXIT_SUCCESS) {
+            status = EXIT_FAILURE;
+        }
+    }
+
+    return status;
+}
 
+typedef struct verify_rounds_t {
+    signature_t* sig;
+    const uint32_t* pubKey;
+    const uint32_t* plaintext;
+    commitments_t* as;
+    g_commitments_t* gs;
+    view_t* view1s;
+    view_t* view2s;
+    uint32_t* view3Slab;
+    uint32_t** viewOutputs;
+    paramset_t* params;
+} verify_rounds_t;
+
+/* Recompute the opened views and commitments for the rounds of one job */
+static int verify_rounds(void* arg, round_job_t* job)
+{
+    verify_rounds_t* ctx = (verify_rounds_t*)arg;
+    paramset_t* params = ctx->params;
+    const proof_t* proofs = ctx->sig->proofs;
+    const uint8_t* received_challengebits = ctx->sig->challengeBits;
+    view_t* view1s = ctx->view1s;
+    view_t* view2s = ctx->view2s;
+    commitments_t* as = ctx->as;
+    g_commitments_t* gs = ctx->gs;
+    uint32_t** viewOutputs = ctx->viewOutputs;
+
+    for (size_t i = job->first; i < job->last; i++) {
         // last bits of communicatedBits may not be set so zero them
         view1s[i].communicatedBits[params->andSizeBytes - 1] = 0;
 
         verifyProof(&proofs[i], &view1s[i], &view2s[i],
-                    getChallenge(received_challengebits, i), sig->salt, i,
-                    tmp, plaintext, tape, params);
+                    getChallenge(received_challengebits, i), ctx->sig->salt, i,
+                    job->tmp, ctx->plaintext, &job->tape, params);
 
         // create ordered array of commitments with order computed based on the challenge
         // check commitments of the two opened views
@@ -598,17 +778,53 @@ int verify(signature_t* sig, const uint32_t* pubKey, const uint32_t* plaintext,
             memcpy(gs[i].G[(challenge + 2) % 3], proofs[i].view3UnruhG, view3UnruhLength);
         }
 
+        /* pointer into the slab to the 3rd view of this round */
+        uint32_t* view3Output = ctx->view3Slab + i * params->stateSizeWords;
+
         VIEW_OUTPUTS(i, challenge) = view1s[i].outputShare;
         VIEW_OUTPUTS(i, (challenge + 1) % 3) = view2s[i].outputShare;
         for (size_t j = 0; j < params->stateSizeWords; j++) {
             view3Output[j] = view1s[i].outputShare[j] ^ view2s[i].outputShare[j]
-                             ^ pubKey[j];
+                             ^ ctx->pubKey[j];
         }
         VIEW_OUTPUTS(i, (challenge + 2) % 3) = view3Output;
-        view3Output += params->stateSizeWords;
     }
 
-    computed_challengebits = malloc(numBytes(2 * params->numMPCRounds));
+    return EXIT_SUCCESS;
+}
+
+int verify(signature_t* sig, const uint32_t* pubKey, const uint32_t* plaintext,
+           const uint8_t* message, size_t messageByteLength, paramset_t* params,
+           picnic_arena_t* arena)
+{
+    commitments_t* as = allocateCommitments(params, 0, arena);
+    g_commitments_t* gs = allocateGCommitments(params, arena);
+
+    uint32_t** viewOutputs = arenaAlloc(arena, params->numMPCRounds * 3 * sizeof(uint32_t*));
+
+    const uint8_t* received_challengebits = sig->challengeBits;
+    int status = EXIT_SUCCESS;
+    uint8_t* computed_challengebits = NULL;
+    uint32_t* view3Slab = NULL;
+
+    view_t* view1s = arenaAlloc(arena, params->numMPCRounds * sizeof(view_t));
+    view_t* view2s = arenaAlloc(arena, params->numMPCRounds * sizeof(view_t));
+
+    for (size_t i = 0; i < params->numMPCRounds; i++) {
+        allocateView(&view1s[i], params, arena);
+        allocateView(&view2s[i], params, arena);
+    }
+
+    /* Allocate a slab of memory for the 3rd view's output in each round */
+    view3Slab = arenaAlloc(arena, params->stateSizeBytes * params->numMPCRounds);
+
+    verify_rounds_t rounds = { sig, pubKey, plaintext, as, gs, view1s, view2s,
+                               view3Slab, viewOutputs, params };
+    run_rounds(verify_rounds, &rounds,
+               MAX(6 * params->stateSizeBytes, params->stateSizeBytes + params->andSizeBytes),
+               params, arena);
+
+    computed_challengebits = arenaAlloc(arena, numBytes(2 * params->numMPCRounds));
 
     H3(pubKey, plaintext, viewOutputs, as,
        computed_challengebits, sig->salt, message, messageByteLength, gs, params);
@@ -620,22 +836,6 @@ int verify(signature_t* sig, const uint32_t* pubKey, const uint32_t* plaintext,
         status = EXIT_FAILURE;
     }
 
-    free(computed_challengebits);
-    free(view3Slab);
-
-    freeCommitments(as);
-    for (size_t i = 0; i < params->numMPCRounds; i++) {
-        freeView(&view1s[i]);
-        freeView(&view2s[i]);
-    }
-    free(view1s);
-    free(view2s);
-    free(tmp);
-    freeRandomTape(tape);
-    free(tape);
-    freeGCommitments(gs);
-    free(viewOutputs);
-
     return status;
 }
 
@@ -743,10 +943,11 @@ int random_bytes_supercop(uint8_t* buf, size_t len)
 #endif /* SUPERCOP */
 
 seeds_t* computeSeeds(uint32_t* privateKey, uint32_t*
-                      publicKey, uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, paramset_t* params)
+                      publicKey, uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, paramset_t* params,
+                      picnic_arena_t* arena)
 {
     HashInstance ctx;
-    seeds_t* allSeeds = allocateSeeds(params);
+    seeds_t* allSeeds = allocateSeeds(params, arena);
 
     HashInit(&ctx, params, HASH_PREFIX_NONE);
     HashUpdate(&ctx, (uint8_t*)privateKey, params->stateSizeBytes);
@@ -763,54 +964,59 @@ seeds_t* computeSeeds(uint32_t* privateKey, uint32_t*
 }
 
 
-int sign_picnic1(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, const uint8_t* message,
-                 size_t messageByteLength, signature_t* sig, paramset_t* params)
+typedef struct sign_rounds_t {
+    uint32_t* privateKey;
+    uint32_t* plaintext;
+    uint8_t* salt;
+    seeds_t* seeds;
+    view_t** views;
+    commitments_t* as;
+    g_commitments_t* gs;
+    paramset_t* params;
+} sign_rounds_t;
+
+/* Simulate the MPC protocol and commit to the views for the rounds of one job */
+static int sign_picnic1_rounds(void* arg, round_job_t* job)
 {
+    sign_rounds_t* ctx = (sign_rounds_t*)arg;
+    paramset_t* params = ctx->params;
+    seeds_t* seeds = ctx->seeds;
+    view_t** views = ctx->views;
+    commitments_t* as = ctx->as;
+    g_commitments_t* gs = ctx->gs;
     bool status;
 
-    /* Allocate views and commitments for all parallel iterations */
-    view_t** views = allocateViews(params);
-    commitments_t* as = allocateCommitments(params, 0);
-    g_commitments_t* gs = allocateGCommitments(params);
-
-    /* Compute seeds for all parallel iterations */
-    seeds_t* seeds = computeSeeds(privateKey, pubKey, plaintext, message, messageByteLength, params);
-
-    memcpy(sig->salt, seeds[params->numMPCRounds].iSeed, params->saltSizeBytes);
-
-    //Allocate a random tape (re-used per parallel iteration), and a temporary buffer
-    randomTape_t tape;
+    // The random tape is re-used per parallel iteration, as is the temporary buffer
+    randomTape_t* tape = &job->tape;
+    uint8_t* tmp = job->tmp;
 
-    allocateRandomTape(&tape, params);
-    uint8_t* tmp = malloc( MAX(9 * params->stateSizeBytes, params->stateSizeBytes + params->andSizeBytes));
-
-    for (uint32_t k = 0; k < params->numMPCRounds; k++) {
+    for (uint32_t k = job->first; k < job->last; k++) {
         // for first two players get all tape INCLUDING INPUT SHARE from seed
         for (int j = 0; j < 2; j++) {
-            status = createRandomTape(seeds[k].seed[j], sig->salt, k, j, tmp, params->stateSizeBytes + params->andSizeBytes, params);
+            status = createRandomTape(seeds[k].seed[j], ctx->salt, k, j, tmp, params->stateSizeBytes + params->andSizeBytes, params);
             if (!status) {
                 fprintf(stderr, "%s: createRandomTape failed \n", __func__);
                 return EXIT_FAILURE;
             }
 
             memcpy(views[k][j].inputShare, tmp, params->stateSizeBytes);
-            memcpy(tape.tape[j], tmp + params->stateSizeBytes, params->andSizeBytes);
+            memcpy(tape->tape[j], tmp + params->stateSizeBytes, params->andSizeBytes);
         }
         // Now set third party's wires. The random bits are from the seed, the input is
         // the XOR of other two inputs and the private key
-        status = createRandomTape(seeds[k].seed[2], sig->salt, k, 2, tape.tape[2], params->andSizeBytes, params);
+        status = createRandomTape(seeds[k].seed[2], ctx->salt, k, 2, tape->tape[2], params->andSizeBytes, params);
         if (!status) {
             fprintf(stderr, "%s: createRandomTape failed \n", __func__);
             return EXIT_FAILURE;
         }
 
         for (uint32_t j = 0; j < params->stateSizeWords; j++) {
-            views[k][2].inputShare[j] = privateKey[j]
+            views[k][2].inputShare[j] = ctx->privateKey[j]
                                         ^ views[k][0].inputShare[j]
                                         ^ views[k][1].inputShare[j];
         }
 
-        runMPC(views[k], &tape, plaintext, (uint32_t*)tmp, params);
+        runMPC(views[k], tape, ctx->plaintext, (uint32_t*)tmp, params);
 
         //Committing
         Commit(seeds[k].seed[0], views[k][0], as[k].hashes[0], params);
@@ -824,8 +1030,34 @@ int sign_picnic1(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, co
         }
     }
 
+    return EXIT_SUCCESS;
+}
+
+int sign_picnic1(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, const uint8_t* message,
+                 size_t messageByteLength, signature_t* sig, paramset_t* params, picnic_arena_t* arena)
+{
+    int status;
+
+    /* Allocate views and commitments for all parallel iterations */
+    view_t** views = allocateViews(params, arena);
+    commitments_t* as = allocateCommitments(params, 0, arena);
+    g_commitments_t* gs = allocateGCommitments(params, arena);
+
+    /* Compute seeds for all parallel iterations */
+    seeds_t* seeds = computeSeeds(privateKey, pubKey, plaintext, message, messageByteLength, params, arena);
+
+    memcpy(sig->salt, seeds[params->numMPCRounds].iSeed, params->saltSizeBytes);
+
+    sign_rounds_t rounds = { privateKey, plaintext, sig->salt, seeds, views, as, gs, params };
+    status = run_rounds(sign_picnic1_rounds, &rounds,
+                        MAX(9 * params->stateSizeBytes, params->stateSizeBytes + params->andSizeBytes),
+                        params, arena);
+    if (status != EXIT_SUCCESS) {
+        return status;
+    }
+
     //Generating challenges
-    uint32_t** viewOutputs = malloc(params->numMPCRounds * 3 * sizeof(uint32_t*));
+    uint32_t** viewOutputs = arenaAlloc(arena, params->numMPCRounds * 3 * sizeof(uint32_t*));
 
     for (size_t i = 0; i < params->numMPCRounds; i++) {
         for (size_t j = 0; j < 3; j++) {
@@ -848,16 +1080,7 @@ int sign_picnic1(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, co
               views[i], &as[i], (gs == NULL) ? NULL : &gs[i], params);
     }
 
-    free(tmp);
-
-    freeViews(views, params);
-    freeCommitments(as);
-    freeRandomTape(&tape);
-    freeGCommitments(gs);
-    free(viewOutputs);
-    freeSeeds(seeds);
-
-    return EXIT_SUCCESS;
+    return status;
 }
 
 /*** Serialization functions ***/
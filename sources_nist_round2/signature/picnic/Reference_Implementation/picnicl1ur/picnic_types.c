@@ -11,16 +11,155 @@
  */
 
 #include "picnic_types.h"
+#include "tree.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
 
-shares_t* allocateShares(size_t count)
+/* Arena allocations are rounded up to keep every object 8-byte aligned */
+#define ARENA_ALIGN(n) (((n) + 7) & ~(size_t)7)
+
+int createArena(picnic_arena_t* arena, size_t size)
+{
+    arena->size = ARENA_ALIGN(size);
+    arena->used = 0;
+    arena->overflow = NULL;
+    arena->numOverflow = 0;
+    arena->base = calloc(1, arena->size);
+    if (arena->base == NULL) {
+        arena->size = 0;
+        return -1;
+    }
+    return 0;
+}
+
+void* arenaAlloc(picnic_arena_t* arena, size_t size)
+{
+    if (arena == NULL) {
+        return calloc(1, size);
+    }
+
+    size = ARENA_ALIGN(size);
+    if (size <= arena->size - arena->used) {
+        void* p = arena->base + arena->used;
+        arena->used += size;
+        return p;
+    }
+
+    /* The arena was sized too small; keep going from the heap */
+    void** overflow = realloc(arena->overflow, (arena->numOverflow + 1) * sizeof(void*));
+    if (overflow == NULL) {
+        return NULL;
+    }
+    arena->overflow = overflow;
+    arena->overflow[arena->numOverflow] = calloc(1, size);
+    if (arena->overflow[arena->numOverflow] == NULL) {
+        return NULL;
+    }
+    return arena->overflow[arena->numOverflow++];
+}
+
+void resetArena(picnic_arena_t* arena)
+{
+    memset(arena->base, 0, arena->used);
+    arena->used = 0;
+    for (size_t i = 0; i < arena->numOverflow; i++) {
+        free(arena->overflow[i]);
+    }
+    free(arena->overflow);
+    arena->overflow = NULL;
+    arena->numOverflow = 0;
+}
+
+void freeArena(picnic_arena_t* arena)
+{
+    if (arena->base != NULL) {
+        resetArena(arena);
+        free(arena->base);
+        arena->base = NULL;
+        arena->size = 0;
+    }
+}
+
+static size_t treeArenaSize(size_t numLeaves, size_t dataSize)
+{
+    size_t depth = ceil_log2(numLeaves) + 1;
+    size_t numNodes = ((1 << depth) - 1) - ((1 << (depth - 1)) - numLeaves);
+
+    return ARENA_ALIGN(sizeof(tree_t)) + ARENA_ALIGN(numNodes * sizeof(uint8_t*)) +
+           ARENA_ALIGN(numNodes * dataSize) + 2 * ARENA_ALIGN(numNodes);
+}
+
+static size_t randomTapeArenaSize(paramset_t* params)
+{
+    return ARENA_ALIGN(params->numMPCParties * sizeof(uint8_t*)) +
+           ARENA_ALIGN(params->numMPCParties * (2 * params->andSizeBytes + params->stateSizeBytes));
+}
+
+static size_t commitmentsArenaSize(paramset_t* params, size_t nCommitments)
+{
+    return ARENA_ALIGN(params->numMPCRounds * sizeof(commitments_t)) +
+           ARENA_ALIGN(params->numMPCRounds * nCommitments * (params->digestSizeBytes + sizeof(uint8_t*)));
+}
+
+static size_t viewArenaSize(paramset_t* params)
+{
+    return 2 * ARENA_ALIGN(params->stateSizeBytes) + ARENA_ALIGN(params->andSizeBytes);
+}
+
+/* Sums the allocations made by sign_picnic1/verify, or by
+ * sign_picnic2/verify_picnic2, whichever needs more. */
+size_t arenaSize(paramset_t* params)
+{
+    size_t T = params->numMPCRounds;
+    size_t N = params->numMPCParties;
+    size_t size = 0;
+
+    if (N == 3) {
+        /* Views; signing keeps three per round, verification two plus the
+         * third view's output */
+        size += ARENA_ALIGN(T * sizeof(view_t*)) + T * ARENA_ALIGN(3 * sizeof(view_t)) + 3 * T * viewArenaSize(params);
+        size += commitmentsArenaSize(params, 3);
+        if (params->transform == TRANSFORM_UR) {
+            size += ARENA_ALIGN(T * sizeof(g_commitments_t)) + ARENA_ALIGN(3 * T * params->UnruhGWithInputBytes);
+        }
+        /* Seeds and salt */
+        size += ARENA_ALIGN((T + 1) * sizeof(seeds_t)) + ARENA_ALIGN(T * 3 * params->seedSizeBytes + params->saltSizeBytes) +
+                ARENA_ALIGN((4 * T + 1) * sizeof(uint8_t*)) + ARENA_ALIGN(T * params->seedSizeBytes + params->saltSizeBytes);
+        size += ARENA_ALIGN(3 * T * sizeof(uint32_t*));                 // viewOutputs
+        size += ARENA_ALIGN(T * params->stateSizeBytes);                // view3Slab
+        size += ARENA_ALIGN(numBytes(2 * T));                           // challenge bits
+        /* Scratch for each thread: a random tape and a temporary buffer */
+        size += PICNIC_NUM_THREADS * (randomTapeArenaSize(params) +
+                                      ARENA_ALIGN(9 * params->stateSizeBytes + params->andSizeBytes));
+    }
+    else {
+        size_t challengeBytes = ARENA_ALIGN(params->numOpenedRounds * sizeof(uint16_t));
+
+        size += ARENA_ALIGN(params->saltSizeBytes + params->seedSizeBytes);
+        size += treeArenaSize(T, params->seedSizeBytes);                // iSeeds
+        size += ARENA_ALIGN(T * sizeof(tree_t*)) + T * treeArenaSize(N, params->seedSizeBytes);
+        size += ARENA_ALIGN(T * sizeof(randomTape_t)) + T * randomTapeArenaSize(params);
+        size += commitmentsArenaSize(params, N);                        // C
+        size += ARENA_ALIGN(T * (params->stateSizeBytes + sizeof(uint8_t*)));  // inputs
+        size += ARENA_ALIGN(T * sizeof(msgs_t)) +
+                ARENA_ALIGN(T * N * (params->andSizeBytes + params->stateSizeBytes + sizeof(uint8_t*)));
+        size += ARENA_ALIGN(sizeof(shares_t)) + ARENA_ALIGN(params->stateSizeBits * sizeof(uint64_t));
+        size += 2 * ARENA_ALIGN(T * (params->digestSizeBytes + sizeof(uint8_t*)));  // Ch, Cv
+        size += treeArenaSize(T, params->digestSizeBytes);              // treeCv
+        size += ARENA_ALIGN((T - params->numOpenedRounds) * sizeof(uint16_t));    // missingLeaves
+        size += 2 * challengeBytes;
+    }
+
+    return size;
+}
+
+shares_t* allocateShares(size_t count, picnic_arena_t* arena)
 {
-    shares_t* shares = malloc(sizeof(shares_t));
+    shares_t* shares = arenaAlloc(arena, sizeof(shares_t));
 
-    shares->shares = calloc(count, sizeof(uint64_t));
+    shares->shares = arenaAlloc(arena, count * sizeof(uint64_t));
     shares->numWords = count;
     return shares;
 }
@@ -31,11 +170,11 @@ void freeShares(shares_t* shares)
 }
 
 /* Allocate/free functions for dynamically sized types */
-void allocateView(view_t* view, paramset_t* params)
+void allocateView(view_t* view, paramset_t* params, picnic_arena_t* arena)
 {
-    view->inputShare = malloc(params->stateSizeBytes);
-    view->communicatedBits = malloc(params->andSizeBytes);
-    view->outputShare = malloc(params->stateSizeBytes);
+    view->inputShare = arenaAlloc(arena, params->stateSizeBytes);
+    view->communicatedBits = arenaAlloc(arena, params->andSizeBytes);
+    view->outputShare = arenaAlloc(arena, params->stateSizeBytes);
 }
 
 void freeView(view_t* view)
@@ -45,12 +184,12 @@ void freeView(view_t* view)
     free(view->outputShare);
 }
 
-void allocateRandomTape(randomTape_t* tape, paramset_t* params)
+void allocateRandomTape(randomTape_t* tape, paramset_t* params, picnic_arena_t* arena)
 {
     tape->nTapes = params->numMPCParties;
-    tape->tape = malloc(tape->nTapes * sizeof(uint8_t*));
+    tape->tape = arenaAlloc(arena, tape->nTapes * sizeof(uint8_t*));
     size_t tapeSizeBytes = 2 * params->andSizeBytes + params->stateSizeBytes;
-    uint8_t* slab = calloc(1, tape->nTapes * tapeSizeBytes);
+    uint8_t* slab = arenaAlloc(arena, tape->nTapes * tapeSizeBytes);
     for (uint8_t i = 0; i < tape->nTapes; i++) {
         tape->tape[i] = slab;
         slab += tapeSizeBytes;
@@ -162,13 +301,13 @@ void freeSignature2(signature2_t* sig, paramset_t* params)
     free(sig->proofs);
 }
 
-seeds_t* allocateSeeds(paramset_t* params)
+seeds_t* allocateSeeds(paramset_t* params, picnic_arena_t* arena)
 {
-    seeds_t* seeds = malloc((params->numMPCRounds + 1) * sizeof(seeds_t));
+    seeds_t* seeds = arenaAlloc(arena, (params->numMPCRounds + 1) * sizeof(seeds_t));
     size_t nSeeds = params->numMPCParties;
-    uint8_t* slab1 = malloc((params->numMPCRounds * nSeeds) * params->seedSizeBytes + params->saltSizeBytes);                                   // Seeds
-    uint8_t* slab2 = malloc(params->numMPCRounds * nSeeds * sizeof(uint8_t*) + sizeof(uint8_t*) + params->numMPCRounds * sizeof(uint8_t*) );    // pointers to seeds
-    uint8_t* slab3 = malloc((params->numMPCRounds) * params->seedSizeBytes + params->saltSizeBytes);                                            // iSeeds, used to derive seeds
+    uint8_t* slab1 = arenaAlloc(arena, (params->numMPCRounds * nSeeds) * params->seedSizeBytes + params->saltSizeBytes);                                   // Seeds
+    uint8_t* slab2 = arenaAlloc(arena, params->numMPCRounds * nSeeds * sizeof(uint8_t*) + sizeof(uint8_t*) + params->numMPCRounds * sizeof(uint8_t*) );    // pointers to seeds
+    uint8_t* slab3 = arenaAlloc(arena, (params->numMPCRounds) * params->seedSizeBytes + params->saltSizeBytes);                                            // iSeeds, used to derive seeds
 
     // We need multiple slabs here, because the seeds are generated with one call to the KDF;
     // they must be stored contiguously
@@ -206,14 +345,14 @@ void freeSeeds(seeds_t* seeds)
     free(seeds);
 }
 
-commitments_t* allocateCommitments(paramset_t* params, size_t numCommitments)
+commitments_t* allocateCommitments(paramset_t* params, size_t numCommitments, picnic_arena_t* arena)
 {
-    commitments_t* commitments = malloc(params->numMPCRounds * sizeof(commitments_t));
+    commitments_t* commitments = arenaAlloc(arena, params->numMPCRounds * sizeof(commitments_t));
 
     commitments->nCommitments = (numCommitments) ? numCommitments : params->numMPCParties;
 
-    uint8_t* slab = malloc(params->numMPCRounds * (commitments->nCommitments * params->digestSizeBytes +
-                                                   commitments->nCommitments * sizeof(uint8_t*)) );
+    uint8_t* slab = arenaAlloc(arena, params->numMPCRounds * (commitments->nCommitments * params->digestSizeBytes +
+                                                               commitments->nCommitments * sizeof(uint8_t*)) );
 
     for (uint32_t i = 0; i < params->numMPCRounds; i++) {
         commitments[i].hashes = (uint8_t**)slab;
@@ -236,11 +375,11 @@ void freeCommitments(commitments_t* commitments)
 
 
 /* Allocate one commitments_t object with capacity for numCommitments values */
-void allocateCommitments2(commitments_t* commitments, paramset_t* params, size_t numCommitments)
+void allocateCommitments2(commitments_t* commitments, paramset_t* params, size_t numCommitments, picnic_arena_t* arena)
 {
     commitments->nCommitments = numCommitments;
 
-    uint8_t* slab = malloc(numCommitments * params->digestSizeBytes + numCommitments * sizeof(uint8_t*));
+    uint8_t* slab = arenaAlloc(arena, numCommitments * params->digestSizeBytes + numCommitments * sizeof(uint8_t*));
 
     commitments->hashes = (uint8_t**)slab;
     slab += numCommitments * sizeof(uint8_t*);
@@ -258,9 +397,9 @@ void freeCommitments2(commitments_t* commitments)
     }
 }
 
-inputs_t allocateInputs(paramset_t* params)
+inputs_t allocateInputs(paramset_t* params, picnic_arena_t* arena)
 {
-    uint8_t* slab = calloc(1, params->numMPCRounds * (params->stateSizeBytes + sizeof(uint8_t*)));
+    uint8_t* slab = arenaAlloc(arena, params->numMPCRounds * (params->stateSizeBytes + sizeof(uint8_t*)));
 
     inputs_t inputs = (uint8_t**)slab;
 
@@ -279,12 +418,12 @@ void freeInputs(inputs_t inputs)
     free(inputs);
 }
 
-msgs_t* allocateMsgs(paramset_t* params)
+msgs_t* allocateMsgs(paramset_t* params, picnic_arena_t* arena)
 {
-    msgs_t* msgs = malloc(params->numMPCRounds * sizeof(msgs_t));
+    msgs_t* msgs = arenaAlloc(arena, params->numMPCRounds * sizeof(msgs_t));
 
-    uint8_t* slab = calloc(1, params->numMPCRounds * (params->numMPCParties * (params->andSizeBytes + params->stateSizeBytes) +
-                                                      params->numMPCParties * sizeof(uint8_t*)));
+    uint8_t* slab = arenaAlloc(arena, params->numMPCRounds * (params->numMPCParties * (params->andSizeBytes + params->stateSizeBytes) +
+                                                               params->numMPCParties * sizeof(uint8_t*)));
 
     for (uint32_t i = 0; i < params->numMPCRounds; i++) {
         msgs[i].pos = 0;
@@ -309,15 +448,15 @@ void freeMsgs(msgs_t* msgs)
 
 
 
-view_t** allocateViews(paramset_t* params)
+view_t** allocateViews(paramset_t* params, picnic_arena_t* arena)
 {
     // 3 views per round
-    view_t** views = malloc(params->numMPCRounds * sizeof(view_t *));
+    view_t** views = arenaAlloc(arena, params->numMPCRounds * sizeof(view_t *));
 
     for (size_t i = 0; i < params->numMPCRounds; i++) {
-        views[i] = malloc(3 * sizeof(view_t));
+        views[i] = arenaAlloc(arena, 3 * sizeof(view_t));
         for (size_t j = 0; j < 3; j++) {
-            allocateView(&views[i][j], params);
+            allocateView(&views[i][j], params, arena);
             //last byte of communiated bits will not nec get set so need to zero it out
             views[i][j].communicatedBits[params->andSizeBytes - 1] = 0;
         }
@@ -338,13 +477,13 @@ void freeViews(view_t** views, paramset_t* params)
     free(views);
 }
 
-g_commitments_t* allocateGCommitments(paramset_t* params)
+g_commitments_t* allocateGCommitments(paramset_t* params, picnic_arena_t* arena)
 {
     g_commitments_t* gs = NULL;
 
     if (params->transform == TRANSFORM_UR) {
-        gs = malloc(params->numMPCRounds * sizeof(g_commitments_t));
-        uint8_t* slab = malloc(params->UnruhGWithInputBytes * params->numMPCRounds * 3);
+        gs = arenaAlloc(arena, params->numMPCRounds * sizeof(g_commitments_t));
+        uint8_t* slab = arenaAlloc(arena, params->UnruhGWithInputBytes * params->numMPCRounds * 3);
         for (uint32_t i = 0; i < params->numMPCRounds; i++) {
             for (uint8_t j = 0; j < 3; j++) {
                 gs[i].G[j] = slab;
@@ -38,8 +38,9 @@ typedef struct signature2_t {
     proof2_t* proofs;           // One proof for each online execution the verifier checks
 } signature2_t;
 
-int sign_picnic2(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, signature2_t* sig, paramset_t* params);
-int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, paramset_t* params);
+/* As for sign_picnic1 and verify, all working memory comes from arena */
+int sign_picnic2(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, signature2_t* sig, paramset_t* params, struct picnic_arena_t* arena);
+int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* plaintext, const uint8_t* message, size_t messageByteLength, paramset_t* params, struct picnic_arena_t* arena);
 
 void allocateSignature2(signature2_t* sig, paramset_t* params);
 void freeSignature2(signature2_t* sig, paramset_t* params);
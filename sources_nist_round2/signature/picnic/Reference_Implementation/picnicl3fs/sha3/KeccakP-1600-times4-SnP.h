@@ -0,0 +1,29 @@
+/*
+Four parallel instances of Keccak-p[1600], with the KeccakP1600times4_*
+interface of the Keccak Code Package (see SnP-documentation.h there), so that
+an optimized implementation from the KCP can be substituted.
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#ifndef _KeccakP_1600_times4_SnP_h_
+#define _KeccakP_1600_times4_SnP_h_
+
+#if defined(__AVX2__)
+#define KeccakP1600times4_implementation        "256-bit SIMD implementation (AVX2)"
+#else
+#define KeccakP1600times4_implementation        "64-bit implementation, four instances in turn"
+#endif
+#define KeccakP1600times4_statesSizeInBytes     800
+#define KeccakP1600times4_statesAlignment       32
+
+/* The states are interleaved: lane x of instance i is the 64-bit word 4*x + i */
+void KeccakP1600times4_InitializeAll(void *states);
+void KeccakP1600times4_AddByte(void *states, unsigned int instanceIndex, unsigned char data, unsigned int offset);
+void KeccakP1600times4_AddBytes(void *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length);
+void KeccakP1600times4_PermuteAll_24rounds(void *states);
+void KeccakP1600times4_ExtractBytes(const void *states, unsigned int instanceIndex, unsigned char *data, unsigned int offset, unsigned int length);
+
+#endif
@@ -195,6 +195,73 @@ int test_serialization_L1()
     return 1;
 }
 
+/* Sign and verify several times with one context, interleaving valid and
+ * invalid signatures, and check each signature against picnic_sign(). */
+int test_context_reuse(picnic_params_t params)
+{
+    picnic_publickey_t pk;
+    picnic_privatekey_t sk;
+    uint8_t message[32];
+    size_t sigMax = picnic_signature_size(params);
+    uint8_t* signature = malloc(sigMax);
+    uint8_t* expected = malloc(sigMax);
+    picnic_context_t* ctx = picnic_context_new(params);
+    int passed = 0;
+
+    if (signature == NULL || expected == NULL || ctx == NULL) {
+        printf("%s: Failed to allocate memory\n", __func__);
+        goto Exit;
+    }
+    if (picnic_keygen(params, &pk, &sk) != 0) {
+        printf("%s: Keygen failed\n", __func__);
+        goto Exit;
+    }
+
+    for (uint8_t i = 0; i < 3; i++) {
+        size_t signature_len = sigMax;
+        size_t expected_len = sigMax;
+        memset(message, i, sizeof(message));
+
+        if (picnic_sign_ctx(ctx, &sk, message, sizeof(message), signature, &signature_len) != 0 ||
+            picnic_sign(&sk, message, sizeof(message), expected, &expected_len) != 0) {
+            printf("%s: %s: Signing failed\n", __func__, picnic_get_param_name(params));
+            goto Exit;
+        }
+        if (signature_len != expected_len || memcmp(signature, expected, signature_len) != 0) {
+            printf("%s: %s: Signature made with a context differs\n", __func__, picnic_get_param_name(params));
+            goto Exit;
+        }
+
+        signature[signature_len / 2] ^= 1;
+        if (picnic_verify_ctx(ctx, &pk, message, sizeof(message), signature, signature_len) == 0) {
+            printf("%s: %s: Modified signature accepted\n", __func__, picnic_get_param_name(params));
+            goto Exit;
+        }
+        signature[signature_len / 2] ^= 1;
+        if (picnic_verify_ctx(ctx, &pk, message, sizeof(message), signature, signature_len) != 0) {
+            printf("%s: %s: Valid signature rejected\n", __func__, picnic_get_param_name(params));
+            goto Exit;
+        }
+    }
+
+    /* The context only works with keys of its own parameter set */
+    sk.params = pk.params = (params == Picnic_L1_FS) ? Picnic_L1_UR : Picnic_L1_FS;
+    size_t signature_len = sigMax;
+    if (picnic_sign_ctx(ctx, &sk, message, sizeof(message), signature, &signature_len) == 0 ||
+        picnic_verify_ctx(ctx, &pk, message, sizeof(message), expected, sigMax) == 0) {
+        printf("%s: %s: Context used with another parameter set\n", __func__, picnic_get_param_name(params));
+        goto Exit;
+    }
+
+    passed = 1;
+
+Exit:
+    picnic_context_free(ctx);
+    free(signature);
+    free(expected);
+    return passed;
+}
+
 
 int main()
 {
@@ -231,6 +298,15 @@ int main()
     passed += test_serialization_L1();
     tests_run++;
 
+    passed += test_context_reuse(Picnic_L1_FS);
+    tests_run++;
+
+    passed += test_context_reuse(Picnic_L1_UR);
+    tests_run++;
+
+    passed += test_context_reuse(Picnic2_L1_FS);
+    tests_run++;
+
 
     printf("Ran %d tests, %d passed\n", tests_run, passed);
 
@@ -0,0 +1,154 @@
+/*
+Four parallel instances of Keccak-p[1600] with 24 rounds. With AVX2, each
+256-bit register holds the same lane of the four states; otherwise the four
+states are permuted one after the other by the same code.
+
+To the extent possible under law, the implementer has waived all copyright
+and related or neighboring rights to the source code in this file.
+http://creativecommons.org/publicdomain/zero/1.0/
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "KeccakP-1600-times4-SnP.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#define nrRounds 24
+#define nrLanes 25
+
+static const uint64_t KeccakRoundConstants[nrRounds] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+#if defined(__AVX2__)
+typedef __m256i V;
+#define XOR(a, b)       _mm256_xor_si256(a, b)
+#define ANDNOT(a, b)    _mm256_andnot_si256(a, b)
+#define ROL(a, n)       _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - (n)))
+#define CONST(c)        _mm256_set1_epi64x((long long)(c))
+#else
+typedef uint64_t V;
+#define XOR(a, b)       ((a) ^ (b))
+#define ANDNOT(a, b)    (~(a) & (b))
+#define ROL(a, n)       (((a) << (n)) | ((a) >> (64 - (n))))
+#define CONST(c)        (c)
+#endif
+
+/* Lane x + 5y of the state(s) is A[x + 5y] */
+static void KeccakP1600_Permute_lanes(V A[nrLanes])
+{
+    V B[nrLanes];
+    V C[5];
+    V D[5];
+
+    for (unsigned int round = 0; round < nrRounds; round++) {
+        /* theta */
+        for (unsigned int x = 0; x < 5; x++) {
+            C[x] = XOR(XOR(XOR(A[x], A[x + 5]), XOR(A[x + 10], A[x + 15])), A[x + 20]);
+        }
+        for (unsigned int x = 0; x < 5; x++) {
+            D[x] = XOR(C[(x + 4) % 5], ROL(C[(x + 1) % 5], 1));
+        }
+        for (unsigned int i = 0; i < nrLanes; i++) {
+            A[i] = XOR(A[i], D[i % 5]);
+        }
+
+        /* rho and pi: B[y + 5((2x + 3y) mod 5)] = ROL(A[x + 5y], r[x + 5y]) */
+        B[ 0] = A[0];
+        B[10] = ROL(A[ 1],  1);
+        B[20] = ROL(A[ 2], 62);
+        B[ 5] = ROL(A[ 3], 28);
+        B[15] = ROL(A[ 4], 27);
+        B[16] = ROL(A[ 5], 36);
+        B[ 1] = ROL(A[ 6], 44);
+        B[11] = ROL(A[ 7],  6);
+        B[21] = ROL(A[ 8], 55);
+        B[ 6] = ROL(A[ 9], 20);
+        B[ 7] = ROL(A[10],  3);
+        B[17] = ROL(A[11], 10);
+        B[ 2] = ROL(A[12], 43);
+        B[12] = ROL(A[13], 25);
+        B[22] = ROL(A[14], 39);
+        B[23] = ROL(A[15], 41);
+        B[ 8] = ROL(A[16], 45);
+        B[18] = ROL(A[17], 15);
+        B[ 3] = ROL(A[18], 21);
+        B[13] = ROL(A[19],  8);
+        B[14] = ROL(A[20], 18);
+        B[24] = ROL(A[21],  2);
+        B[ 9] = ROL(A[22], 61);
+        B[19] = ROL(A[23], 56);
+        B[ 4] = ROL(A[24], 14);
+
+        /* chi */
+        for (unsigned int y = 0; y < nrLanes; y += 5) {
+            for (unsigned int x = 0; x < 5; x++) {
+                A[x + y] = XOR(B[x + y], ANDNOT(B[(x + 1) % 5 + y], B[(x + 2) % 5 + y]));
+            }
+        }
+
+        /* iota */
+        A[0] = XOR(A[0], CONST(KeccakRoundConstants[round]));
+    }
+}
+
+void KeccakP1600times4_InitializeAll(void *states)
+{
+    memset(states, 0, KeccakP1600times4_statesSizeInBytes);
+}
+
+void KeccakP1600times4_AddByte(void *states, unsigned int instanceIndex, unsigned char data, unsigned int offset)
+{
+    uint64_t *lanes = (uint64_t*)states;
+
+    lanes[4 * (offset / 8) + instanceIndex] ^= (uint64_t)data << (8 * (offset % 8));
+}
+
+void KeccakP1600times4_AddBytes(void *states, unsigned int instanceIndex, const unsigned char *data, unsigned int offset, unsigned int length)
+{
+    for (unsigned int i = 0; i < length; i++) {
+        KeccakP1600times4_AddByte(states, instanceIndex, data[i], offset + i);
+    }
+}
+
+void KeccakP1600times4_PermuteAll_24rounds(void *states)
+{
+    uint64_t *lanes = (uint64_t*)states;
+    V A[nrLanes];
+
+#if defined(__AVX2__)
+    for (unsigned int x = 0; x < nrLanes; x++) {
+        A[x] = _mm256_loadu_si256((const __m256i*)&lanes[4 * x]);
+    }
+    KeccakP1600_Permute_lanes(A);
+    for (unsigned int x = 0; x < nrLanes; x++) {
+        _mm256_storeu_si256((__m256i*)&lanes[4 * x], A[x]);
+    }
+#else
+    for (unsigned int i = 0; i < 4; i++) {
+        for (unsigned int x = 0; x < nrLanes; x++) {
+            A[x] = lanes[4 * x + i];
+        }
+        KeccakP1600_Permute_lanes(A);
+        for (unsigned int x = 0; x < nrLanes; x++) {
+            lanes[4 * x + i] = A[x];
+        }
+    }
+#endif
+}
+
+void KeccakP1600times4_ExtractBytes(const void *states, unsigned int instanceIndex, unsigned char *data, unsigned int offset, unsigned int length)
+{
+    const uint64_t *lanes = (const uint64_t*)states;
+
+    for (unsigned int i = 0; i < length; i++) {
+        data[i] = (unsigned char)(lanes[4 * ((offset + i) / 8) + instanceIndex] >> (8 * ((offset + i) % 8)));
+    }
+}
@@ -42,27 +42,27 @@ int exists(tree_t* tree, size_t i)
     return 0;
 }
 
-tree_t* createTree(size_t numLeaves, size_t dataSize)
+tree_t* createTree(size_t numLeaves, size_t dataSize, picnic_arena_t* arena)
 {
-    tree_t* tree = malloc(sizeof(tree_t));
+    tree_t* tree = arenaAlloc(arena, sizeof(tree_t));
 
     tree->depth = ceil_log2(numLeaves) + 1;
     tree->numNodes = ((1 << (tree->depth)) - 1) - ((1 << (tree->depth - 1)) - numLeaves);  /* Num nodes in complete - number of missing leaves */
     tree->numLeaves = numLeaves;
     tree->dataSize = dataSize;
-    tree->nodes = malloc(tree->numNodes * sizeof(uint8_t*));
+    tree->nodes = arenaAlloc(arena, tree->numNodes * sizeof(uint8_t*));
 
-    uint8_t* slab = calloc(tree->numNodes, dataSize);
+    uint8_t* slab = arenaAlloc(arena, tree->numNodes * dataSize);
 
     for (size_t i = 0; i < tree->numNodes; i++) {
         tree->nodes[i] = slab;
         slab += dataSize;
     }
 
-    tree->haveNode = calloc(tree->numNodes, 1);
+    tree->haveNode = arenaAlloc(arena, tree->numNodes);
 
     /* Depending on the number of leaves, the tree may not be complete */
-    tree->exists = calloc(tree->numNodes, 1);
+    tree->exists = arenaAlloc(arena, tree->numNodes);
     memset(tree->exists + tree->numNodes - tree->numLeaves, 1, tree->numLeaves);    /* Set leaves */
     for (int i = tree->numNodes - tree->numLeaves; i > 0; i--) {
         if (exists(tree, 2 * i + 1) || exists(tree, 2 * i + 2) ) {
@@ -133,41 +133,91 @@ void hashSeed(uint8_t* digest, const uint8_t* inputSeed, uint8_t* salt, uint8_t
     HashSqueeze(&ctx, digest, 2 * params->seedSizeBytes);
 }
 
-void expandSeeds(tree_t* tree, uint8_t* salt, size_t repIndex, paramset_t* params)
+/* hashSeed for four nodes at once */
+static void hashSeed4(uint8_t** digest, const uint8_t** inputSeed, uint8_t* salt, uint8_t hashPrefix, size_t repIndex, const size_t* nodeIndex, paramset_t* params)
 {
-    uint8_t tmp[2*MAX_SEED_SIZE_BYTES];
+    HashInstancex4 ctx;
+    const uint8_t* salts[4] = { salt, salt, salt, salt };
+    uint16_t reps[4];
+    uint16_t nodes[4];
+
+    for (size_t k = 0; k < 4; k++) {
+        reps[k] = (uint16_t)repIndex;
+        nodes[k] = (uint16_t)nodeIndex[k];
+    }
+
+    HashInit4(&ctx, params, hashPrefix);
+    HashUpdate4(&ctx, inputSeed, params->seedSizeBytes);
+    HashUpdate4(&ctx, salts, params->saltSizeBytes);
+    HashUpdateIntLE4(&ctx, reps);
+    HashUpdateIntLE4(&ctx, nodes);
+    HashFinal4(&ctx);
+    HashSqueeze4(&ctx, digest, 2 * params->seedSizeBytes);
+}
 
-    /* Walk the tree, expanding seeds where possible. Compute children of
-     * non-leaf nodes. */
-    size_t lastNonLeaf = getParent(tree->numNodes - 1);
+/* Set the children of node i from the hash of its seed, unless we have them */
+static void setChildren(tree_t* tree, size_t i, const uint8_t* hash, paramset_t* params)
+{
+    if (!tree->haveNode[2 * i + 1]) {
+        /* left child = H_left(seed_i || salt || t || i) */
+        memcpy(tree->nodes[2 * i + 1], hash, params->seedSizeBytes);
+        tree->haveNode[2 * i + 1] = 1;
+    }
 
-    for (size_t i = 0; i <= lastNonLeaf; i++) {
-        if (!tree->haveNode[i]) {
-            continue;
-        }
+    /* The last non-leaf node will only have a left child when there are an odd number of leaves */
+    if (exists(tree, 2 * i + 2) && !tree->haveNode[2 * i + 2]) {
+        /* right child = H_right(seed_i || salt || t || i)  */
+        memcpy(tree->nodes[2 * i + 2], hash + params->seedSizeBytes, params->seedSizeBytes);
+        tree->haveNode[2 * i + 2] = 1;
+    }
+}
 
-        hashSeed(tmp, tree->nodes[i], salt, HASH_PREFIX_1, repIndex, i, params);
+void expandSeeds(tree_t* tree, uint8_t* salt, size_t repIndex, paramset_t* params)
+{
+    uint8_t tmp[4][2 * MAX_SEED_SIZE_BYTES];
+    uint8_t* digests[4] = { tmp[0], tmp[1], tmp[2], tmp[3] };
+    const uint8_t* seeds[4];
+    size_t batch[4];
+
+    /* Walk the tree one level at a time, expanding seeds where possible.
+     * Every node of a level depends only on its parent, so the seeds of a
+     * level are hashed four at a time. */
+    size_t lastNonLeaf = getParent(tree->numNodes - 1);
 
-        if (!tree->haveNode[2 * i + 1]) {
-            /* left child = H_left(seed_i || salt || t || i) */
-            memcpy(tree->nodes[2 * i + 1], tmp, params->seedSizeBytes);
-            tree->haveNode[2 * i + 1] = 1;
-        }
+    for (size_t first = 0; first <= lastNonLeaf; first = 2 * first + 1) {
+        size_t last = 2 * first;    // Last node of the level
+        size_t count = 0;
 
-        /* The last non-leaf node will only have a left child when there are an odd number of leaves */
-        if (exists(tree, 2 * i + 2) && !tree->haveNode[2 * i + 2]) {
-            /* right child = H_right(seed_i || salt || t || i)  */
-            memcpy(tree->nodes[2 * i + 2], tmp + params->seedSizeBytes, params->seedSizeBytes);
-            tree->haveNode[2 * i + 2] = 1;
+        if (last > lastNonLeaf) {
+            last = lastNonLeaf;
+        }
+        for (size_t i = first; i <= last; i++) {
+            if (!tree->haveNode[i]) {
+                continue;
+            }
+            batch[count++] = i;
+            if (count == 4) {
+                for (size_t k = 0; k < 4; k++) {
+                    seeds[k] = tree->nodes[batch[k]];
+                }
+                hashSeed4(digests, seeds, salt, HASH_PREFIX_1, repIndex, batch, params);
+                for (size_t k = 0; k < 4; k++) {
+                    setChildren(tree, batch[k], tmp[k], params);
+                }
+                count = 0;
+            }
+        }
+        for (size_t k = 0; k < count; k++) {
+            hashSeed(tmp[k], tree->nodes[batch[k]], salt, HASH_PREFIX_1, repIndex, batch[k], params);
+            setChildren(tree, batch[k], tmp[k], params);
         }
-
     }
 
 }
 
-tree_t* generateSeeds(size_t nSeeds, uint8_t* rootSeed, uint8_t* salt, size_t repIndex, paramset_t* params)
+tree_t* generateSeeds(size_t nSeeds, uint8_t* rootSeed, uint8_t* salt, size_t repIndex, paramset_t* params, picnic_arena_t* arena)
 {
-    tree_t* tree = createTree(nSeeds, params->seedSizeBytes);
+    tree_t* tree = createTree(nSeeds, params->seedSizeBytes, arena);
 
     memcpy(tree->nodes[0], rootSeed, params->seedSizeBytes);
     tree->haveNode[0] = 1;
@@ -292,7 +342,7 @@ static size_t* getRevealedNodes(tree_t* tree, uint16_t* hideList, size_t hideLis
 
 size_t revealSeedsSize(size_t numNodes, uint16_t* hideList, size_t hideListSize, paramset_t* params)
 {
-    tree_t* tree = createTree(numNodes, params->seedSizeBytes);
+    tree_t* tree = createTree(numNodes, params->seedSizeBytes, NULL);
     size_t numNodesRevealed = 0;
     size_t* revealed = getRevealedNodes(tree, hideList, hideListSize, &numNodesRevealed);
 
@@ -473,7 +523,7 @@ static size_t* getRevealedMerkleNodes(tree_t* tree, uint16_t* missingLeaves,
 size_t openMerkleTreeSize(size_t numNodes, uint16_t* missingLeaves, size_t missingLeavesSize, paramset_t* params)
 {
 
-    tree_t* tree = createTree(numNodes, params->digestSizeBytes);
+    tree_t* tree = createTree(numNodes, params->digestSizeBytes, NULL);
     size_t revealedSize = 0;
     size_t* revealed = getRevealedMerkleNodes(tree, missingLeaves, missingLeavesSize, &revealedSize);
 
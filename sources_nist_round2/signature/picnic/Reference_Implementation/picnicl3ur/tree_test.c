@@ -78,8 +78,8 @@ int runSeedTest(uint16_t* hideList, size_t hideListSize, size_t numLeaves, param
     memset(salt, 0x09, sizeof(salt));
 
     //printf("%s: Generating seeds\n", __func__);
-    tree_t* tree = generateSeeds(numLeaves, iSeed, salt, repIndex, params);
-    tree_t* tree2 = createTree(numLeaves, params->seedSizeBytes); 
+    tree_t* tree = generateSeeds(numLeaves, iSeed, salt, repIndex, params, NULL);
+    tree_t* tree2 = createTree(numLeaves, params->seedSizeBytes, NULL); 
 
 #if 0
     printTree("tree", tree);
@@ -221,7 +221,7 @@ int runMerkleTest(uint16_t* missingLeaves, size_t missingLeavesSize, size_t numL
     
     // Prover side; all leaves are present
 
-    tree_t* tree = createTree(numLeaves, params->digestSizeBytes); 
+    tree_t* tree = createTree(numLeaves, params->digestSizeBytes, NULL); 
 
     uint8_t** leafData = malloc(tree->numLeaves*sizeof(uint8_t*));
     uint8_t* slab = malloc(tree->numLeaves*tree->dataSize);
@@ -255,7 +255,7 @@ int runMerkleTest(uint16_t* missingLeaves, size_t missingLeavesSize, size_t numL
     // prover sends openData, tree->nodes[0] to verifier
 
     // Verifier side
-    tree2 = createTree(numLeaves, params->digestSizeBytes); 
+    tree2 = createTree(numLeaves, params->digestSizeBytes, NULL); 
 
     for(size_t i = 0; i < missingLeavesSize; i++) {
         leafData[missingLeaves[i]] = NULL;
@@ -56,22 +56,29 @@ uint32_t ceil_log2(uint32_t x)
     return 32 - nlz(x - 1);
 }
 
-static void createRandomTapes(randomTape_t* tapes, uint8_t** seeds, uint8_t* salt, size_t t, paramset_t* params)
+static void createRandomTapes(randomTape_t* tapes, uint8_t** seeds, uint8_t* salt, size_t t, paramset_t* params,
+                              picnic_arena_t* arena)
 {
-    HashInstance ctx;
-
     size_t tapeSizeBytes = 2 * params->andSizeBytes + params->stateSizeBytes;
 
-    allocateRandomTape(tapes, params);
-    for (size_t i = 0; i < params->numMPCParties; i++) {
-        HashInit(&ctx, params, HASH_PREFIX_NONE);
-        HashUpdate(&ctx, seeds[i], params->seedSizeBytes);
-        HashUpdate(&ctx, salt, params->saltSizeBytes);
-        HashUpdateIntLE(&ctx, t);
-        HashUpdateIntLE(&ctx, i);
-        HashFinal(&ctx);
+    allocateRandomTape(tapes, params, arena);
+
+    /* Derive the tapes four parties at a time (numMPCParties is a multiple of 4) */
+    assert(params->numMPCParties % 4 == 0);
+    for (size_t i = 0; i < params->numMPCParties; i += 4) {
+        HashInstancex4 ctx4;
+        const uint8_t* salts[4] = { salt, salt, salt, salt };
+        uint16_t reps[4] = { (uint16_t)t, (uint16_t)t, (uint16_t)t, (uint16_t)t };
+        uint16_t parties[4] = { (uint16_t)i, (uint16_t)(i + 1), (uint16_t)(i + 2), (uint16_t)(i + 3) };
 
-        HashSqueeze(&ctx, tapes->tape[i], tapeSizeBytes);
+        HashInit4(&ctx4, params, HASH_PREFIX_NONE);
+        HashUpdate4(&ctx4, (const uint8_t**)&seeds[i], params->seedSizeBytes);
+        HashUpdate4(&ctx4, salts, params->saltSizeBytes);
+        HashUpdateIntLE4(&ctx4, reps);
+        HashUpdateIntLE4(&ctx4, parties);
+        HashFinal4(&ctx4);
+
+        HashSqueeze4(&ctx4, &tapes->tape[i], tapeSizeBytes);
     }
 }
 
@@ -172,24 +179,36 @@ static void mpc_xor_masks(shares_t* out, const shares_t* a, const shares_t* b)
     }
 }
 
-static void aux_matrix_mul(shares_t* output, const shares_t* vec, const uint32_t* matrix, shares_t* tmp_output, paramset_t* params)
+/* Multiply the matrix with a vector of shares: output[i] is the XOR of the
+ * vec[j] for which bit j of row i is set. Uses the Method of Four Russians;
+ * for each group of eight entries of vec the XOR of every subset is tabulated,
+ * so that each byte of the matrix costs a single lookup. The table is indexed
+ * by the (public) matrix, never by the shares. */
+static void matrix_mul_shares(uint64_t* output, const uint64_t* vec, const uint32_t* matrix, paramset_t* params)
 {
-    for (size_t i = 0; i < params->stateSizeBits; i++) {
-        uint64_t new_mask_i = 0;
-        for (uint32_t j = 0; j < params->stateSizeBits / 8; j++) {
-            uint8_t matrix_byte = ((uint8_t*)matrix)[i * (params->stateSizeBits / 8) + j];
-            new_mask_i ^= vec->shares[j * 8] & extend((matrix_byte >> 7) & 1);
-            new_mask_i ^= vec->shares[j * 8 + 1] & extend((matrix_byte >> 6) & 1);
-            new_mask_i ^= vec->shares[j * 8 + 2] & extend((matrix_byte >> 5) & 1);
-            new_mask_i ^= vec->shares[j * 8 + 3] & extend((matrix_byte >> 4) & 1);
-            new_mask_i ^= vec->shares[j * 8 + 4] & extend((matrix_byte >> 3) & 1);
-            new_mask_i ^= vec->shares[j * 8 + 5] & extend((matrix_byte >> 2) & 1);
-            new_mask_i ^= vec->shares[j * 8 + 6] & extend((matrix_byte >> 1) & 1);
-            new_mask_i ^= vec->shares[j * 8 + 7] & extend(matrix_byte & 1);
+    const uint8_t* matrixBytes = (const uint8_t*)matrix;
+    uint32_t rowBytes = params->stateSizeBits / 8;
+    uint64_t table[256];
+
+    memset(output, 0x00, params->stateSizeBits * sizeof(uint64_t));
+    for (uint32_t j = 0; j < rowBytes; j++) {
+        /* table[v] is the XOR of vec[8j + k] over the bits (7 - k) set in v */
+        table[0] = 0;
+        for (uint32_t k = 8; k-- > 0; ) {
+            uint32_t bit = 1u << (7 - k);
+            for (uint32_t v = 0; v < bit; v++) {
+                table[bit | v] = table[v] ^ vec[j * 8 + k];
+            }
+        }
+        for (size_t i = 0; i < params->stateSizeBits; i++) {
+            output[i] ^= table[matrixBytes[i * rowBytes + j]];
         }
-        tmp_output->shares[i] = new_mask_i;
     }
+}
 
+static void aux_matrix_mul(shares_t* output, const shares_t* vec, const uint32_t* matrix, shares_t* tmp_output, paramset_t* params)
+{
+    matrix_mul_shares(tmp_output->shares, vec->shares, matrix, params);
     copyShares(output, tmp_output);
 }
 
@@ -219,10 +238,15 @@ static void aux_matrix_mul_simple(shares_t* output, const shares_t* vec, const u
  */
 static void computeAuxTape(randomTape_t* tapes, paramset_t* params)
 {
-    shares_t* roundKey = allocateShares(params->stateSizeBits);
-    shares_t* state = allocateShares(params->stateSizeBits);
-    shares_t* key = allocateShares(params->stateSizeBits);
-    shares_t* tmp1 = allocateShares(params->stateSizeBits);
+    uint64_t slab[4][LOWMC_MAX_KEY_BITS];
+    shares_t roundKey_shares = { slab[0], params->stateSizeBits };
+    shares_t state_shares = { slab[1], params->stateSizeBits };
+    shares_t key_shares = { slab[2], params->stateSizeBits };
+    shares_t tmp1_shares = { slab[3], params->stateSizeBits };
+    shares_t* roundKey = &roundKey_shares;
+    shares_t* state = &state_shares;
+    shares_t* key = &key_shares;
+    shares_t* tmp1 = &tmp1_shares;
 
     tapesToWords(key, tapes);
 
@@ -243,11 +267,6 @@ static void computeAuxTape(randomTape_t* tapes, paramset_t* params)
     // Reset the random tape counter so that the online execution uses the
     // same random bits as when computing the aux shares
     tapes->pos = 0;
-
-    freeShares(key);
-    freeShares(roundKey);
-    freeShares(state);
-    freeShares(tmp1);
 }
 
 static void commit(uint8_t* digest, uint8_t* seed, uint8_t* aux, uint8_t* salt, size_t t, size_t j, paramset_t* params)
@@ -268,6 +287,32 @@ static void commit(uint8_t* digest, uint8_t* seed, uint8_t* aux, uint8_t* salt,
     HashSqueeze(&ctx, digest, params->digestSizeBytes);
 }
 
+/* Compute C[t][j] for the parties j < N - 1, which commit to their seed only.
+ * Four parties are hashed at a time. */
+static void commitSeeds(commitments_t* C, uint8_t** seeds, uint8_t* salt, size_t t, paramset_t* params)
+{
+    size_t last = params->numMPCParties - 1;
+    size_t j = 0;
+
+    for (; j + 4 <= last; j += 4) {
+        HashInstancex4 ctx;
+        const uint8_t* salts[4] = { salt, salt, salt, salt };
+        uint16_t reps[4] = { (uint16_t)t, (uint16_t)t, (uint16_t)t, (uint16_t)t };
+        uint16_t parties[4] = { (uint16_t)j, (uint16_t)(j + 1), (uint16_t)(j + 2), (uint16_t)(j + 3) };
+
+        HashInit4(&ctx, params, HASH_PREFIX_NONE);
+        HashUpdate4(&ctx, (const uint8_t**)&seeds[j], params->seedSizeBytes);
+        HashUpdate4(&ctx, salts, params->saltSizeBytes);
+        HashUpdateIntLE4(&ctx, reps);
+        HashUpdateIntLE4(&ctx, parties);
+        HashFinal4(&ctx);
+        HashSqueeze4(&ctx, &C->hashes[j], params->digestSizeBytes);
+    }
+    for (; j < last; j++) {
+        commit(C->hashes[j], seeds[j], NULL, salt, t, j, params);
+    }
+}
+
 static void commit_h(uint8_t* digest, commitments_t* C, paramset_t* params)
 {
     HashInstance ctx;
@@ -280,6 +325,30 @@ static void commit_h(uint8_t* digest, commitments_t* C, paramset_t* params)
     HashSqueeze(&ctx, digest, params->digestSizeBytes);
 }
 
+/* Ch[t] = commit_h(C[t]) for all rounds t, computing four rounds at a time */
+static void commit_h_all(commitments_t* Ch, commitments_t* C, paramset_t* params)
+{
+    size_t t = 0;
+
+    for (; t + 4 <= params->numMPCRounds; t += 4) {
+        HashInstancex4 ctx;
+        const uint8_t* hashes[4];
+
+        HashInit4(&ctx, params, HASH_PREFIX_NONE);
+        for (size_t i = 0; i < params->numMPCParties; i++) {
+            for (size_t k = 0; k < 4; k++) {
+                hashes[k] = C[t + k].hashes[i];
+            }
+            HashUpdate4(&ctx, hashes, params->seedSizeBytes);
+        }
+        HashFinal4(&ctx);
+        HashSqueeze4(&ctx, &Ch->hashes[t], params->digestSizeBytes);
+    }
+    for (; t < params->numMPCRounds; t++) {
+        commit_h(Ch->hashes[t], &C[t], params);
+    }
+}
+
 // Commit to the views for one parallel rep
 static void commit_v(uint8_t* digest, uint8_t* input, msgs_t* msgs, paramset_t* params)
 {
@@ -367,36 +436,12 @@ static void broadcast(shares_t* shares, msgs_t* msgs, paramset_t* params)
 
 static void mpc_matrix_mul(uint32_t* output, const uint32_t* vec, const uint32_t* matrix, shares_t* mask_shares, paramset_t* params)
 {
-    uint32_t prod[LOWMC_MAX_STATE_SIZE];
-    uint32_t temp[LOWMC_MAX_STATE_SIZE];
+    uint64_t tmp_mask[LOWMC_MAX_KEY_BITS];
 
-    shares_t* tmp_mask = allocateShares(mask_shares->numWords);
+    matrix_mul(output, vec, matrix, params);
 
-    for (size_t i = 0; i < params->stateSizeBits; i++) {
-        tmp_mask->shares[i] = 0;
-        for (uint32_t j = 0; j < params->stateSizeBits / 8; j++) {
-            uint8_t matrix_byte = ((uint8_t*)matrix)[(i * params->stateSizeBits) / 8 + j];
-            uint8_t vec_byte = ((uint8_t*)vec)[j];
-
-            ((uint8_t*)prod)[j] = matrix_byte & vec_byte;
-
-            tmp_mask->shares[i] ^= mask_shares->shares[j * 8] & extend((matrix_byte >> 7) & 1);
-            tmp_mask->shares[i] ^= mask_shares->shares[j * 8 + 1] & extend((matrix_byte >> 6) & 1);
-            tmp_mask->shares[i] ^= mask_shares->shares[j * 8 + 2] & extend((matrix_byte >> 5) & 1);
-            tmp_mask->shares[i] ^= mask_shares->shares[j * 8 + 3] & extend((matrix_byte >> 4) & 1);
-            tmp_mask->shares[i] ^= mask_shares->shares[j * 8 + 4] & extend((matrix_byte >> 3) & 1);
-            tmp_mask->shares[i] ^= mask_shares->shares[j * 8 + 5] & extend((matrix_byte >> 2) & 1);
-            tmp_mask->shares[i] ^= mask_shares->shares[j * 8 + 6] & extend((matrix_byte >> 1) & 1);
-            tmp_mask->shares[i] ^= mask_shares->shares[j * 8 + 7] & extend(matrix_byte & 1);
-
-        }
-        uint8_t output_bit_i = parity(&prod[0], params->stateSizeWords);
-        setBit((uint8_t*)temp, i, output_bit_i);
-    }
-
-    memcpy(output, &temp, params->stateSizeBytes);
-    copyShares(mask_shares, tmp_mask);
-    freeShares(tmp_mask);
+    matrix_mul_shares(tmp_mask, mask_shares->shares, matrix, params);
+    memcpy(mask_shares->shares, tmp_mask, params->stateSizeBits * sizeof(uint64_t));
 }
 
 #if 0
@@ -406,7 +451,7 @@ static void mpc_matrix_mul_simple(uint32_t* output, const uint32_t* vec, const u
     uint32_t prod[LOWMC_MAX_STATE_SIZE];
     uint32_t temp[LOWMC_MAX_STATE_SIZE];
 
-    shares_t* tmp_mask = allocateShares(mask_shares->numWords);
+    shares_t* tmp_mask = allocateShares(mask_shares->numWords, NULL);
 
     for (size_t i = 0; i < params->stateSizeBits; i++) {
         tmp_mask->shares[i] = 0;
@@ -500,16 +545,20 @@ static int simulateOnline(uint32_t* maskedKey, shares_t* mask_shares, randomTape
                           tapes, msgs_t* msgs, const uint32_t* plaintext, const uint32_t* pubKey, paramset_t* params)
 {
     int ret = 0;
-    uint32_t* roundKey = malloc(params->stateSizeBytes);
-    uint32_t* state = malloc(params->stateSizeBytes);
-    shares_t* key_masks = allocateShares(mask_shares->numWords);    // Make a copy to use when computing each round key
+    uint32_t roundKey[LOWMC_MAX_STATE_SIZE];
+    uint32_t state[LOWMC_MAX_STATE_SIZE];
+    uint64_t key_mask_words[LOWMC_MAX_KEY_BITS];
+    uint64_t round_key_mask_words[LOWMC_MAX_KEY_BITS];
+    shares_t key_masks_shares = { key_mask_words, mask_shares->numWords };
+    shares_t round_key_masks_shares = { round_key_mask_words, mask_shares->numWords };
+    shares_t* key_masks = &key_masks_shares;    // Make a copy to use when computing each round key
+    shares_t* round_key_masks = &round_key_masks_shares;
 
     copyShares(key_masks, mask_shares);
 
     mpc_matrix_mul(roundKey, maskedKey, KMatrix(0, params), mask_shares, params);       // roundKey = maskedKey * KMatrix[0]
     xor_array(state, roundKey, plaintext, params->stateSizeWords);                      // state = plaintext + roundKey
 
-    shares_t* round_key_masks = allocateShares(mask_shares->numWords);
     for (uint32_t r = 1; r <= params->numRounds; r++) {
         copyShares(round_key_masks, key_masks);
         mpc_matrix_mul(roundKey, maskedKey, KMatrix(r, params), round_key_masks, params);
@@ -519,7 +568,6 @@ static int simulateOnline(uint32_t* maskedKey, shares_t* mask_shares, randomTape
         xor_array(state, state, RConstant(r - 1, params), params->stateSizeWords);              // state += RConstant
         mpc_xor2(state, mask_shares, roundKey, round_key_masks, state, mask_shares, params);    // state += roundKey
     }
-    freeShares(round_key_masks);
 
     /* Unmask the output, and check that it's correct */
     if (msgs->unopened >= 0) {
@@ -545,10 +593,6 @@ static int simulateOnline(uint32_t* maskedKey, shares_t* mask_shares, randomTape
 
     broadcast(mask_shares, msgs, params);
 
-    free(state);
-    free(roundKey);
-    freeShares(key_masks);
-
 Exit:
     return ret;
 }
@@ -632,7 +676,7 @@ static void HCP(uint16_t* challengeC, uint16_t* challengeP, commitments_t* Ch,
     // Populate C
     uint32_t bitsPerChunkC = ceil_log2(params->numMPCRounds);
     uint32_t bitsPerChunkP = ceil_log2(params->numMPCParties);
-    uint16_t* chunks = calloc(params->digestSizeBytes * 8 / bitsPerChunkP, sizeof(uint16_t));
+    uint16_t chunks[MAX_DIGEST_SIZE * 8];
 
     size_t countC = 0;
     while (countC < params->numOpenedRounds) {
@@ -687,14 +731,12 @@ static void HCP(uint16_t* challengeC, uint16_t* challengeP, commitments_t* Ch,
     printf("\n");
 #endif
 
-    free(chunks);
-
 }
 
-static uint16_t* getMissingLeavesList(uint16_t* challengeC, paramset_t* params)
+static uint16_t* getMissingLeavesList(uint16_t* challengeC, paramset_t* params, picnic_arena_t* arena)
 {
     size_t missingLeavesSize = params->numMPCRounds - params->numOpenedRounds;
-    uint16_t* missingLeaves = calloc(missingLeavesSize, sizeof(uint16_t));
+    uint16_t* missingLeaves = arenaAlloc(arena, missingLeavesSize * sizeof(uint16_t));
     size_t pos = 0;
 
     for (size_t i = 0; i < params->numMPCRounds; i++) {
@@ -708,19 +750,19 @@ static uint16_t* getMissingLeavesList(uint16_t* challengeC, paramset_t* params)
 }
 
 int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* plaintext, const uint8_t* message, size_t messageByteLength,
-                   paramset_t* params)
+                   paramset_t* params, picnic_arena_t* arena)
 {
-    commitments_t* C = allocateCommitments(params, 0);
+    commitments_t* C = allocateCommitments(params, 0, arena);
     commitments_t Ch = { 0 };
     commitments_t Cv = { 0 };
-    msgs_t* msgs = allocateMsgs(params);
-    tree_t* treeCv = createTree(params->numMPCRounds, params->digestSizeBytes);
+    msgs_t* msgs = allocateMsgs(params, arena);
+    tree_t* treeCv = createTree(params->numMPCRounds, params->digestSizeBytes, arena);
     size_t challengeSizeBytes = params->numOpenedRounds * sizeof(uint16_t);
-    uint16_t* challengeC = malloc(challengeSizeBytes);
-    uint16_t* challengeP = malloc(challengeSizeBytes);
-    tree_t** seeds = calloc(params->numMPCRounds, sizeof(tree_t*));
-    randomTape_t* tapes = malloc(params->numMPCRounds * sizeof(randomTape_t));
-    tree_t* iSeedsTree = createTree(params->numMPCRounds, params->seedSizeBytes);
+    uint16_t* challengeC = arenaAlloc(arena, challengeSizeBytes);
+    uint16_t* challengeP = arenaAlloc(arena, challengeSizeBytes);
+    tree_t** seeds = arenaAlloc(arena, params->numMPCRounds * sizeof(tree_t*));
+    randomTape_t* tapes = arenaAlloc(arena, params->numMPCRounds * sizeof(randomTape_t));
+    tree_t* iSeedsTree = createTree(params->numMPCRounds, params->seedSizeBytes, arena);
     int ret = reconstructSeeds(iSeedsTree, sig->challengeC, params->numOpenedRounds, sig->iSeedInfo, sig->iSeedInfoLen, sig->salt, 0, params);
 
     if (ret != 0) {
@@ -732,12 +774,12 @@ int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* pl
     for (size_t t = 0; t < params->numMPCRounds; t++) {
         if (!contains(sig->challengeC, params->numOpenedRounds, t)) {
             /* Expand iSeed[t] to seeds for each parties, using a seed tree */
-            seeds[t] = generateSeeds(params->numMPCParties, getLeaf(iSeedsTree, t), sig->salt, t, params);
+            seeds[t] = generateSeeds(params->numMPCParties, getLeaf(iSeedsTree, t), sig->salt, t, params, arena);
         }
         else {
             /* We don't have the initial seed for the round, but instead a seed
              * for each unopened party */
-            seeds[t] = createTree(params->numMPCParties, params->seedSizeBytes);
+            seeds[t] = createTree(params->numMPCParties, params->seedSizeBytes, arena);
             size_t P_index = indexOf(sig->challengeC, params->numOpenedRounds, t);
             uint16_t hideList[1];
             hideList[0] = sig->challengeP[P_index];
@@ -759,14 +801,12 @@ int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* pl
         /* Compute random tapes for all parties.  One party for each repitition
          * challengeC will have a bogus seed; but we won't use that party's
          * random tape. */
-        createRandomTapes(&tapes[t], getLeaves(seeds[t]), sig->salt, t, params);
+        createRandomTapes(&tapes[t], getLeaves(seeds[t]), sig->salt, t, params, arena);
 
         if (!contains(sig->challengeC, params->numOpenedRounds, t)) {
             /* We're given iSeed, have expanded the seeds, compute aux from scratch so we can comnpte Com[t] */
             computeAuxTape(&tapes[t], params);
-            for (size_t j = 0; j < last; j++) {
-                commit(C[t].hashes[j], getLeaf(seeds[t], j), NULL, sig->salt, t, j, params);
-            }
+            commitSeeds(&C[t], getLeaves(seeds[t]), sig->salt, t, params);
             getAuxBits(auxBits, &tapes[t], params);
             commit(C[t].hashes[last], getLeaf(seeds[t], last), auxBits, sig->salt, t, last, params);
         }
@@ -774,11 +814,9 @@ int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* pl
             /* We're given all seeds and aux bits, execpt for the unopened 
              * party, we get their commitment */
             size_t unopened = sig->challengeP[indexOf(sig->challengeC, params->numOpenedRounds, t)];
-            for (size_t j = 0; j < last; j++) {
-                if (j != unopened) {
-                    commit(C[t].hashes[j], getLeaf(seeds[t], j), NULL, sig->salt, t, j, params);
-                }
-            }
+            /* The commitment computed from the unopened party's (bogus) seed
+             * is replaced below */
+            commitSeeds(&C[t], getLeaves(seeds[t]), sig->salt, t, params);
             if (last != unopened) {
                 commit(C[t].hashes[last], getLeaf(seeds[t], last), sig->proofs[t].aux, sig->salt, t, last, params);
             }
@@ -790,14 +828,12 @@ int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* pl
 
 
     /* Commit to the commitments */
-    allocateCommitments2(&Ch, params, params->numMPCRounds);
-    for (size_t t = 0; t < params->numMPCRounds; t++) {
-        commit_h(Ch.hashes[t], &C[t], params);
-    }
+    allocateCommitments2(&Ch, params, params->numMPCRounds, arena);
+    commit_h_all(&Ch, C, params);
 
     /* Commit to the views */
-    allocateCommitments2(&Cv, params, params->numMPCRounds);
-    shares_t* mask_shares = allocateShares(params->stateSizeBits);
+    allocateCommitments2(&Cv, params, params->numMPCRounds, arena);
+    shares_t* mask_shares = allocateShares(params->stateSizeBits, arena);
     for (size_t t = 0; t < params->numMPCRounds; t++) {
         if (contains(sig->challengeC, params->numOpenedRounds, t)) {
             /* 2. When t is in C, we have everything we need to re-compute the view, as an honest signer would.
@@ -812,11 +848,10 @@ int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* pl
             msgs[t].unopened = unopened;
 
             tapesToWords(mask_shares, &tapes[t]);
-            int ret = simulateOnline((uint32_t*)sig->proofs[t].input, mask_shares, &tapes[t], &msgs[t], plaintext, pubKey, params);
+            ret = simulateOnline((uint32_t*)sig->proofs[t].input, mask_shares, &tapes[t], &msgs[t], plaintext, pubKey, params);
             if (ret != 0) {
                 printf("MPC simulation failed for round %lu, signature invalid\n", t);
                 ret = -1;
-                freeShares(mask_shares);
                 goto Exit;
             }
             commit_v(Cv.hashes[t], sig->proofs[t].input, &msgs[t], params);
@@ -825,12 +860,10 @@ int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* pl
             Cv.hashes[t] = NULL;
         }
     }
-    freeShares(mask_shares);
 
     size_t missingLeavesSize = params->numMPCRounds - params->numOpenedRounds;
-    uint16_t* missingLeaves = getMissingLeavesList(sig->challengeC, params);
+    uint16_t* missingLeaves = getMissingLeavesList(sig->challengeC, params, arena);
     ret = addMerkleNodes(treeCv, missingLeaves, missingLeavesSize, sig->cvInfo, sig->cvInfoLen);
-    free(missingLeaves);
     if (ret != 0) {
         ret = -1;
         goto Exit;
@@ -857,21 +890,6 @@ int verify_picnic2(signature2_t* sig, const uint32_t* pubKey, const uint32_t* pl
 
 Exit:
 
-    free(challengeC);
-    free(challengeP);
-    freeCommitments(C);
-    freeCommitments2(&Cv);
-    freeCommitments2(&Ch);
-    freeMsgs(msgs);
-    freeTree(treeCv);
-    freeTree(iSeedsTree);
-    for (size_t t = 0; t < params->numMPCRounds; t++) {
-        freeRandomTape(&tapes[t]);
-        freeTree(seeds[t]);
-    }
-    free(seeds);
-    free(tapes);
-
     return ret;
 }
 
@@ -891,22 +909,21 @@ static void computeSaltAndRootSeed(uint8_t* saltAndRoot, size_t saltAndRootLengt
 }
 
 int sign_picnic2(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, const uint8_t* message,
-                 size_t messageByteLength, signature2_t* sig, paramset_t* params)
+                 size_t messageByteLength, signature2_t* sig, paramset_t* params, picnic_arena_t* arena)
 {
     int ret = 0;
-    uint8_t* saltAndRoot = malloc(params->saltSizeBytes + params->seedSizeBytes);
+    uint8_t* saltAndRoot = arenaAlloc(arena, params->saltSizeBytes + params->seedSizeBytes);
 
     computeSaltAndRootSeed(saltAndRoot, params->saltSizeBytes + params->seedSizeBytes, privateKey, pubKey, plaintext, message, messageByteLength, params);
     memcpy(sig->salt, saltAndRoot, params->saltSizeBytes);
-    tree_t* iSeedsTree = generateSeeds(params->numMPCRounds, saltAndRoot + params->saltSizeBytes, sig->salt, 0, params);
+    tree_t* iSeedsTree = generateSeeds(params->numMPCRounds, saltAndRoot + params->saltSizeBytes, sig->salt, 0, params, arena);
     uint8_t** iSeeds = getLeaves(iSeedsTree);
-    free(saltAndRoot);
 
-    randomTape_t* tapes = malloc(params->numMPCRounds * sizeof(randomTape_t));
-    tree_t** seeds = malloc(params->numMPCRounds * sizeof(tree_t*));
+    randomTape_t* tapes = arenaAlloc(arena, params->numMPCRounds * sizeof(randomTape_t));
+    tree_t** seeds = arenaAlloc(arena, params->numMPCRounds * sizeof(tree_t*));
     for (size_t t = 0; t < params->numMPCRounds; t++) {
-        seeds[t] = generateSeeds(params->numMPCParties, iSeeds[t], sig->salt, t, params);
-        createRandomTapes(&tapes[t], getLeaves(seeds[t]), sig->salt, t, params);
+        seeds[t] = generateSeeds(params->numMPCParties, iSeeds[t], sig->salt, t, params, arena);
+        createRandomTapes(&tapes[t], getLeaves(seeds[t]), sig->salt, t, params, arena);
     }
 
     /* Preprocessing; compute aux tape for the N-th player, for each parallel rep */
@@ -916,20 +933,18 @@ int sign_picnic2(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, co
     }
 
     /* Commit to seeds and aux bits */
-    commitments_t* C = allocateCommitments(params, 0);
+    commitments_t* C = allocateCommitments(params, 0, arena);
     for (size_t t = 0; t < params->numMPCRounds; t++) {
-        for (size_t j = 0; j < params->numMPCParties - 1; j++) {
-            commit(C[t].hashes[j], getLeaf(seeds[t], j), NULL, sig->salt, t, j, params);
-        }
+        commitSeeds(&C[t], getLeaves(seeds[t]), sig->salt, t, params);
         size_t last = params->numMPCParties - 1;
         getAuxBits(auxBits, &tapes[t], params);
         commit(C[t].hashes[last], getLeaf(seeds[t], last), auxBits, sig->salt, t, last, params);
     }
 
     /* Simulate the online phase of the MPC */
-    inputs_t inputs = allocateInputs(params);
-    msgs_t* msgs = allocateMsgs(params);
-    shares_t* mask_shares = allocateShares(params->stateSizeBits);
+    inputs_t inputs = allocateInputs(params, arena);
+    msgs_t* msgs = allocateMsgs(params, arena);
+    shares_t* mask_shares = allocateShares(params->stateSizeBits, arena);
     for (size_t t = 0; t < params->numMPCRounds; t++) {
         uint32_t* maskedKey = (uint32_t*)inputs[t];
 
@@ -943,20 +958,19 @@ int sign_picnic2(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, co
             ret = -1;
         }
     }
-    freeShares(mask_shares);
 
     /* Commit to the commitments and views */
     commitments_t Ch;
-    allocateCommitments2(&Ch, params, params->numMPCRounds);
+    allocateCommitments2(&Ch, params, params->numMPCRounds, arena);
     commitments_t Cv;
-    allocateCommitments2(&Cv, params, params->numMPCRounds);
+    allocateCommitments2(&Cv, params, params->numMPCRounds, arena);
+    commit_h_all(&Ch, C, params);
     for (size_t t = 0; t < params->numMPCRounds; t++) {
-        commit_h(Ch.hashes[t], &C[t], params);
         commit_v(Cv.hashes[t], inputs[t], &msgs[t], params);
     }
 
     /* Create a Merkle tree with Cv as the leaves */
-    tree_t* treeCv = createTree(params->numMPCRounds, params->digestSizeBytes);
+    tree_t* treeCv = createTree(params->numMPCRounds, params->digestSizeBytes, arena);
     buildMerkleTree(treeCv, Cv.hashes, sig->salt, params);
 
     /* Compute the challenge; two lists of integers */
@@ -967,12 +981,11 @@ int sign_picnic2(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, co
     /* Send information required for checking commitments with Merkle tree.
      * The commitments the verifier will be missing are those not in challengeC. */
     size_t missingLeavesSize = params->numMPCRounds - params->numOpenedRounds;
-    uint16_t* missingLeaves = getMissingLeavesList(challengeC, params);
+    uint16_t* missingLeaves = getMissingLeavesList(challengeC, params, arena);
     size_t cvInfoLen = 0;
     uint8_t* cvInfo = openMerkleTree(treeCv, missingLeaves, missingLeavesSize, &cvInfoLen);
     sig->cvInfo = cvInfo;
     sig->cvInfoLen = cvInfoLen;
-    free(missingLeaves);
 
     /* Reveal iSeeds for unopned rounds, those in {0..T-1} \ ChallengeC. */
     sig->iSeedInfo = malloc(params->numMPCRounds * params->seedSizeBytes);
@@ -1021,21 +1034,6 @@ int sign_picnic2(uint32_t* privateKey, uint32_t* pubKey, uint32_t* plaintext, co
 
 #endif
 
-    for (size_t t = 0; t < params->numMPCRounds; t++) {
-        freeRandomTape(&tapes[t]);
-        freeTree(seeds[t]);
-    }
-    free(tapes);
-    free(seeds);
-    freeTree(iSeedsTree);
-    freeTree(treeCv);
-
-    freeCommitments(C);
-    freeCommitments2(&Ch);
-    freeCommitments2(&Cv);
-    freeInputs(inputs);
-    freeMsgs(msgs);
-
     return ret;
 
 }
@@ -1111,7 +1109,7 @@ int deserializeSignature2(signature2_t* sig, const uint8_t* sigBytes, size_t sig
 
     /* Add the size of the Cv Merkle tree data */
     size_t missingLeavesSize = params->numMPCRounds - params->numOpenedRounds;
-    uint16_t* missingLeaves = getMissingLeavesList(sig->challengeC, params);
+    uint16_t* missingLeaves = getMissingLeavesList(sig->challengeC, params, NULL);
     sig->cvInfoLen = openMerkleTreeSize(params->numMPCRounds, missingLeaves, missingLeavesSize, params);
     bytesRequired += sig->cvInfoLen;
     free(missingLeaves);
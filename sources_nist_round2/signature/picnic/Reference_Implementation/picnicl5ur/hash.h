@@ -14,8 +14,12 @@
 
 #ifndef SUPERCOP
 #include "sha3/KeccakHash.h"
+#include "sha3/KeccakP-1600-times4-SnP.h"
+#include "sha3/align.h"
 #else
 #include <libkeccak.a.headers/KeccakHash.h>
+#include <libkeccak.a.headers/KeccakP-1600-times4-SnP.h>
+#include <libkeccak.a.headers/align.h>
 #endif
 #include "picnic_impl.h"
 
@@ -48,4 +52,19 @@ uint16_t toLittleEndian(uint16_t x);
 void HashUpdateIntLE(HashInstance* ctx, uint16_t x);
 uint16_t fromLittleEndian(uint16_t x);
 
+/* Four SHAKE instances computed in parallel. The four inputs must have the
+ * same length at each step, and all four outputs are squeezed together; the
+ * output of each instance is the same as with the functions above. */
+typedef struct HashInstancex4 {
+    ALIGN(KeccakP1600times4_statesAlignment) uint8_t states[KeccakP1600times4_statesSizeInBytes];
+    unsigned int rate;          // In bytes
+    unsigned int byteIOIndex;   // Position in the current block, while absorbing or squeezing
+} HashInstancex4;
+
+void HashInit4(HashInstancex4* ctx, paramset_t* params, uint8_t hashPrefix);
+void HashUpdate4(HashInstancex4* ctx, const uint8_t** data, size_t byteLen);
+void HashUpdateIntLE4(HashInstancex4* ctx, const uint16_t* x);
+void HashFinal4(HashInstancex4* ctx);
+void HashSqueeze4(HashInstancex4* ctx, uint8_t** digest, size_t byteLen);
+
 #endif /* HASH_H */
@@ -58,12 +58,36 @@ typedef struct shares_t {
 
 
 
+/* A bump allocator for the working memory of one sign or verify operation.
+ * Memory taken from an arena is zeroed, and is released all at once by
+ * resetArena or freeArena; objects allocated from an arena must not be passed
+ * to their free function. An arena is not thread-safe.
+ * The allocate functions below take an arena as their last argument, and use
+ * the heap when it is NULL. */
+typedef struct picnic_arena_t {
+    uint8_t* base;
+    size_t size;
+    size_t used;
+    void** overflow;        // Heap blocks, allocated once the arena is full
+    size_t numOverflow;
+} picnic_arena_t;
+
 #define UNUSED_PARAMETER(x) (void)(x)
 
-void allocateView(view_t* view, paramset_t* params);
+/* Arena size needed to sign or verify with the given parameters */
+size_t arenaSize(paramset_t* params);
+/* Returns 0 on success, -1 on failure */
+int createArena(picnic_arena_t* arena, size_t size);
+/* Zeroed memory from the arena, or from the heap (calloc) if arena is NULL */
+void* arenaAlloc(picnic_arena_t* arena, size_t size);
+/* Zero the memory handed out so far and make it available again */
+void resetArena(picnic_arena_t* arena);
+void freeArena(picnic_arena_t* arena);
+
+void allocateView(view_t* view, paramset_t* params, picnic_arena_t* arena);
 void freeView(view_t* view);
 
-void allocateRandomTape(randomTape_t* tape, paramset_t* params);
+void allocateRandomTape(randomTape_t* tape, paramset_t* params, picnic_arena_t* arena);
 void freeRandomTape(randomTape_t* tape);
 
 void allocateProof(proof_t* proof, paramset_t* params);
@@ -75,28 +99,28 @@ void freeProof2(proof2_t* proof);
 void allocateSignature(signature_t* sig, paramset_t* params);
 void freeSignature(signature_t* sig, paramset_t* params);
 
-seeds_t* allocateSeeds(paramset_t* params);
+seeds_t* allocateSeeds(paramset_t* params, picnic_arena_t* arena);
 void freeSeeds(seeds_t* seeds);
 
-commitments_t* allocateCommitments(paramset_t* params, size_t nCommitments);
+commitments_t* allocateCommitments(paramset_t* params, size_t nCommitments, picnic_arena_t* arena);
 void freeCommitments(commitments_t* commitments);
 
-void allocateCommitments2(commitments_t* commitments, paramset_t* params, size_t nCommitments);
+void allocateCommitments2(commitments_t* commitments, paramset_t* params, size_t nCommitments, picnic_arena_t* arena);
 void freeCommitments2(commitments_t* commitments);
 
-inputs_t allocateInputs(paramset_t* params);
+inputs_t allocateInputs(paramset_t* params, picnic_arena_t* arena);
 void freeInputs(inputs_t inputs);
 
-msgs_t* allocateMsgs(paramset_t* params);
+msgs_t* allocateMsgs(paramset_t* params, picnic_arena_t* arena);
 void freeMsgs(msgs_t* msgs);
 
-shares_t* allocateShares(size_t count);
+shares_t* allocateShares(size_t count, picnic_arena_t* arena);
 void freeShares(shares_t* shares);
 
-view_t** allocateViews(paramset_t* params);
+view_t** allocateViews(paramset_t* params, picnic_arena_t* arena);
 void freeViews(view_t** views, paramset_t* params);
 
-g_commitments_t* allocateGCommitments(paramset_t* params);
+g_commitments_t* allocateGCommitments(paramset_t* params, picnic_arena_t* arena);
 void freeGCommitments(g_commitments_t* gs);
 
 #endif /* PICNIC_TYPES_H */
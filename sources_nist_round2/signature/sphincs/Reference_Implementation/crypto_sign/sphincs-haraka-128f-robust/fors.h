@@ -4,15 +4,36 @@
 #include <stdint.h>
 
 #include "params.h"
+#include "context.h"
+
+/* Bytes of a FORS signature that belong to a single tree. */
+#define SPX_FORS_TREE_BYTES ((SPX_FORS_HEIGHT + 1) * SPX_N)
 
 /**
- * Signs a message m, deriving the secret key from sk_seed and the FTS address.
+ * Signs the tree_idx-th of the SPX_FORS_TREES trees for the message m,
+ * writing its SPX_FORS_TREE_BYTES bytes of the signature to sig and its root
+ * to root. The trees are independent, so they can be signed in any order.
+ * Assumes m contains at least SPX_FORS_HEIGHT * SPX_FORS_TREES bits.
+ */
+void fors_sign_tree(unsigned char *sig, unsigned char *root,
+                    const unsigned char *m, unsigned int tree_idx,
+                    const spx_ctx *ctx, const uint32_t fors_addr[8]);
+
+/**
+ * Derives the FORS public key from the SPX_FORS_TREES roots computed by
+ * fors_sign_tree, concatenated in order of tree_idx.
+ */
+void fors_roots_to_pk(unsigned char *pk, const unsigned char *roots,
+                      const spx_ctx *ctx, const uint32_t fors_addr[8]);
+
+/**
+ * Signs a message m, deriving the secret key from the sk_seed in ctx and the
+ * FTS address.
  * Assumes m contains at least SPX_FORS_HEIGHT * SPX_FORS_TREES bits.
  */
 void fors_sign(unsigned char *sig, unsigned char *pk,
                const unsigned char *m,
-               const unsigned char *sk_seed, const unsigned char *pub_seed,
-               const uint32_t fors_addr[8]);
+               const spx_ctx *ctx, const uint32_t fors_addr[8]);
 
 /**
  * Derives the FORS public key from a signature.
@@ -23,7 +44,15 @@ void fors_sign(unsigned char *sig, unsigned char *pk,
  */
 void fors_pk_from_sig(unsigned char *pk,
                       const unsigned char *sig, const unsigned char *m,
-                      const unsigned char *pub_seed,
-                      const uint32_t fors_addr[8]);
+                      const spx_ctx *ctx, const uint32_t fors_addr[8]);
+
+/**
+ * Four instances of fors_pk_from_sig, for the signatures sig[j], messages
+ * m[j] and addresses fors_addrx4 + 8*j, hashing the four side by side.
+ * Writes the public keys to pk[j].
+ */
+void fors_pk_from_sigx4(unsigned char *pk[4],
+                        const unsigned char *sig[4], const unsigned char *m[4],
+                        const spx_ctx *ctx, const uint32_t fors_addrx4[4*8]);
 
 #endif
@@ -8,6 +8,21 @@ Plain C implementation of the Haraka256 and Haraka512 permutations.
 
 #include "haraka.h"
 
+/* The AES-NI code is compiled in on x86 with gcc or clang and used when the
+   CPU supports it, so the default build stays portable. Defining
+   SPX_NO_SIMD_DISPATCH leaves only the portable code. */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) \
+    && !defined(SPX_NO_SIMD_DISPATCH)
+#define SPX_HARAKA_AESNI
+#include <wmmintrin.h>
+
+/* Cleared by test/haraka.c to compute reference values with the portable
+   code. */
+static int haraka_use_aesni = 1;
+
+#define HAS_AESNI() (haraka_use_aesni && __builtin_cpu_supports("aes"))
+#endif
+
 #define HARAKAS_RATE 32
 
 static const unsigned char haraka_rc[40][16] = {
@@ -53,9 +68,6 @@ static const unsigned char haraka_rc[40][16] = {
     {0xa1, 0x9d, 0xc5, 0xe9, 0xfd, 0xbd, 0xd6, 0x4a, 0x88, 0x82, 0x28, 0x02, 0x03, 0xcc, 0x6a, 0x75}
 };
 
-static unsigned char rc[40][16];
-static unsigned char rc_sseed[40][16];
-
 static const unsigned char sbox[256] =
 { 0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe,
   0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4,
@@ -122,28 +134,35 @@ void unpackhi32(unsigned char *t, unsigned char *a, unsigned char *b)
     memcpy(t, tmp, 16);
 }
 
-void tweak_constants(const unsigned char *pk_seed, const unsigned char *sk_seed,
-                     unsigned long long seed_length)
+void tweak_constants(spx_ctx *ctx)
 {
     unsigned char buf[40*16];
 
     /* Use the standard constants to generate tweaked ones. */
-    memcpy(rc, haraka_rc, 40*16);
+    memcpy(ctx->rc, haraka_rc, 40*16);
 
     /* Constants for sk.seed */
-    if (sk_seed != NULL) {
-        haraka_S(buf, 40*16, sk_seed, seed_length);
-        memcpy(rc_sseed, buf, 40*16);
-    }
+    haraka_S(buf, 40*16, ctx->sk_seed, SPX_N, ctx);
+    memcpy(ctx->rc_sseed, buf, 40*16);
 
     /* Constants for pk.seed */
-    haraka_S(buf, 40*16, pk_seed, seed_length);
-    memcpy(rc, buf, 40*16);
+    tweak_constants_public(ctx);
+}
+
+void tweak_constants_public(spx_ctx *ctx)
+{
+    unsigned char buf[40*16];
+
+    /* Use the standard constants to generate tweaked ones. */
+    memcpy(ctx->rc, haraka_rc, 40*16);
+
+    haraka_S(buf, 40*16, ctx->pub_seed, SPX_N, ctx);
+    memcpy(ctx->rc, buf, 40*16);
 }
 
 static void haraka_S_absorb(unsigned char *s, unsigned int r,
                             const unsigned char *m, unsigned long long mlen,
-                            unsigned char p)
+                            unsigned char p, const spx_ctx *ctx)
 {
     unsigned long long i;
     unsigned char t[r];
@@ -153,7 +172,7 @@ static void haraka_S_absorb(unsigned char *s, unsigned int r,
         for (i = 0; i < r; ++i) {
             s[i] ^= m[i];
         }
-        haraka512_perm(s, s);
+        haraka512_perm(s, s, ctx);
         mlen -= r;
         m += r;
     }
@@ -172,10 +191,11 @@ static void haraka_S_absorb(unsigned char *s, unsigned int r,
 }
 
 static void haraka_S_squeezeblocks(unsigned char *h, unsigned long long nblocks,
-                                   unsigned char *s, unsigned int r)
+                                   unsigned char *s, unsigned int r,
+                                   const spx_ctx *ctx)
 {
     while (nblocks > 0) {
-        haraka512_perm(s, s);
+        haraka512_perm(s, s, ctx);
         memcpy(h, s, HARAKAS_RATE);
         h += r;
         nblocks--;
@@ -192,7 +212,8 @@ void haraka_S_inc_init(uint8_t *s_inc)
     s_inc[64] = 0;
 }
 
-void haraka_S_inc_absorb(uint8_t *s_inc, const uint8_t *m, size_t mlen)
+void haraka_S_inc_absorb(uint8_t *s_inc, const uint8_t *m, size_t mlen,
+                         const spx_ctx *ctx)
 {
     size_t i;
 
@@ -207,7 +228,7 @@ void haraka_S_inc_absorb(uint8_t *s_inc, const uint8_t *m, size_t mlen)
         m += HARAKAS_RATE - s_inc[64];
         s_inc[64] = 0;
 
-        haraka512_perm(s_inc, s_inc);
+        haraka512_perm(s_inc, s_inc, ctx);
     }
 
     for (i = 0; i < mlen; i++) {
@@ -225,7 +246,8 @@ void haraka_S_inc_finalize(uint8_t *s_inc)
     s_inc[64] = 0;
 }
 
-void haraka_S_inc_squeeze(uint8_t *out, size_t outlen, uint8_t *s_inc)
+void haraka_S_inc_squeeze(uint8_t *out, size_t outlen, uint8_t *s_inc,
+                          const spx_ctx *ctx)
 {
     size_t i;
 
@@ -241,7 +263,7 @@ void haraka_S_inc_squeeze(uint8_t *out, size_t outlen, uint8_t *s_inc)
 
     /* Then squeeze the remaining necessary blocks */
     while (outlen > 0) {
-        haraka512_perm(s_inc, s_inc);
+        haraka512_perm(s_inc, s_inc, ctx);
 
         for (i = 0; i < outlen && i < HARAKAS_RATE; i++) {
             out[i] = s_inc[i];
@@ -253,7 +275,8 @@ void haraka_S_inc_squeeze(uint8_t *out, size_t outlen, uint8_t *s_inc)
 }
 
 void haraka_S(unsigned char *out, unsigned long long outlen,
-              const unsigned char *in, unsigned long long inlen)
+              const unsigned char *in, unsigned long long inlen,
+              const spx_ctx *ctx)
 {
     unsigned long long i;
     unsigned char s[64];
@@ -262,25 +285,186 @@ void haraka_S(unsigned char *out, unsigned long long outlen,
     for (i = 0; i < 64; i++) {
         s[i] = 0;
     }
-    haraka_S_absorb(s, 32, in, inlen, 0x1F);
+    haraka_S_absorb(s, 32, in, inlen, 0x1F, ctx);
 
-    haraka_S_squeezeblocks(out, outlen / 32, s, 32);
+    haraka_S_squeezeblocks(out, outlen / 32, s, 32, ctx);
     out += (outlen / 32) * 32;
 
     if (outlen % 32) {
-        haraka_S_squeezeblocks(d, 1, s, 32);
+        haraka_S_squeezeblocks(d, 1, s, 32, ctx);
         for (i = 0; i < outlen % 32; i++) {
             out[i] = d[i];
         }
     }
 }
 
-void haraka512_perm(unsigned char *out, const unsigned char *in)
+void haraka_Sx4(unsigned char *out0, unsigned char *out1,
+                unsigned char *out2, unsigned char *out3,
+                unsigned long long outlen,
+                const unsigned char *in0, const unsigned char *in1,
+                const unsigned char *in2, const unsigned char *in3,
+                unsigned long long inlen, const spx_ctx *ctx)
+{
+    const unsigned char *in[4] = { in0, in1, in2, in3 };
+    unsigned char *out[4] = { out0, out1, out2, out3 };
+    unsigned long long i, n;
+    unsigned int j;
+    unsigned char s[4*64];
+    unsigned char t[HARAKAS_RATE];
+
+    for (i = 0; i < 4*64; i++) {
+        s[i] = 0;
+    }
+
+    /* Absorb */
+    while (inlen >= HARAKAS_RATE) {
+        for (j = 0; j < 4; j++) {
+            for (i = 0; i < HARAKAS_RATE; i++) {
+                s[64*j + i] ^= in[j][i];
+            }
+            in[j] += HARAKAS_RATE;
+        }
+        haraka512_perm_x4(s, s, ctx);
+        inlen -= HARAKAS_RATE;
+    }
+
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < HARAKAS_RATE; i++) {
+            t[i] = 0;
+        }
+        for (i = 0; i < inlen; i++) {
+            t[i] = in[j][i];
+        }
+        t[i] = 0x1F;
+        t[HARAKAS_RATE - 1] |= 128;
+        for (i = 0; i < HARAKAS_RATE; i++) {
+            s[64*j + i] ^= t[i];
+        }
+    }
+
+    /* Squeeze */
+    while (outlen > 0) {
+        haraka512_perm_x4(s, s, ctx);
+        n = outlen < HARAKAS_RATE ? outlen : HARAKAS_RATE;
+        for (j = 0; j < 4; j++) {
+            memcpy(out[j], s + 64*j, n);
+            out[j] += n;
+        }
+        outlen -= n;
+    }
+}
+
+#ifdef SPX_HARAKA_AESNI
+/* The permutation of haraka512_perm with the round constants rcs, applied
+   with AES-NI to the n <= 4 consecutive 64-byte inputs at in. The AES rounds
+   of different inputs are independent, which lets them overlap in the
+   pipeline. */
+__attribute__((target("aes,sse2")))
+static void haraka512_perm_aesni(unsigned char *out, const unsigned char *in,
+                                 unsigned int n,
+                                 const unsigned char rcs[40][16])
+{
+    unsigned int i, j, k, l;
+
+    __m128i s[4][4], rk, tmp;
+
+    for (k = 0; k < n; ++k) {
+        for (l = 0; l < 4; ++l) {
+            s[k][l] = _mm_loadu_si128((const __m128i *)(in + 64*k + 16*l));
+        }
+    }
+
+    for (i = 0; i < 5; ++i) {
+        // aes round(s)
+        for (j = 0; j < 2; ++j) {
+            for (l = 0; l < 4; ++l) {
+                rk = _mm_loadu_si128((const __m128i *)rcs[4*2*i + 4*j + l]);
+                for (k = 0; k < n; ++k) {
+                    s[k][l] = _mm_aesenc_si128(s[k][l], rk);
+                }
+            }
+        }
+
+        // mixing
+        for (k = 0; k < n; ++k) {
+            tmp = _mm_unpacklo_epi32(s[k][0], s[k][1]);
+            s[k][0] = _mm_unpackhi_epi32(s[k][0], s[k][1]);
+            s[k][1] = _mm_unpacklo_epi32(s[k][2], s[k][3]);
+            s[k][2] = _mm_unpackhi_epi32(s[k][2], s[k][3]);
+            s[k][3] = _mm_unpacklo_epi32(s[k][0], s[k][2]);
+            s[k][0] = _mm_unpackhi_epi32(s[k][0], s[k][2]);
+            s[k][2] = _mm_unpackhi_epi32(s[k][1], tmp);
+            s[k][1] = _mm_unpacklo_epi32(s[k][1], tmp);
+        }
+    }
+
+    for (k = 0; k < n; ++k) {
+        for (l = 0; l < 4; ++l) {
+            _mm_storeu_si128((__m128i *)(out + 64*k + 16*l), s[k][l]);
+        }
+    }
+}
+
+/* Haraka-256 with the round constants rcs, applied with AES-NI to the
+   n <= 4 consecutive 32-byte inputs at in. */
+__attribute__((target("aes,sse2")))
+static void haraka256_aesni(unsigned char *out, const unsigned char *in,
+                            unsigned int n, const unsigned char rcs[40][16])
+{
+    unsigned int i, j, k, l;
+
+    __m128i s[4][2], rk, tmp;
+
+    for (k = 0; k < n; ++k) {
+        for (l = 0; l < 2; ++l) {
+            s[k][l] = _mm_loadu_si128((const __m128i *)(in + 32*k + 16*l));
+        }
+    }
+
+    for (i = 0; i < 5; ++i) {
+        // aes round(s)
+        for (j = 0; j < 2; ++j) {
+            for (l = 0; l < 2; ++l) {
+                rk = _mm_loadu_si128((const __m128i *)rcs[2*2*i + 2*j + l]);
+                for (k = 0; k < n; ++k) {
+                    s[k][l] = _mm_aesenc_si128(s[k][l], rk);
+                }
+            }
+        }
+
+        // mixing
+        for (k = 0; k < n; ++k) {
+            tmp = _mm_unpacklo_epi32(s[k][0], s[k][1]);
+            s[k][1] = _mm_unpackhi_epi32(s[k][0], s[k][1]);
+            s[k][0] = tmp;
+        }
+    }
+
+    /* Feed-forward */
+    for (k = 0; k < n; ++k) {
+        for (l = 0; l < 2; ++l) {
+            tmp = _mm_loadu_si128((const __m128i *)(in + 32*k + 16*l));
+            _mm_storeu_si128((__m128i *)(out + 32*k + 16*l),
+                             _mm_xor_si128(s[k][l], tmp));
+        }
+    }
+}
+#endif
+
+void haraka512_perm(unsigned char *out, const unsigned char *in,
+                    const spx_ctx *ctx)
 {
     int i, j;
 
     unsigned char s[64], tmp[16];
 
+#ifdef SPX_HARAKA_AESNI
+    if (HAS_AESNI()) {
+        haraka512_perm_aesni(out, in, 1, ctx->rc);
+        return;
+    }
+#endif
+
     memcpy(s, in, 16);
     memcpy(s + 16, in + 16, 16);
     memcpy(s + 32, in + 32, 16);
@@ -289,10 +473,10 @@ void haraka512_perm(unsigned char *out, const unsigned char *in)
     for (i = 0; i < 5; ++i) {
         // aes round(s)
         for (j = 0; j < 2; ++j) {
-            aesenc(s, rc[4*2*i + 4*j]);
-            aesenc(s + 16, rc[4*2*i + 4*j + 1]);
-            aesenc(s + 32, rc[4*2*i + 4*j + 2]);
-            aesenc(s + 48, rc[4*2*i + 4*j + 3]);
+            aesenc(s, ctx->rc[4*2*i + 4*j]);
+            aesenc(s + 16, ctx->rc[4*2*i + 4*j + 1]);
+            aesenc(s + 32, ctx->rc[4*2*i + 4*j + 2]);
+            aesenc(s + 48, ctx->rc[4*2*i + 4*j + 3]);
         }
 
         // mixing
@@ -309,13 +493,30 @@ void haraka512_perm(unsigned char *out, const unsigned char *in)
     memcpy(out, s, 64);
 }
 
-void haraka512(unsigned char *out, const unsigned char *in)
+void haraka512_perm_x4(unsigned char *out, const unsigned char *in,
+                       const spx_ctx *ctx)
+{
+    int i;
+
+#ifdef SPX_HARAKA_AESNI
+    if (HAS_AESNI()) {
+        haraka512_perm_aesni(out, in, 4, ctx->rc);
+        return;
+    }
+#endif
+
+    for (i = 0; i < 4; i++) {
+        haraka512_perm(out + 64*i, in + 64*i, ctx);
+    }
+}
+
+void haraka512(unsigned char *out, const unsigned char *in, const spx_ctx *ctx)
 {
     int i;
 
     unsigned char buf[64];
 
-    haraka512_perm(buf, in);
+    haraka512_perm(buf, in, ctx);
     /* Feed-forward */
     for (i = 0; i < 64; i++) {
         buf[i] = buf[i] ^ in[i];
@@ -328,21 +529,50 @@ void haraka512(unsigned char *out, const unsigned char *in)
     memcpy(out + 24, buf + 48, 8);
 }
 
+void haraka512x4(unsigned char *out, const unsigned char *in,
+                 const spx_ctx *ctx)
+{
+    int i, j;
+
+    unsigned char buf[4*64];
 
-void haraka256(unsigned char *out, const unsigned char *in)
+    haraka512_perm_x4(buf, in, ctx);
+    for (j = 0; j < 4; j++) {
+        /* Feed-forward */
+        for (i = 0; i < 64; i++) {
+            buf[64*j + i] = buf[64*j + i] ^ in[64*j + i];
+        }
+
+        /* Truncated */
+        memcpy(out + 32*j,      buf + 64*j + 8, 8);
+        memcpy(out + 32*j + 8,  buf + 64*j + 24, 8);
+        memcpy(out + 32*j + 16, buf + 64*j + 32, 8);
+        memcpy(out + 32*j + 24, buf + 64*j + 48, 8);
+    }
+}
+
+
+void haraka256(unsigned char *out, const unsigned char *in, const spx_ctx *ctx)
 {
     int i, j;
 
     unsigned char s[32], tmp[16];
 
+#ifdef SPX_HARAKA_AESNI
+    if (HAS_AESNI()) {
+        haraka256_aesni(out, in, 1, ctx->rc);
+        return;
+    }
+#endif
+
     memcpy(s, in, 16);
     memcpy(s + 16, in + 16, 16);
 
     for (i = 0; i < 5; ++i) {
         // aes round(s)
         for (j = 0; j < 2; ++j) {
-            aesenc(s, rc[2*2*i + 2*j]);
-            aesenc(s + 16, rc[2*2*i + 2*j + 1]);
+            aesenc(s, ctx->rc[2*2*i + 2*j]);
+            aesenc(s + 16, ctx->rc[2*2*i + 2*j + 1]);
         }
 
         // mixing
@@ -357,20 +587,45 @@ void haraka256(unsigned char *out, const unsigned char *in)
     }
 }
 
-void haraka256_sk(unsigned char *out, const unsigned char *in)
+void haraka256x4(unsigned char *out, const unsigned char *in,
+                 const spx_ctx *ctx)
+{
+    int i;
+
+#ifdef SPX_HARAKA_AESNI
+    if (HAS_AESNI()) {
+        haraka256_aesni(out, in, 4, ctx->rc);
+        return;
+    }
+#endif
+
+    for (i = 0; i < 4; i++) {
+        haraka256(out + 32*i, in + 32*i, ctx);
+    }
+}
+
+void haraka256_sk(unsigned char *out, const unsigned char *in,
+                  const spx_ctx *ctx)
 {
     int i, j;
 
     unsigned char s[32], tmp[16];
 
+#ifdef SPX_HARAKA_AESNI
+    if (HAS_AESNI()) {
+        haraka256_aesni(out, in, 1, ctx->rc_sseed);
+        return;
+    }
+#endif
+
     memcpy(s, in, 16);
     memcpy(s + 16, in + 16, 16);
 
     for (i = 0; i < 5; ++i) {
         // aes round(s)
         for (j = 0; j < 2; ++j) {
-            aesenc(s, rc_sseed[2*2*i + 2*j]);
-            aesenc(s + 16, rc_sseed[2*2*i + 2*j + 1]);
+            aesenc(s, ctx->rc_sseed[2*2*i + 2*j]);
+            aesenc(s + 16, ctx->rc_sseed[2*2*i + 2*j + 1]);
         }
 
         // mixing
@@ -384,3 +639,20 @@ void haraka256_sk(unsigned char *out, const unsigned char *in)
         out[i] = in[i] ^ s[i];
     }
 }
+
+void haraka256_skx4(unsigned char *out, const unsigned char *in,
+                    const spx_ctx *ctx)
+{
+    int i;
+
+#ifdef SPX_HARAKA_AESNI
+    if (HAS_AESNI()) {
+        haraka256_aesni(out, in, 4, ctx->rc_sseed);
+        return;
+    }
+#endif
+
+    for (i = 0; i < 4; i++) {
+        haraka256_sk(out + 32*i, in + 32*i, ctx);
+    }
+}
@@ -1,28 +1,64 @@
 #ifndef SPX_HARAKA_H
 #define SPX_HARAKA_H
 
-/* Tweak constants with seed */
-void tweak_constants(const unsigned char *pk_seed, const unsigned char *sk_seed, 
-	                 unsigned long long seed_length);
+#include <stddef.h>
+#include <stdint.h>
+
+#include "context.h"
+
+/* Tweak constants with the seeds in ctx */
+void tweak_constants(spx_ctx *ctx);
+
+/* Tweak constants with pub_seed only, leaving those for sk_seed unset */
+void tweak_constants_public(spx_ctx *ctx);
 
 /* Haraka Sponge */
 void haraka_S_inc_init(uint8_t *s_inc);
-void haraka_S_inc_absorb(uint8_t *s_inc, const uint8_t *m, size_t mlen);
+void haraka_S_inc_absorb(uint8_t *s_inc, const uint8_t *m, size_t mlen,
+                         const spx_ctx *ctx);
 void haraka_S_inc_finalize(uint8_t *s_inc);
-void haraka_S_inc_squeeze(uint8_t *out, size_t outlen, uint8_t *s_inc);
+void haraka_S_inc_squeeze(uint8_t *out, size_t outlen, uint8_t *s_inc,
+                          const spx_ctx *ctx);
 void haraka_S(unsigned char *out, unsigned long long outlen,
-              const unsigned char *in, unsigned long long inlen);
+              const unsigned char *in, unsigned long long inlen,
+              const spx_ctx *ctx);
+
+/* Four instances of haraka_S on inputs of equal length. */
+void haraka_Sx4(unsigned char *out0, unsigned char *out1,
+                unsigned char *out2, unsigned char *out3,
+                unsigned long long outlen,
+                const unsigned char *in0, const unsigned char *in1,
+                const unsigned char *in2, const unsigned char *in3,
+                unsigned long long inlen, const spx_ctx *ctx);
 
 /* Applies the 512-bit Haraka permutation to in. */
-void haraka512_perm(unsigned char *out, const unsigned char *in);
+void haraka512_perm(unsigned char *out, const unsigned char *in,
+                    const spx_ctx *ctx);
+
+/* Applies the 512-bit Haraka permutation to four consecutive 64-byte inputs. */
+void haraka512_perm_x4(unsigned char *out, const unsigned char *in,
+                       const spx_ctx *ctx);
 
 /* Implementation of Haraka-512 */
-void haraka512(unsigned char *out, const unsigned char *in);
+void haraka512(unsigned char *out, const unsigned char *in, const spx_ctx *ctx);
+
+/* Four instances of Haraka-512, on consecutive inputs and outputs */
+void haraka512x4(unsigned char *out, const unsigned char *in,
+                 const spx_ctx *ctx);
 
 /* Implementation of Haraka-256 */
-void haraka256(unsigned char *out, const unsigned char *in);
+void haraka256(unsigned char *out, const unsigned char *in, const spx_ctx *ctx);
+
+/* Four instances of Haraka-256, on consecutive inputs and outputs */
+void haraka256x4(unsigned char *out, const unsigned char *in,
+                 const spx_ctx *ctx);
 
 /* Implementation of Haraka-256 using sk.seed constants */
-void haraka256_sk(unsigned char *out, const unsigned char *in);
+void haraka256_sk(unsigned char *out, const unsigned char *in,
+                  const spx_ctx *ctx);
+
+/* Four instances of haraka256_sk, on consecutive inputs and outputs */
+void haraka256_skx4(unsigned char *out, const unsigned char *in,
+                    const spx_ctx *ctx);
 
 #endif
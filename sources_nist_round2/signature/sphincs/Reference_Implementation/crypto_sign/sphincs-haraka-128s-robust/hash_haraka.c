@@ -8,45 +8,70 @@
 #include "haraka.h"
 #include "hash.h"
 
-void initialize_hash_function(const unsigned char *pk_seed,
-                              const unsigned char *sk_seed)
+void initialize_hash_function(spx_ctx *ctx)
 {
-    tweak_constants(pk_seed, sk_seed, SPX_N);
+    tweak_constants(ctx);
+}
+
+void initialize_hash_function_public(spx_ctx *ctx)
+{
+    tweak_constants_public(ctx);
 }
 
 /*
- * Computes PRF(key, addr), given a secret key of SPX_N bytes and an address
+ * Computes PRF(sk_seed, addr), given the secret seed in ctx and an address
  */
-void prf_addr(unsigned char *out, const unsigned char *key,
+void prf_addr(unsigned char *out, const spx_ctx *ctx,
               const uint32_t addr[8])
 {
     unsigned char buf[SPX_ADDR_BYTES];
     /* Since SPX_N may be smaller than 32, we need a temporary buffer. */
     unsigned char outbuf[32];
 
-    (void)key; /* Suppress an 'unused parameter' warning. */
-
     addr_to_bytes(buf, addr);
-    haraka256_sk(outbuf, buf);
+    haraka256_sk(outbuf, buf, ctx);
     memcpy(out, outbuf, SPX_N);
 }
 
+/*
+ * Four instances of prf_addr, for the addresses addrx4, addrx4 + 8, etc.
+ */
+void prf_addrx4(unsigned char *out0, unsigned char *out1,
+                unsigned char *out2, unsigned char *out3,
+                const spx_ctx *ctx, const uint32_t addrx4[4*8])
+{
+    unsigned char bufx4[4*SPX_ADDR_BYTES];
+    /* Since SPX_N may be smaller than 32, we need a temporary buffer. */
+    unsigned char outbufx4[4*32];
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        addr_to_bytes(bufx4 + j*SPX_ADDR_BYTES, addrx4 + j*8);
+    }
+    haraka256_skx4(outbufx4, bufx4, ctx);
+    memcpy(out0, outbufx4, SPX_N);
+    memcpy(out1, outbufx4 + 32, SPX_N);
+    memcpy(out2, outbufx4 + 64, SPX_N);
+    memcpy(out3, outbufx4 + 96, SPX_N);
+}
+
 /**
  * Computes the message-dependent randomness R, using a secret seed and an
  * optional randomization value as well as the message.
  */
 void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
                         const unsigned char *optrand,
-                        const unsigned char *m, unsigned long long mlen)
+                        const unsigned char *m, unsigned long long mlen,
+                        const spx_ctx *ctx)
 {
     uint8_t s_inc[65];
 
     haraka_S_inc_init(s_inc);
-    haraka_S_inc_absorb(s_inc, sk_prf, SPX_N);
-    haraka_S_inc_absorb(s_inc, optrand, SPX_N);
-    haraka_S_inc_absorb(s_inc, m, mlen);
+    haraka_S_inc_absorb(s_inc, sk_prf, SPX_N, ctx);
+    haraka_S_inc_absorb(s_inc, optrand, SPX_N, ctx);
+    haraka_S_inc_absorb(s_inc, m, mlen, ctx);
     haraka_S_inc_finalize(s_inc);
-    haraka_S_inc_squeeze(R, SPX_N, s_inc);
+    haraka_S_inc_squeeze(R, SPX_N, s_inc, ctx);
 }
 
 /**
@@ -56,7 +81,8 @@ void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
  */
 void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
                   const unsigned char *R, const unsigned char *pk,
-                  const unsigned char *m, unsigned long long mlen)
+                  const unsigned char *m, unsigned long long mlen,
+                  const spx_ctx *ctx)
 {
 #define SPX_TREE_BITS (SPX_TREE_HEIGHT * (SPX_D - 1))
 #define SPX_TREE_BYTES ((SPX_TREE_BITS + 7) / 8)
@@ -69,11 +95,11 @@ void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
     uint8_t s_inc[65];
 
     haraka_S_inc_init(s_inc);
-    haraka_S_inc_absorb(s_inc, R, SPX_N);
-    haraka_S_inc_absorb(s_inc, pk, SPX_PK_BYTES);
-    haraka_S_inc_absorb(s_inc, m, mlen);
+    haraka_S_inc_absorb(s_inc, R, SPX_N, ctx);
+    haraka_S_inc_absorb(s_inc, pk, SPX_PK_BYTES, ctx);
+    haraka_S_inc_absorb(s_inc, m, mlen, ctx);
     haraka_S_inc_finalize(s_inc);
-    haraka_S_inc_squeeze(buf, SPX_DGST_BYTES, s_inc);
+    haraka_S_inc_squeeze(buf, SPX_DGST_BYTES, s_inc, ctx);
 
     memcpy(digest, bufp, SPX_FORS_MSG_BYTES);
     bufp += SPX_FORS_MSG_BYTES;
@@ -3,25 +3,32 @@
 
 #include <stdint.h>
 #include "params.h"
+#include "context.h"
 
 /**
- * WOTS key generation. Takes a 32 byte seed for the private key, expands it to
- * a full WOTS private key and computes the corresponding public key.
- * It requires the seed pub_seed (used to generate bitmasks and hash keys)
- * and the address of this WOTS key pair.
+ * WOTS key generation. Takes the secret seed in ctx, expands it to a full
+ * WOTS private key and computes the corresponding public key.
+ * It requires the seed pub_seed in ctx (used to generate bitmasks and hash
+ * keys) and the address of this WOTS key pair.
  *
  * Writes the computed public key to 'pk'.
  */
-void wots_gen_pk(unsigned char *pk, const unsigned char *seed,
-                 const unsigned char *pub_seed, uint32_t addr[8]);
+void wots_gen_pk(unsigned char *pk, const spx_ctx *ctx, uint32_t addr[8]);
 
 /**
- * Takes a n-byte message and the 32-byte seed for the private key to compute a
- * signature that is placed at 'sig'.
+ * Computes four WOTS public keys at once, as wots_gen_pk does for addrx4,
+ * addrx4 + 8, etc., hashing the four keys' chains side by side.
+ * Writes the keys to pkx4, one after the other.
+ */
+void wots_gen_pkx4(unsigned char *pkx4, const spx_ctx *ctx,
+                   uint32_t addrx4[4*8]);
+
+/**
+ * Takes a n-byte message and the secret seed in ctx to compute a signature
+ * that is placed at 'sig'.
  */
 void wots_sign(unsigned char *sig, const unsigned char *msg,
-               const unsigned char *seed, const unsigned char *pub_seed,
-               uint32_t addr[8]);
+               const spx_ctx *ctx, uint32_t addr[8]);
 
 /**
  * Takes a WOTS signature and an n-byte message, computes a WOTS public key.
@@ -30,6 +37,19 @@ void wots_sign(unsigned char *sig, const unsigned char *msg,
  */
 void wots_pk_from_sig(unsigned char *pk,
                       const unsigned char *sig, const unsigned char *msg,
-                      const unsigned char *pub_seed, uint32_t addr[8]);
+                      const spx_ctx *ctx, uint32_t addr[8]);
+
+/**
+ * Computes the WOTS public keys for the first 'count' (at most four) of the
+ * signatures sig[j] on the n-byte messages msg[j], as wots_pk_from_sig does
+ * for the address addrx4 + 8*j, hashing their chains four at a time.
+ *
+ * Writes each public key to pk[j].
+ */
+void wots_pk_from_sigx4(unsigned char *pk[4],
+                        const unsigned char *sig[4],
+                        const unsigned char *msg[4],
+                        unsigned int count,
+                        const spx_ctx *ctx, const uint32_t addrx4[4*8]);
 
 #endif
@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include "../api.h"
+#include "../params.h"
+#include "../rng.h"
+
+#define SPX_MLEN 32
+
+/* From cqcrandom.c, which the tests are linked with. */
+void randombytes_set(int (*instance)(unsigned char *, unsigned int));
+
+/* Fixes optrand, so that signatures can be compared byte for byte. */
+static int fixed_randombytes(unsigned char *x, unsigned int xlen)
+{
+    memset(x, 0x5a, xlen);
+    return 0;
+}
+
+/* With four levels or fewer per subtree, two layers are quick to compute. */
+#if SPX_TREE_HEIGHT <= 4
+    #define SPX_CACHE_LAYERS 2
+#else
+    #define SPX_CACHE_LAYERS 1
+#endif
+
+int main()
+{
+    int ret = 0;
+    unsigned long long cachelen = crypto_sign_cache_bytes(SPX_CACHE_LAYERS);
+
+    /* Make stdout buffer more responsive. */
+    setbuf(stdout, NULL);
+
+    unsigned char pk[SPX_PK_BYTES];
+    unsigned char sk[SPX_SK_BYTES];
+    unsigned char *cache = malloc(cachelen);
+    unsigned char *m = malloc(SPX_MLEN);
+    unsigned char *sig = malloc(SPX_BYTES);
+    unsigned char *sig_uncached = malloc(SPX_BYTES);
+    size_t siglen;
+    /* The root of the top subtree ends the first cached layer. */
+    unsigned long long top_root = crypto_sign_cache_bytes(1) - 1;
+
+    randombytes(m, SPX_MLEN);
+
+    if (crypto_sign_cache_layers(cachelen) != SPX_CACHE_LAYERS ||
+        crypto_sign_cache_layers(cachelen - 1) != SPX_CACHE_LAYERS - 1) {
+        printf("X cache budget does not give the expected number of layers!\n");
+        ret = -1;
+    }
+
+    printf("Generating keypair.. ");
+
+    if (crypto_sign_keypair(pk, sk)) {
+        printf("failed!\n");
+        return -1;
+    }
+    printf("successful.\n");
+
+    printf("Caching the top %d layer(s).. ", SPX_CACHE_LAYERS);
+
+    if (crypto_sign_cache_init(cache, SPX_CACHE_LAYERS, sk)) {
+        printf("failed!\n");
+        return -1;
+    }
+    printf("successful.\n");
+
+    if (crypto_sign_cache_check(cache, cachelen, sk)) {
+        printf("  X cache check failed!\n");
+        ret = -1;
+    }
+    else {
+        printf("    cache check succeeded.\n");
+    }
+
+    randombytes_set(fixed_randombytes);
+    crypto_sign_signature(sig_uncached, &siglen, m, SPX_MLEN, sk);
+    if (crypto_sign_signature_cached(sig, &siglen, m, SPX_MLEN, sk,
+                                     cache, cachelen)) {
+        printf("  X signing with cache failed!\n");
+        ret = -1;
+    }
+
+    if (memcmp(sig, sig_uncached, SPX_BYTES)) {
+        printf("  X signatures with and without cache differ!\n");
+        ret = -1;
+    }
+    else {
+        printf("    signatures with and without cache are identical.\n");
+    }
+    randombytes_set(NULL);
+
+    if (siglen != SPX_BYTES) {
+        printf("  X siglen incorrect [%zu != %u]!\n", siglen, SPX_BYTES);
+        ret = -1;
+    }
+
+    /* Test if the signature made with the cache is valid. */
+    if (crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X verification with cache failed!\n");
+        ret = -1;
+    }
+    else {
+        printf("    verification with cache succeeded.\n");
+    }
+
+    /* Test if changing a cached node is detected. */
+    cache[cachelen - 1] ^= 1;
+    if (!crypto_sign_cache_check(cache, cachelen, sk)) {
+        printf("  X modified cache passed the check!\n");
+        ret = -1;
+    }
+    else {
+        printf("    modified cache fails the check.\n");
+    }
+    cache[cachelen - 1] ^= 1;
+
+    /* Every signature uses the top subtree, so signing with a modified root
+       of it must fail rather than sign a wrong root. */
+    cache[top_root] ^= 1;
+    if (!crypto_sign_signature_cached(sig, &siglen, m, SPX_MLEN, sk,
+                                      cache, cachelen)) {
+        printf("  X signing with a modified cache succeeded!\n");
+        ret = -1;
+    }
+    else {
+        printf("    signing with a modified cache fails.\n");
+    }
+    cache[top_root] ^= 1;
+
+#if SPX_CACHE_LAYERS > 1
+    /* Test if swapping the first two subtrees of the second layer, which both
+       carry a valid tag, is detected. */
+    {
+        size_t tree_bytes = (crypto_sign_cache_bytes(2) -
+                             crypto_sign_cache_bytes(1)) >> SPX_TREE_HEIGHT;
+        unsigned char *first = cache + top_root + 1;
+        unsigned char *tmp = malloc(tree_bytes);
+
+        memcpy(tmp, first, tree_bytes);
+        memcpy(first, first + tree_bytes, tree_bytes);
+        memcpy(first + tree_bytes, tmp, tree_bytes);
+        if (!crypto_sign_cache_check(cache, cachelen, sk)) {
+            printf("  X cache with swapped subtrees passed the check!\n");
+            ret = -1;
+        }
+        else {
+            printf("    cache with swapped subtrees fails the check.\n");
+        }
+        memcpy(first + tree_bytes, first, tree_bytes);
+        memcpy(first, tmp, tree_bytes);
+        free(tmp);
+    }
+#endif
+
+    /* The restored cache is accepted again. */
+    if (crypto_sign_cache_check(cache, cachelen, sk) ||
+        crypto_sign_signature_cached(sig, &siglen, m, SPX_MLEN, sk,
+                                     cache, cachelen) ||
+        crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk)) {
+        printf("  X restored cache rejected!\n");
+        ret = -1;
+    }
+    else {
+        printf("    restored cache accepted.\n");
+    }
+
+    free(cache);
+    free(m);
+    free(sig);
+    free(sig_uncached);
+
+    return ret;
+}
@@ -6,6 +6,8 @@
 #include "../haraka.c"
 #include "../rng.h"
 
+static spx_ctx ctx;
+
 static int test_haraka_S_incremental(void) {
     unsigned char input[521];
     unsigned char check[521];
@@ -22,21 +24,21 @@ static int test_haraka_S_incremental(void) {
 
     randombytes(input, 521);
 
-    haraka_S(check, 521, input, 521);
+    haraka_S(check, 521, input, 521, &ctx);
 
     haraka_S_inc_init(s_inc_absorb);
 
     absorbed = 0;
     for (i = 0; i < 521 && absorbed + i <= 521; i++) {
-        haraka_S_inc_absorb(s_inc_absorb, input + absorbed, i);
+        haraka_S_inc_absorb(s_inc_absorb, input + absorbed, i, &ctx);
         absorbed += i;
     }
-    haraka_S_inc_absorb(s_inc_absorb, input + absorbed, 521 - absorbed);
+    haraka_S_inc_absorb(s_inc_absorb, input + absorbed, 521 - absorbed, &ctx);
 
     haraka_S_inc_finalize(s_inc_absorb);
 
     memset(s_combined, 0, 64);
-    haraka_S_absorb(s_combined, HARAKAS_RATE, input, 521, 0x1F);
+    haraka_S_absorb(s_combined, HARAKAS_RATE, input, 521, 0x1F, &ctx);
 
     if (memcmp(s_inc_absorb, s_combined, 64 * sizeof(uint8_t))) {
         printf("ERROR haraka_S state after incremental absorb did not match all-at-once absorb.\n");
@@ -55,7 +57,7 @@ static int test_haraka_S_incremental(void) {
 
     memcpy(s_inc_both, s_inc_absorb, 65 * sizeof(uint8_t));
 
-    haraka_S_squeezeblocks(output, 3, s_inc_absorb, HARAKAS_RATE);
+    haraka_S_squeezeblocks(output, 3, s_inc_absorb, HARAKAS_RATE, &ctx);
 
     if (memcmp(check, output, 3*HARAKAS_RATE)) {
         printf("ERROR haraka_S incremental absorb did not match haraka_S.\n");
@@ -73,12 +75,12 @@ static int test_haraka_S_incremental(void) {
     }
 
     memset(s_inc_squeeze, 0, 65);
-    haraka_S_absorb(s_inc_squeeze, HARAKAS_RATE, input, 521, 0x1F);
+    haraka_S_absorb(s_inc_squeeze, HARAKAS_RATE, input, 521, 0x1F, &ctx);
     s_inc_squeeze[64] = 0;
 
     memcpy(s_inc_squeeze_all, s_inc_squeeze, 65 * sizeof(uint8_t));
 
-    haraka_S_inc_squeeze(output, 521, s_inc_squeeze_all);
+    haraka_S_inc_squeeze(output, 521, s_inc_squeeze_all, &ctx);
 
     if (memcmp(check, output, 521)) {
         printf("ERROR haraka_S incremental squeeze-all did not match haraka_S.\n");
@@ -98,10 +100,10 @@ static int test_haraka_S_incremental(void) {
     squeezed = 0;
     memset(output, 0, 521);
     for (i = 0; i < 521 && squeezed + i <= 521; i++) {
-        haraka_S_inc_squeeze(output + squeezed, i, s_inc_squeeze);
+        haraka_S_inc_squeeze(output + squeezed, i, s_inc_squeeze, &ctx);
         squeezed += i;
     }
-    haraka_S_inc_squeeze(output + squeezed, 521 - squeezed, s_inc_squeeze);
+    haraka_S_inc_squeeze(output + squeezed, 521 - squeezed, s_inc_squeeze, &ctx);
 
     if (memcmp(check, output, 521)) {
         printf("ERROR haraka_S incremental squeeze did not match haraka_S.\n");
@@ -121,10 +123,10 @@ static int test_haraka_S_incremental(void) {
     squeezed = 0;
     memset(output, 0, 521);
     for (i = 0; i < 521 && squeezed + i <= 521; i++) {
-        haraka_S_inc_squeeze(output + squeezed, i, s_inc_both);
+        haraka_S_inc_squeeze(output + squeezed, i, s_inc_both, &ctx);
         squeezed += i;
     }
-    haraka_S_inc_squeeze(output + squeezed, 521 - squeezed, s_inc_both);
+    haraka_S_inc_squeeze(output + squeezed, 521 - squeezed, s_inc_both, &ctx);
 
     if (memcmp(check, output, 521)) {
         printf("ERROR haraka_S incremental absorb + squeeze did not match haraka_S.\n");
@@ -144,9 +146,107 @@ static int test_haraka_S_incremental(void) {
     return returncode;
 }
 
+/* Selects the portable code even where AES-NI is available, so that the
+   reference values do not come from the code under test. */
+static void use_portable(int portable) {
+#ifdef SPX_HARAKA_AESNI
+    haraka_use_aesni = !portable;
+#else
+    (void)portable;
+#endif
+}
+
+static int compare(const char *name, const unsigned char *check,
+                   const unsigned char *output, size_t len) {
+    if (memcmp(check, output, len)) {
+        printf("ERROR %s did not match the portable reference.\n", name);
+        return 1;
+    }
+    return 0;
+}
+
+static int test_haraka_x4(void) {
+    unsigned char input[4*521];
+    unsigned char check[4*521];
+    unsigned char output[4*521];
+    int i;
+    int returncode = 0;
+
+    randombytes(input, 4*521);
+
+    use_portable(1);
+    for (i = 0; i < 4; i++) {
+        haraka512_perm(check + 64*i, input + 64*i, &ctx);
+    }
+    use_portable(0);
+    haraka512_perm_x4(output, input, &ctx);
+    returncode |= compare("haraka512_perm_x4", check, output, 4*64);
+    for (i = 0; i < 4; i++) {
+        haraka512_perm(output + 64*i, input + 64*i, &ctx);
+    }
+    returncode |= compare("haraka512_perm", check, output, 4*64);
+
+    use_portable(1);
+    for (i = 0; i < 4; i++) {
+        haraka512(check + 32*i, input + 64*i, &ctx);
+    }
+    use_portable(0);
+    haraka512x4(output, input, &ctx);
+    returncode |= compare("haraka512x4", check, output, 4*32);
+    for (i = 0; i < 4; i++) {
+        haraka512(output + 32*i, input + 64*i, &ctx);
+    }
+    returncode |= compare("haraka512", check, output, 4*32);
+
+    use_portable(1);
+    for (i = 0; i < 4; i++) {
+        haraka256(check + 32*i, input + 32*i, &ctx);
+    }
+    use_portable(0);
+    haraka256x4(output, input, &ctx);
+    returncode |= compare("haraka256x4", check, output, 4*32);
+    for (i = 0; i < 4; i++) {
+        haraka256(output + 32*i, input + 32*i, &ctx);
+    }
+    returncode |= compare("haraka256", check, output, 4*32);
+
+    use_portable(1);
+    for (i = 0; i < 4; i++) {
+        haraka256_sk(check + 32*i, input + 32*i, &ctx);
+    }
+    use_portable(0);
+    haraka256_skx4(output, input, &ctx);
+    returncode |= compare("haraka256_skx4", check, output, 4*32);
+    for (i = 0; i < 4; i++) {
+        haraka256_sk(output + 32*i, input + 32*i, &ctx);
+    }
+    returncode |= compare("haraka256_sk", check, output, 4*32);
+
+    use_portable(1);
+    for (i = 0; i < 4; i++) {
+        haraka_S(check + 521*i, 521, input + 521*i, 521, &ctx);
+    }
+    use_portable(0);
+    haraka_Sx4(output, output + 521, output + 2*521, output + 3*521, 521,
+               input, input + 521, input + 2*521, input + 3*521, 521, &ctx);
+    returncode |= compare("haraka_Sx4", check, output, 4*521);
+    for (i = 0; i < 4; i++) {
+        haraka_S(output + 521*i, 521, input + 521*i, 521, &ctx);
+    }
+    returncode |= compare("haraka_S", check, output, 4*521);
+
+    return returncode;
+}
+
 int main(void) {
     int result = 0;
+
+    randombytes(ctx.pub_seed, SPX_N);
+    randombytes(ctx.sk_seed, SPX_N);
+    tweak_constants(&ctx);
+
     result += test_haraka_S_incremental();
+    result += test_haraka_x4();
 
     if (result != 0) {
         puts("Errors occurred");
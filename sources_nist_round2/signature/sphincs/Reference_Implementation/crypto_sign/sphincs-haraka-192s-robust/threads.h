@@ -0,0 +1,21 @@
+#ifndef SPX_THREADS_H
+#define SPX_THREADS_H
+
+/* Number of threads used for signing. Set with "make THREADS=n". */
+#ifndef SPX_NUM_THREADS
+#define SPX_NUM_THREADS 1
+#endif
+
+/**
+ * Calls job(ctx, i) for every i in [0, njobs), spreading the calls over
+ * SPX_NUM_THREADS threads, and returns once all of them have completed.
+ * The calling thread takes part, and jobs are handed out in increasing order
+ * of i, so that the most expensive jobs should come first.
+ * The other threads are started on the first call and kept for later calls.
+ * If they cannot be started, or are already busy with the jobs of another
+ * thread, the jobs run on the calling thread.
+ */
+void run_jobs(void (*job)(void *ctx, unsigned int i), void *ctx,
+              unsigned int njobs);
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "params.h"
+#include "context.h"
 
 /**
  * Converts the value of 'in' to 'outlen' bytes in big-endian byte order.
@@ -22,7 +23,17 @@ unsigned long long bytes_to_ull(const unsigned char *in, unsigned int inlen);
 void compute_root(unsigned char *root, const unsigned char *leaf,
                   uint32_t leaf_idx, uint32_t idx_offset,
                   const unsigned char *auth_path, uint32_t tree_height,
-                  const unsigned char *pub_seed, uint32_t addr[8]);
+                  const spx_ctx *ctx, uint32_t addr[8]);
+
+/**
+ * Four instances of compute_root, hashing the four paths side by side. Takes
+ * the leaf, leaf index, auth path and address (addrx4 + 8*j) of each path j,
+ * and writes its root to root[j]. The paths share idx_offset and tree_height.
+ */
+void compute_rootx4(unsigned char *root[4], const unsigned char *leaf[4],
+                    const uint32_t leaf_idx[4], uint32_t idx_offset,
+                    const unsigned char *auth_path[4], uint32_t tree_height,
+                    const spx_ctx *ctx, uint32_t addrx4[4*8]);
 
 /**
  * For a given leaf index, computes the authentication path and the resulting
@@ -31,14 +42,16 @@ void compute_root(unsigned char *root, const unsigned char *leaf,
  * tree type (i.e. SPX_ADDR_TYPE_HASHTREE or SPX_ADDR_TYPE_FORSTREE).
  * Applies the offset idx_offset to indices before building addresses, so that
  * it is possible to continue counting indices across trees.
+ * The leaves are computed four at a time by gen_leafx4, which writes the
+ * leaves at addr_idx, ..., addr_idx + 3 to consecutive SPX_N-byte blocks;
+ * tree_height must be at least 2.
  */
 void treehash(unsigned char *root, unsigned char *auth_path,
-              const unsigned char *sk_seed, const unsigned char *pub_seed,
+              const spx_ctx *ctx,
               uint32_t leaf_idx, uint32_t idx_offset, uint32_t tree_height,
-              void (*gen_leaf)(
-                 unsigned char* /* leaf */,
-                 const unsigned char* /* sk_seed */,
-                 const unsigned char* /* pub_seed */,
+              void (*gen_leafx4)(
+                 unsigned char* /* leaves (4 * SPX_N bytes) */,
+                 const spx_ctx* /* ctx */,
                  uint32_t /* addr_idx */, const uint32_t[8] /* tree_addr */),
               uint32_t tree_addr[8]);
 
@@ -16,14 +16,14 @@
  * Computes the starting value for a chain, i.e. the secret key.
  * Expects the address to be complete up to the chain address.
  */
-static void wots_gen_sk(unsigned char *sk, const unsigned char *sk_seed,
+static void wots_gen_sk(unsigned char *sk, const spx_ctx *ctx,
                         uint32_t wots_addr[8])
 {
     /* Make sure that the hash address is actually zeroed. */
     set_hash_addr(wots_addr, 0);
 
     /* Generate sk element. */
-    prf_addr(sk, sk_seed, wots_addr);
+    prf_addr(sk, ctx, wots_addr);
 }
 
 /**
@@ -35,7 +35,7 @@ static void wots_gen_sk(unsigned char *sk, const unsigned char *sk_seed,
  */
 static void gen_chain(unsigned char *out, const unsigned char *in,
                       unsigned int start, unsigned int steps,
-                      const unsigned char *pub_seed, uint32_t addr[8])
+                      const spx_ctx *ctx, uint32_t addr[8])
 {
     uint32_t i;
 
@@ -45,7 +45,41 @@ static void gen_chain(unsigned char *out, const unsigned char *in,
     /* Iterate 'steps' calls to the hash function. */
     for (i = start; i < (start+steps) && i < SPX_WOTS_W; i++) {
         set_hash_addr(addr, i);
-        thash(out, out, 1, pub_seed, addr);
+        thash(out, out, 1, ctx, addr);
+    }
+}
+
+/**
+ * Four instances of wots_gen_sk, for the addresses in wots_addrx4.
+ */
+static void wots_gen_skx4(unsigned char *sk[4], const spx_ctx *ctx,
+                          uint32_t wots_addrx4[4*8])
+{
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        set_hash_addr(wots_addrx4 + j*8, 0);
+    }
+    prf_addrx4(sk[0], sk[1], sk[2], sk[3], ctx, wots_addrx4);
+}
+
+/**
+ * Four instances of gen_chain, computed in place on out, with the same start
+ * and steps and the addresses in addrx4.
+ */
+static void gen_chainx4(unsigned char *out[4],
+                        unsigned int start, unsigned int steps,
+                        const spx_ctx *ctx, uint32_t addrx4[4*8])
+{
+    uint32_t i;
+    unsigned int j;
+
+    for (i = start; i < (start+steps) && i < SPX_WOTS_W; i++) {
+        for (j = 0; j < 4; j++) {
+            set_hash_addr(addrx4 + j*8, i);
+        }
+        thashx4(out[0], out[1], out[2], out[3],
+                out[0], out[1], out[2], out[3], 1, ctx, addrx4);
     }
 }
 
@@ -101,32 +135,52 @@ static void chain_lengths(int *lengths, const unsigned char *msg)
 }
 
 /**
- * WOTS key generation. Takes a 32 byte sk_seed, expands it to WOTS private key
- * elements and computes the corresponding public key.
- * It requires the seed pub_seed (used to generate bitmasks and hash keys)
- * and the address of this WOTS key pair.
+ * WOTS key generation. Takes the sk_seed in ctx, expands it to WOTS private
+ * key elements and computes the corresponding public key.
+ * It requires the seed pub_seed in ctx (used to generate bitmasks and hash
+ * keys) and the address of this WOTS key pair.
  *
  * Writes the computed public key to 'pk'.
  */
-void wots_gen_pk(unsigned char *pk, const unsigned char *sk_seed,
-                 const unsigned char *pub_seed, uint32_t addr[8])
+void wots_gen_pk(unsigned char *pk, const spx_ctx *ctx, uint32_t addr[8])
 {
     uint32_t i;
 
     for (i = 0; i < SPX_WOTS_LEN; i++) {
         set_chain_addr(addr, i);
-        wots_gen_sk(pk + i*SPX_N, sk_seed, addr);
+        wots_gen_sk(pk + i*SPX_N, ctx, addr);
         gen_chain(pk + i*SPX_N, pk + i*SPX_N,
-                  0, SPX_WOTS_W - 1, pub_seed, addr);
+                  0, SPX_WOTS_W - 1, ctx, addr);
     }
 }
 
 /**
- * Takes a n-byte message and the 32-byte sk_see to compute a signature 'sig'.
+ * Computes four WOTS public keys at once, for the addresses in addrx4, which
+ * typically differ only in their key pair address. The keys are written to
+ * pkx4 one after the other, SPX_WOTS_BYTES each.
+ */
+void wots_gen_pkx4(unsigned char *pkx4, const spx_ctx *ctx,
+                   uint32_t addrx4[4*8])
+{
+    unsigned char *chains[4];
+    uint32_t i;
+    unsigned int j;
+
+    for (i = 0; i < SPX_WOTS_LEN; i++) {
+        for (j = 0; j < 4; j++) {
+            set_chain_addr(addrx4 + j*8, i);
+            chains[j] = pkx4 + j*SPX_WOTS_BYTES + i*SPX_N;
+        }
+        wots_gen_skx4(chains, ctx, addrx4);
+        gen_chainx4(chains, 0, SPX_WOTS_W - 1, ctx, addrx4);
+    }
+}
+
+/**
+ * Takes a n-byte message and the sk_seed in ctx to compute a signature 'sig'.
  */
 void wots_sign(unsigned char *sig, const unsigned char *msg,
-               const unsigned char *sk_seed, const unsigned char *pub_seed,
-               uint32_t addr[8])
+               const spx_ctx *ctx, uint32_t addr[8])
 {
     int lengths[SPX_WOTS_LEN];
     uint32_t i;
@@ -135,8 +189,8 @@ void wots_sign(unsigned char *sig, const unsigned char *msg,
 
     for (i = 0; i < SPX_WOTS_LEN; i++) {
         set_chain_addr(addr, i);
-        wots_gen_sk(sig + i*SPX_N, sk_seed, addr);
-        gen_chain(sig + i*SPX_N, sig + i*SPX_N, 0, lengths[i], pub_seed, addr);
+        wots_gen_sk(sig + i*SPX_N, ctx, addr);
+        gen_chain(sig + i*SPX_N, sig + i*SPX_N, 0, lengths[i], ctx, addr);
     }
 }
 
@@ -147,7 +201,7 @@ void wots_sign(unsigned char *sig, const unsigned char *msg,
  */
 void wots_pk_from_sig(unsigned char *pk,
                       const unsigned char *sig, const unsigned char *msg,
-                      const unsigned char *pub_seed, uint32_t addr[8])
+                      const spx_ctx *ctx, uint32_t addr[8])
 {
     int lengths[SPX_WOTS_LEN];
     uint32_t i;
@@ -157,6 +211,82 @@ void wots_pk_from_sig(unsigned char *pk,
     for (i = 0; i < SPX_WOTS_LEN; i++) {
         set_chain_addr(addr, i);
         gen_chain(pk + i*SPX_N, sig + i*SPX_N,
-                  lengths[i], SPX_WOTS_W - 1 - lengths[i], pub_seed, addr);
+                  lengths[i], SPX_WOTS_W - 1 - lengths[i], ctx, addr);
+    }
+}
+
+/**
+ * Computes the WOTS public keys for the first 'count' (at most four) of the
+ * signatures sig[j] on the n-byte messages msg[j], as wots_pk_from_sig does
+ * for the address addrx4 + 8*j. Writes each public key to pk[j].
+ * The chains of all signatures share the four lanes of thashx4: a lane takes
+ * the next chain as soon as its chain is complete, so that chains of
+ * different lengths keep all lanes busy.
+ */
+void wots_pk_from_sigx4(unsigned char *pk[4],
+                        const unsigned char *sig[4],
+                        const unsigned char *msg[4],
+                        unsigned int count,
+                        const spx_ctx *ctx, const uint32_t addrx4[4*8])
+{
+    int lengths[4][SPX_WOTS_LEN];
+    unsigned char idle[4][SPX_N] = {{0}};
+    unsigned char *out[4];
+    unsigned char *lane[4];
+    uint32_t lane_addrx4[4*8];
+    int pos[4];
+    unsigned int next = 0;
+    unsigned int busy;
+    unsigned int i, j, k;
+
+    for (j = 0; j < count; j++) {
+        chain_lengths(lengths[j], msg[j]);
+    }
+    /* Lanes without a chain hash a scratch value instead. */
+    for (k = 0; k < 4; k++) {
+        out[k] = NULL;
+        memcpy(lane_addrx4 + k*8, addrx4, 8 * sizeof(uint32_t));
+    }
+
+    for (;;) {
+        busy = 0;
+        for (k = 0; k < 4; k++) {
+            /* Give idle lanes the next chain that still needs hashing. */
+            while (out[k] == NULL && next < count * SPX_WOTS_LEN) {
+                j = next / SPX_WOTS_LEN;
+                i = next % SPX_WOTS_LEN;
+                next++;
+
+                memcpy(pk[j] + i*SPX_N, sig[j] + i*SPX_N, SPX_N);
+                if (lengths[j][i] < SPX_WOTS_W - 1) {
+                    out[k] = pk[j] + i*SPX_N;
+                    pos[k] = lengths[j][i];
+                    memcpy(lane_addrx4 + k*8, addrx4 + j*8,
+                           8 * sizeof(uint32_t));
+                    set_chain_addr(lane_addrx4 + k*8, i);
+                }
+            }
+            if (out[k] != NULL) {
+                set_hash_addr(lane_addrx4 + k*8, pos[k]);
+                lane[k] = out[k];
+                busy++;
+            }
+            else {
+                lane[k] = idle[k];
+            }
+        }
+        if (busy == 0) {
+            break;
+        }
+
+        thashx4(lane[0], lane[1], lane[2], lane[3],
+                lane[0], lane[1], lane[2], lane[3], 1, ctx, lane_addrx4);
+
+        /* Release the lanes whose chain has reached its end. */
+        for (k = 0; k < 4; k++) {
+            if (out[k] != NULL && ++pos[k] == SPX_WOTS_W - 1) {
+                out[k] = NULL;
+            }
+        }
     }
 }
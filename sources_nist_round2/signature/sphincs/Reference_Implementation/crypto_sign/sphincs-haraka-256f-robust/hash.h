@@ -3,18 +3,31 @@
 
 #include <stdint.h>
 
-void initialize_hash_function(const unsigned char *pub_seed,
-                              const unsigned char *sk_seed);
+#include "context.h"
 
-void prf_addr(unsigned char *out, const unsigned char *key,
+/* Fills in the hash-specific part of ctx, once pub_seed and sk_seed are set. */
+void initialize_hash_function(spx_ctx *ctx);
+
+/* Same as initialize_hash_function, for a ctx that is only used to verify:
+   only pub_seed needs to be set, and ctx must not be passed to prf_addr. */
+void initialize_hash_function_public(spx_ctx *ctx);
+
+void prf_addr(unsigned char *out, const spx_ctx *ctx,
               const uint32_t addr[8]);
 
+/* Four instances of prf_addr, for the addresses addrx4, addrx4 + 8, etc. */
+void prf_addrx4(unsigned char *out0, unsigned char *out1,
+                unsigned char *out2, unsigned char *out3,
+                const spx_ctx *ctx, const uint32_t addrx4[4*8]);
+
 void gen_message_random(unsigned char *R, const unsigned char *sk_seed,
                         const unsigned char *optrand,
-                        const unsigned char *m, unsigned long long mlen);
+                        const unsigned char *m, unsigned long long mlen,
+                        const spx_ctx *ctx);
 
 void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
                   const unsigned char *R, const unsigned char *pk,
-                  const unsigned char *m, unsigned long long mlen);
+                  const unsigned char *m, unsigned long long mlen,
+                  const spx_ctx *ctx);
 
 #endif
@@ -2,6 +2,7 @@
 #include <string.h>
 
 #include "../wots.h"
+#include "../hash.h"
 #include "../rng.h"
 #include "../params.h"
 
@@ -10,24 +11,24 @@ int main()
     /* Make stdout buffer more responsive. */
     setbuf(stdout, NULL);
 
-    unsigned char seed[SPX_N];
-    unsigned char pub_seed[SPX_N];
+    spx_ctx ctx;
     unsigned char pk1[SPX_WOTS_PK_BYTES];
     unsigned char pk2[SPX_WOTS_PK_BYTES];
     unsigned char sig[SPX_WOTS_BYTES];
     unsigned char m[SPX_N];
     uint32_t addr[8] = {0};
 
-    randombytes(seed, SPX_N);
-    randombytes(pub_seed, SPX_N);
+    randombytes(ctx.sk_seed, SPX_N);
+    randombytes(ctx.pub_seed, SPX_N);
+    initialize_hash_function(&ctx);
     randombytes(m, SPX_N);
     randombytes((unsigned char *)addr, 8 * sizeof(uint32_t));
 
     printf("Testing WOTS signature and PK derivation.. ");
 
-    wots_gen_pk(pk1, seed, pub_seed, addr);
-    wots_sign(sig, m, seed, pub_seed, addr);
-    wots_pk_from_sig(pk2, sig, m, pub_seed, addr);
+    wots_gen_pk(pk1, &ctx, addr);
+    wots_sign(sig, m, &ctx, addr);
+    wots_pk_from_sig(pk2, sig, m, &ctx, addr);
 
     if (memcmp(pk1, pk2, SPX_WOTS_PK_BYTES)) {
         printf("failed!\n");
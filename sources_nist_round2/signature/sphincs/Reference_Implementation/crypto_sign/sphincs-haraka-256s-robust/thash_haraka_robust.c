@@ -11,7 +11,7 @@
  * Takes an array of inblocks concatenated arrays of SPX_N bytes.
  */
 void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
-           const unsigned char *pub_seed, uint32_t addr[8])
+           const spx_ctx *ctx, uint32_t addr[8])
 {
     unsigned char buf[SPX_ADDR_BYTES + inblocks*SPX_N];
     unsigned char bitmask[inblocks * SPX_N];
@@ -19,29 +19,87 @@ void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
     unsigned char buf_tmp[64];
     unsigned int i;
 
-    (void)pub_seed; /* Suppress an 'unused parameter' warning. */
-
     if (inblocks == 1) {
         /* F function */
         /* Since SPX_N may be smaller than 32, we need a temporary buffer. */
         memset(buf_tmp, 0, 64);
         addr_to_bytes(buf_tmp, addr);
 
-        haraka256(outbuf, buf_tmp);
+        haraka256(outbuf, buf_tmp, ctx);
         for (i = 0; i < inblocks * SPX_N; i++) {
             buf_tmp[SPX_ADDR_BYTES + i] = in[i] ^ outbuf[i];
         }
-        haraka512(outbuf, buf_tmp);
+        haraka512(outbuf, buf_tmp, ctx);
         memcpy(out, outbuf, SPX_N);
     } else {
         /* All other tweakable hashes*/
         addr_to_bytes(buf, addr);
-        haraka_S(bitmask, inblocks * SPX_N, buf, SPX_ADDR_BYTES);
+        haraka_S(bitmask, inblocks * SPX_N, buf, SPX_ADDR_BYTES, ctx);
 
         for (i = 0; i < inblocks * SPX_N; i++) {
             buf[SPX_ADDR_BYTES + i] = in[i] ^ bitmask[i];
         }
 
-        haraka_S(out, SPX_N, buf, SPX_ADDR_BYTES + inblocks*SPX_N);
+        haraka_S(out, SPX_N, buf, SPX_ADDR_BYTES + inblocks*SPX_N, ctx);
+    }
+}
+
+/**
+ * Four instances of thash, on inputs of inblocks blocks each.
+ */
+void thashx4(unsigned char *out0, unsigned char *out1,
+             unsigned char *out2, unsigned char *out3,
+             const unsigned char *in0, const unsigned char *in1,
+             const unsigned char *in2, const unsigned char *in3,
+             unsigned int inblocks,
+             const spx_ctx *ctx, uint32_t addrx4[4*8])
+{
+    unsigned char bufx4[4][SPX_ADDR_BYTES + inblocks*SPX_N];
+    unsigned char bitmaskx4[4][inblocks * SPX_N];
+    unsigned char outbufx4[4*32];
+    unsigned char buf_tmpx4[4*64];
+    const unsigned char *in[4] = { in0, in1, in2, in3 };
+    unsigned char *out[4] = { out0, out1, out2, out3 };
+    unsigned int i, j;
+
+    if (inblocks == 1) {
+        /* F function */
+        /* The addresses are hashed as four consecutive 32-byte inputs. */
+        for (j = 0; j < 4; j++) {
+            addr_to_bytes(bufx4[j], addrx4 + j*8);
+            memcpy(buf_tmpx4 + 32*j, bufx4[j], SPX_ADDR_BYTES);
+        }
+        haraka256x4(outbufx4, buf_tmpx4, ctx);
+
+        memset(buf_tmpx4, 0, 4*64);
+        for (j = 0; j < 4; j++) {
+            memcpy(buf_tmpx4 + 64*j, bufx4[j], SPX_ADDR_BYTES);
+            for (i = 0; i < inblocks * SPX_N; i++) {
+                buf_tmpx4[64*j + SPX_ADDR_BYTES + i] =
+                    in[j][i] ^ outbufx4[32*j + i];
+            }
+        }
+        haraka512x4(outbufx4, buf_tmpx4, ctx);
+        for (j = 0; j < 4; j++) {
+            memcpy(out[j], outbufx4 + 32*j, SPX_N);
+        }
+    } else {
+        /* All other tweakable hashes*/
+        for (j = 0; j < 4; j++) {
+            addr_to_bytes(bufx4[j], addrx4 + j*8);
+        }
+        haraka_Sx4(bitmaskx4[0], bitmaskx4[1], bitmaskx4[2], bitmaskx4[3],
+                   inblocks * SPX_N, bufx4[0], bufx4[1], bufx4[2], bufx4[3],
+                   SPX_ADDR_BYTES, ctx);
+
+        for (j = 0; j < 4; j++) {
+            for (i = 0; i < inblocks * SPX_N; i++) {
+                bufx4[j][SPX_ADDR_BYTES + i] = in[j][i] ^ bitmaskx4[j][i];
+            }
+        }
+
+        haraka_Sx4(out0, out1, out2, out3, SPX_N,
+                   bufx4[0], bufx4[1], bufx4[2], bufx4[3],
+                   SPX_ADDR_BYTES + inblocks*SPX_N, ctx);
     }
 }
@@ -0,0 +1,120 @@
+#include <stddef.h>
+
+#include "threads.h"
+
+#if SPX_NUM_THREADS > 1
+#include <pthread.h>
+
+/* The pool of SPX_NUM_THREADS - 1 workers. They are started on the first
+   call to run_jobs and then wait on pool_work for the next batch of jobs.
+   All fields are protected by pool_lock. */
+static struct {
+    void (*job)(void *ctx, unsigned int i);
+    void *ctx;
+    unsigned int njobs;
+    unsigned int next;
+    unsigned long batch;   /* Incremented for every batch handed out. */
+    unsigned int active;   /* Workers currently taking jobs from the batch. */
+    unsigned int workers;  /* Workers that were started. */
+    int busy;              /* Set while a caller owns the pool. */
+} pool;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+
+/* Takes jobs from the current batch until it is empty. Called with pool_lock
+   held, which is released while a job runs. */
+static void take_jobs(void)
+{
+    unsigned int i;
+
+    while (pool.next < pool.njobs) {
+        i = pool.next++;
+        pthread_mutex_unlock(&pool_lock);
+        pool.job(pool.ctx, i);
+        pthread_mutex_lock(&pool_lock);
+    }
+}
+
+/* Waits for a new batch, helps with it, and reports back when done. */
+static void *job_worker(void *arg)
+{
+    unsigned long seen = 0;
+
+    (void)arg;
+    pthread_mutex_lock(&pool_lock);
+    for (;;) {
+        while (pool.batch == seen) {
+            pthread_cond_wait(&pool_work, &pool_lock);
+        }
+        seen = pool.batch;
+
+        pool.active++;
+        take_jobs();
+        if (--pool.active == 0) {
+            pthread_cond_signal(&pool_done);
+        }
+    }
+    return NULL;
+}
+
+static void start_workers(void)
+{
+    pthread_attr_t attr;
+    pthread_t thread;
+    unsigned int i;
+
+    if (pthread_attr_init(&attr) != 0) {
+        return;
+    }
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    for (i = 0; i < SPX_NUM_THREADS - 1; i++) {
+        if (pthread_create(&thread, &attr, job_worker, NULL) != 0) {
+            break;
+        }
+        pthread_mutex_lock(&pool_lock);
+        pool.workers++;
+        pthread_mutex_unlock(&pool_lock);
+    }
+    pthread_attr_destroy(&attr);
+}
+#endif
+
+void run_jobs(void (*job)(void *ctx, unsigned int i), void *ctx,
+              unsigned int njobs)
+{
+    unsigned int i;
+
+#if SPX_NUM_THREADS > 1
+    if (njobs > 1) {
+        pthread_once(&pool_once, start_workers);
+
+        pthread_mutex_lock(&pool_lock);
+        if (!pool.busy && pool.workers > 0) {
+            pool.busy = 1;
+            pool.job = job;
+            pool.ctx = ctx;
+            pool.njobs = njobs;
+            pool.next = 0;
+            pool.batch++;
+            pthread_cond_broadcast(&pool_work);
+
+            take_jobs();
+            /* The last jobs may still be running on the workers. */
+            while (pool.active > 0) {
+                pthread_cond_wait(&pool_done, &pool_lock);
+            }
+            pool.busy = 0;
+            pthread_mutex_unlock(&pool_lock);
+            return;
+        }
+        pthread_mutex_unlock(&pool_lock);
+    }
+#endif
+
+    for (i = 0; i < njobs; i++) {
+        job(ctx, i);
+    }
+}
@@ -54,12 +54,67 @@ int crypto_sign_keypair(unsigned char *pk, unsigned char *sk);
 int crypto_sign_signature(uint8_t *sig, size_t *siglen,
                           const uint8_t *m, size_t mlen, const uint8_t *sk);
 
+/*
+ * Returns the length of a cache of the top 'layers' layers of the hypertree,
+ * in bytes, or 0 if that does not fit in an unsigned long long.
+ */
+unsigned long long crypto_sign_cache_bytes(unsigned int layers);
+
+/*
+ * Returns the largest number of layers whose cache takes at most 'budget'
+ * bytes.
+ */
+unsigned int crypto_sign_cache_layers(unsigned long long budget);
+
+/*
+ * Fills a cache of crypto_sign_cache_bytes(layers) bytes with the nodes of
+ * the top 'layers' layers of the hypertree of sk. Returns 0 on success.
+ * The cache is a flat array of bytes, so it can be written to a file and
+ * mapped back into memory later. Each subtree in it carries a tag keyed with
+ * SK_PRF, which crypto_sign_signature_cached checks before signing its root
+ * with a one-time key of the layer above.
+ */
+int crypto_sign_cache_init(uint8_t *cache, unsigned int layers,
+                           const uint8_t *sk);
+
+/*
+ * Checks that a cache was made by crypto_sign_cache_init for sk and has not
+ * been modified since. Returns 0 if so, and -1 otherwise. This checks the
+ * tags of all subtrees at once, e.g. after reading a cache from storage.
+ */
+int crypto_sign_cache_check(const uint8_t *cache, size_t cachelen,
+                            const uint8_t *sk);
+
+/**
+ * Returns an array containing a detached signature, taking the subtrees of
+ * the cached layers from a cache for sk instead of recomputing them.
+ * Signatures are the same as those of crypto_sign_signature, which this
+ * falls back to if the cache belongs to another key. Each subtree used is
+ * checked against its tag first; if one was modified, no signature is made
+ * and -1 is returned.
+ */
+int crypto_sign_signature_cached(uint8_t *sig, size_t *siglen,
+                                 const uint8_t *m, size_t mlen,
+                                 const uint8_t *sk,
+                                 const uint8_t *cache, size_t cachelen);
+
 /**
  * Verifies a detached signature and message under a given public key.
  */
 int crypto_sign_verify(const uint8_t *sig, size_t siglen,
                        const uint8_t *m, size_t mlen, const uint8_t *pk);
 
+/**
+ * Verifies n detached signatures on n messages under a single public key, as
+ * crypto_sign_verify does for each i < n, and stores each result in
+ * results[i]. Returns 0 if all signatures are valid, and -1 otherwise.
+ * The signatures are verified four at a time, hashing for all four at once.
+ */
+int crypto_sign_verify_batch(int *results,
+                             const uint8_t *const *sigs, const size_t *siglens,
+                             const uint8_t *const *ms, const size_t *mlens,
+                             size_t n, const uint8_t *pk);
+
 /**
  * Returns an array containing the signature followed by the message.
  */
@@ -9,6 +9,10 @@
 #include "utils.h"
 #include "sha256.h"
 
+#ifdef SPX_SHA256_SHANI
+#include <immintrin.h>
+#endif
+
 static uint32_t load_bigendian_32(const uint8_t *x) {
     return (uint32_t)(x[3]) | (((uint32_t)(x[2])) << 8) |
            (((uint32_t)(x[1])) << 16) | (((uint32_t)(x[0])) << 24);
@@ -49,6 +53,104 @@ static void store_bigendian_64(uint8_t *x, uint64_t u) {
     x[0] = (uint8_t) u;
 }
 
+#ifdef SPX_SHA256_SHANI
+
+static const uint32_t K_256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+    0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+    0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/* Four rounds with the message words in msg and the constants at k. */
+#define QROUND_SHANI(msg, k)                                        \
+    t = _mm_add_epi32(msg, _mm_loadu_si128((const __m128i *)(k)));  \
+    cdgh = _mm_sha256rnds2_epu32(cdgh, abef, t);                    \
+    abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(t, 0x0E));
+
+/* Replaces the oldest four message words m0 by the next four. */
+#define SCHEDULE_SHANI(m0, m1, m2, m3)                              \
+    m0 = _mm_sha256msg2_epu32(                                      \
+        _mm_add_epi32(_mm_sha256msg1_epu32(m0, m1),                 \
+                      _mm_alignr_epi8(m3, m2, 4)), m3);
+
+__attribute__((target("sha,sse4.1")))
+static size_t crypto_hashblocks_sha256_shani(uint8_t *statebytes,
+                                             const uint8_t *in, size_t inlen) {
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                         0x0405060700010203ULL);
+    __m128i abef, cdgh, abef_save, cdgh_save, t, m0, m1, m2, m3;
+    uint32_t state[8];
+    size_t i;
+
+    for (i = 0; i < 8; i++) {
+        state[i] = load_bigendian_32(statebytes + 4*i);
+    }
+    t = _mm_loadu_si128((const __m128i *)state);
+    cdgh = _mm_loadu_si128((const __m128i *)(state + 4));
+    t = _mm_shuffle_epi32(t, 0xB1);                 /* CDAB */
+    cdgh = _mm_shuffle_epi32(cdgh, 0x1B);           /* EFGH */
+    abef = _mm_alignr_epi8(t, cdgh, 8);             /* ABEF */
+    cdgh = _mm_blend_epi16(cdgh, t, 0xF0);          /* CDGH */
+
+    while (inlen >= 64) {
+        abef_save = abef;
+        cdgh_save = cdgh;
+
+        m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 0)), bswap);
+        QROUND_SHANI(m0, K_256 + 0)
+        m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 16)), bswap);
+        QROUND_SHANI(m1, K_256 + 4)
+        m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 32)), bswap);
+        QROUND_SHANI(m2, K_256 + 8)
+        m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 48)), bswap);
+        QROUND_SHANI(m3, K_256 + 12)
+
+        for (i = 16; i < 64; i += 16) {
+            SCHEDULE_SHANI(m0, m1, m2, m3)
+            QROUND_SHANI(m0, K_256 + i)
+            SCHEDULE_SHANI(m1, m2, m3, m0)
+            QROUND_SHANI(m1, K_256 + i + 4)
+            SCHEDULE_SHANI(m2, m3, m0, m1)
+            QROUND_SHANI(m2, K_256 + i + 8)
+            SCHEDULE_SHANI(m3, m0, m1, m2)
+            QROUND_SHANI(m3, K_256 + i + 12)
+        }
+
+        abef = _mm_add_epi32(abef, abef_save);
+        cdgh = _mm_add_epi32(cdgh, cdgh_save);
+
+        in += 64;
+        inlen -= 64;
+    }
+
+    t = _mm_shuffle_epi32(abef, 0x1B);              /* FEBA */
+    cdgh = _mm_shuffle_epi32(cdgh, 0xB1);           /* DCHG */
+    abef = _mm_blend_epi16(t, cdgh, 0xF0);          /* DCBA */
+    cdgh = _mm_alignr_epi8(cdgh, t, 8);             /* HGFE */
+    _mm_storeu_si128((__m128i *)state, abef);
+    _mm_storeu_si128((__m128i *)(state + 4), cdgh);
+    for (i = 0; i < 8; i++) {
+        store_bigendian_32(statebytes + 4*i, state[i]);
+    }
+
+    return inlen;
+}
+
+#endif
+
 #define SHR(x, c) ((x) >> (c))
 #define ROTR_32(x, c) (((x) >> (c)) | ((x) << (32 - (c))))
 #define ROTR_64(x, c) (((x) >> (c)) | ((x) << (64 - (c))))
@@ -107,6 +209,12 @@ static size_t crypto_hashblocks_sha256(uint8_t *statebytes,
     uint32_t T1;
     uint32_t T2;
 
+#ifdef SPX_SHA256_SHANI
+    if (SPX_SHA256_HAS_SHANI()) {
+        return crypto_hashblocks_sha256_shani(statebytes, in, inlen);
+    }
+#endif
+
     a = load_bigendian_32(statebytes + 0);
     state[0] = a;
     b = load_bigendian_32(statebytes + 4);
@@ -373,13 +481,11 @@ void mgf1(unsigned char *out, unsigned long outlen,
     }
 }
 
-uint8_t state_seeded[40];
-
 /**
  * Absorb the constant pub_seed using one round of the compression function
  * This initializes state_seeded, which can then be reused in thash
  **/
-void seed_state(const unsigned char *pub_seed) {
+void seed_state(uint8_t *state_seeded, const unsigned char *pub_seed) {
     uint8_t block[SPX_SHA256_BLOCK_BYTES];
     size_t i;
 
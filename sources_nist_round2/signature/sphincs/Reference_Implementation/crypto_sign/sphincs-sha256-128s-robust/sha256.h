@@ -10,6 +10,17 @@
 
 #define SPX_SHA256_ADDR_BYTES 22
 
+/* With SPX_SHA256_SHANI defined ("make SHANI=1"), the compression function
+   uses the SHA extensions when the CPU has them. This is opt-in, as some
+   virtual machines report but emulate these instructions, which is many
+   times slower. */
+#ifdef SPX_SHA256_SHANI
+    #if !((defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__))
+        #error SPX_SHA256_SHANI requires an x86 target and gcc or clang
+    #endif
+    #define SPX_SHA256_HAS_SHANI() __builtin_cpu_supports("sha")
+#endif
+
 #include <stddef.h>
 #include <stdint.h>
 
@@ -23,8 +34,6 @@ void compress_address(unsigned char *out, const uint32_t addr[8]);
 void mgf1(unsigned char *out, unsigned long outlen,
           const unsigned char *in, unsigned long inlen);
 
-uint8_t state_seeded[40];
-
-void seed_state(const unsigned char *pub_seed);
+void seed_state(uint8_t *state_seeded, const unsigned char *pub_seed);
 
 #endif
@@ -5,12 +5,13 @@
 #include "address.h"
 #include "params.h"
 #include "sha256.h"
+#include "sha256x4.h"
 
 /**
  * Takes an array of inblocks concatenated arrays of SPX_N bytes.
  */
 void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
-           const unsigned char *pub_seed, uint32_t addr[8])
+           const spx_ctx *ctx, uint32_t addr[8])
 {
     unsigned char buf[SPX_N + SPX_SHA256_ADDR_BYTES + inblocks*SPX_N];
     unsigned char outbuf[SPX_SHA256_OUTPUT_BYTES];
@@ -18,12 +19,12 @@ void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
     uint8_t sha2_state[40];
     unsigned int i;
 
-    memcpy(buf, pub_seed, SPX_N);
+    memcpy(buf, ctx->pub_seed, SPX_N);
     compress_address(buf + SPX_N, addr);
     mgf1(bitmask, inblocks * SPX_N, buf, SPX_N + SPX_SHA256_ADDR_BYTES);
 
     /* Retrieve precomputed state containing pub_seed */
-    memcpy(sha2_state, state_seeded, 40 * sizeof(uint8_t));
+    memcpy(sha2_state, ctx->state_seeded, 40 * sizeof(uint8_t));
 
     for (i = 0; i < inblocks * SPX_N; i++) {
         buf[SPX_N + SPX_SHA256_ADDR_BYTES + i] = in[i] ^ bitmask[i];
@@ -33,3 +34,49 @@ void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
                         SPX_SHA256_ADDR_BYTES + inblocks*SPX_N);
     memcpy(out, outbuf, SPX_N);
 }
+
+/**
+ * Four instances of thash, on inputs of inblocks blocks each.
+ */
+void thashx4(unsigned char *out0, unsigned char *out1,
+             unsigned char *out2, unsigned char *out3,
+             const unsigned char *in0, const unsigned char *in1,
+             const unsigned char *in2, const unsigned char *in3,
+             unsigned int inblocks,
+             const spx_ctx *ctx, uint32_t addrx4[4*8])
+{
+    unsigned char bufx4[4][SPX_N + SPX_SHA256_ADDR_BYTES + inblocks*SPX_N];
+    unsigned char outbufx4[4][SPX_SHA256_OUTPUT_BYTES];
+    unsigned char bitmaskx4[4][inblocks * SPX_N];
+    uint8_t sha2_statex4[4*40];
+    const unsigned char *in[4] = { in0, in1, in2, in3 };
+    unsigned char *out[4] = { out0, out1, out2, out3 };
+    unsigned int i, j;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(bufx4[j], ctx->pub_seed, SPX_N);
+        compress_address(bufx4[j] + SPX_N, addrx4 + j*8);
+    }
+    mgf1x4(bitmaskx4[0], bitmaskx4[1], bitmaskx4[2], bitmaskx4[3],
+           inblocks * SPX_N, bufx4[0], bufx4[1], bufx4[2], bufx4[3],
+           SPX_N + SPX_SHA256_ADDR_BYTES);
+
+    for (j = 0; j < 4; j++) {
+        /* Retrieve precomputed state containing pub_seed */
+        memcpy(sha2_statex4 + j*40, ctx->state_seeded, 40 * sizeof(uint8_t));
+
+        for (i = 0; i < inblocks * SPX_N; i++) {
+            bufx4[j][SPX_N + SPX_SHA256_ADDR_BYTES + i] =
+                in[j][i] ^ bitmaskx4[j][i];
+        }
+    }
+
+    sha256x4_inc_finalize(outbufx4[0], outbufx4[1], outbufx4[2], outbufx4[3],
+                          sha2_statex4, bufx4[0] + SPX_N, bufx4[1] + SPX_N,
+                          bufx4[2] + SPX_N, bufx4[3] + SPX_N,
+                          SPX_SHA256_ADDR_BYTES + inblocks*SPX_N);
+
+    for (j = 0; j < 4; j++) {
+        memcpy(out[j], outbufx4[j], SPX_N);
+    }
+}
@@ -8,32 +8,55 @@
 #include "thash.h"
 #include "address.h"
 
-static void fors_gen_sk(unsigned char *sk, const unsigned char *sk_seed,
+static void fors_gen_sk(unsigned char *sk, const spx_ctx *ctx,
                         uint32_t fors_leaf_addr[8])
 {
-    prf_addr(sk, sk_seed, fors_leaf_addr);
+    prf_addr(sk, ctx, fors_leaf_addr);
 }
 
 static void fors_sk_to_leaf(unsigned char *leaf, const unsigned char *sk,
-                            const unsigned char *pub_seed,
+                            const spx_ctx *ctx,
                             uint32_t fors_leaf_addr[8])
 {
-    thash(leaf, sk, 1, pub_seed, fors_leaf_addr);
+    thash(leaf, sk, 1, ctx, fors_leaf_addr);
 }
 
-static void fors_gen_leaf(unsigned char *leaf, const unsigned char *sk_seed,
-                          const unsigned char *pub_seed,
-                          uint32_t addr_idx, const uint32_t fors_tree_addr[8])
+static void fors_gen_leafx4(unsigned char *leaves, const spx_ctx *ctx,
+                            uint32_t addr_idx,
+                            const uint32_t fors_tree_addr[8])
 {
-    uint32_t fors_leaf_addr[8] = {0};
+    uint32_t fors_leaf_addrx4[4*8] = {0};
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        /* Only copy the parts that must be kept in fors_leaf_addr. */
+        copy_keypair_addr(fors_leaf_addrx4 + j*8, fors_tree_addr);
+        set_type(fors_leaf_addrx4 + j*8, SPX_ADDR_TYPE_FORSTREE);
+        set_tree_index(fors_leaf_addrx4 + j*8, addr_idx + j);
+    }
 
-    /* Only copy the parts that must be kept in fors_leaf_addr. */
-    copy_keypair_addr(fors_leaf_addr, fors_tree_addr);
-    set_type(fors_leaf_addr, SPX_ADDR_TYPE_FORSTREE);
-    set_tree_index(fors_leaf_addr, addr_idx);
+    prf_addrx4(leaves, leaves + SPX_N, leaves + 2*SPX_N, leaves + 3*SPX_N,
+               ctx, fors_leaf_addrx4);
+    thashx4(leaves, leaves + SPX_N, leaves + 2*SPX_N, leaves + 3*SPX_N,
+            leaves, leaves + SPX_N, leaves + 2*SPX_N, leaves + 3*SPX_N,
+            1, ctx, fors_leaf_addrx4);
+}
 
-    fors_gen_sk(leaf, sk_seed, fors_leaf_addr);
-    fors_sk_to_leaf(leaf, leaf, pub_seed, fors_leaf_addr);
+/**
+ * Interprets the SPX_FORS_HEIGHT bits of m that select the leaf of tree
+ * tree_idx as an unsigned integer.
+ */
+static uint32_t message_to_index(const unsigned char *m, unsigned int tree_idx)
+{
+    unsigned int j;
+    unsigned int offset = tree_idx * SPX_FORS_HEIGHT;
+    uint32_t index = 0;
+
+    for (j = 0; j < SPX_FORS_HEIGHT; j++) {
+        index ^= ((m[offset >> 3] >> (offset & 0x7)) & 0x1) << j;
+        offset++;
+    }
+    return index;
 }
 
 /**
@@ -43,61 +66,74 @@ static void fors_gen_leaf(unsigned char *leaf, const unsigned char *sk_seed,
  */
 static void message_to_indices(uint32_t *indices, const unsigned char *m)
 {
-    unsigned int i, j;
-    unsigned int offset = 0;
+    unsigned int i;
 
     for (i = 0; i < SPX_FORS_TREES; i++) {
-        indices[i] = 0;
-        for (j = 0; j < SPX_FORS_HEIGHT; j++) {
-            indices[i] ^= ((m[offset >> 3] >> (offset & 0x7)) & 0x1) << j;
-            offset++;
-        }
+        indices[i] = message_to_index(m, i);
     }
 }
 
 /**
- * Signs a message m, deriving the secret key from sk_seed and the FTS address.
- * Assumes m contains at least SPX_FORS_HEIGHT * SPX_FORS_TREES bits.
+ * Signs the tree_idx-th FORS tree for the message m: writes the secret key
+ * part and authentication path of the selected leaf to sig, and the root of
+ * the tree to root.
  */
-void fors_sign(unsigned char *sig, unsigned char *pk,
-               const unsigned char *m,
-               const unsigned char *sk_seed, const unsigned char *pub_seed,
-               const uint32_t fors_addr[8])
+void fors_sign_tree(unsigned char *sig, unsigned char *root,
+                    const unsigned char *m, unsigned int tree_idx,
+                    const spx_ctx *ctx, const uint32_t fors_addr[8])
 {
-    uint32_t indices[SPX_FORS_TREES];
-    unsigned char roots[SPX_FORS_TREES * SPX_N];
     uint32_t fors_tree_addr[8] = {0};
-    uint32_t fors_pk_addr[8] = {0};
-    uint32_t idx_offset;
-    unsigned int i;
+    uint32_t idx_offset = tree_idx * (1 << SPX_FORS_HEIGHT);
+    uint32_t index = message_to_index(m, tree_idx);
 
     copy_keypair_addr(fors_tree_addr, fors_addr);
-    copy_keypair_addr(fors_pk_addr, fors_addr);
-
     set_type(fors_tree_addr, SPX_ADDR_TYPE_FORSTREE);
-    set_type(fors_pk_addr, SPX_ADDR_TYPE_FORSPK);
 
-    message_to_indices(indices, m);
+    set_tree_height(fors_tree_addr, 0);
+    set_tree_index(fors_tree_addr, index + idx_offset);
 
-    for (i = 0; i < SPX_FORS_TREES; i++) {
-        idx_offset = i * (1 << SPX_FORS_HEIGHT);
+    /* Include the secret key part that produces the selected leaf node. */
+    fors_gen_sk(sig, ctx, fors_tree_addr);
+    sig += SPX_N;
 
-        set_tree_height(fors_tree_addr, 0);
-        set_tree_index(fors_tree_addr, indices[i] + idx_offset);
+    /* Compute the authentication path for this leaf node. */
+    treehash(root, sig, ctx, index, idx_offset,
+             SPX_FORS_HEIGHT, fors_gen_leafx4, fors_tree_addr);
+}
 
-        /* Include the secret key part that produces the selected leaf node. */
-        fors_gen_sk(sig, sk_seed, fors_tree_addr);
-        sig += SPX_N;
+/**
+ * Derives the FORS public key from the roots of its SPX_FORS_TREES trees.
+ */
+void fors_roots_to_pk(unsigned char *pk, const unsigned char *roots,
+                      const spx_ctx *ctx, const uint32_t fors_addr[8])
+{
+    uint32_t fors_pk_addr[8] = {0};
 
-        /* Compute the authentication path for this leaf node. */
-        treehash(roots + i*SPX_N, sig, sk_seed, pub_seed,
-                 indices[i], idx_offset, SPX_FORS_HEIGHT, fors_gen_leaf,
-                 fors_tree_addr);
-        sig += SPX_N * SPX_FORS_HEIGHT;
-    }
+    copy_keypair_addr(fors_pk_addr, fors_addr);
+    set_type(fors_pk_addr, SPX_ADDR_TYPE_FORSPK);
 
     /* Hash horizontally across all tree roots to derive the public key. */
-    thash(pk, roots, SPX_FORS_TREES, pub_seed, fors_pk_addr);
+    thash(pk, roots, SPX_FORS_TREES, ctx, fors_pk_addr);
+}
+
+/**
+ * Signs a message m, deriving the secret key from the sk_seed in ctx and the
+ * FTS address.
+ * Assumes m contains at least SPX_FORS_HEIGHT * SPX_FORS_TREES bits.
+ */
+void fors_sign(unsigned char *sig, unsigned char *pk,
+               const unsigned char *m,
+               const spx_ctx *ctx, const uint32_t fors_addr[8])
+{
+    unsigned char roots[SPX_FORS_TREES * SPX_N];
+    unsigned int i;
+
+    for (i = 0; i < SPX_FORS_TREES; i++) {
+        fors_sign_tree(sig + i * SPX_FORS_TREE_BYTES, roots + i*SPX_N,
+                       m, i, ctx, fors_addr);
+    }
+
+    fors_roots_to_pk(pk, roots, ctx, fors_addr);
 }
 
 /**
@@ -109,8 +145,7 @@ void fors_sign(unsigned char *sig, unsigned char *pk,
  */
 void fors_pk_from_sig(unsigned char *pk,
                       const unsigned char *sig, const unsigned char *m,
-                      const unsigned char *pub_seed,
-                      const uint32_t fors_addr[8])
+                      const spx_ctx *ctx, const uint32_t fors_addr[8])
 {
     uint32_t indices[SPX_FORS_TREES];
     unsigned char roots[SPX_FORS_TREES * SPX_N];
@@ -135,15 +170,75 @@ void fors_pk_from_sig(unsigned char *pk,
         set_tree_index(fors_tree_addr, indices[i] + idx_offset);
 
         /* Derive the leaf from the included secret key part. */
-        fors_sk_to_leaf(leaf, sig, pub_seed, fors_tree_addr);
+        fors_sk_to_leaf(leaf, sig, ctx, fors_tree_addr);
         sig += SPX_N;
 
         /* Derive the corresponding root node of this tree. */
         compute_root(roots + i*SPX_N, leaf, indices[i], idx_offset,
-                     sig, SPX_FORS_HEIGHT, pub_seed, fors_tree_addr);
+                     sig, SPX_FORS_HEIGHT, ctx, fors_tree_addr);
         sig += SPX_N * SPX_FORS_HEIGHT;
     }
 
     /* Hash horizontally across all tree roots to derive the public key. */
-    thash(pk, roots, SPX_FORS_TREES, pub_seed, fors_pk_addr);
+    thash(pk, roots, SPX_FORS_TREES, ctx, fors_pk_addr);
+}
+
+/**
+ * Four instances of fors_pk_from_sig, for the signatures sig[j], messages
+ * m[j] and addresses fors_addrx4 + 8*j, hashing the four side by side.
+ * Writes the public keys to pk[j].
+ */
+void fors_pk_from_sigx4(unsigned char *pk[4],
+                        const unsigned char *sig[4], const unsigned char *m[4],
+                        const spx_ctx *ctx, const uint32_t fors_addrx4[4*8])
+{
+    uint32_t indices[4][SPX_FORS_TREES];
+    unsigned char roots[4][SPX_FORS_TREES * SPX_N];
+    unsigned char leaf[4][SPX_N];
+    unsigned char *root[4];
+    const unsigned char *leafp[4];
+    const unsigned char *sk[4];
+    const unsigned char *auth_path[4];
+    uint32_t leaf_idx[4];
+    uint32_t fors_tree_addrx4[4*8] = {0};
+    uint32_t fors_pk_addrx4[4*8] = {0};
+    uint32_t idx_offset;
+    unsigned int i, j;
+
+    for (j = 0; j < 4; j++) {
+        copy_keypair_addr(fors_tree_addrx4 + j*8, fors_addrx4 + j*8);
+        copy_keypair_addr(fors_pk_addrx4 + j*8, fors_addrx4 + j*8);
+
+        set_type(fors_tree_addrx4 + j*8, SPX_ADDR_TYPE_FORSTREE);
+        set_type(fors_pk_addrx4 + j*8, SPX_ADDR_TYPE_FORSPK);
+
+        message_to_indices(indices[j], m[j]);
+        leafp[j] = leaf[j];
+    }
+
+    for (i = 0; i < SPX_FORS_TREES; i++) {
+        idx_offset = i * (1 << SPX_FORS_HEIGHT);
+
+        for (j = 0; j < 4; j++) {
+            set_tree_height(fors_tree_addrx4 + j*8, 0);
+            set_tree_index(fors_tree_addrx4 + j*8, indices[j][i] + idx_offset);
+
+            sk[j] = sig[j] + i * SPX_FORS_TREE_BYTES;
+            auth_path[j] = sk[j] + SPX_N;
+            root[j] = roots[j] + i*SPX_N;
+            leaf_idx[j] = indices[j][i];
+        }
+
+        /* Derive the leaves from the included secret key parts. */
+        thashx4(leaf[0], leaf[1], leaf[2], leaf[3],
+                sk[0], sk[1], sk[2], sk[3], 1, ctx, fors_tree_addrx4);
+
+        /* Derive the corresponding root nodes of these trees. */
+        compute_rootx4(root, leafp, leaf_idx, idx_offset,
+                       auth_path, SPX_FORS_HEIGHT, ctx, fors_tree_addrx4);
+    }
+
+    /* Hash horizontally across all tree roots to derive the public keys. */
+    thashx4(pk[0], pk[1], pk[2], pk[3], roots[0], roots[1], roots[2], roots[3],
+            SPX_FORS_TREES, ctx, fors_pk_addrx4);
 }
@@ -0,0 +1,321 @@
+/* Four SHA-256 computations on inputs of equal length. With the SHA
+ * extensions, the single-buffer compression function of sha256.c is the
+ * fastest option and is used for each input in turn; otherwise the four
+ * inputs are hashed side by side in the 32-bit lanes of SSE2 registers,
+ * which every x86-64 CPU has. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "utils.h"
+#include "sha256x4.h"
+
+#if defined(__SSE2__)
+#define SPX_SHA256X4_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(SPX_SHA256_SHANI) || !defined(SPX_SHA256X4_SSE2)
+/* Hashes the four inputs in turn with the compression function of sha256.c */
+static void sha256x4_blocks_seq(uint8_t *statex4, const uint8_t *in[4],
+                                size_t nblocks)
+{
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        sha256_inc_blocks(statex4 + 40*j, in[j], nblocks);
+    }
+}
+#endif
+
+#ifdef SPX_SHA256X4_SSE2
+
+static uint32_t load_bigendian_32(const uint8_t *x) {
+    return (uint32_t)(x[3]) | (((uint32_t)(x[2])) << 8) |
+           (((uint32_t)(x[1])) << 16) | (((uint32_t)(x[0])) << 24);
+}
+
+#define ADD(a, b) _mm_add_epi32(a, b)
+#define XOR(a, b) _mm_xor_si128(a, b)
+#define SHR(x, c) _mm_srli_epi32(x, c)
+#define ROTR(x, c) _mm_or_si128(_mm_srli_epi32(x, c), _mm_slli_epi32(x, 32 - (c)))
+
+#define Ch(x, y, z) XOR(_mm_and_si128(x, y), _mm_andnot_si128(x, z))
+#define Maj(x, y, z) XOR(XOR(_mm_and_si128(x, y), _mm_and_si128(x, z)), \
+                         _mm_and_si128(y, z))
+
+#define Sigma0(x) XOR(XOR(ROTR(x, 2), ROTR(x, 13)), ROTR(x, 22))
+#define Sigma1(x) XOR(XOR(ROTR(x, 6), ROTR(x, 11)), ROTR(x, 25))
+#define sigma0(x) XOR(XOR(ROTR(x, 7), ROTR(x, 18)), SHR(x, 3))
+#define sigma1(x) XOR(XOR(ROTR(x, 17), ROTR(x, 19)), SHR(x, 10))
+
+#define M(w0, w14, w9, w1) w0 = ADD(ADD(sigma1(w14), w9), ADD(sigma0(w1), w0));
+
+#define EXPAND           \
+    M(w0, w14, w9, w1)   \
+    M(w1, w15, w10, w2)  \
+    M(w2, w0, w11, w3)   \
+    M(w3, w1, w12, w4)   \
+    M(w4, w2, w13, w5)   \
+    M(w5, w3, w14, w6)   \
+    M(w6, w4, w15, w7)   \
+    M(w7, w5, w0, w8)    \
+    M(w8, w6, w1, w9)    \
+    M(w9, w7, w2, w10)   \
+    M(w10, w8, w3, w11)  \
+    M(w11, w9, w4, w12)  \
+    M(w12, w10, w5, w13) \
+    M(w13, w11, w6, w14) \
+    M(w14, w12, w7, w15) \
+    M(w15, w13, w8, w0)
+
+#define F(w, k)                                                         \
+    T1 = ADD(ADD(h, Sigma1(e)),                                         \
+             ADD(Ch(e, f, g), ADD(_mm_set1_epi32((int)(k)), w)));       \
+    T2 = ADD(Sigma0(a), Maj(a, b, c));                                  \
+    h = g;                                                              \
+    g = f;                                                              \
+    f = e;                                                              \
+    e = ADD(d, T1);                                                     \
+    d = c;                                                              \
+    c = b;                                                              \
+    b = a;                                                              \
+    a = ADD(T1, T2);
+
+/* Word i of the four states or blocks at p[0], ..., p[3], one per lane */
+#define GATHER(p, i) \
+    _mm_set_epi32((int)load_bigendian_32((p)[3] + 4*(i)), \
+                  (int)load_bigendian_32((p)[2] + 4*(i)), \
+                  (int)load_bigendian_32((p)[1] + 4*(i)), \
+                  (int)load_bigendian_32((p)[0] + 4*(i)))
+
+static void sha256x4_blocks(uint8_t *statex4, const uint8_t *in[4],
+                            size_t nblocks)
+{
+    uint8_t *states[4] = { statex4, statex4 + 40, statex4 + 80, statex4 + 120 };
+    const uint8_t *blocks[4] = { in[0], in[1], in[2], in[3] };
+    __m128i state[8];
+    __m128i a, b, c, d, e, f, g, h, T1, T2;
+    uint32_t lanes[4];
+    size_t blk;
+    unsigned int i, j;
+
+#ifdef SPX_SHA256_SHANI
+    if (SPX_SHA256_HAS_SHANI()) {
+        sha256x4_blocks_seq(statex4, in, nblocks);
+        return;
+    }
+#endif
+
+    for (i = 0; i < 8; i++) {
+        state[i] = GATHER(states, i);
+    }
+    a = state[0]; b = state[1]; c = state[2]; d = state[3];
+    e = state[4]; f = state[5]; g = state[6]; h = state[7];
+
+    for (blk = 0; blk < nblocks; blk++) {
+        __m128i w0  = GATHER(blocks, 0);
+        __m128i w1  = GATHER(blocks, 1);
+        __m128i w2  = GATHER(blocks, 2);
+        __m128i w3  = GATHER(blocks, 3);
+        __m128i w4  = GATHER(blocks, 4);
+        __m128i w5  = GATHER(blocks, 5);
+        __m128i w6  = GATHER(blocks, 6);
+        __m128i w7  = GATHER(blocks, 7);
+        __m128i w8  = GATHER(blocks, 8);
+        __m128i w9  = GATHER(blocks, 9);
+        __m128i w10 = GATHER(blocks, 10);
+        __m128i w11 = GATHER(blocks, 11);
+        __m128i w12 = GATHER(blocks, 12);
+        __m128i w13 = GATHER(blocks, 13);
+        __m128i w14 = GATHER(blocks, 14);
+        __m128i w15 = GATHER(blocks, 15);
+
+        F(w0, 0x428a2f98)
+        F(w1, 0x71374491)
+        F(w2, 0xb5c0fbcf)
+        F(w3, 0xe9b5dba5)
+        F(w4, 0x3956c25b)
+        F(w5, 0x59f111f1)
+        F(w6, 0x923f82a4)
+        F(w7, 0xab1c5ed5)
+        F(w8, 0xd807aa98)
+        F(w9, 0x12835b01)
+        F(w10, 0x243185be)
+        F(w11, 0x550c7dc3)
+        F(w12, 0x72be5d74)
+        F(w13, 0x80deb1fe)
+        F(w14, 0x9bdc06a7)
+        F(w15, 0xc19bf174)
+
+        EXPAND
+
+        F(w0, 0xe49b69c1)
+        F(w1, 0xefbe4786)
+        F(w2, 0x0fc19dc6)
+        F(w3, 0x240ca1cc)
+        F(w4, 0x2de92c6f)
+        F(w5, 0x4a7484aa)
+        F(w6, 0x5cb0a9dc)
+        F(w7, 0x76f988da)
+        F(w8, 0x983e5152)
+        F(w9, 0xa831c66d)
+        F(w10, 0xb00327c8)
+        F(w11, 0xbf597fc7)
+        F(w12, 0xc6e00bf3)
+        F(w13, 0xd5a79147)
+        F(w14, 0x06ca6351)
+        F(w15, 0x14292967)
+
+        EXPAND
+
+        F(w0, 0x27b70a85)
+        F(w1, 0x2e1b2138)
+        F(w2, 0x4d2c6dfc)
+        F(w3, 0x53380d13)
+        F(w4, 0x650a7354)
+        F(w5, 0x766a0abb)
+        F(w6, 0x81c2c92e)
+        F(w7, 0x92722c85)
+        F(w8, 0xa2bfe8a1)
+        F(w9, 0xa81a664b)
+        F(w10, 0xc24b8b70)
+        F(w11, 0xc76c51a3)
+        F(w12, 0xd192e819)
+        F(w13, 0xd6990624)
+        F(w14, 0xf40e3585)
+        F(w15, 0x106aa070)
+
+        EXPAND
+
+        F(w0, 0x19a4c116)
+        F(w1, 0x1e376c08)
+        F(w2, 0x2748774c)
+        F(w3, 0x34b0bcb5)
+        F(w4, 0x391c0cb3)
+        F(w5, 0x4ed8aa4a)
+        F(w6, 0x5b9cca4f)
+        F(w7, 0x682e6ff3)
+        F(w8, 0x748f82ee)
+        F(w9, 0x78a5636f)
+        F(w10, 0x84c87814)
+        F(w11, 0x8cc70208)
+        F(w12, 0x90befffa)
+        F(w13, 0xa4506ceb)
+        F(w14, 0xbef9a3f7)
+        F(w15, 0xc67178f2)
+
+        a = ADD(a, state[0]); b = ADD(b, state[1]);
+        c = ADD(c, state[2]); d = ADD(d, state[3]);
+        e = ADD(e, state[4]); f = ADD(f, state[5]);
+        g = ADD(g, state[6]); h = ADD(h, state[7]);
+
+        state[0] = a; state[1] = b; state[2] = c; state[3] = d;
+        state[4] = e; state[5] = f; state[6] = g; state[7] = h;
+
+        for (j = 0; j < 4; j++) {
+            blocks[j] += 64;
+        }
+    }
+
+    for (i = 0; i < 8; i++) {
+        _mm_storeu_si128((__m128i *)lanes, state[i]);
+        for (j = 0; j < 4; j++) {
+            ull_to_bytes(states[j] + 4*i, 4, lanes[j]);
+        }
+    }
+    for (j = 0; j < 4; j++) {
+        ull_to_bytes(states[j] + 32, 8,
+                     bytes_to_ull(states[j] + 32, 8) + 64*nblocks);
+    }
+}
+
+#else
+
+static void sha256x4_blocks(uint8_t *statex4, const uint8_t *in[4],
+                            size_t nblocks)
+{
+    sha256x4_blocks_seq(statex4, in, nblocks);
+}
+
+#endif
+
+void sha256x4_inc_finalize(uint8_t *out0, uint8_t *out1,
+                           uint8_t *out2, uint8_t *out3, uint8_t *statex4,
+                           const uint8_t *in0, const uint8_t *in1,
+                           const uint8_t *in2, const uint8_t *in3,
+                           size_t inlen)
+{
+    /* Room for the 0x80 byte and the 64-bit length */
+    size_t nblocks = (inlen + 9 + 63) / 64;
+    uint8_t padded[4][nblocks * 64];
+    const uint8_t *in[4] = { in0, in1, in2, in3 };
+    uint8_t *out[4] = { out0, out1, out2, out3 };
+    const uint8_t *blocks[4] = { padded[0], padded[1], padded[2], padded[3] };
+    unsigned long long bytes;
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        bytes = bytes_to_ull(statex4 + 40*j + 32, 8) + inlen;
+
+        memcpy(padded[j], in[j], inlen);
+        padded[j][inlen] = 0x80;
+        memset(padded[j] + inlen + 1, 0, nblocks*64 - inlen - 9);
+        ull_to_bytes(padded[j] + nblocks*64 - 8, 8, bytes << 3);
+    }
+
+    sha256x4_blocks(statex4, blocks, nblocks);
+
+    for (j = 0; j < 4; j++) {
+        memcpy(out[j], statex4 + 40*j, 32);
+    }
+}
+
+void sha256x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3,
+              const uint8_t *in0, const uint8_t *in1,
+              const uint8_t *in2, const uint8_t *in3, size_t inlen)
+{
+    uint8_t statex4[4*40];
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        sha256_inc_init(statex4 + 40*j);
+    }
+    sha256x4_inc_finalize(out0, out1, out2, out3, statex4,
+                          in0, in1, in2, in3, inlen);
+}
+
+void mgf1x4(unsigned char *out0, unsigned char *out1,
+            unsigned char *out2, unsigned char *out3, unsigned long outlen,
+            const unsigned char *in0, const unsigned char *in1,
+            const unsigned char *in2, const unsigned char *in3,
+            unsigned long inlen)
+{
+    unsigned char inbuf[4][inlen + 4];
+    unsigned char outbuf[4][SPX_SHA256_OUTPUT_BYTES];
+    const unsigned char *in[4] = { in0, in1, in2, in3 };
+    unsigned char *out[4] = { out0, out1, out2, out3 };
+    unsigned long i, len;
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(inbuf[j], in[j], inlen);
+    }
+
+    for (i = 0; i*SPX_SHA256_OUTPUT_BYTES < outlen; i++) {
+        for (j = 0; j < 4; j++) {
+            ull_to_bytes(inbuf[j] + inlen, 4, i);
+        }
+        sha256x4(outbuf[0], outbuf[1], outbuf[2], outbuf[3],
+                 inbuf[0], inbuf[1], inbuf[2], inbuf[3], inlen + 4);
+
+        len = outlen - i*SPX_SHA256_OUTPUT_BYTES;
+        if (len > SPX_SHA256_OUTPUT_BYTES) {
+            len = SPX_SHA256_OUTPUT_BYTES;
+        }
+        for (j = 0; j < 4; j++) {
+            memcpy(out[j] + i*SPX_SHA256_OUTPUT_BYTES, outbuf[j], len);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
+
+#include "../api.h"
+#include "../params.h"
+#include "../rng.h"
+#include "../address.h"
+#include "../context.h"
+#include "../hash.h"
+#include "../thash.h"
+
+#define SPX_MLEN 32
+#define SPX_KEYS 2
+#define SPX_ROUNDS 2
+
+static unsigned char pk[SPX_KEYS][SPX_PK_BYTES];
+static unsigned char sk[SPX_KEYS][SPX_SK_BYTES];
+
+/* Key 'key' signs and verifies SPX_ROUNDS messages in its own thread, while
+   the other key does the same. Its signatures must not verify under the
+   other key. */
+static void *sign_verify_thread(void *arg)
+{
+    unsigned int key = *(unsigned int *)arg;
+    unsigned char m[SPX_MLEN];
+    unsigned char sig[SPX_BYTES];
+    size_t siglen;
+    long ret = 0;
+    int i;
+
+    for (i = 0; i < SPX_ROUNDS; i++) {
+        memset(m, key * SPX_ROUNDS + i, SPX_MLEN);
+        crypto_sign_signature(sig, &siglen, m, SPX_MLEN, sk[key]);
+        if (crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk[key]) ||
+            !crypto_sign_verify(sig, siglen, m, SPX_MLEN, pk[1 - key])) {
+            ret = -1;
+        }
+    }
+    return (void *)ret;
+}
+
+/* Hashes a fixed input with thash under ctx. */
+static void hash_with(unsigned char *out, const spx_ctx *ctx)
+{
+    unsigned char in[2 * SPX_N];
+    uint32_t addr[8] = {0};
+
+    memset(in, 0xa5, sizeof(in));
+    set_type(addr, SPX_ADDR_TYPE_HASHTREE);
+    set_tree_height(addr, 1);
+    thash(out, in, 2, ctx, addr);
+}
+
+int main()
+{
+    int ret = 0;
+    unsigned int keys[SPX_KEYS];
+    pthread_t threads[SPX_KEYS];
+    spx_ctx ctx[SPX_KEYS];
+    spx_ctx ctx_public[SPX_KEYS];
+    unsigned char out[SPX_KEYS][SPX_N];
+    unsigned char out_public[SPX_N];
+    unsigned int i;
+    void *thread_ret;
+
+    /* Make stdout buffer more responsive. */
+    setbuf(stdout, NULL);
+
+    printf("Generating %d keypairs.. ", SPX_KEYS);
+    for (i = 0; i < SPX_KEYS; i++) {
+        if (crypto_sign_keypair(pk[i], sk[i])) {
+            printf("failed!\n");
+            return -1;
+        }
+    }
+    printf("successful.\n");
+
+    /* Contexts for both keys, in use at the same time. */
+    for (i = 0; i < SPX_KEYS; i++) {
+        memcpy(ctx[i].pub_seed, pk[i], SPX_N);
+        memcpy(ctx[i].sk_seed, sk[i], SPX_N);
+        initialize_hash_function(&ctx[i]);
+        memset(&ctx_public[i], 0, sizeof(spx_ctx));
+        memcpy(ctx_public[i].pub_seed, pk[i], SPX_N);
+        initialize_hash_function_public(&ctx_public[i]);
+    }
+    for (i = 0; i < SPX_KEYS; i++) {
+        hash_with(out[i], &ctx[i]);
+    }
+    for (i = 0; i < SPX_KEYS; i++) {
+        hash_with(out_public, &ctx_public[i]);
+        if (memcmp(out_public, out[i], SPX_N)) {
+            printf("  X public context of key %u hashes differently!\n", i);
+            ret = -1;
+        }
+    }
+    if (!memcmp(out[0], out[1], SPX_N)) {
+        printf("  X contexts of different keys hash the same!\n");
+        ret = -1;
+    }
+    if (!ret) {
+        printf("    public and full contexts hash the same.\n");
+    }
+
+    printf("Signing and verifying with %d keys in parallel.. ", SPX_KEYS);
+    for (i = 0; i < SPX_KEYS; i++) {
+        keys[i] = i;
+        if (pthread_create(&threads[i], NULL, sign_verify_thread, &keys[i])) {
+            printf("failed to start a thread!\n");
+            return -1;
+        }
+    }
+    for (i = 0; i < SPX_KEYS; i++) {
+        pthread_join(threads[i], &thread_ret);
+        if (thread_ret != NULL) {
+            ret = -1;
+        }
+    }
+    if (ret) {
+        printf("failed!\n");
+    }
+    else {
+        printf("successful.\n");
+    }
+
+    return ret;
+}
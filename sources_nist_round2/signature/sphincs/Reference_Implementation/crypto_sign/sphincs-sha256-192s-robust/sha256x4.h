@@ -0,0 +1,29 @@
+#ifndef SPX_SHA256X4_H
+#define SPX_SHA256X4_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sha256.h"
+
+/* Four instances of sha256_inc_finalize on inputs of equal length. The four
+   40-byte incremental states are stored one after the other in statex4. */
+void sha256x4_inc_finalize(uint8_t *out0, uint8_t *out1,
+                           uint8_t *out2, uint8_t *out3, uint8_t *statex4,
+                           const uint8_t *in0, const uint8_t *in1,
+                           const uint8_t *in2, const uint8_t *in3,
+                           size_t inlen);
+
+/* Four instances of sha256 on inputs of equal length. */
+void sha256x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3,
+              const uint8_t *in0, const uint8_t *in1,
+              const uint8_t *in2, const uint8_t *in3, size_t inlen);
+
+/* Four instances of mgf1 on inputs of equal length. */
+void mgf1x4(unsigned char *out0, unsigned char *out1,
+            unsigned char *out2, unsigned char *out3, unsigned long outlen,
+            const unsigned char *in0, const unsigned char *in1,
+            const unsigned char *in2, const unsigned char *in3,
+            unsigned long inlen);
+
+#endif
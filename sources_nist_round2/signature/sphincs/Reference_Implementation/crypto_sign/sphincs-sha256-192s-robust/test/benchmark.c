@@ -2,16 +2,22 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 #include "../api.h"
 #include "../fors.h"
+#include "../hash.h"
 #include "../wots.h"
 #include "../params.h"
 #include "../rng.h"
 
 #define SPX_MLEN 32
 #define NTESTS 10
+/* Memory to spend on caching the top layers of the hypertree. */
+#define SPX_CACHE_BUDGET (1 << 20)
+/* Number of signatures verified at once by crypto_sign_verify_batch. */
+#define SPX_BATCH 8
 
 static int cmp_llu(const void *a, const void*b)
 {
@@ -107,6 +113,16 @@ int main()
     unsigned char *m = malloc(SPX_MLEN);
     unsigned char *sm = malloc(SPX_BYTES + SPX_MLEN);
     unsigned char *mout = malloc(SPX_BYTES + SPX_MLEN);
+    unsigned int cache_layers = crypto_sign_cache_layers(SPX_CACHE_BUDGET);
+    size_t cachelen = crypto_sign_cache_bytes(cache_layers);
+    unsigned char *cache = malloc(cachelen);
+    size_t siglen;
+
+    const uint8_t *batch_sigs[SPX_BATCH];
+    const uint8_t *batch_ms[SPX_BATCH];
+    size_t batch_siglens[SPX_BATCH];
+    size_t batch_mlens[SPX_BATCH];
+    int batch_results[SPX_BATCH];
 
     unsigned char fors_pk[SPX_FORS_PK_BYTES];
     unsigned char fors_m[SPX_FORS_MSG_BYTES];
@@ -117,6 +133,8 @@ int main()
     unsigned char wots_m[SPX_N];
     unsigned char wots_pk[SPX_WOTS_PK_BYTES];
 
+    spx_ctx ctx;
+
     unsigned long long smlen;
     unsigned long long mlen;
     unsigned long long t[NTESTS+1];
@@ -134,13 +152,30 @@ int main()
     printf("Running %d iterations.\n", NTESTS);
 
     MEASURE("Generating keypair.. ", 1, crypto_sign_keypair(pk, sk));
-    MEASURE("  - WOTS pk gen..    ", (1 << SPX_TREE_HEIGHT), wots_gen_pk(wots_pk, sk, pk, (uint32_t *) addr));
+
+    memcpy(ctx.sk_seed, sk, SPX_N);
+    memcpy(ctx.pub_seed, pk, SPX_N);
+    initialize_hash_function(&ctx);
+
+    MEASURE("  - WOTS pk gen..    ", (1 << SPX_TREE_HEIGHT), wots_gen_pk(wots_pk, &ctx, (uint32_t *) addr));
     MEASURE("Signing..            ", 1, crypto_sign(sm, &smlen, m, SPX_MLEN, sk));
-    MEASURE("  - FORS signing..   ", 1, fors_sign(fors_sig, fors_pk, fors_m, sk, pk, (uint32_t *) addr));
-    MEASURE("  - WOTS signing..   ", SPX_D, wots_sign(wots_sig, wots_m, sk, pk, (uint32_t *) addr));
-    MEASURE("  - WOTS pk gen..    ", SPX_D * (1 << SPX_TREE_HEIGHT), wots_gen_pk(wots_pk, sk, pk, (uint32_t *) addr));
+    MEASURE("  - FORS signing..   ", 1, fors_sign(fors_sig, fors_pk, fors_m, &ctx, (uint32_t *) addr));
+    MEASURE("  - WOTS signing..   ", SPX_D, wots_sign(wots_sig, wots_m, &ctx, (uint32_t *) addr));
+    MEASURE("  - WOTS pk gen..    ", SPX_D * (1 << SPX_TREE_HEIGHT), wots_gen_pk(wots_pk, &ctx, (uint32_t *) addr));
     MEASURE("Verifying..          ", 1, crypto_sign_open(mout, &mlen, sm, smlen, pk));
 
+    for (i = 0; i < SPX_BATCH; i++) {
+        batch_sigs[i] = sm;
+        batch_ms[i] = sm + SPX_BYTES;
+        batch_siglens[i] = SPX_BYTES;
+        batch_mlens[i] = SPX_MLEN;
+    }
+    MEASURE("Verifying a batch..  ", 1, crypto_sign_verify_batch(batch_results, batch_sigs, batch_siglens, batch_ms, batch_mlens, SPX_BATCH, pk));
+
+    printf("Caching %u layer(s) in %zu bytes.\n", cache_layers, cachelen);
+    crypto_sign_cache_init(cache, cache_layers, sk);
+    MEASURE("Signing with cache.. ", 1, crypto_sign_signature_cached(sm, &siglen, m, SPX_MLEN, sk, cache, cachelen));
+
     printf("Signature size: %d (%.2f KiB)\n", SPX_BYTES, SPX_BYTES / 1024.0);
     printf("Public key size: %d (%.2f KiB)\n", SPX_PK_BYTES, SPX_PK_BYTES / 1024.0);
     printf("Secret key size: %d (%.2f KiB)\n", SPX_SK_BYTES, SPX_SK_BYTES / 1024.0);
@@ -148,6 +183,7 @@ int main()
     free(m);
     free(sm);
     free(mout);
+    free(cache);
 
     return 0;
 }
\ No newline at end of file
@@ -6,32 +6,62 @@
 #include "params.h"
 #include "hash.h"
 #include "sha256.h"
+#include "sha256x4.h"
 
-/* For SHA256, there is no immediate reason to initialize at the start,
-   so this function is an empty operation. */
-void initialize_hash_function(const unsigned char *pub_seed,
-                              const unsigned char *sk_seed)
+/* For SHA256, absorb pub_seed into the state that thash starts from. */
+void initialize_hash_function(spx_ctx *ctx)
 {
-    seed_state(pub_seed);
-    (void)sk_seed; /* Suppress an 'unused parameter' warning. */
+    seed_state(ctx->state_seeded, ctx->pub_seed);
+}
+
+/* The seeded state does not depend on sk_seed. */
+void initialize_hash_function_public(spx_ctx *ctx)
+{
+    initialize_hash_function(ctx);
 }
 
 /*
- * Computes PRF(key, addr), given a secret key of SPX_N bytes and an address
+ * Computes PRF(sk_seed, addr), given the secret seed in ctx and an address
  */
-void prf_addr(unsigned char *out, const unsigned char *key,
+void prf_addr(unsigned char *out, const spx_ctx *ctx,
               const uint32_t addr[8])
 {
     unsigned char buf[SPX_N + SPX_SHA256_ADDR_BYTES];
     unsigned char outbuf[SPX_SHA256_OUTPUT_BYTES];
 
-    memcpy(buf, key, SPX_N);
+    memcpy(buf, ctx->sk_seed, SPX_N);
     compress_address(buf + SPX_N, addr);
 
     sha256(outbuf, buf, SPX_N + SPX_SHA256_ADDR_BYTES);
     memcpy(out, outbuf, SPX_N);
 }
 
+/*
+ * Four instances of prf_addr, for the addresses addrx4, addrx4 + 8, etc.
+ */
+void prf_addrx4(unsigned char *out0, unsigned char *out1,
+                unsigned char *out2, unsigned char *out3,
+                const spx_ctx *ctx, const uint32_t addrx4[4*8])
+{
+    unsigned char bufx4[4][SPX_N + SPX_SHA256_ADDR_BYTES];
+    unsigned char outbufx4[4][SPX_SHA256_OUTPUT_BYTES];
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(bufx4[j], ctx->sk_seed, SPX_N);
+        compress_address(bufx4[j] + SPX_N, addrx4 + j*8);
+    }
+
+    sha256x4(outbufx4[0], outbufx4[1], outbufx4[2], outbufx4[3],
+             bufx4[0], bufx4[1], bufx4[2], bufx4[3],
+             SPX_N + SPX_SHA256_ADDR_BYTES);
+
+    memcpy(out0, outbufx4[0], SPX_N);
+    memcpy(out1, outbufx4[1], SPX_N);
+    memcpy(out2, outbufx4[2], SPX_N);
+    memcpy(out3, outbufx4[3], SPX_N);
+}
+
 /**
  * Computes the message-dependent randomness R, using a secret seed as a key
  * for HMAC, and an optional randomization value prefixed to the message.
@@ -42,12 +72,15 @@ void prf_addr(unsigned char *out, const unsigned char *key,
  */
 void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
                         const unsigned char *optrand,
-                        const unsigned char *m, unsigned long long mlen)
+                        const unsigned char *m, unsigned long long mlen,
+                        const spx_ctx *ctx)
 {
     unsigned char buf[SPX_SHA256_BLOCK_BYTES + SPX_SHA256_OUTPUT_BYTES];
     uint8_t state[40];
     int i;
 
+    (void)ctx; /* Suppress an 'unused parameter' warning. */
+
 #if SPX_N > SPX_SHA256_BLOCK_BYTES
     #error "Currently only supports SPX_N of at most SPX_SHA256_BLOCK_BYTES"
 #endif
@@ -95,7 +128,8 @@ void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
  */
 void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
                   const unsigned char *R, const unsigned char *pk,
-                  const unsigned char *m, unsigned long long mlen)
+                  const unsigned char *m, unsigned long long mlen,
+                  const spx_ctx *ctx)
 {
 #define SPX_TREE_BITS (SPX_TREE_HEIGHT * (SPX_D - 1))
 #define SPX_TREE_BYTES ((SPX_TREE_BITS + 7) / 8)
@@ -105,6 +139,8 @@ void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
 
     unsigned char seed[SPX_SHA256_OUTPUT_BYTES];
 
+    (void)ctx; /* Suppress an 'unused parameter' warning. */
+
     /* Round to nearest multiple of SPX_SHA256_BLOCK_BYTES */
 #if (SPX_SHA256_BLOCK_BYTES & (SPX_SHA256_BLOCK_BYTES-1)) != 0
     #error "Assumes that SPX_SHA256_BLOCK_BYTES is a power of 2"
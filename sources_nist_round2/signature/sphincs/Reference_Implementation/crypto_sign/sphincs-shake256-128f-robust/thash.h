@@ -3,7 +3,21 @@
 
 #include <stdint.h>
 
+#include "context.h"
+
 void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
-           const unsigned char *pub_seed, uint32_t addr[8]);
+           const spx_ctx *ctx, uint32_t addr[8]);
+
+/**
+ * Computes four independent tweakable hashes of inblocks blocks each, as
+ * thash does for (out0, in0, addrx4), (out1, in1, addrx4 + 8), etc.
+ * Each outi may equal ini.
+ */
+void thashx4(unsigned char *out0, unsigned char *out1,
+             unsigned char *out2, unsigned char *out3,
+             const unsigned char *in0, const unsigned char *in1,
+             const unsigned char *in2, const unsigned char *in3,
+             unsigned int inblocks,
+             const spx_ctx *ctx, uint32_t addrx4[4*8]);
 
 #endif
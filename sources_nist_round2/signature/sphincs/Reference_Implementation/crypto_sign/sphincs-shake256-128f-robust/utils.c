@@ -6,6 +6,10 @@
 #include "thash.h"
 #include "address.h"
 
+#if SPX_TREE_HEIGHT < 2 || SPX_FORS_HEIGHT < 2
+    #error treehash computes leaves in groups of four, so trees need height 2
+#endif
+
 /**
  * Converts the value of 'in' to 'outlen' bytes in big-endian byte order.
  */
@@ -42,7 +46,7 @@ unsigned long long bytes_to_ull(const unsigned char *in, unsigned int inlen)
 void compute_root(unsigned char *root, const unsigned char *leaf,
                   uint32_t leaf_idx, uint32_t idx_offset,
                   const unsigned char *auth_path, uint32_t tree_height,
-                  const unsigned char *pub_seed, uint32_t addr[8])
+                  const spx_ctx *ctx, uint32_t addr[8])
 {
     uint32_t i;
     unsigned char buffer[2 * SPX_N];
@@ -68,11 +72,11 @@ void compute_root(unsigned char *root, const unsigned char *leaf,
 
         /* Pick the right or left neighbor, depending on parity of the node. */
         if (leaf_idx & 1) {
-            thash(buffer + SPX_N, buffer, 2, pub_seed, addr);
+            thash(buffer + SPX_N, buffer, 2, ctx, addr);
             memcpy(buffer, auth_path, SPX_N);
         }
         else {
-            thash(buffer, buffer, 2, pub_seed, addr);
+            thash(buffer, buffer, 2, ctx, addr);
             memcpy(buffer + SPX_N, auth_path, SPX_N);
         }
         auth_path += SPX_N;
@@ -83,7 +87,54 @@ void compute_root(unsigned char *root, const unsigned char *leaf,
     idx_offset >>= 1;
     set_tree_height(addr, tree_height);
     set_tree_index(addr, leaf_idx + idx_offset);
-    thash(root, buffer, 2, pub_seed, addr);
+    thash(root, buffer, 2, ctx, addr);
+}
+
+/**
+ * Four instances of compute_root, hashing the four paths side by side. Takes
+ * the leaf, leaf index, auth path and address (addrx4 + 8*j) of each path j,
+ * and writes its root to root[j]. The paths share idx_offset and tree_height.
+ */
+void compute_rootx4(unsigned char *root[4], const unsigned char *leaf[4],
+                    const uint32_t leaf_idx[4], uint32_t idx_offset,
+                    const unsigned char *auth_path[4], uint32_t tree_height,
+                    const spx_ctx *ctx, uint32_t addrx4[4*8])
+{
+    unsigned char buffer[4][2 * SPX_N];
+    const unsigned char *auth[4];
+    uint32_t idx[4];
+    uint32_t i;
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(root[j], leaf[j], SPX_N);
+        auth[j] = auth_path[j];
+        idx[j] = leaf_idx[j];
+    }
+
+    for (i = 0; i < tree_height; i++) {
+        idx_offset >>= 1;
+        for (j = 0; j < 4; j++) {
+            /* Put the node left or right of its neighbor on the auth path,
+               depending on the parity of its index. */
+            if (idx[j] & 1) {
+                memcpy(buffer[j], auth[j], SPX_N);
+                memcpy(buffer[j] + SPX_N, root[j], SPX_N);
+            }
+            else {
+                memcpy(buffer[j], root[j], SPX_N);
+                memcpy(buffer[j] + SPX_N, auth[j], SPX_N);
+            }
+            auth[j] += SPX_N;
+            idx[j] >>= 1;
+
+            /* Set the address of the node we're creating. */
+            set_tree_height(addrx4 + j*8, i + 1);
+            set_tree_index(addrx4 + j*8, idx[j] + idx_offset);
+        }
+        thashx4(root[0], root[1], root[2], root[3],
+                buffer[0], buffer[1], buffer[2], buffer[3], 2, ctx, addrx4);
+    }
 }
 
 /**
@@ -95,12 +146,11 @@ void compute_root(unsigned char *root, const unsigned char *leaf,
  * it is possible to continue counting indices across trees.
  */
 void treehash(unsigned char *root, unsigned char *auth_path,
-              const unsigned char *sk_seed, const unsigned char *pub_seed,
+              const spx_ctx *ctx,
               uint32_t leaf_idx, uint32_t idx_offset, uint32_t tree_height,
-              void (*gen_leaf)(
-                 unsigned char* /* leaf */,
-                 const unsigned char* /* sk_seed */,
-                 const unsigned char* /* pub_seed */,
+              void (*gen_leafx4)(
+                 unsigned char* /* leaves (4 * SPX_N bytes) */,
+                 const spx_ctx* /* ctx */,
                  uint32_t /* addr_idx */, const uint32_t[8] /* tree_addr */),
               uint32_t tree_addr[8])
 {
@@ -109,11 +159,15 @@ void treehash(unsigned char *root, unsigned char *auth_path,
     unsigned int offset = 0;
     uint32_t idx;
     uint32_t tree_idx;
+    unsigned char leaves[4 * SPX_N];
 
     for (idx = 0; idx < (uint32_t)(1 << tree_height); idx++) {
+        /* Compute the leaves in groups of four. */
+        if ((idx & 3) == 0) {
+            gen_leafx4(leaves, ctx, idx + idx_offset, tree_addr);
+        }
         /* Add the next leaf node to the stack. */
-        gen_leaf(stack + offset*SPX_N,
-                 sk_seed, pub_seed, idx + idx_offset, tree_addr);
+        memcpy(stack + offset*SPX_N, leaves + (idx & 3)*SPX_N, SPX_N);
         offset++;
         heights[offset - 1] = 0;
 
@@ -133,7 +187,7 @@ void treehash(unsigned char *root, unsigned char *auth_path,
                            tree_idx + (idx_offset >> (heights[offset-1] + 1)));
             /* Hash the top-most nodes from the stack together. */
             thash(stack + (offset - 2)*SPX_N,
-                  stack + (offset - 2)*SPX_N, 2, pub_seed, tree_addr);
+                  stack + (offset - 2)*SPX_N, 2, ctx, tree_addr);
             offset--;
             /* Note that the top-most node is now one layer higher. */
             heights[offset - 1]++;
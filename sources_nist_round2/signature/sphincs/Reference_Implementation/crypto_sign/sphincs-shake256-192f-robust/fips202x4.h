@@ -0,0 +1,15 @@
+#ifndef SPX_FIPS202X4_H
+#define SPX_FIPS202X4_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fips202.h"
+
+/* Four instances of shake256 on inputs of equal length. */
+void shake256x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3,
+                size_t outlen,
+                const uint8_t *in0, const uint8_t *in1,
+                const uint8_t *in2, const uint8_t *in3, size_t inlen);
+
+#endif
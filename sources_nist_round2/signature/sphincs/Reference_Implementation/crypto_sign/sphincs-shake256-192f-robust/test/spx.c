@@ -117,6 +117,50 @@ int main()
 #endif
     }
 
+    /* Test batch verification, with valid and invalid signatures mixed. */
+    printf("Testing batch verification.. \n");
+    {
+        unsigned char *m2 = malloc(SPX_MLEN);
+        unsigned char *sig1 = malloc(SPX_BYTES);
+        unsigned char *sig2 = malloc(SPX_BYTES);
+        size_t siglen;
+        const uint8_t *sigs[6] = { sig1, sig2, sig1, sig1, sig2, sig2 };
+        const uint8_t *ms[6] = { m, m2, m2, m, m2, m };
+        size_t siglens[6] = { SPX_BYTES, SPX_BYTES, SPX_BYTES, SPX_BYTES - 1,
+                              SPX_BYTES, SPX_BYTES };
+        size_t mlens[6] = { SPX_MLEN, SPX_MLEN, SPX_MLEN, SPX_MLEN,
+                            SPX_MLEN, SPX_MLEN };
+        int expected[6] = { 0, 0, -1, -1, 0, -1 };
+        int results[6];
+
+        randombytes(m2, SPX_MLEN);
+        crypto_sign_signature(sig1, &siglen, m, SPX_MLEN, sk);
+        crypto_sign_signature(sig2, &siglen, m2, SPX_MLEN, sk);
+
+        if (crypto_sign_verify_batch(results, sigs, siglens, ms, mlens,
+                                     6, pk) != -1 ||
+            memcmp(results, expected, sizeof(results))) {
+            printf("  X batch verification results incorrect!\n");
+            ret = -1;
+        }
+        else {
+            printf("    batch verification results as expected.\n");
+        }
+
+        if (crypto_sign_verify_batch(results, sigs, siglens, ms, mlens,
+                                     2, pk)) {
+            printf("  X batch verification of valid signatures failed!\n");
+            ret = -1;
+        }
+        else {
+            printf("    batch verification of valid signatures succeeded.\n");
+        }
+
+        free(m2);
+        free(sig1);
+        free(sig2);
+    }
+
     free(m);
     free(sm);
     free(mout);
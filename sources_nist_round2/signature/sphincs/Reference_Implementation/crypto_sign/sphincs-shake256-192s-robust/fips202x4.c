@@ -0,0 +1,435 @@
+/* Four SHAKE256 computations on inputs of equal length. With AVX2, the four
+ * Keccak states are interleaved so that each 256-bit register holds the same
+ * lane of all four of them; otherwise the inputs are hashed one by one.
+ * The AVX2 code is compiled in on x86 with gcc or clang and selected at run
+ * time; defining SPX_NO_SIMD_DISPATCH leaves only the portable code. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fips202x4.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) \
+    && !defined(SPX_NO_SIMD_DISPATCH)
+#define SPX_SHAKE256X4_AVX2
+#include <immintrin.h>
+
+#define AVX2 __attribute__((target("avx2")))
+
+#define NROUNDS 24
+#define ROL(a, offset) _mm256_or_si256(_mm256_slli_epi64(a, offset), \
+                                       _mm256_srli_epi64(a, 64 - (offset)))
+#define XOR(a, b) _mm256_xor_si256(a, b)
+#define XOR5(a, b, c, d, e) XOR(XOR(XOR(a, b), XOR(c, d)), e)
+#define ANDNOT(a, b) _mm256_andnot_si256(a, b)
+#define RC(i) _mm256_set1_epi64x((long long)KeccakF_RoundConstants[i])
+
+/* Keccak round constants */
+static const uint64_t KeccakF_RoundConstants[NROUNDS] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL,
+    0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL,
+    0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL,
+    0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL,
+    0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL,
+    0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL,
+    0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+/*************************************************
+ * Name:        load64
+ *
+ * Description: Load 8 bytes into uint64_t in little-endian order
+ *
+ * Arguments:   - const uint8_t *x: pointer to input byte array
+ *
+ * Returns the loaded 64-bit unsigned integer
+ **************************************************/
+static uint64_t load64(const uint8_t *x) {
+    uint64_t r = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        r |= (uint64_t)x[i] << 8 * i;
+    }
+
+    return r;
+}
+
+/*************************************************
+ * Name:        store64
+ *
+ * Description: Store a 64-bit integer to a byte array in little-endian order
+ *
+ * Arguments:   - uint8_t *x: pointer to the output byte array
+ *              - uint64_t u: input 64-bit unsigned integer
+ **************************************************/
+static void store64(uint8_t *x, uint64_t u) {
+    for (size_t i = 0; i < 8; ++i) {
+        x[i] = (uint8_t) (u >> 8 * i);
+    }
+}
+
+/*************************************************
+ * Name:        KeccakF1600_StatePermutex4
+ *
+ * Description: The Keccak F1600 Permutation, applied to four interleaved
+ *              states
+ *
+ * Arguments:   - __m256i *state: pointer to input/output Keccak states
+ **************************************************/
+static AVX2 void KeccakF1600_StatePermutex4(__m256i *state) {
+    int round;
+
+    __m256i Aba, Abe, Abi, Abo, Abu;
+    __m256i Aga, Age, Agi, Ago, Agu;
+    __m256i Aka, Ake, Aki, Ako, Aku;
+    __m256i Ama, Ame, Ami, Amo, Amu;
+    __m256i Asa, Ase, Asi, Aso, Asu;
+    __m256i BCa, BCe, BCi, BCo, BCu;
+    __m256i Da, De, Di, Do, Du;
+    __m256i Eba, Ebe, Ebi, Ebo, Ebu;
+    __m256i Ega, Ege, Egi, Ego, Egu;
+    __m256i Eka, Eke, Eki, Eko, Eku;
+    __m256i Ema, Eme, Emi, Emo, Emu;
+    __m256i Esa, Ese, Esi, Eso, Esu;
+
+    // copyFromState(A, state)
+    Aba = state[0];
+    Abe = state[1];
+    Abi = state[2];
+    Abo = state[3];
+    Abu = state[4];
+    Aga = state[5];
+    Age = state[6];
+    Agi = state[7];
+    Ago = state[8];
+    Agu = state[9];
+    Aka = state[10];
+    Ake = state[11];
+    Aki = state[12];
+    Ako = state[13];
+    Aku = state[14];
+    Ama = state[15];
+    Ame = state[16];
+    Ami = state[17];
+    Amo = state[18];
+    Amu = state[19];
+    Asa = state[20];
+    Ase = state[21];
+    Asi = state[22];
+    Aso = state[23];
+    Asu = state[24];
+
+    for (round = 0; round < NROUNDS; round += 2) {
+        //    prepareTheta
+        BCa = XOR5(Aba, Aga, Aka, Ama, Asa);
+        BCe = XOR5(Abe, Age, Ake, Ame, Ase);
+        BCi = XOR5(Abi, Agi, Aki, Ami, Asi);
+        BCo = XOR5(Abo, Ago, Ako, Amo, Aso);
+        BCu = XOR5(Abu, Agu, Aku, Amu, Asu);
+
+        // thetaRhoPiChiIotaPrepareTheta(round  , A, E)
+        Da = XOR(BCu, ROL(BCe, 1));
+        De = XOR(BCa, ROL(BCi, 1));
+        Di = XOR(BCe, ROL(BCo, 1));
+        Do = XOR(BCi, ROL(BCu, 1));
+        Du = XOR(BCo, ROL(BCa, 1));
+
+        Aba = XOR(Aba, Da);
+        BCa = Aba;
+        Age = XOR(Age, De);
+        BCe = ROL(Age, 44);
+        Aki = XOR(Aki, Di);
+        BCi = ROL(Aki, 43);
+        Amo = XOR(Amo, Do);
+        BCo = ROL(Amo, 21);
+        Asu = XOR(Asu, Du);
+        BCu = ROL(Asu, 14);
+        Eba = XOR(BCa, ANDNOT(BCe, BCi));
+        Eba = XOR(Eba, RC(round));
+        Ebe = XOR(BCe, ANDNOT(BCi, BCo));
+        Ebi = XOR(BCi, ANDNOT(BCo, BCu));
+        Ebo = XOR(BCo, ANDNOT(BCu, BCa));
+        Ebu = XOR(BCu, ANDNOT(BCa, BCe));
+
+        Abo = XOR(Abo, Do);
+        BCa = ROL(Abo, 28);
+        Agu = XOR(Agu, Du);
+        BCe = ROL(Agu, 20);
+        Aka = XOR(Aka, Da);
+        BCi = ROL(Aka, 3);
+        Ame = XOR(Ame, De);
+        BCo = ROL(Ame, 45);
+        Asi = XOR(Asi, Di);
+        BCu = ROL(Asi, 61);
+        Ega = XOR(BCa, ANDNOT(BCe, BCi));
+        Ege = XOR(BCe, ANDNOT(BCi, BCo));
+        Egi = XOR(BCi, ANDNOT(BCo, BCu));
+        Ego = XOR(BCo, ANDNOT(BCu, BCa));
+        Egu = XOR(BCu, ANDNOT(BCa, BCe));
+
+        Abe = XOR(Abe, De);
+        BCa = ROL(Abe, 1);
+        Agi = XOR(Agi, Di);
+        BCe = ROL(Agi, 6);
+        Ako = XOR(Ako, Do);
+        BCi = ROL(Ako, 25);
+        Amu = XOR(Amu, Du);
+        BCo = ROL(Amu, 8);
+        Asa = XOR(Asa, Da);
+        BCu = ROL(Asa, 18);
+        Eka = XOR(BCa, ANDNOT(BCe, BCi));
+        Eke = XOR(BCe, ANDNOT(BCi, BCo));
+        Eki = XOR(BCi, ANDNOT(BCo, BCu));
+        Eko = XOR(BCo, ANDNOT(BCu, BCa));
+        Eku = XOR(BCu, ANDNOT(BCa, BCe));
+
+        Abu = XOR(Abu, Du);
+        BCa = ROL(Abu, 27);
+        Aga = XOR(Aga, Da);
+        BCe = ROL(Aga, 36);
+        Ake = XOR(Ake, De);
+        BCi = ROL(Ake, 10);
+        Ami = XOR(Ami, Di);
+        BCo = ROL(Ami, 15);
+        Aso = XOR(Aso, Do);
+        BCu = ROL(Aso, 56);
+        Ema = XOR(BCa, ANDNOT(BCe, BCi));
+        Eme = XOR(BCe, ANDNOT(BCi, BCo));
+        Emi = XOR(BCi, ANDNOT(BCo, BCu));
+        Emo = XOR(BCo, ANDNOT(BCu, BCa));
+        Emu = XOR(BCu, ANDNOT(BCa, BCe));
+
+        Abi = XOR(Abi, Di);
+        BCa = ROL(Abi, 62);
+        Ago = XOR(Ago, Do);
+        BCe = ROL(Ago, 55);
+        Aku = XOR(Aku, Du);
+        BCi = ROL(Aku, 39);
+        Ama = XOR(Ama, Da);
+        BCo = ROL(Ama, 41);
+        Ase = XOR(Ase, De);
+        BCu = ROL(Ase, 2);
+        Esa = XOR(BCa, ANDNOT(BCe, BCi));
+        Ese = XOR(BCe, ANDNOT(BCi, BCo));
+        Esi = XOR(BCi, ANDNOT(BCo, BCu));
+        Eso = XOR(BCo, ANDNOT(BCu, BCa));
+        Esu = XOR(BCu, ANDNOT(BCa, BCe));
+
+        //    prepareTheta
+        BCa = XOR5(Eba, Ega, Eka, Ema, Esa);
+        BCe = XOR5(Ebe, Ege, Eke, Eme, Ese);
+        BCi = XOR5(Ebi, Egi, Eki, Emi, Esi);
+        BCo = XOR5(Ebo, Ego, Eko, Emo, Eso);
+        BCu = XOR5(Ebu, Egu, Eku, Emu, Esu);
+
+        // thetaRhoPiChiIotaPrepareTheta(round+1, E, A)
+        Da = XOR(BCu, ROL(BCe, 1));
+        De = XOR(BCa, ROL(BCi, 1));
+        Di = XOR(BCe, ROL(BCo, 1));
+        Do = XOR(BCi, ROL(BCu, 1));
+        Du = XOR(BCo, ROL(BCa, 1));
+
+        Eba = XOR(Eba, Da);
+        BCa = Eba;
+        Ege = XOR(Ege, De);
+        BCe = ROL(Ege, 44);
+        Eki = XOR(Eki, Di);
+        BCi = ROL(Eki, 43);
+        Emo = XOR(Emo, Do);
+        BCo = ROL(Emo, 21);
+        Esu = XOR(Esu, Du);
+        BCu = ROL(Esu, 14);
+        Aba = XOR(BCa, ANDNOT(BCe, BCi));
+        Aba = XOR(Aba, RC(round + 1));
+        Abe = XOR(BCe, ANDNOT(BCi, BCo));
+        Abi = XOR(BCi, ANDNOT(BCo, BCu));
+        Abo = XOR(BCo, ANDNOT(BCu, BCa));
+        Abu = XOR(BCu, ANDNOT(BCa, BCe));
+
+        Ebo = XOR(Ebo, Do);
+        BCa = ROL(Ebo, 28);
+        Egu = XOR(Egu, Du);
+        BCe = ROL(Egu, 20);
+        Eka = XOR(Eka, Da);
+        BCi = ROL(Eka, 3);
+        Eme = XOR(Eme, De);
+        BCo = ROL(Eme, 45);
+        Esi = XOR(Esi, Di);
+        BCu = ROL(Esi, 61);
+        Aga = XOR(BCa, ANDNOT(BCe, BCi));
+        Age = XOR(BCe, ANDNOT(BCi, BCo));
+        Agi = XOR(BCi, ANDNOT(BCo, BCu));
+        Ago = XOR(BCo, ANDNOT(BCu, BCa));
+        Agu = XOR(BCu, ANDNOT(BCa, BCe));
+
+        Ebe = XOR(Ebe, De);
+        BCa = ROL(Ebe, 1);
+        Egi = XOR(Egi, Di);
+        BCe = ROL(Egi, 6);
+        Eko = XOR(Eko, Do);
+        BCi = ROL(Eko, 25);
+        Emu = XOR(Emu, Du);
+        BCo = ROL(Emu, 8);
+        Esa = XOR(Esa, Da);
+        BCu = ROL(Esa, 18);
+        Aka = XOR(BCa, ANDNOT(BCe, BCi));
+        Ake = XOR(BCe, ANDNOT(BCi, BCo));
+        Aki = XOR(BCi, ANDNOT(BCo, BCu));
+        Ako = XOR(BCo, ANDNOT(BCu, BCa));
+        Aku = XOR(BCu, ANDNOT(BCa, BCe));
+
+        Ebu = XOR(Ebu, Du);
+        BCa = ROL(Ebu, 27);
+        Ega = XOR(Ega, Da);
+        BCe = ROL(Ega, 36);
+        Eke = XOR(Eke, De);
+        BCi = ROL(Eke, 10);
+        Emi = XOR(Emi, Di);
+        BCo = ROL(Emi, 15);
+        Eso = XOR(Eso, Do);
+        BCu = ROL(Eso, 56);
+        Ama = XOR(BCa, ANDNOT(BCe, BCi));
+        Ame = XOR(BCe, ANDNOT(BCi, BCo));
+        Ami = XOR(BCi, ANDNOT(BCo, BCu));
+        Amo = XOR(BCo, ANDNOT(BCu, BCa));
+        Amu = XOR(BCu, ANDNOT(BCa, BCe));
+
+        Ebi = XOR(Ebi, Di);
+        BCa = ROL(Ebi, 62);
+        Ego = XOR(Ego, Do);
+        BCe = ROL(Ego, 55);
+        Eku = XOR(Eku, Du);
+        BCi = ROL(Eku, 39);
+        Ema = XOR(Ema, Da);
+        BCo = ROL(Ema, 41);
+        Ese = XOR(Ese, De);
+        BCu = ROL(Ese, 2);
+        Asa = XOR(BCa, ANDNOT(BCe, BCi));
+        Ase = XOR(BCe, ANDNOT(BCi, BCo));
+        Asi = XOR(BCi, ANDNOT(BCo, BCu));
+        Aso = XOR(BCo, ANDNOT(BCu, BCa));
+        Asu = XOR(BCu, ANDNOT(BCa, BCe));
+    }
+
+    // copyToState(state, A)
+    state[0] = Aba;
+    state[1] = Abe;
+    state[2] = Abi;
+    state[3] = Abo;
+    state[4] = Abu;
+    state[5] = Aga;
+    state[6] = Age;
+    state[7] = Agi;
+    state[8] = Ago;
+    state[9] = Agu;
+    state[10] = Aka;
+    state[11] = Ake;
+    state[12] = Aki;
+    state[13] = Ako;
+    state[14] = Aku;
+    state[15] = Ama;
+    state[16] = Ame;
+    state[17] = Ami;
+    state[18] = Amo;
+    state[19] = Amu;
+    state[20] = Asa;
+    state[21] = Ase;
+    state[22] = Asi;
+    state[23] = Aso;
+    state[24] = Asu;
+}
+
+/* Lane i of the four states, XORed with eight bytes of each input */
+static AVX2 __m256i xor_lanes(__m256i s, const uint8_t *in[4], size_t i) {
+    __m256i m = _mm256_set_epi64x((long long)load64(in[3] + 8*i),
+                                  (long long)load64(in[2] + 8*i),
+                                  (long long)load64(in[1] + 8*i),
+                                  (long long)load64(in[0] + 8*i));
+    return XOR(s, m);
+}
+
+static AVX2 void shake256x4_avx2(uint8_t *out0, uint8_t *out1,
+                                 uint8_t *out2, uint8_t *out3, size_t outlen,
+                                 const uint8_t *in0, const uint8_t *in1,
+                                 const uint8_t *in2, const uint8_t *in3,
+                                 size_t inlen) {
+    const uint8_t *in[4] = { in0, in1, in2, in3 };
+    uint8_t *out[4] = { out0, out1, out2, out3 };
+    uint8_t t[4][SHAKE256_RATE];
+    const uint8_t *tp[4] = { t[0], t[1], t[2], t[3] };
+    uint64_t lanes[4];
+    __m256i s[25];
+    size_t i, j, n;
+
+    for (i = 0; i < 25; ++i) {
+        s[i] = _mm256_setzero_si256();
+    }
+
+    /* Absorb */
+    while (inlen >= SHAKE256_RATE) {
+        for (i = 0; i < SHAKE256_RATE / 8; ++i) {
+            s[i] = xor_lanes(s[i], in, i);
+        }
+        KeccakF1600_StatePermutex4(s);
+        for (j = 0; j < 4; ++j) {
+            in[j] += SHAKE256_RATE;
+        }
+        inlen -= SHAKE256_RATE;
+    }
+
+    for (j = 0; j < 4; ++j) {
+        for (i = 0; i < SHAKE256_RATE; ++i) {
+            t[j][i] = 0;
+        }
+        for (i = 0; i < inlen; ++i) {
+            t[j][i] = in[j][i];
+        }
+        t[j][i] = 0x1F;
+        t[j][SHAKE256_RATE - 1] |= 128;
+    }
+    for (i = 0; i < SHAKE256_RATE / 8; ++i) {
+        s[i] = xor_lanes(s[i], tp, i);
+    }
+
+    /* Squeeze */
+    while (outlen > 0) {
+        KeccakF1600_StatePermutex4(s);
+        n = outlen < SHAKE256_RATE ? outlen : SHAKE256_RATE;
+        for (i = 0; i < SHAKE256_RATE / 8; ++i) {
+            _mm256_storeu_si256((__m256i *)lanes, s[i]);
+            for (j = 0; j < 4; ++j) {
+                store64(t[j] + 8*i, lanes[j]);
+            }
+        }
+        for (j = 0; j < 4; ++j) {
+            for (i = 0; i < n; ++i) {
+                out[j][i] = t[j][i];
+            }
+            out[j] += n;
+        }
+        outlen -= n;
+    }
+}
+
+#endif
+
+void shake256x4(uint8_t *out0, uint8_t *out1, uint8_t *out2, uint8_t *out3,
+                size_t outlen,
+                const uint8_t *in0, const uint8_t *in1,
+                const uint8_t *in2, const uint8_t *in3, size_t inlen) {
+#ifdef SPX_SHAKE256X4_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        shake256x4_avx2(out0, out1, out2, out3, outlen,
+                        in0, in1, in2, in3, inlen);
+        return;
+    }
+#endif
+    shake256(out0, outlen, in0, inlen);
+    shake256(out1, outlen, in1, inlen);
+    shake256(out2, outlen, in2, inlen);
+    shake256(out3, outlen, in3, inlen);
+}
@@ -6,40 +6,66 @@
 #include "params.h"
 #include "hash.h"
 #include "fips202.h"
+#include "fips202x4.h"
 
 /* For SHAKE256, there is no immediate reason to initialize at the start,
    so this function is an empty operation. */
-void initialize_hash_function(const unsigned char *pub_seed,
-                              const unsigned char *sk_seed)
+void initialize_hash_function(spx_ctx *ctx)
 {
-    (void)pub_seed; /* Suppress an 'unused parameter' warning. */
-    (void)sk_seed; /* Suppress an 'unused parameter' warning. */
+    (void)ctx; /* Suppress an 'unused parameter' warning. */
+}
+
+void initialize_hash_function_public(spx_ctx *ctx)
+{
+    (void)ctx; /* Suppress an 'unused parameter' warning. */
 }
 
 /*
- * Computes PRF(key, addr), given a secret key of SPX_N bytes and an address
+ * Computes PRF(sk_seed, addr), given the secret seed in ctx and an address
  */
-void prf_addr(unsigned char *out, const unsigned char *key,
+void prf_addr(unsigned char *out, const spx_ctx *ctx,
               const uint32_t addr[8])
 {
     unsigned char buf[SPX_N + SPX_ADDR_BYTES];
 
-    memcpy(buf, key, SPX_N);
+    memcpy(buf, ctx->sk_seed, SPX_N);
     addr_to_bytes(buf + SPX_N, addr);
 
     shake256(out, SPX_N, buf, SPX_N + SPX_ADDR_BYTES);
 }
 
+/*
+ * Four instances of prf_addr, for the addresses addrx4, addrx4 + 8, etc.
+ */
+void prf_addrx4(unsigned char *out0, unsigned char *out1,
+                unsigned char *out2, unsigned char *out3,
+                const spx_ctx *ctx, const uint32_t addrx4[4*8])
+{
+    unsigned char bufx4[4][SPX_N + SPX_ADDR_BYTES];
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(bufx4[j], ctx->sk_seed, SPX_N);
+        addr_to_bytes(bufx4[j] + SPX_N, addrx4 + j*8);
+    }
+
+    shake256x4(out0, out1, out2, out3, SPX_N,
+               bufx4[0], bufx4[1], bufx4[2], bufx4[3], SPX_N + SPX_ADDR_BYTES);
+}
+
 /**
  * Computes the message-dependent randomness R, using a secret seed and an
  * optional randomization value as well as the message.
  */
 void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
                         const unsigned char *optrand,
-                        const unsigned char *m, unsigned long long mlen)
+                        const unsigned char *m, unsigned long long mlen,
+                        const spx_ctx *ctx)
 {
     uint64_t s_inc[26];
 
+    (void)ctx; /* Suppress an 'unused parameter' warning. */
+
     shake256_inc_init(s_inc);
     shake256_inc_absorb(s_inc, sk_prf, SPX_N);
     shake256_inc_absorb(s_inc, optrand, SPX_N);
@@ -55,7 +81,8 @@ void gen_message_random(unsigned char *R, const unsigned char *sk_prf,
  */
 void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
                   const unsigned char *R, const unsigned char *pk,
-                  const unsigned char *m, unsigned long long mlen)
+                  const unsigned char *m, unsigned long long mlen,
+                  const spx_ctx *ctx)
 {
 #define SPX_TREE_BITS (SPX_TREE_HEIGHT * (SPX_D - 1))
 #define SPX_TREE_BYTES ((SPX_TREE_BITS + 7) / 8)
@@ -67,6 +94,8 @@ void hash_message(unsigned char *digest, uint64_t *tree, uint32_t *leaf_idx,
     unsigned char *bufp = buf;
     uint64_t s_inc[26];
 
+    (void)ctx; /* Suppress an 'unused parameter' warning. */
+
     shake256_inc_init(s_inc);
     shake256_inc_absorb(s_inc, R, SPX_N);
     shake256_inc_absorb(s_inc, pk, SPX_PK_BYTES);
@@ -2,6 +2,7 @@
 #include <string.h>
 
 #include "../fors.h"
+#include "../hash.h"
 #include "../rng.h"
 #include "../params.h"
 
@@ -10,23 +11,23 @@ int main()
     /* Make stdout buffer more responsive. */
     setbuf(stdout, NULL);
 
-    unsigned char sk_seed[SPX_N];
-    unsigned char pub_seed[SPX_N];
+    spx_ctx ctx;
     unsigned char pk1[SPX_FORS_PK_BYTES];
     unsigned char pk2[SPX_FORS_PK_BYTES];
     unsigned char sig[SPX_FORS_BYTES];
     unsigned char m[SPX_FORS_MSG_BYTES];
     uint32_t addr[8] = {0};
 
-    randombytes(sk_seed, SPX_N);
-    randombytes(pub_seed, SPX_N);
+    randombytes(ctx.sk_seed, SPX_N);
+    randombytes(ctx.pub_seed, SPX_N);
+    initialize_hash_function(&ctx);
     randombytes(m, SPX_FORS_MSG_BYTES);
     randombytes((unsigned char *)addr, 8 * sizeof(uint32_t));
 
     printf("Testing FORS signature and PK derivation.. ");
 
-    fors_sign(sig, pk1, m, sk_seed, pub_seed, addr);
-    fors_pk_from_sig(pk2, sig, m, pub_seed, addr);
+    fors_sign(sig, pk1, m, &ctx, addr);
+    fors_pk_from_sig(pk2, sig, m, &ctx, addr);
 
     if (memcmp(pk1, pk2, SPX_FORS_PK_BYTES)) {
         printf("failed!\n");
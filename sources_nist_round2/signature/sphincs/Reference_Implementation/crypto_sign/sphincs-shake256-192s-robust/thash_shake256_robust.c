@@ -6,18 +6,19 @@
 #include "params.h"
 
 #include "fips202.h"
+#include "fips202x4.h"
 
 /**
  * Takes an array of inblocks concatenated arrays of SPX_N bytes.
  */
 void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
-           const unsigned char *pub_seed, uint32_t addr[8])
+           const spx_ctx *ctx, uint32_t addr[8])
 {
     unsigned char buf[SPX_N + SPX_ADDR_BYTES + inblocks*SPX_N];
     unsigned char bitmask[inblocks * SPX_N];
     unsigned int i;
 
-    memcpy(buf, pub_seed, SPX_N);
+    memcpy(buf, ctx->pub_seed, SPX_N);
     addr_to_bytes(buf + SPX_N, addr);
 
     shake256(bitmask, inblocks * SPX_N, buf, SPX_N + SPX_ADDR_BYTES);
@@ -28,3 +29,38 @@ void thash(unsigned char *out, const unsigned char *in, unsigned int inblocks,
 
     shake256(out, SPX_N, buf, SPX_N + SPX_ADDR_BYTES + inblocks*SPX_N);
 }
+
+/**
+ * Four instances of thash, on inputs of inblocks blocks each.
+ */
+void thashx4(unsigned char *out0, unsigned char *out1,
+             unsigned char *out2, unsigned char *out3,
+             const unsigned char *in0, const unsigned char *in1,
+             const unsigned char *in2, const unsigned char *in3,
+             unsigned int inblocks,
+             const spx_ctx *ctx, uint32_t addrx4[4*8])
+{
+    unsigned char bufx4[4][SPX_N + SPX_ADDR_BYTES + inblocks*SPX_N];
+    unsigned char bitmaskx4[4][inblocks * SPX_N];
+    const unsigned char *in[4] = { in0, in1, in2, in3 };
+    unsigned int i, j;
+
+    for (j = 0; j < 4; j++) {
+        memcpy(bufx4[j], ctx->pub_seed, SPX_N);
+        addr_to_bytes(bufx4[j] + SPX_N, addrx4 + j*8);
+    }
+
+    shake256x4(bitmaskx4[0], bitmaskx4[1], bitmaskx4[2], bitmaskx4[3],
+               inblocks * SPX_N, bufx4[0], bufx4[1], bufx4[2], bufx4[3],
+               SPX_N + SPX_ADDR_BYTES);
+
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < inblocks * SPX_N; i++) {
+            bufx4[j][SPX_N + SPX_ADDR_BYTES + i] = in[j][i] ^ bitmaskx4[j][i];
+        }
+    }
+
+    shake256x4(out0, out1, out2, out3, SPX_N,
+               bufx4[0], bufx4[1], bufx4[2], bufx4[3],
+               SPX_N + SPX_ADDR_BYTES + inblocks*SPX_N);
+}
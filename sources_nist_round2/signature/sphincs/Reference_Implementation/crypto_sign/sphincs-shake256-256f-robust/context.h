@@ -0,0 +1,18 @@
+#ifndef SPX_CONTEXT_H
+#define SPX_CONTEXT_H
+
+#include <stdint.h>
+
+#include "params.h"
+
+/* The seeds of a key pair, along with what the hash function precomputes
+   from them in initialize_hash_function. Only read while signing or
+   verifying, so a context can be shared between threads, and keys in use at
+   the same time need no common state. The precomputed part differs per hash
+   function, like hash_shake256.c; SHAKE256 needs none. */
+typedef struct {
+    unsigned char pub_seed[SPX_N];
+    unsigned char sk_seed[SPX_N];
+} spx_ctx;
+
+#endif
@@ -11,28 +11,278 @@
 #include "address.h"
 #include "rng.h"
 #include "utils.h"
+#include "threads.h"
 
 /**
- * Computes the leaf at a given address. First generates the WOTS key pair,
- * then computes leaf by hashing horizontally.
+ * Computes the four leaves starting at a given address. First generates the
+ * WOTS key pairs, then computes each leaf by hashing horizontally.
  */
-static void wots_gen_leaf(unsigned char *leaf, const unsigned char *sk_seed,
-                          const unsigned char *pub_seed,
-                          uint32_t addr_idx, const uint32_t tree_addr[8])
+static void wots_gen_leafx4(unsigned char *leaves, const spx_ctx *ctx,
+                            uint32_t addr_idx, const uint32_t tree_addr[8])
 {
-    unsigned char pk[SPX_WOTS_BYTES];
+    unsigned char pkx4[4 * SPX_WOTS_BYTES];
+    uint32_t wots_addrx4[4*8] = {0};
+    uint32_t wots_pk_addrx4[4*8] = {0};
+    unsigned int j;
+
+    for (j = 0; j < 4; j++) {
+        set_type(wots_addrx4 + j*8, SPX_ADDR_TYPE_WOTS);
+        set_type(wots_pk_addrx4 + j*8, SPX_ADDR_TYPE_WOTSPK);
+
+        copy_subtree_addr(wots_addrx4 + j*8, tree_addr);
+        set_keypair_addr(wots_addrx4 + j*8, addr_idx + j);
+        copy_keypair_addr(wots_pk_addrx4 + j*8, wots_addrx4 + j*8);
+    }
+    wots_gen_pkx4(pkx4, ctx, wots_addrx4);
+
+    thashx4(leaves, leaves + SPX_N, leaves + 2*SPX_N, leaves + 3*SPX_N,
+            pkx4, pkx4 + SPX_WOTS_BYTES,
+            pkx4 + 2*SPX_WOTS_BYTES, pkx4 + 3*SPX_WOTS_BYTES,
+            SPX_WOTS_LEN, ctx, wots_pk_addrx4);
+}
+
+/* Inputs and outputs of the jobs that sign one message digest. */
+typedef struct {
+    unsigned char *sig;     /* Start of the FORS signature */
+    const unsigned char *mhash;
+    const spx_ctx *ctx;
+    uint64_t tree[SPX_D];   /* Tree and leaf used at each hypertree layer */
+    uint32_t idx_leaf[SPX_D];
+    unsigned int cached_from;   /* Lowest layer taken from the cache */
+    unsigned char fors_roots[SPX_FORS_TREES * SPX_N];
+    unsigned char roots[(SPX_D + 1) * SPX_N];   /* FORS pk, subtree roots */
+} sign_state;
+
+/* Returns the part of the signature of hypertree layer 'layer'. */
+static unsigned char *layer_sig(const sign_state *st, unsigned int layer)
+{
+    return st->sig + SPX_FORS_BYTES +
+           layer * (SPX_WOTS_BYTES + SPX_TREE_HEIGHT * SPX_N);
+}
+
+/**
+ * Job i < cached_from computes the authentication path and the root of the
+ * subtree used at layer i, and job cached_from + j signs FORS tree j. These
+ * depend only on the message digest, not on each other. The subtrees come
+ * first, as they are the larger jobs.
+ */
+static void sign_tree_job(void *arg, unsigned int i)
+{
+    sign_state *st = arg;
+    uint32_t addr[8] = {0};
+
+    if (i < st->cached_from) {
+        set_layer_addr(addr, i);
+        set_tree_addr(addr, st->tree[i]);
+        set_type(addr, SPX_ADDR_TYPE_HASHTREE);
+
+        treehash(st->roots + (i + 1)*SPX_N, layer_sig(st, i) + SPX_WOTS_BYTES,
+                 st->ctx, st->idx_leaf[i], 0,
+                 SPX_TREE_HEIGHT, wots_gen_leafx4, addr);
+    }
+    else {
+        i -= st->cached_from;
+        set_tree_addr(addr, st->tree[0]);
+        set_keypair_addr(addr, st->idx_leaf[0]);
+
+        fors_sign_tree(st->sig + i * SPX_FORS_TREE_BYTES,
+                       st->fors_roots + i*SPX_N, st->mhash, i, st->ctx, addr);
+    }
+}
+
+/**
+ * Job i computes the WOTS signature at layer i, on the FORS public key for
+ * layer 0 and on the root of the subtree below it otherwise.
+ */
+static void sign_wots_job(void *arg, unsigned int i)
+{
+    sign_state *st = arg;
     uint32_t wots_addr[8] = {0};
-    uint32_t wots_pk_addr[8] = {0};
 
+    set_layer_addr(wots_addr, i);
+    set_tree_addr(wots_addr, st->tree[i]);
     set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
-    set_type(wots_pk_addr, SPX_ADDR_TYPE_WOTSPK);
+    set_keypair_addr(wots_addr, st->idx_leaf[i]);
+
+    wots_sign(layer_sig(st, i), st->roots + i*SPX_N, st->ctx, wots_addr);
+}
+
+/* A cache starts with the public key it belongs to and the number of cached
+   layers. */
+#define SPX_CACHE_HEADER_BYTES (SPX_PK_BYTES + 4)
+/* It then stores each subtree in the cached layers, from the top layer down
+   and from left to right within a layer: a tag that authenticates the
+   subtree, followed by every node of it. */
+#define SPX_CACHE_NODES_BYTES (((2 << SPX_TREE_HEIGHT) - 1) * SPX_N)
+#define SPX_CACHE_TREE_BYTES (SPX_N + SPX_CACHE_NODES_BYTES)
+
+/**
+ * Returns the number of subtrees in the top 'layers' layers of the hypertree.
+ */
+static unsigned long long cache_trees(unsigned int layers)
+{
+    unsigned long long trees = 0;
+    unsigned int j;
+
+    for (j = 0; j < layers; j++) {
+        trees += 1ULL << (j * SPX_TREE_HEIGHT);
+    }
+    return trees;
+}
+
+/**
+ * Returns the layer and the index within that layer of the i-th cached
+ * subtree.
+ */
+static void cache_tree_pos(unsigned int *layer, uint64_t *tree,
+                           unsigned long long i)
+{
+    *layer = SPX_D - 1;
+    while (i >= cache_trees(SPX_D - *layer)) {
+        (*layer)--;
+    }
+    *tree = i - cache_trees(SPX_D - 1 - *layer);
+}
+
+/**
+ * Returns the offset of node idx at the given height within a cached subtree.
+ * The leaves come first, followed by each level above them, up to the root.
+ */
+static unsigned long cache_node(unsigned int height, uint32_t idx)
+{
+    return ((2UL << SPX_TREE_HEIGHT) - (2UL << (SPX_TREE_HEIGHT - height))
+            + idx) * SPX_N;
+}
+
+/**
+ * Returns the number of layers in a cache for the key sk, or -1 if the cache
+ * belongs to a different key or does not have the right length.
+ */
+static int cache_layers(const uint8_t *cache, size_t cachelen,
+                        const uint8_t *sk)
+{
+    unsigned int layers;
+
+    if (cachelen < SPX_CACHE_HEADER_BYTES ||
+        memcmp(cache, sk + 2*SPX_N, SPX_PK_BYTES)) {
+        return -1;
+    }
+    layers = bytes_to_ull(cache + SPX_PK_BYTES, 4);
+    if (layers > SPX_D || crypto_sign_cache_bytes(layers) != cachelen) {
+        return -1;
+    }
+    return layers;
+}
+
+/**
+ * Computes the tag of the nodes of the subtree at index 'tree' of layer
+ * 'layer', as PRF_msg keyed with SK_PRF. The position of the subtree stands
+ * in for optrand, so that a subtree moved to another position in the cache
+ * does not match its tag. It also tells the tag apart from the randomness R
+ * of a signature, for which optrand is drawn at random.
+ */
+static void cache_tag(unsigned char *tag, const unsigned char *nodes,
+                      unsigned int layer, uint64_t tree,
+                      const uint8_t *sk, const spx_ctx *ctx)
+{
+    unsigned char pos[SPX_N] = {0};
+
+    ull_to_bytes(pos, 4, layer);
+    ull_to_bytes(pos + 4, 8, tree);
+    gen_message_random(tag, sk + SPX_N, pos, nodes, SPX_CACHE_NODES_BYTES,
+                       ctx);
+}
+
+/**
+ * Checks the tag of a cached subtree in constant time. Returns 0 if it
+ * matches, and -1 otherwise.
+ */
+static int cache_tree_check(const unsigned char *entry, unsigned int layer,
+                            uint64_t tree, const uint8_t *sk,
+                            const spx_ctx *ctx)
+{
+    unsigned char tag[SPX_N];
+    unsigned char diff = 0;
+    unsigned int j;
+
+    cache_tag(tag, entry + SPX_N, layer, tree, sk, ctx);
+    for (j = 0; j < SPX_N; j++) {
+        diff |= tag[j] ^ entry[j];
+    }
+    return -(int)((diff + 0xFFU) >> 8);
+}
+
+/* Inputs of the jobs that fill a cache. */
+typedef struct {
+    unsigned char *trees;   /* First cached subtree */
+    const uint8_t *sk;
+    const spx_ctx *ctx;
+} cache_state;
+
+/**
+ * Job i computes all nodes of the i-th cached subtree, and their tag.
+ */
+static void cache_tree_job(void *arg, unsigned int i)
+{
+    cache_state *cs = arg;
+    unsigned char *entry = cs->trees + (unsigned long long)i *
+                                       SPX_CACHE_TREE_BYTES;
+    unsigned char *nodes = entry + SPX_N;
+    unsigned int layer;
+    unsigned int height;
+    uint64_t tree;
+    uint32_t tree_addr[8] = {0};
+    uint32_t idx;
+
+    cache_tree_pos(&layer, &tree, i);
+    set_layer_addr(tree_addr, layer);
+    set_tree_addr(tree_addr, tree);
+    set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
 
-    copy_subtree_addr(wots_addr, tree_addr);
-    set_keypair_addr(wots_addr, addr_idx);
-    wots_gen_pk(pk, sk_seed, pub_seed, wots_addr);
+    for (idx = 0; idx < (uint32_t)(1 << SPX_TREE_HEIGHT); idx += 4) {
+        wots_gen_leafx4(nodes + idx*SPX_N, cs->ctx, idx, tree_addr);
+    }
+    for (height = 1; height <= SPX_TREE_HEIGHT; height++) {
+        set_tree_height(tree_addr, height);
+        for (idx = 0; idx < (1U << (SPX_TREE_HEIGHT - height)); idx++) {
+            set_tree_index(tree_addr, idx);
+            thash(nodes + cache_node(height, idx),
+                  nodes + cache_node(height - 1, 2*idx), 2, cs->ctx,
+                  tree_addr);
+        }
+    }
+    cache_tag(entry, nodes, layer, tree, cs->sk, cs->ctx);
+}
 
-    copy_keypair_addr(wots_pk_addr, wots_addr);
-    thash(leaf, pk, SPX_WOTS_LEN, pub_seed, wots_pk_addr);
+/**
+ * Copies the authentication path and the root of the subtree used at layer
+ * 'layer' from the cache, in place of computing them with treehash.
+ * Returns -1, without copying anything, if the subtree does not match its
+ * tag: its root would be signed by a one-time key of the layer above.
+ */
+static int cached_tree(sign_state *st, unsigned int layer,
+                       const uint8_t *cache, const uint8_t *sk)
+{
+    const unsigned char *entry = cache + SPX_CACHE_HEADER_BYTES +
+        (cache_trees(SPX_D - 1 - layer) + st->tree[layer]) *
+        SPX_CACHE_TREE_BYTES;
+    const unsigned char *nodes = entry + SPX_N;
+    unsigned char *auth_path = layer_sig(st, layer) + SPX_WOTS_BYTES;
+    unsigned int height;
+
+    if (cache_tree_check(entry, layer, st->tree[layer], sk, st->ctx)) {
+        return -1;
+    }
+
+    for (height = 0; height < SPX_TREE_HEIGHT; height++) {
+        memcpy(auth_path + height*SPX_N,
+               nodes + cache_node(height,
+                                  (st->idx_leaf[layer] >> height) ^ 1),
+               SPX_N);
+    }
+    memcpy(st->roots + (layer + 1)*SPX_N,
+           nodes + cache_node(SPX_TREE_HEIGHT, 0), SPX_N);
+    return 0;
 }
 
 /*
@@ -80,6 +330,7 @@ int crypto_sign_seed_keypair(unsigned char *pk, unsigned char *sk,
        in one function. */
     unsigned char auth_path[SPX_TREE_HEIGHT * SPX_N];
     uint32_t top_tree_addr[8] = {0};
+    spx_ctx ctx;
 
     set_layer_addr(top_tree_addr, SPX_D - 1);
     set_type(top_tree_addr, SPX_ADDR_TYPE_HASHTREE);
@@ -89,13 +340,16 @@ int crypto_sign_seed_keypair(unsigned char *pk, unsigned char *sk,
 
     memcpy(pk, sk + 2*SPX_N, SPX_N);
 
+    memcpy(ctx.pub_seed, pk, SPX_N);
+    memcpy(ctx.sk_seed, sk, SPX_N);
+
     /* This hook allows the hash function instantiation to do whatever
        preparation or computation it needs, based on the public seed. */
-    initialize_hash_function(pk, sk);
+    initialize_hash_function(&ctx);
 
     /* Compute root node of the top-most subtree. */
-    treehash(sk + 3*SPX_N, auth_path, sk, sk + 2*SPX_N, 0, 0, SPX_TREE_HEIGHT,
-             wots_gen_leaf, top_tree_addr);
+    treehash(sk + 3*SPX_N, auth_path, &ctx, 0, 0, SPX_TREE_HEIGHT,
+             wots_gen_leafx4, top_tree_addr);
 
     memcpy(pk + SPX_N, sk + 3*SPX_N, SPX_N);
 
@@ -116,71 +370,209 @@ int crypto_sign_keypair(unsigned char *pk, unsigned char *sk)
   return 0;
 }
 
+/*
+ * Returns the length of a cache of the top 'layers' layers of the hypertree,
+ * in bytes, or 0 if that does not fit in an unsigned long long.
+ */
+unsigned long long crypto_sign_cache_bytes(unsigned int layers)
+{
+    unsigned long long bytes = SPX_CACHE_HEADER_BYTES;
+    unsigned long long trees;
+    unsigned int j;
+
+    if (layers > SPX_D) {
+        return 0;
+    }
+    for (j = 0; j < layers; j++) {
+        /* Layer j from the top consists of 2^(j * SPX_TREE_HEIGHT) subtrees. */
+        if (j * SPX_TREE_HEIGHT >= 64) {
+            return 0;
+        }
+        trees = 1ULL << (j * SPX_TREE_HEIGHT);
+        if (trees > (~0ULL - bytes) / SPX_CACHE_TREE_BYTES) {
+            return 0;
+        }
+        bytes += trees * SPX_CACHE_TREE_BYTES;
+    }
+    return bytes;
+}
+
+/*
+ * Returns the largest number of layers whose cache takes at most 'budget'
+ * bytes.
+ */
+unsigned int crypto_sign_cache_layers(unsigned long long budget)
+{
+    unsigned long long bytes;
+    unsigned int layers = 0;
+
+    while (layers < SPX_D) {
+        bytes = crypto_sign_cache_bytes(layers + 1);
+        if (bytes == 0 || bytes > budget) {
+            break;
+        }
+        layers++;
+    }
+    return layers;
+}
+
+/*
+ * Fills a cache of crypto_sign_cache_bytes(layers) bytes with the nodes of
+ * the top 'layers' layers of the hypertree of sk. Returns 0 on success.
+ * This costs as much as generating one key pair per cached subtree.
+ */
+int crypto_sign_cache_init(uint8_t *cache, unsigned int layers,
+                           const uint8_t *sk)
+{
+    unsigned long long cachelen = crypto_sign_cache_bytes(layers);
+    cache_state cs;
+    spx_ctx ctx;
+
+    /* The jobs that fill the cache are numbered with an unsigned int. */
+    if (cachelen == 0 || cachelen != (size_t)cachelen ||
+        cache_trees(layers) > (unsigned int)-1) {
+        return -1;
+    }
+
+    memcpy(ctx.pub_seed, sk + 2*SPX_N, SPX_N);
+    memcpy(ctx.sk_seed, sk, SPX_N);
+    initialize_hash_function(&ctx);
+
+    memcpy(cache, sk + 2*SPX_N, SPX_PK_BYTES);
+    ull_to_bytes(cache + SPX_PK_BYTES, 4, layers);
+
+    cs.trees = cache + SPX_CACHE_HEADER_BYTES;
+    cs.sk = sk;
+    cs.ctx = &ctx;
+    run_jobs(cache_tree_job, &cs, cache_trees(layers));
+
+    return 0;
+}
+
+/*
+ * Checks that a cache was made by crypto_sign_cache_init for sk and has not
+ * been modified since. Returns 0 if so, and -1 otherwise.
+ */
+int crypto_sign_cache_check(const uint8_t *cache, size_t cachelen,
+                            const uint8_t *sk)
+{
+    int layers = cache_layers(cache, cachelen, sk);
+    unsigned long long i;
+    unsigned int layer;
+    uint64_t tree;
+    spx_ctx ctx;
+    int ret = 0;
+
+    if (layers < 0) {
+        return -1;
+    }
+
+    memcpy(ctx.pub_seed, sk + 2*SPX_N, SPX_N);
+    memcpy(ctx.sk_seed, sk, SPX_N);
+    initialize_hash_function(&ctx);
+
+    for (i = 0; i < cache_trees(layers); i++) {
+        cache_tree_pos(&layer, &tree, i);
+        ret |= cache_tree_check(cache + SPX_CACHE_HEADER_BYTES +
+                                i * SPX_CACHE_TREE_BYTES,
+                                layer, tree, sk, &ctx);
+    }
+
+    return ret;
+}
+
 /**
  * Returns an array containing a detached signature.
  */
 int crypto_sign_signature(uint8_t *sig, size_t *siglen,
                           const uint8_t *m, size_t mlen, const uint8_t *sk)
+{
+    return crypto_sign_signature_cached(sig, siglen, m, mlen, sk, NULL, 0);
+}
+
+/**
+ * Returns an array containing a detached signature, taking the subtrees of
+ * the cached layers from a cache for sk instead of recomputing them.
+ * Signatures are the same as those of crypto_sign_signature, which this
+ * falls back to if the cache belongs to another key. Each subtree used is
+ * checked against its tag first; if one was modified, no signature is made
+ * and -1 is returned.
+ */
+int crypto_sign_signature_cached(uint8_t *sig, size_t *siglen,
+                                 const uint8_t *m, size_t mlen,
+                                 const uint8_t *sk,
+                                 const uint8_t *cache, size_t cachelen)
 {
     const unsigned char *sk_seed = sk;
     const unsigned char *sk_prf = sk + SPX_N;
     const unsigned char *pk = sk + 2*SPX_N;
     const unsigned char *pub_seed = pk;
+    spx_ctx ctx;
 
     unsigned char optrand[SPX_N];
     unsigned char mhash[SPX_FORS_MSG_BYTES];
-    unsigned char root[SPX_N];
-    unsigned long long i;
+    unsigned int i;
     uint64_t tree;
     uint32_t idx_leaf;
-    uint32_t wots_addr[8] = {0};
-    uint32_t tree_addr[8] = {0};
+    uint32_t fors_addr[8] = {0};
+    int layers = 0;
+    sign_state st;
+
+    memcpy(ctx.pub_seed, pub_seed, SPX_N);
+    memcpy(ctx.sk_seed, sk_seed, SPX_N);
 
     /* This hook allows the hash function instantiation to do whatever
        preparation or computation it needs, based on the public seed. */
-    initialize_hash_function(pub_seed, sk_seed);
-
-    set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
-    set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
+    initialize_hash_function(&ctx);
 
     /* Optionally, signing can be made non-deterministic using optrand.
        This can help counter side-channel attacks that would benefit from
        getting a large number of traces when the signer uses the same nodes. */
     randombytes(optrand, SPX_N);
     /* Compute the digest randomization value. */
-    gen_message_random(sig, sk_prf, optrand, m, mlen);
+    gen_message_random(sig, sk_prf, optrand, m, mlen, &ctx);
 
     /* Derive the message digest and leaf index from R, PK and M. */
-    hash_message(mhash, &tree, &idx_leaf, sig, pk, m, mlen);
+    hash_message(mhash, &tree, &idx_leaf, sig, pk, m, mlen, &ctx);
     sig += SPX_N;
 
-    set_tree_addr(wots_addr, tree);
-    set_keypair_addr(wots_addr, idx_leaf);
-
-    /* Sign the message hash using FORS. */
-    fors_sign(sig, root, mhash, sk_seed, pub_seed, wots_addr);
-    sig += SPX_FORS_BYTES;
-
+    /* Determine the tree and leaf used at each layer. */
     for (i = 0; i < SPX_D; i++) {
-        set_layer_addr(tree_addr, i);
-        set_tree_addr(tree_addr, tree);
-
-        copy_subtree_addr(wots_addr, tree_addr);
-        set_keypair_addr(wots_addr, idx_leaf);
-
-        /* Compute a WOTS signature. */
-        wots_sign(sig, root, sk_seed, pub_seed, wots_addr);
-        sig += SPX_WOTS_BYTES;
+        st.tree[i] = tree;
+        st.idx_leaf[i] = idx_leaf;
 
-        /* Compute the authentication path for the used WOTS leaf. */
-        treehash(root, sig, sk_seed, pub_seed, idx_leaf, 0,
-                 SPX_TREE_HEIGHT, wots_gen_leaf, tree_addr);
-        sig += SPX_TREE_HEIGHT * SPX_N;
-
-        /* Update the indices for the next layer. */
         idx_leaf = (tree & ((1 << SPX_TREE_HEIGHT)-1));
         tree = tree >> SPX_TREE_HEIGHT;
     }
+    st.sig = sig;
+    st.mhash = mhash;
+    st.ctx = &ctx;
+
+    /* Look up the authentication paths and roots of the cached layers. */
+    if (cache != NULL) {
+        layers = cache_layers(cache, cachelen, sk);
+    }
+    if (layers < 0) {
+        layers = 0;
+    }
+    st.cached_from = SPX_D - layers;
+    for (i = st.cached_from; i < SPX_D; i++) {
+        if (cached_tree(&st, i, cache, sk)) {
+            *siglen = 0;
+            return -1;
+        }
+    }
+
+    /* Sign the message hash using FORS, and compute the authentication path
+       and root of each other subtree, spread over SPX_NUM_THREADS threads. */
+    run_jobs(sign_tree_job, &st, st.cached_from + SPX_FORS_TREES);
+
+    set_tree_addr(fors_addr, st.tree[0]);
+    set_keypair_addr(fors_addr, st.idx_leaf[0]);
+    fors_roots_to_pk(st.roots, st.fors_roots, &ctx, fors_addr);
+
+    /* Now that all roots are known, sign each of them with WOTS. */
+    run_jobs(sign_wots_job, &st, SPX_D);
 
     *siglen = SPX_BYTES;
 
@@ -205,14 +597,19 @@ int crypto_sign_verify(const uint8_t *sig, size_t siglen,
     uint32_t wots_addr[8] = {0};
     uint32_t tree_addr[8] = {0};
     uint32_t wots_pk_addr[8] = {0};
+    spx_ctx ctx;
 
     if (siglen != SPX_BYTES) {
         return -1;
     }
 
+    /* Verification does not use the secret seed. */
+    memcpy(ctx.pub_seed, pub_seed, SPX_N);
+    memset(ctx.sk_seed, 0, SPX_N);
+
     /* This hook allows the hash function instantiation to do whatever
        preparation or computation it needs, based on the public seed. */
-    initialize_hash_function(pub_seed, NULL);
+    initialize_hash_function_public(&ctx);
 
     set_type(wots_addr, SPX_ADDR_TYPE_WOTS);
     set_type(tree_addr, SPX_ADDR_TYPE_HASHTREE);
@@ -220,14 +617,14 @@ int crypto_sign_verify(const uint8_t *sig, size_t siglen,
 
     /* Derive the message digest and leaf index from R || PK || M. */
     /* The additional SPX_N is a result of the hash domain separator. */
-    hash_message(mhash, &tree, &idx_leaf, sig, pk, m, mlen);
+    hash_message(mhash, &tree, &idx_leaf, sig, pk, m, mlen, &ctx);
     sig += SPX_N;
 
     /* Layer correctly defaults to 0, so no need to set_layer_addr */
     set_tree_addr(wots_addr, tree);
     set_keypair_addr(wots_addr, idx_leaf);
 
-    fors_pk_from_sig(root, sig, mhash, pub_seed, wots_addr);
+    fors_pk_from_sig(root, sig, mhash, &ctx, wots_addr);
     sig += SPX_FORS_BYTES;
 
     /* For each subtree.. */
@@ -243,15 +640,15 @@ int crypto_sign_verify(const uint8_t *sig, size_t siglen,
         /* The WOTS public key is only correct if the signature was correct. */
         /* Initially, root is the FORS pk, but on subsequent iterations it is
            the root of the subtree below the currently processed subtree. */
-        wots_pk_from_sig(wots_pk, sig, root, pub_seed, wots_addr);
+        wots_pk_from_sig(wots_pk, sig, root, &ctx, wots_addr);
         sig += SPX_WOTS_BYTES;
 
         /* Compute the leaf node using the WOTS public key. */
-        thash(leaf, wots_pk, SPX_WOTS_LEN, pub_seed, wots_pk_addr);
+        thash(leaf, wots_pk, SPX_WOTS_LEN, &ctx, wots_pk_addr);
 
         /* Compute the root node of this subtree. */
         compute_root(root, leaf, idx_leaf, 0, sig, SPX_TREE_HEIGHT,
-                     pub_seed, tree_addr);
+                     &ctx, tree_addr);
         sig += SPX_TREE_HEIGHT * SPX_N;
 
         /* Update the indices for the next layer. */
@@ -267,6 +664,162 @@ int crypto_sign_verify(const uint8_t *sig, size_t siglen,
     return 0;
 }
 
+/**
+ * Verifies the signatures sigs[idx[j]] for j < count, where count is at most
+ * four, as crypto_sign_verify does, and stores each result in results[idx[j]].
+ * Each step hashes for all signatures at once, with the x4 functions.
+ * Lanes from count on repeat the first signature, and their results are
+ * dropped.
+ */
+static void verify_x4(int *results, const uint8_t *const *sigs,
+                      const uint8_t *const *ms, const size_t *mlens,
+                      const size_t *idx, unsigned int count,
+                      const uint8_t *pk, const spx_ctx *ctx)
+{
+    const unsigned char *pub_root = pk + SPX_N;
+    const unsigned char *sig[4];
+    const unsigned char *mhashp[4];
+    const unsigned char *rootp[4];
+    const unsigned char *leafp[4];
+    unsigned char *wots_pkp[4];
+    unsigned char *root[4];
+    unsigned char mhash[4][SPX_FORS_MSG_BYTES];
+    unsigned char wots_pk[4][SPX_WOTS_BYTES] = {{0}};
+    unsigned char roots[4][SPX_N];
+    unsigned char leaf[4][SPX_N];
+    unsigned int i, j;
+    uint64_t tree[4];
+    uint32_t idx_leaf[4];
+    uint32_t wots_addrx4[4*8] = {0};
+    uint32_t tree_addrx4[4*8] = {0};
+    uint32_t wots_pk_addrx4[4*8] = {0};
+
+    for (j = 0; j < 4; j++) {
+        sig[j] = sigs[idx[j < count ? j : 0]];
+        mhashp[j] = mhash[j];
+        rootp[j] = roots[j];
+        leafp[j] = leaf[j];
+        wots_pkp[j] = wots_pk[j];
+        root[j] = roots[j];
+
+        set_type(wots_addrx4 + j*8, SPX_ADDR_TYPE_WOTS);
+        set_type(tree_addrx4 + j*8, SPX_ADDR_TYPE_HASHTREE);
+        set_type(wots_pk_addrx4 + j*8, SPX_ADDR_TYPE_WOTSPK);
+
+        /* Derive the message digest and leaf index from R || PK || M. */
+        if (j < count) {
+            hash_message(mhash[j], &tree[j], &idx_leaf[j], sig[j], pk,
+                         ms[idx[j]], mlens[idx[j]], ctx);
+        }
+        else {
+            memcpy(mhash[j], mhash[0], SPX_FORS_MSG_BYTES);
+            tree[j] = tree[0];
+            idx_leaf[j] = idx_leaf[0];
+        }
+        sig[j] += SPX_N;
+
+        /* Layer correctly defaults to 0, so no need to set_layer_addr */
+        set_tree_addr(wots_addrx4 + j*8, tree[j]);
+        set_keypair_addr(wots_addrx4 + j*8, idx_leaf[j]);
+    }
+
+    fors_pk_from_sigx4(root, sig, mhashp, ctx, wots_addrx4);
+    for (j = 0; j < 4; j++) {
+        sig[j] += SPX_FORS_BYTES;
+    }
+
+    /* For each subtree.. */
+    for (i = 0; i < SPX_D; i++) {
+        for (j = 0; j < 4; j++) {
+            set_layer_addr(tree_addrx4 + j*8, i);
+            set_tree_addr(tree_addrx4 + j*8, tree[j]);
+
+            copy_subtree_addr(wots_addrx4 + j*8, tree_addrx4 + j*8);
+            set_keypair_addr(wots_addrx4 + j*8, idx_leaf[j]);
+
+            copy_keypair_addr(wots_pk_addrx4 + j*8, wots_addrx4 + j*8);
+        }
+
+        /* Only the lanes that hold a signature of their own need their
+           chains computed; the others only keep the x4 calls fed. */
+        wots_pk_from_sigx4(wots_pkp, sig, rootp, count, ctx, wots_addrx4);
+        for (j = 0; j < 4; j++) {
+            sig[j] += SPX_WOTS_BYTES;
+        }
+
+        /* Compute the leaf nodes using the WOTS public keys. */
+        thashx4(leaf[0], leaf[1], leaf[2], leaf[3],
+                wots_pk[0], wots_pk[1], wots_pk[2], wots_pk[3],
+                SPX_WOTS_LEN, ctx, wots_pk_addrx4);
+
+        /* Compute the root nodes of these subtrees. */
+        compute_rootx4(root, leafp, idx_leaf, 0, sig, SPX_TREE_HEIGHT,
+                       ctx, tree_addrx4);
+
+        /* Update the indices for the next layer. */
+        for (j = 0; j < 4; j++) {
+            sig[j] += SPX_TREE_HEIGHT * SPX_N;
+            idx_leaf[j] = (tree[j] & ((1 << SPX_TREE_HEIGHT)-1));
+            tree[j] = tree[j] >> SPX_TREE_HEIGHT;
+        }
+    }
+
+    /* Check if the root nodes equal the root node in the public key. */
+    for (j = 0; j < count; j++) {
+        results[idx[j]] = memcmp(roots[j], pub_root, SPX_N) ? -1 : 0;
+    }
+}
+
+/**
+ * Verifies n detached signatures on n messages under a single public key, as
+ * crypto_sign_verify does for each i < n, and stores each result in
+ * results[i]. Returns 0 if all signatures are valid, and -1 otherwise.
+ * The signatures are verified four at a time, hashing for all four at once.
+ */
+int crypto_sign_verify_batch(int *results,
+                             const uint8_t *const *sigs, const size_t *siglens,
+                             const uint8_t *const *ms, const size_t *mlens,
+                             size_t n, const uint8_t *pk)
+{
+    const unsigned char *pub_seed = pk;
+    size_t idx[4];
+    unsigned int count;
+    int ret = 0;
+    size_t i;
+    spx_ctx ctx;
+
+    /* Verification does not use the secret seed. */
+    memcpy(ctx.pub_seed, pub_seed, SPX_N);
+    memset(ctx.sk_seed, 0, SPX_N);
+
+    /* This hook allows the hash function instantiation to do whatever
+       preparation or computation it needs, based on the public seed. */
+    initialize_hash_function_public(&ctx);
+
+    for (i = 0; i < n; ) {
+        /* Take the next four signatures, skipping those of the wrong length,
+           which fail without taking a lane. */
+        count = 0;
+        while (i < n && count < 4) {
+            if (siglens[i] != SPX_BYTES) {
+                results[i] = -1;
+            }
+            else {
+                idx[count++] = i;
+            }
+            i++;
+        }
+        if (count > 0) {
+            verify_x4(results, sigs, ms, mlens, idx, count, pk, &ctx);
+        }
+    }
+
+    for (i = 0; i < n; i++) {
+        ret |= results[i];
+    }
+    return ret;
+}
+
 
 /**
  * Returns an array containing the signature followed by the message.
@@ -266,17 +266,18 @@ libkeccak_pad10star1(register struct libkeccak_state *restrict state, register s
 /**
  * Perform the absorption phase
  * 
- * @param  state  The hashing state
- * @param  len    The number of bytes from `state->M` to absorb
+ * @param  state    The hashing state
+ * @param  message  The bytes to absorb, either `state->M` or the caller's buffer
+ * @param  len      The number of bytes from `message` to absorb
  */
 LIBKECCAK_GCC_ONLY(__attribute__((__nonnull__, __nothrow__)))
 static void
-libkeccak_absorption_phase(register struct libkeccak_state *restrict state, register size_t len)
+libkeccak_absorption_phase(register struct libkeccak_state *restrict state,
+                           register const unsigned char *restrict message, register size_t len)
 {
 	register long int rr = state->r >> 3;
 	register long int ww = state->w >> 3;
 	register long int n = (long)len / rr;
-	register const unsigned char *restrict message = state->M;
 	if (__builtin_expect(ww >= 8, 1)) { /* ww > 8 is impossible, it is just for optimisation possibilities. */
 		while (n--) {
 #define X(N) state->S[N] ^= libkeccak_to_lane64(message, len, rr, (size_t)(LANE_TRANSPOSE_MAP[N] * 8));
@@ -342,27 +343,32 @@ libkeccak_squeezing_phase(register struct libkeccak_state *restrict state, long
  * @return          Zero on success, -1 on error
  */
 int
-libkeccak_fast_update(struct libkeccak_state *restrict state, const void *restrict msg, size_t msglen)
+libkeccak_fast_update(struct libkeccak_state *restrict state, const void *restrict msg_, size_t msglen)
 {
-	size_t len;
-	auto unsigned char *restrict new;
-
-	if (__builtin_expect(state->mptr + msglen > state->mlen, 0)) {
-		state->mlen += msglen;
-		new = realloc(state->M, state->mlen * sizeof(char));
-		if (!new)
-			return state->mlen -= msglen, -1;
-		state->M = new;
+	const unsigned char *restrict msg = msg_;
+	register size_t rr = (size_t)(state->r >> 3);
+	register size_t len;
+
+	/* Complete the buffered block, then absorb whole blocks straight
+	 * from `msg` and only keep the tail in `state->M`. */
+	if (state->mptr) {
+		len = rr - state->mptr % rr;
+		if (msglen < len) {
+			__builtin_memcpy(state->M + state->mptr, msg, msglen * sizeof(char));
+			state->mptr += msglen;
+			return 0;
+		}
+		__builtin_memcpy(state->M + state->mptr, msg, len * sizeof(char));
+		msg += len, msglen -= len;
+		libkeccak_absorption_phase(state, state->M, state->mptr + len);
+		state->mptr = 0;
 	}
 
-	__builtin_memcpy(state->M + state->mptr, msg, msglen * sizeof(char));
-	state->mptr += msglen;
-	len = state->mptr;
-	len -= state->mptr % (size_t)((state->r * state->b) >> 3);
-	state->mptr -= len;
-
-	libkeccak_absorption_phase(state, len);
-	__builtin_memmove(state->M, state->M + len, state->mptr * sizeof(char));
+	len = msglen - msglen % rr;
+	libkeccak_absorption_phase(state, msg, len);
+	msglen -= len;
+	__builtin_memcpy(state->M, msg + len, msglen * sizeof(char));
+	state->mptr = msglen;
 
 	return 0;
 }
@@ -378,29 +384,34 @@ libkeccak_fast_update(struct libkeccak_state *restrict state, const void *restri
  * @return          Zero on success, -1 on error
  */
 int
-libkeccak_update(struct libkeccak_state *restrict state, const void *restrict msg, size_t msglen)
+libkeccak_update(struct libkeccak_state *restrict state, const void *restrict msg_, size_t msglen)
 {
-	size_t len;
-	auto unsigned char *restrict new;
-
-	if (__builtin_expect(state->mptr + msglen > state->mlen, 0)) {
-		state->mlen += msglen;
-		new = malloc(state->mlen * sizeof(char));
-		if (!new)
-			return state->mlen -= msglen, -1;
+	const unsigned char *restrict msg = msg_;
+	register size_t rr = (size_t)(state->r >> 3);
+	register size_t len;
+
+	/* Complete the buffered block, then absorb whole blocks straight
+	 * from `msg` and only keep the tail in `state->M`. */
+	if (state->mptr) {
+		len = rr - state->mptr % rr;
+		if (msglen < len) {
+			__builtin_memcpy(state->M + state->mptr, msg, msglen * sizeof(char));
+			state->mptr += msglen;
+			return 0;
+		}
+		__builtin_memcpy(state->M + state->mptr, msg, len * sizeof(char));
+		msg += len, msglen -= len;
+		libkeccak_absorption_phase(state, state->M, state->mptr + len);
+		state->mptr += len;
 		libkeccak_state_wipe_message(state);
-		free(state->M);
-		state->M = new;
+		state->mptr = 0;
 	}
 
-	__builtin_memcpy(state->M + state->mptr, msg, msglen * sizeof(char));
-	state->mptr += msglen;
-	len = state->mptr;
-	len -= state->mptr % (size_t)((state->r * state->b) >> 3);
-	state->mptr -= len;
-
-	libkeccak_absorption_phase(state, len);
-	__builtin_memmove(state->M, state->M + len, state->mptr * sizeof(char));
+	len = msglen - msglen % rr;
+	libkeccak_absorption_phase(state, msg, len);
+	msglen -= len;
+	__builtin_memcpy(state->M, msg + len, msglen * sizeof(char));
+	state->mptr = msglen;
 
 	return 0;
 }
@@ -434,7 +445,12 @@ libkeccak_fast_digest(struct libkeccak_state *restrict state, const void *restri
 	else
 		msglen += bits >> 3, bits &= 7;
 
-	ext = msglen + ((bits + suffix_len + 7) >> 3) + (size_t)rr;
+	if (msglen) {
+		libkeccak_fast_update(state, msg, msglen);
+		msg += msglen;
+	}
+
+	ext = ((bits + suffix_len + 7) >> 3) + (size_t)rr;
 	if (__builtin_expect(state->mptr + ext > state->mlen, 0)) {
 		state->mlen += ext;
 		new = realloc(state->M, state->mlen * sizeof(char));
@@ -443,12 +459,8 @@ libkeccak_fast_digest(struct libkeccak_state *restrict state, const void *restri
 		state->M = new;
 	}
 
-	if (msglen)
-		__builtin_memcpy(state->M + state->mptr, msg, msglen * sizeof(char));
-	state->mptr += msglen;
-
 	if (bits)
-		state->M[state->mptr] = msg[msglen] & (unsigned char)((1 << bits) - 1);
+		state->M[state->mptr] = *msg & (unsigned char)((1 << bits) - 1);
 	if (__builtin_expect(!!suffix_len, 1)) {
 		if (!bits)
 			state->M[state->mptr] = 0;
@@ -462,7 +474,7 @@ libkeccak_fast_digest(struct libkeccak_state *restrict state, const void *restri
 		state->mptr++;
 
 	libkeccak_pad10star1(state, bits);
-	libkeccak_absorption_phase(state, state->mptr);
+	libkeccak_absorption_phase(state, state->M, state->mptr);
 
 	if (hashsum) {
 		libkeccak_squeezing_phase(state, rr, (state->n + 7) >> 3, state->w >> 3, hashsum);
@@ -503,23 +515,25 @@ libkeccak_digest(struct libkeccak_state *restrict state, const void *restrict ms
 	else
 		msglen += bits >> 3, bits &= 7;
 
-	ext = msglen + ((bits + suffix_len + 7) >> 3) + (size_t)rr;
+	if (msglen) {
+		libkeccak_update(state, msg, msglen);
+		msg += msglen;
+	}
+
+	ext = ((bits + suffix_len + 7) >> 3) + (size_t)rr;
 	if (__builtin_expect(state->mptr + ext > state->mlen, 0)) {
 		state->mlen += ext;
 		new = malloc(state->mlen * sizeof(char));
 		if (!new)
 			return state->mlen -= ext, -1;
+		__builtin_memcpy(new, state->M, state->mptr * sizeof(char));
 		libkeccak_state_wipe_message(state);
 		free(state->M);
 		state->M = new;
 	}
 
-	if (msglen)
-		__builtin_memcpy(state->M + state->mptr, msg, msglen * sizeof(char));
-	state->mptr += msglen;
-
 	if (bits)
-		state->M[state->mptr] = msg[msglen] & (unsigned char)((1 << bits) - 1);
+		state->M[state->mptr] = *msg & (unsigned char)((1 << bits) - 1);
 	if (__builtin_expect(!!suffix_len, 1)) {
 		if (!bits)
 			state->M[state->mptr] = 0;
@@ -533,7 +547,7 @@ libkeccak_digest(struct libkeccak_state *restrict state, const void *restrict ms
 		state->mptr++;
 
 	libkeccak_pad10star1(state, bits);
-	libkeccak_absorption_phase(state, state->mptr);
+	libkeccak_absorption_phase(state, state->M, state->mptr);
 
 	if (hashsum) {
 		libkeccak_squeezing_phase(state, rr, (state->n + 7) >> 3, state->w >> 3, hashsum);
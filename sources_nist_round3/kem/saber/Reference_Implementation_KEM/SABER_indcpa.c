@@ -79,6 +79,63 @@ void indcpa_kem_enc(const uint8_t m[SABER_KEYBYTES], const uint8_t seed_sp[SABER
 	POLT2BS(ciphertext + SABER_POLYVECCOMPRESSEDBYTES, vp);
 }
 
+void indcpa_kem_expand_pk(saber_expanded_pk *epk, const uint8_t pk[SABER_INDCPA_PUBLICKEYBYTES])
+{
+	uint16_t A[SABER_L][SABER_L][SABER_N];
+	uint16_t b[SABER_L][SABER_N];
+	int i, j;
+	const uint8_t *seed_A = pk + SABER_POLYVECCOMPRESSEDBYTES;
+
+	GenMatrix(A, seed_A);
+	for (i = 0; i < SABER_L; i++)
+	{
+		for (j = 0; j < SABER_L; j++)
+		{
+			poly_mul_eval(A[i][j], epk->Aw[i][j]);
+		}
+	}
+
+	BS2POLVECp(pk, b);
+	for (i = 0; i < SABER_L; i++)
+	{
+		poly_mul_eval(b[i], epk->bw[i]);
+	}
+
+	sha3_256(epk->hpk, pk, SABER_INDCPA_PUBLICKEYBYTES);
+}
+
+void indcpa_kem_enc_expanded(const uint8_t m[SABER_KEYBYTES], const uint8_t seed_sp[SABER_NOISE_SEEDBYTES], const saber_expanded_pk *epk, uint8_t ciphertext[SABER_BYTES_CCA_DEC])
+{
+	uint16_t sp[SABER_L][SABER_N];
+	uint16_t bp[SABER_L][SABER_N] = {0};
+	uint16_t vp[SABER_N] = {0};
+	uint16_t mp[SABER_N];
+	int i, j;
+
+	GenSecret(sp, seed_sp);
+	MatrixVectorMulEval(epk->Aw, sp, bp, 0);
+
+	for (i = 0; i < SABER_L; i++)
+	{
+		for (j = 0; j < SABER_N; j++)
+		{
+			bp[i][j] = (bp[i][j] + h1) >> (SABER_EQ - SABER_EP);
+		}
+	}
+
+	POLVECp2BS(ciphertext, bp);
+	InnerProdEval(epk->bw, sp, vp);
+
+	BS2POLmsg(m, mp);
+
+	for (j = 0; j < SABER_N; j++)
+	{
+		vp[j] = (vp[j] - (mp[j] << (SABER_EP - 1)) + h1) >> (SABER_EP - SABER_ET);
+	}
+
+	POLT2BS(ciphertext + SABER_POLYVECCOMPRESSEDBYTES, vp);
+}
+
 void indcpa_kem_dec(const uint8_t sk[SABER_INDCPA_SECRETKEYBYTES], const uint8_t ciphertext[SABER_BYTES_CCA_DEC], uint8_t m[SABER_KEYBYTES])
 {
 
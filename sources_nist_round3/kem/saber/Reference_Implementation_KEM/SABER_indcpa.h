@@ -1,10 +1,24 @@
 #ifndef INDCPA_H
 #define INDCPA_H
 
+#include <stdint.h>
 #include "SABER_params.h"
+#include "poly_mul.h"
+
+/* Public key expanded for repeated encryption under the same key: the
+   matrix A and the vector b in the Toom-Cook evaluated domain, plus
+   H(pk) for the CCA transform. Contains no secret data. */
+typedef struct
+{
+	uint16_t Aw[SABER_L][SABER_L][SABER_TC_POINTS][SABER_TC_N];
+	uint16_t bw[SABER_L][SABER_TC_POINTS][SABER_TC_N];
+	uint8_t hpk[SABER_HASHBYTES];
+} saber_expanded_pk;
 
 void indcpa_kem_keypair(uint8_t pk[SABER_INDCPA_PUBLICKEYBYTES], uint8_t sk[SABER_INDCPA_SECRETKEYBYTES]);
 void indcpa_kem_enc(const uint8_t m[SABER_KEYBYTES], const uint8_t seed_sp[SABER_NOISE_SEEDBYTES], const uint8_t pk[SABER_INDCPA_PUBLICKEYBYTES], uint8_t ciphertext[SABER_BYTES_CCA_DEC]);
+void indcpa_kem_expand_pk(saber_expanded_pk *epk, const uint8_t pk[SABER_INDCPA_PUBLICKEYBYTES]);
+void indcpa_kem_enc_expanded(const uint8_t m[SABER_KEYBYTES], const uint8_t seed_sp[SABER_NOISE_SEEDBYTES], const saber_expanded_pk *epk, uint8_t ciphertext[SABER_BYTES_CCA_DEC]);
 void indcpa_kem_dec(const uint8_t sk[SABER_INDCPA_SECRETKEYBYTES], const uint8_t ciphertext[SABER_BYTES_CCA_DEC], uint8_t m[SABER_KEYBYTES]);
 
 #endif
\ No newline at end of file
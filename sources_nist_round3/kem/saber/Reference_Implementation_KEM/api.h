@@ -2,6 +2,7 @@
 #define API_H
 
 #include "SABER_params.h"
+#include "SABER_indcpa.h"
 
 #if SABER_L == 2
 	#define CRYPTO_ALGNAME "LightSaber"
@@ -22,4 +23,13 @@ int crypto_kem_keypair(unsigned char *pk, unsigned char *sk);
 int crypto_kem_enc(unsigned char *ct, unsigned char *ss, const unsigned char *pk);
 int crypto_kem_dec(unsigned char *ss, const unsigned char *ct, const unsigned char *sk);
 
+/* Expanded public key, for many encapsulations to one pk or many
+   decapsulations under one sk. For decapsulation, epk must be expanded
+   from the public key stored in sk (sk + SABER_INDCPA_SECRETKEYBYTES);
+   crypto_kem_dec_expanded returns -1 if the hash of that public key does
+   not match the one kept in epk. */
+int crypto_kem_expand_pk(saber_expanded_pk *epk, const unsigned char *pk);
+int crypto_kem_enc_expanded(unsigned char *ct, unsigned char *ss, const saber_expanded_pk *epk);
+int crypto_kem_dec_expanded(unsigned char *ss, const unsigned char *ct, const unsigned char *sk, const saber_expanded_pk *epk);
+
 #endif /* api_h */
@@ -76,3 +76,65 @@ int crypto_kem_dec(unsigned char *k, const unsigned char *c, const unsigned char
 
   return (0);
 }
+
+int crypto_kem_expand_pk(saber_expanded_pk *epk, const unsigned char *pk)
+{
+  indcpa_kem_expand_pk(epk, pk);
+  return (0);
+}
+
+int crypto_kem_enc_expanded(unsigned char *c, unsigned char *k, const saber_expanded_pk *epk)
+{
+
+  unsigned char kr[64]; // Will contain key, coins
+  unsigned char buf[64];
+  int i;
+
+  randombytes(buf, 32);
+
+  sha3_256(buf, buf, 32); // BUF[0:31] <-- random message (will be used as the key for client) Note: hash doesnot release system RNG output
+
+  for (i = 0; i < 32; i++) // BUF[32:63] <-- Hash(public key), computed when the key was expanded
+    buf[32 + i] = epk->hpk[i];
+
+  sha3_512(kr, buf, 64);                      // kr[0:63] <-- Hash(buf[0:63]);
+  indcpa_kem_enc_expanded(buf, kr + 32, epk, c); // buf[0:31] contains message; kr[32:63] contains randomness r;
+
+  sha3_256(kr + 32, c, SABER_BYTES_CCA_DEC);
+
+  sha3_256(k, kr, 64); // hash concatenation of pre-k and h(c) to k
+
+  return (0);
+}
+
+int crypto_kem_dec_expanded(unsigned char *k, const unsigned char *c, const unsigned char *sk, const saber_expanded_pk *epk)
+{
+  int i, fail;
+  unsigned char cmp[SABER_BYTES_CCA_DEC];
+  unsigned char buf[64];
+  unsigned char kr[64]; // Will contain key, coins
+
+  // epk must have been expanded from the pk stored in sk: compare h(pk) of both
+  if (verify(epk->hpk, sk + SABER_SECRETKEYBYTES - 64, SABER_HASHBYTES))
+    return (-1);
+
+  indcpa_kem_dec(sk, c, buf); // buf[0:31] <-- message
+
+  // Multitarget countermeasure for coins + contributory KEM
+  for (i = 0; i < 32; i++) // Save hash by storing h(pk) in sk
+    buf[32 + i] = sk[SABER_SECRETKEYBYTES - 64 + i];
+
+  sha3_512(kr, buf, 64);
+
+  indcpa_kem_enc_expanded(buf, kr + 32, epk, cmp); // re-encryption reuses the expanded A and b
+
+  fail = verify(c, cmp, SABER_BYTES_CCA_DEC);
+
+  sha3_256(kr + 32, c, SABER_BYTES_CCA_DEC); // overwrite coins in kr with h(c)
+
+  cmov(kr, sk + SABER_SECRETKEYBYTES - SABER_KEYBYTES, SABER_KEYBYTES, fail);
+
+  sha3_256(k, kr, 64); // hash concatenation of pre-k and h(c) to k
+
+  return (0);
+}
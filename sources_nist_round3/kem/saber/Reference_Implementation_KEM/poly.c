@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <string.h>
 #include "api.h"
 #include "poly.h"
 #include "poly_mul.h"
@@ -8,30 +9,95 @@
 
 void MatrixVectorMul(const uint16_t A[SABER_L][SABER_L][SABER_N], const uint16_t s[SABER_L][SABER_N], uint16_t res[SABER_L][SABER_N], int16_t transpose)
 {
+	uint16_t sw[SABER_L][SABER_TC_POINTS][SABER_TC_N];
+	uint16_t aw[SABER_TC_POINTS][SABER_TC_N];
+	uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES];
 	int i, j;
+
+	/* each s[j] is evaluated once and reused for every row */
+	for (j = 0; j < SABER_L; j++)
+	{
+		poly_mul_eval(s[j], sw[j]);
+	}
+
 	for (i = 0; i < SABER_L; i++)
 	{
+		memset(cw, 0, sizeof(cw));
 		for (j = 0; j < SABER_L; j++)
 		{
 			if (transpose == 1)
 			{
-				poly_mul_acc(A[j][i], s[j], res[i]);
+				poly_mul_eval(A[j][i], aw);
 			}
 			else
 			{
-				poly_mul_acc(A[i][j], s[j], res[i]);
-			}	
+				poly_mul_eval(A[i][j], aw);
+			}
+			poly_mul_pointwise_acc(aw, sw[j], cw);
 		}
+		poly_mul_interp_acc(cw, res[i]);
 	}
 }
 
 void InnerProd(const uint16_t b[SABER_L][SABER_N], const uint16_t s[SABER_L][SABER_N], uint16_t res[SABER_N])
 {
+	uint16_t bw[SABER_TC_POINTS][SABER_TC_N];
+	uint16_t sw[SABER_TC_POINTS][SABER_TC_N];
+	uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES] = {{0}};
+	int j;
+
+	for (j = 0; j < SABER_L; j++)
+	{
+		poly_mul_eval(b[j], bw);
+		poly_mul_eval(s[j], sw);
+		poly_mul_pointwise_acc(bw, sw, cw);
+	}
+	poly_mul_interp_acc(cw, res);
+}
+
+/* As MatrixVectorMul, with A already in the Toom-Cook evaluated domain */
+void MatrixVectorMulEval(const uint16_t Aw[SABER_L][SABER_L][SABER_TC_POINTS][SABER_TC_N], const uint16_t s[SABER_L][SABER_N], uint16_t res[SABER_L][SABER_N], int16_t transpose)
+{
+	uint16_t sw[SABER_L][SABER_TC_POINTS][SABER_TC_N];
+	uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES];
+	int i, j;
+
+	for (j = 0; j < SABER_L; j++)
+	{
+		poly_mul_eval(s[j], sw[j]);
+	}
+
+	for (i = 0; i < SABER_L; i++)
+	{
+		memset(cw, 0, sizeof(cw));
+		for (j = 0; j < SABER_L; j++)
+		{
+			if (transpose == 1)
+			{
+				poly_mul_pointwise_acc(Aw[j][i], sw[j], cw);
+			}
+			else
+			{
+				poly_mul_pointwise_acc(Aw[i][j], sw[j], cw);
+			}
+		}
+		poly_mul_interp_acc(cw, res[i]);
+	}
+}
+
+/* As InnerProd, with b already in the Toom-Cook evaluated domain */
+void InnerProdEval(const uint16_t bw[SABER_L][SABER_TC_POINTS][SABER_TC_N], const uint16_t s[SABER_L][SABER_N], uint16_t res[SABER_N])
+{
+	uint16_t sw[SABER_TC_POINTS][SABER_TC_N];
+	uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES] = {{0}};
 	int j;
+
 	for (j = 0; j < SABER_L; j++)
 	{
-		poly_mul_acc(b[j], s[j], res);
+		poly_mul_eval(s[j], sw);
+		poly_mul_pointwise_acc(bw[j], sw, cw);
 	}
+	poly_mul_interp_acc(cw, res);
 }
 
 void GenMatrix(uint16_t A[SABER_L][SABER_L][SABER_N], const uint8_t seed[SABER_SEEDBYTES])
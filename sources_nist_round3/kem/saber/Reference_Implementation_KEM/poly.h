@@ -3,9 +3,12 @@
 
 #include <stdint.h>
 #include "SABER_params.h"
+#include "poly_mul.h"
 
 void MatrixVectorMul(const uint16_t a[SABER_L][SABER_L][SABER_N], const uint16_t s[SABER_L][SABER_N], uint16_t res[SABER_L][SABER_N], int16_t transpose);
 void InnerProd(const uint16_t b[SABER_L][SABER_N], const uint16_t s[SABER_L][SABER_N], uint16_t res[SABER_N]);
+void MatrixVectorMulEval(const uint16_t Aw[SABER_L][SABER_L][SABER_TC_POINTS][SABER_TC_N], const uint16_t s[SABER_L][SABER_N], uint16_t res[SABER_L][SABER_N], int16_t transpose);
+void InnerProdEval(const uint16_t bw[SABER_L][SABER_TC_POINTS][SABER_TC_N], const uint16_t s[SABER_L][SABER_N], uint16_t res[SABER_N]);
 void GenMatrix(uint16_t a[SABER_L][SABER_L][SABER_N], const uint8_t seed[SABER_SEEDBYTES]);
 void GenSecret(uint16_t s[SABER_L][SABER_N], const uint8_t seed[SABER_NOISE_SEEDBYTES]);
 
@@ -1,4 +1,5 @@
 #include "poly_mul.h"
+#include "poly_mul_avx2.h"
 #include <stdint.h>
 #include <string.h>
 
@@ -110,28 +111,15 @@ static void karatsuba_simple(const uint16_t *a_1, const uint16_t *b_1, uint16_t
 
 
 
-static void toom_cook_4way (const uint16_t *a1, const uint16_t *b1, uint16_t *result) {
-    uint16_t inv3 = 43691, inv9 = 36409, inv15 = 61167;
-
-    uint16_t aw1[N_SB], aw2[N_SB], aw3[N_SB], aw4[N_SB], aw5[N_SB], aw6[N_SB], aw7[N_SB];
-    uint16_t bw1[N_SB], bw2[N_SB], bw3[N_SB], bw4[N_SB], bw5[N_SB], bw6[N_SB], bw7[N_SB];
-    uint16_t w1[N_SB_RES] = {0}, w2[N_SB_RES] = {0}, w3[N_SB_RES] = {0}, w4[N_SB_RES] = {0},
-                            w5[N_SB_RES] = {0}, w6[N_SB_RES] = {0}, w7[N_SB_RES] = {0};
+static void toom_cook_4way_eval(const uint16_t *a1, uint16_t aw[SABER_TC_POINTS][N_SB]) {
     uint16_t r0, r1, r2, r3, r4, r5, r6, r7;
-    uint16_t *A0, *A1, *A2, *A3, *B0, *B1, *B2, *B3;
-    A0 = (uint16_t *)a1;
-    A1 = (uint16_t *)&a1[N_SB];
-    A2 = (uint16_t *)&a1[2 * N_SB];
-    A3 = (uint16_t *)&a1[3 * N_SB];
-    B0 = (uint16_t *)b1;
-    B1 = (uint16_t *)&b1[N_SB];
-    B2 = (uint16_t *)&b1[2 * N_SB];
-    B3 = (uint16_t *)&b1[3 * N_SB];
-
-    uint16_t *C;
-    C = result;
+    const uint16_t *A0, *A1, *A2, *A3;
+    A0 = a1;
+    A1 = &a1[N_SB];
+    A2 = &a1[2 * N_SB];
+    A3 = &a1[3 * N_SB];
 
-    int i, j;
+    int j;
 
     // EVALUATION
     for (j = 0; j < N_SB; ++j) {
@@ -143,61 +131,39 @@ static void toom_cook_4way (const uint16_t *a1, const uint16_t *b1, uint16_t *re
         r5 = r1 + r3;
         r6 = r4 + r5;
         r7 = r4 - r5;
-        aw3[j] = r6;
-        aw4[j] = r7;
-        r4 = ((r0 << 2) + r2) << 1;
-        r5 = (r1 << 2) + r3;
-        r6 = r4 + r5;
-        r7 = r4 - r5;
-        aw5[j] = r6;
-        aw6[j] = r7;
-        r4 = (r3 << 3) + (r2 << 2) + (r1 << 1) + r0;
-        aw2[j] = r4;
-        aw7[j] = r0;
-        aw1[j] = r3;
-    }
-    for (j = 0; j < N_SB; ++j) {
-        r0 = B0[j];
-        r1 = B1[j];
-        r2 = B2[j];
-        r3 = B3[j];
-        r4 = r0 + r2;
-        r5 = r1 + r3;
-        r6 = r4 + r5;
-        r7 = r4 - r5;
-        bw3[j] = r6;
-        bw4[j] = r7;
+        aw[2][j] = r6;
+        aw[3][j] = r7;
         r4 = ((r0 << 2) + r2) << 1;
         r5 = (r1 << 2) + r3;
         r6 = r4 + r5;
         r7 = r4 - r5;
-        bw5[j] = r6;
-        bw6[j] = r7;
+        aw[4][j] = r6;
+        aw[5][j] = r7;
         r4 = (r3 << 3) + (r2 << 2) + (r1 << 1) + r0;
-        bw2[j] = r4;
-        bw7[j] = r0;
-        bw1[j] = r3;
+        aw[1][j] = r4;
+        aw[6][j] = r0;
+        aw[0][j] = r3;
     }
+}
 
-    // MULTIPLICATION
+static void toom_cook_4way_interp(const uint16_t w[SABER_TC_POINTS][N_SB_RES], uint16_t *result) {
+    uint16_t inv3 = 43691, inv9 = 36409, inv15 = 61167;
 
-    karatsuba_simple(aw1, bw1, w1);
-    karatsuba_simple(aw2, bw2, w2);
-    karatsuba_simple(aw3, bw3, w3);
-    karatsuba_simple(aw4, bw4, w4);
-    karatsuba_simple(aw5, bw5, w5);
-    karatsuba_simple(aw6, bw6, w6);
-    karatsuba_simple(aw7, bw7, w7);
+    uint16_t r0, r1, r2, r3, r4, r5, r6;
+    uint16_t *C;
+    C = result;
+
+    int i;
 
     // INTERPOLATION
     for (i = 0; i < N_SB_RES; ++i) {
-        r0 = w1[i];
-        r1 = w2[i];
-        r2 = w3[i];
-        r3 = w4[i];
-        r4 = w5[i];
-        r5 = w6[i];
-        r6 = w7[i];
+        r0 = w[0][i];
+        r1 = w[1][i];
+        r2 = w[2][i];
+        r3 = w[3][i];
+        r4 = w[4][i];
+        r5 = w[5][i];
+        r6 = w[6][i];
 
         r1 = r1 + r4;
         r5 = r5 - r4;
@@ -228,12 +194,42 @@ static void toom_cook_4way (const uint16_t *a1, const uint16_t *b1, uint16_t *re
     }
 }
 
+static void toom_cook_4way (const uint16_t *a1, const uint16_t *b1, uint16_t *result) {
+    uint16_t aw[SABER_TC_POINTS][N_SB], bw[SABER_TC_POINTS][N_SB];
+    uint16_t w[SABER_TC_POINTS][N_SB_RES];
+    int k;
+
+    toom_cook_4way_eval(a1, aw);
+    toom_cook_4way_eval(b1, bw);
+
+    // MULTIPLICATION
+    for (k = 0; k < SABER_TC_POINTS; k++) {
+        karatsuba_simple(aw[k], bw[k], w[k]);
+    }
+
+    toom_cook_4way_interp(w, result);
+}
+
 /* res += a*b */
 void poly_mul_acc(const uint16_t a[SABER_N], const uint16_t b[SABER_N], uint16_t res[SABER_N])
 {
 	uint16_t c[2 * SABER_N] = {0};
 	int i;
 
+#ifdef SABER_AVX2_BACKEND
+	if (poly_mul_avx2_supported())
+	{
+		uint16_t aw[SABER_TC_POINTS][SABER_TC_N], bw[SABER_TC_POINTS][SABER_TC_N];
+		uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES] = {{0}};
+
+		poly_mul_eval_avx2(a, aw);
+		poly_mul_eval_avx2(b, bw);
+		poly_mul_pointwise_acc_avx2(aw, bw, cw);
+		poly_mul_interp_acc_avx2(cw, res);
+		return;
+	}
+#endif
+
 	toom_cook_4way(a, b, c);
 
 	/* reduction */
@@ -242,3 +238,63 @@ void poly_mul_acc(const uint16_t a[SABER_N], const uint16_t b[SABER_N], uint16_t
 		res[i - SABER_N] += (c[i - SABER_N] - c[i]);
 	}
 }
+
+/* aw <- Toom-Cook 4-way evaluation of a */
+void poly_mul_eval(const uint16_t a[SABER_N], uint16_t aw[SABER_TC_POINTS][SABER_TC_N])
+{
+#ifdef SABER_AVX2_BACKEND
+	if (poly_mul_avx2_supported())
+	{
+		poly_mul_eval_avx2(a, aw);
+		return;
+	}
+#endif
+	toom_cook_4way_eval(a, aw);
+}
+
+/* cw += aw*bw, pointwise over the evaluation points */
+void poly_mul_pointwise_acc(const uint16_t aw[SABER_TC_POINTS][SABER_TC_N], const uint16_t bw[SABER_TC_POINTS][SABER_TC_N], uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES])
+{
+	uint16_t t[SABER_TC_NRES];
+	int i, k;
+
+#ifdef SABER_AVX2_BACKEND
+	if (poly_mul_avx2_supported())
+	{
+		poly_mul_pointwise_acc_avx2(aw, bw, cw);
+		return;
+	}
+#endif
+
+	for (k = 0; k < SABER_TC_POINTS; k++)
+	{
+		karatsuba_simple(aw[k], bw[k], t);
+		for (i = 0; i < SABER_TC_NRES; i++)
+		{
+			cw[k][i] += t[i];
+		}
+	}
+}
+
+/* res += interpolation of cw, reduced mod X^N + 1 */
+void poly_mul_interp_acc(const uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES], uint16_t res[SABER_N])
+{
+	uint16_t c[2 * SABER_N] = {0};
+	int i;
+
+#ifdef SABER_AVX2_BACKEND
+	if (poly_mul_avx2_supported())
+	{
+		poly_mul_interp_acc_avx2(cw, res);
+		return;
+	}
+#endif
+
+	toom_cook_4way_interp(cw, c);
+
+	/* reduction */
+	for (i = SABER_N; i < 2 * SABER_N; i++)
+	{
+		res[i - SABER_N] += (c[i - SABER_N] - c[i]);
+	}
+}
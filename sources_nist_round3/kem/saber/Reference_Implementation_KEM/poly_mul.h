@@ -4,6 +4,17 @@
 #include "SABER_params.h"
 #include <stdint.h>
 
+/* Toom-Cook 4-way: 7 evaluation points of N/4 coefficients, products of 2*N/4-1 */
+#define SABER_TC_POINTS 7
+#define SABER_TC_N (SABER_N >> 2)
+#define SABER_TC_NRES (2 * SABER_TC_N - 1)
+
 void poly_mul_acc(const uint16_t a[SABER_N], const uint16_t b[SABER_N], uint16_t res[SABER_N]);
 
+/* Lazy interpolation: evaluate each operand once, accumulate pointwise
+   products in the evaluated domain and interpolate once per output. */
+void poly_mul_eval(const uint16_t a[SABER_N], uint16_t aw[SABER_TC_POINTS][SABER_TC_N]);
+void poly_mul_pointwise_acc(const uint16_t aw[SABER_TC_POINTS][SABER_TC_N], const uint16_t bw[SABER_TC_POINTS][SABER_TC_N], uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES]);
+void poly_mul_interp_acc(const uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES], uint16_t res[SABER_N]);
+
 #endif
\ No newline at end of file
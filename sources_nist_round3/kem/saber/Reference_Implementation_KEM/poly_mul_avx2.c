@@ -0,0 +1,207 @@
+#include "poly_mul_avx2.h"
+
+#ifdef SABER_AVX2_BACKEND
+
+#include <immintrin.h>
+#include <string.h>
+
+#define AVX2 __attribute__((target("avx2")))
+
+#define N_SB SABER_TC_N
+#define N_SB_RES SABER_TC_NRES
+#define N_SB_PAD (N_SB_RES + 1)
+
+#define SCHB_N 32
+
+int poly_mul_avx2_supported(void)
+{
+	return __builtin_cpu_supports("avx2");
+}
+
+/* 32x32 schoolbook, 16 lanes at a time.
+   c[0..3] = a*b (63 coefficients, lane 63 is zero) */
+AVX2 static void schoolbook_32(const uint16_t *a, const uint16_t *b, __m256i c[4])
+{
+	/* b padded with SCHB_N zeros on each side, so that b * X^i can be read
+	   with unaligned loads for every shift i */
+	uint16_t z[3 * SCHB_N] __attribute__((aligned(32)));
+	__m256i ai;
+	const uint16_t *zb = z + SCHB_N;
+	int i;
+
+	memset(z, 0, sizeof(z));
+	memcpy(z + SCHB_N, b, SCHB_N * sizeof(uint16_t));
+
+	c[0] = c[1] = c[2] = c[3] = _mm256_setzero_si256();
+	for (i = 0; i < SCHB_N; i++)
+	{
+		ai = _mm256_set1_epi16((short)a[i]);
+		c[0] = _mm256_add_epi16(c[0], _mm256_mullo_epi16(ai, _mm256_loadu_si256((const __m256i *)(zb - i))));
+		c[1] = _mm256_add_epi16(c[1], _mm256_mullo_epi16(ai, _mm256_loadu_si256((const __m256i *)(zb + 16 - i))));
+		c[2] = _mm256_add_epi16(c[2], _mm256_mullo_epi16(ai, _mm256_loadu_si256((const __m256i *)(zb + 32 - i))));
+		c[3] = _mm256_add_epi16(c[3], _mm256_mullo_epi16(ai, _mm256_loadu_si256((const __m256i *)(zb + 48 - i))));
+	}
+}
+
+/* One Karatsuba level over schoolbook_32: r[0..7] = a*b (127 coefficients) */
+AVX2 static void karatsuba_64(const uint16_t *a, const uint16_t *b, __m256i r[8])
+{
+	uint16_t a01[SCHB_N] __attribute__((aligned(32)));
+	uint16_t b01[SCHB_N] __attribute__((aligned(32)));
+	__m256i p0[4], p1[4], p2[4];
+	int i;
+
+	for (i = 0; i < SCHB_N; i += 16)
+	{
+		_mm256_store_si256((__m256i *)(a01 + i), _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)(a + i)), _mm256_loadu_si256((const __m256i *)(a + SCHB_N + i))));
+		_mm256_store_si256((__m256i *)(b01 + i), _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)(b + i)), _mm256_loadu_si256((const __m256i *)(b + SCHB_N + i))));
+	}
+
+	schoolbook_32(a, b, p0);
+	schoolbook_32(a + SCHB_N, b + SCHB_N, p2);
+	schoolbook_32(a01, b01, p1);
+
+	for (i = 0; i < 4; i++)
+	{
+		p1[i] = _mm256_sub_epi16(_mm256_sub_epi16(p1[i], p0[i]), p2[i]);
+	}
+
+	r[0] = p0[0];
+	r[1] = p0[1];
+	r[2] = _mm256_add_epi16(p0[2], p1[0]);
+	r[3] = _mm256_add_epi16(p0[3], p1[1]);
+	r[4] = _mm256_add_epi16(p1[2], p2[0]);
+	r[5] = _mm256_add_epi16(p1[3], p2[1]);
+	r[6] = p2[2];
+	r[7] = p2[3];
+}
+
+AVX2 void poly_mul_eval_avx2(const uint16_t a[SABER_N], uint16_t aw[SABER_TC_POINTS][SABER_TC_N])
+{
+	__m256i r0, r1, r2, r3, r4, r5;
+	int j;
+
+	for (j = 0; j < N_SB; j += 16)
+	{
+		r0 = _mm256_loadu_si256((const __m256i *)&a[j]);
+		r1 = _mm256_loadu_si256((const __m256i *)&a[N_SB + j]);
+		r2 = _mm256_loadu_si256((const __m256i *)&a[2 * N_SB + j]);
+		r3 = _mm256_loadu_si256((const __m256i *)&a[3 * N_SB + j]);
+
+		r4 = _mm256_add_epi16(r0, r2);
+		r5 = _mm256_add_epi16(r1, r3);
+		_mm256_storeu_si256((__m256i *)&aw[2][j], _mm256_add_epi16(r4, r5));
+		_mm256_storeu_si256((__m256i *)&aw[3][j], _mm256_sub_epi16(r4, r5));
+
+		r4 = _mm256_slli_epi16(_mm256_add_epi16(_mm256_slli_epi16(r0, 2), r2), 1);
+		r5 = _mm256_add_epi16(_mm256_slli_epi16(r1, 2), r3);
+		_mm256_storeu_si256((__m256i *)&aw[4][j], _mm256_add_epi16(r4, r5));
+		_mm256_storeu_si256((__m256i *)&aw[5][j], _mm256_sub_epi16(r4, r5));
+
+		r4 = _mm256_add_epi16(_mm256_add_epi16(_mm256_slli_epi16(r3, 3), _mm256_slli_epi16(r2, 2)),
+		                      _mm256_add_epi16(_mm256_slli_epi16(r1, 1), r0));
+		_mm256_storeu_si256((__m256i *)&aw[1][j], r4);
+		_mm256_storeu_si256((__m256i *)&aw[6][j], r0);
+		_mm256_storeu_si256((__m256i *)&aw[0][j], r3);
+	}
+}
+
+AVX2 void poly_mul_pointwise_acc_avx2(const uint16_t aw[SABER_TC_POINTS][SABER_TC_N], const uint16_t bw[SABER_TC_POINTS][SABER_TC_N], uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES])
+{
+	uint16_t t[N_SB_PAD] __attribute__((aligned(32)));
+	__m256i r[8];
+	int i, k;
+
+	for (k = 0; k < SABER_TC_POINTS; k++)
+	{
+		karatsuba_64(aw[k], bw[k], r);
+		for (i = 0; i < 7; i++)
+		{
+			__m256i c = _mm256_loadu_si256((const __m256i *)&cw[k][16 * i]);
+			_mm256_storeu_si256((__m256i *)&cw[k][16 * i], _mm256_add_epi16(c, r[i]));
+		}
+		/* last block: only 15 of the 16 lanes belong to this row */
+		_mm256_store_si256((__m256i *)&t[16 * 7], r[7]);
+		for (i = 16 * 7; i < N_SB_RES; i++)
+		{
+			cw[k][i] += t[i];
+		}
+	}
+}
+
+/* Same interpolation as toom_cook_4way_interp in poly_mul.c. Lanes are 16 bits
+   wide, so the exact divisions are done mod 2^16; the coefficients agree with
+   the portable code mod 2^SABER_EQ, which is all that Saber uses. */
+AVX2 void poly_mul_interp_acc_avx2(const uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES], uint16_t res[SABER_N])
+{
+	uint16_t w[SABER_TC_POINTS][N_SB_PAD] __attribute__((aligned(32)));
+	uint16_t c[2 * SABER_N] __attribute__((aligned(32)));
+	const __m256i inv3 = _mm256_set1_epi16((short)43691);
+	const __m256i inv9 = _mm256_set1_epi16((short)36409);
+	const __m256i inv15 = _mm256_set1_epi16((short)61167);
+	const __m256i c45 = _mm256_set1_epi16(45);
+	const __m256i c30 = _mm256_set1_epi16(30);
+	__m256i r0, r1, r2, r3, r4, r5, r6, t;
+	int i, k;
+
+	/* pad every row to a whole number of vectors; the zero lane
+	   interpolates to zero */
+	for (k = 0; k < SABER_TC_POINTS; k++)
+	{
+		memcpy(w[k], cw[k], N_SB_RES * sizeof(uint16_t));
+		w[k][N_SB_RES] = 0;
+	}
+	memset(c, 0, sizeof(c));
+
+	for (i = 0; i < N_SB_PAD; i += 16)
+	{
+		r0 = _mm256_load_si256((const __m256i *)&w[0][i]);
+		r1 = _mm256_load_si256((const __m256i *)&w[1][i]);
+		r2 = _mm256_load_si256((const __m256i *)&w[2][i]);
+		r3 = _mm256_load_si256((const __m256i *)&w[3][i]);
+		r4 = _mm256_load_si256((const __m256i *)&w[4][i]);
+		r5 = _mm256_load_si256((const __m256i *)&w[5][i]);
+		r6 = _mm256_load_si256((const __m256i *)&w[6][i]);
+
+		r1 = _mm256_add_epi16(r1, r4);
+		r5 = _mm256_sub_epi16(r5, r4);
+		r3 = _mm256_srli_epi16(_mm256_sub_epi16(r3, r2), 1);
+		r4 = _mm256_sub_epi16(r4, r0);
+		r4 = _mm256_sub_epi16(r4, _mm256_slli_epi16(r6, 6));
+		r4 = _mm256_add_epi16(_mm256_slli_epi16(r4, 1), r5);
+		r2 = _mm256_add_epi16(r2, r3);
+		r1 = _mm256_sub_epi16(_mm256_sub_epi16(r1, _mm256_slli_epi16(r2, 6)), r2);
+		r2 = _mm256_sub_epi16(r2, r6);
+		r2 = _mm256_sub_epi16(r2, r0);
+		r1 = _mm256_add_epi16(r1, _mm256_mullo_epi16(r2, c45));
+		t = _mm256_sub_epi16(r4, _mm256_slli_epi16(r2, 3));
+		r4 = _mm256_srli_epi16(_mm256_mullo_epi16(t, inv3), 3);
+		r5 = _mm256_add_epi16(r5, r1);
+		t = _mm256_add_epi16(r1, _mm256_slli_epi16(r3, 4));
+		r1 = _mm256_srli_epi16(_mm256_mullo_epi16(t, inv9), 1);
+		r3 = _mm256_sub_epi16(_mm256_setzero_si256(), _mm256_add_epi16(r3, r1));
+		t = _mm256_sub_epi16(_mm256_mullo_epi16(r1, c30), r5);
+		r5 = _mm256_srli_epi16(_mm256_mullo_epi16(t, inv15), 2);
+		r2 = _mm256_sub_epi16(r2, r4);
+		r1 = _mm256_sub_epi16(r1, r5);
+
+#define ACC(off, x) _mm256_storeu_si256((__m256i *)&c[i + (off)], _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)&c[i + (off)]), (x)))
+		ACC(0, r6);
+		ACC(64, r5);
+		ACC(128, r4);
+		ACC(192, r3);
+		ACC(256, r2);
+		ACC(320, r1);
+		ACC(384, r0);
+#undef ACC
+	}
+
+	/* reduction */
+	for (i = 0; i < SABER_N; i += 16)
+	{
+		t = _mm256_sub_epi16(_mm256_load_si256((const __m256i *)&c[i]), _mm256_load_si256((const __m256i *)&c[i + SABER_N]));
+		_mm256_storeu_si256((__m256i *)&res[i], _mm256_add_epi16(_mm256_loadu_si256((const __m256i *)&res[i]), t));
+	}
+}
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef POLY_MUL_AVX2_H
+#define POLY_MUL_AVX2_H
+
+#include "SABER_params.h"
+#include "poly_mul.h"
+#include <stdint.h>
+
+/* AVX2 backend for the Toom-Cook 4-way multiplier. It is compiled on x86
+   with GCC/Clang (define SABER_NO_AVX2 to leave it out) and selected at
+   runtime by poly_mul.c when the CPU supports AVX2. */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && !defined(SABER_NO_AVX2)
+#define SABER_AVX2_BACKEND 1
+
+int poly_mul_avx2_supported(void);
+
+void poly_mul_eval_avx2(const uint16_t a[SABER_N], uint16_t aw[SABER_TC_POINTS][SABER_TC_N]);
+void poly_mul_pointwise_acc_avx2(const uint16_t aw[SABER_TC_POINTS][SABER_TC_N], const uint16_t bw[SABER_TC_POINTS][SABER_TC_N], uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES]);
+void poly_mul_interp_acc_avx2(const uint16_t cw[SABER_TC_POINTS][SABER_TC_NRES], uint16_t res[SABER_N]);
+#endif
+
+#endif
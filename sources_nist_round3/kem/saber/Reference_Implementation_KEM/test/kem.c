@@ -55,6 +55,33 @@ static int test_kem_cca()
 	    }
 
 
+	    // Expanded public key: repeated encapsulations and decapsulations
+	    saber_expanded_pk epk;
+	    crypto_kem_expand_pk(&epk, pk);
+	    for(i=0; i<4; i++)
+	    {
+		crypto_kem_enc_expanded(ct, ss_a, &epk);
+		crypto_kem_dec(ss_b, ct, sk);
+		if(memcmp(ss_a, ss_b, SABER_KEYBYTES) != 0)
+		{
+			printf(" ----- ERR CCA KEM (expanded enc) ------\n");
+			break;
+		}
+		crypto_kem_dec_expanded(ss_b, ct, sk, &epk);
+		if(memcmp(ss_a, ss_b, SABER_KEYBYTES) != 0)
+		{
+			printf(" ----- ERR CCA KEM (expanded dec) ------\n");
+			break;
+		}
+	    }
+
+	    // Decapsulation must refuse an expanded key of another public key
+	    uint8_t pk2[CRYPTO_PUBLICKEYBYTES];
+	    uint8_t sk2[CRYPTO_SECRETKEYBYTES];
+	    crypto_kem_keypair(pk2, sk2);
+	    if(crypto_kem_dec_expanded(ss_b, ct, sk2, &epk) != -1)
+		printf(" ----- ERR CCA KEM (expanded dec with mismatched key) ------\n");
+
   	return 0;
 }
 
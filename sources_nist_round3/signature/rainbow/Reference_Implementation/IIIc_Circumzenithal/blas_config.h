@@ -0,0 +1,28 @@
+/// @file blas_config.h
+/// @brief Configure file for choosing instruction set of BLAS functions.
+///
+///  The ssse3 and avx2 backends are compiled with function-level target attributes
+///  and chosen at run time, so the default CFLAGS (no -mavx2) still produce a portable binary.
+///  Define _BLAS_NO_SIMD_ to build the portable code only.
+///
+
+#ifndef _BLAS_CONFIG_H_
+#define _BLAS_CONFIG_H_
+
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && !defined(_BLAS_NO_SIMD_)
+
+#define _BLAS_SIMD_DISPATCH_
+
+#define _BLAS_TARGET_SSE_   __attribute__((target("ssse3")))
+#define _BLAS_TARGET_AVX2_  __attribute__((target("avx2")))
+
+static inline int blas_cpu_has_avx2(void)  { return __builtin_cpu_supports("avx2"); }
+
+static inline int blas_cpu_has_ssse3(void) { return __builtin_cpu_supports("ssse3"); }
+
+#endif
+
+
+#endif // _BLAS_CONFIG_H_
+
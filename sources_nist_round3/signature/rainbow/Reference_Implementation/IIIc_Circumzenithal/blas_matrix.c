@@ -9,6 +9,9 @@
 
 
 // choosing the implementations depends on the macros _BLAS_AVX2_ and _BLAS_SSE_
+// Without them, the avx2 or ssse3 implementations are chosen at run time if blas_config.h enables them.
+
+#include "blas_config.h"
 
 
 #if defined( _BLAS_AVX2_ )
@@ -45,6 +48,12 @@
 
 #include "blas_matrix_ref.h"
 
+#if defined( _BLAS_SIMD_DISPATCH_ )
+#include "blas_matrix_avx2.h"
+#include "blas_matrix_sse.h"
+#define _BLAS_RUNTIME_DISPATCH_
+#endif
+
 #define gf16mat_prod_impl             gf16mat_prod_ref
 #define gf256mat_prod_impl            gf256mat_prod_ref
 
@@ -65,12 +74,20 @@
 
 void gf16mat_prod(uint8_t *c, const uint8_t *matA, unsigned n_A_vec_byte, unsigned n_A_width, const uint8_t *b)
 {
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) { gf16mat_prod_avx2( c , matA , n_A_vec_byte , n_A_width , b ); return; }
+    if( blas_cpu_has_ssse3() ) { gf16mat_prod_sse( c , matA , n_A_vec_byte , n_A_width , b ); return; }
+#endif
     gf16mat_prod_impl( c, matA, n_A_vec_byte, n_A_width, b);
 }
 
 
 void gf256mat_prod(uint8_t *c, const uint8_t *matA, unsigned n_A_vec_byte, unsigned n_A_width, const uint8_t *b)
 {
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) { gf256mat_prod_avx2( c , matA , n_A_vec_byte , n_A_width , b ); return; }
+    if( blas_cpu_has_ssse3() ) { gf256mat_prod_sse( c , matA , n_A_vec_byte , n_A_width , b ); return; }
+#endif
     gf256mat_prod_impl( c, matA, n_A_vec_byte, n_A_width, b);
 }
 
@@ -80,11 +97,19 @@ void gf256mat_prod(uint8_t *c, const uint8_t *matA, unsigned n_A_vec_byte, unsig
 
 unsigned gf16mat_solve_linear_eq_32x32( uint8_t * sol , const uint8_t * inp_mat , const uint8_t * c_terms )
 {
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf16mat_solve_linear_eq_32x32_avx2( sol , inp_mat , c_terms );
+    if( blas_cpu_has_ssse3() ) return gf16mat_solve_linear_eq_32x32_sse( sol , inp_mat , c_terms );
+#endif
     return gf16mat_solve_linear_eq_32x32_impl( sol , inp_mat , c_terms );
 }
 
 unsigned gf16mat_inv_32x32( uint8_t * inv_a , const uint8_t * a )
 {
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf16mat_inv_32x32_avx2( inv_a , a );
+    if( blas_cpu_has_ssse3() ) return gf16mat_inv_32x32_sse( inv_a , a );
+#endif
     return gf16mat_inv_32x32_impl( inv_a , a );
 }
 
@@ -94,11 +119,19 @@ unsigned gf16mat_inv_32x32( uint8_t * inv_a , const uint8_t * a )
 
 unsigned gf256mat_solve_linear_eq_48x48( uint8_t * sol , const uint8_t * inp_mat , const uint8_t * c_terms )
 {
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf256mat_solve_linear_eq_48x48_avx2( sol , inp_mat , c_terms );
+    if( blas_cpu_has_ssse3() ) return gf256mat_solve_linear_eq_48x48_sse( sol , inp_mat , c_terms );
+#endif
     return gf256mat_solve_linear_eq_48x48_impl( sol , inp_mat , c_terms );
 }
 
 unsigned gf256mat_inv_32x32( uint8_t * inv_a , const uint8_t * a )
 {
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf256mat_inv_32x32_avx2( inv_a , a );
+    if( blas_cpu_has_ssse3() ) return gf256mat_inv_32x32_sse( inv_a , a );
+#endif
     return gf256mat_inv_32x32_impl( inv_a , a );
 }
 
@@ -108,11 +141,101 @@ unsigned gf256mat_inv_32x32( uint8_t * inv_a , const uint8_t * a )
 
 unsigned gf256mat_solve_linear_eq_64x64( uint8_t * sol , const uint8_t * inp_mat , const uint8_t * c_terms )
 {
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf256mat_solve_linear_eq_64x64_avx2( sol , inp_mat , c_terms );
+    if( blas_cpu_has_ssse3() ) return gf256mat_solve_linear_eq_64x64_sse( sol , inp_mat , c_terms );
+#endif
     return gf256mat_solve_linear_eq_64x64_impl( sol , inp_mat , c_terms );
 }
 
 unsigned gf256mat_inv_36x36( uint8_t * inv_a , const uint8_t * a )
 {
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf256mat_inv_36x36_avx2( inv_a , a );
+    if( blas_cpu_has_ssse3() ) return gf256mat_inv_36x36_sse( inv_a , a );
+#endif
     return gf256mat_inv_36x36_impl( inv_a , a );
 }
 
+
+
+////////////////  building the linear equations and solving  ////////////////
+
+
+unsigned gf16mat_prod_solve_linear_eq_32x32( uint8_t * sol , const uint8_t * mat_c , const uint8_t * matA , unsigned n_A_width , const uint8_t * b , const uint8_t * c_terms )
+{
+    uint8_t mat[32*16];
+    gf16mat_prod( mat , matA , 32*16 , n_A_width , b );
+    gf256v_add( mat , mat_c , 32*16 );
+    unsigned r8 = gf16mat_solve_linear_eq_32x32( sol , mat , c_terms );
+    gf256v_set_zero( mat , 32*16 );
+    return r8;
+}
+
+unsigned gf16mat_prod_inv_32x32( uint8_t * inv_a , const uint8_t * matA , unsigned n_A_width , const uint8_t * b )
+{
+    uint8_t mat[32*16];
+    gf16mat_prod( mat , matA , 32*16 , n_A_width , b );
+    unsigned r8 = gf16mat_inv_32x32( inv_a , mat );
+    gf256v_set_zero( mat , 32*16 );
+    return r8;
+}
+
+
+////////////////
+
+
+unsigned gf256mat_prod_solve_linear_eq_48x48( uint8_t * sol , const uint8_t * mat_c , const uint8_t * matA , unsigned n_A_width , const uint8_t * b , const uint8_t * c_terms )
+{
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf256mat_prod_solve_linear_eq_48x48_avx2( sol , mat_c , matA , n_A_width , b , c_terms );
+    if( blas_cpu_has_ssse3() ) return gf256mat_prod_solve_linear_eq_48x48_sse( sol , mat_c , matA , n_A_width , b , c_terms );
+#endif
+    uint8_t mat[48*48];
+    gf256mat_prod( mat , matA , 48*48 , n_A_width , b );
+    gf256v_add( mat , mat_c , 48*48 );
+    unsigned r8 = gf256mat_solve_linear_eq_48x48( sol , mat , c_terms );
+    gf256v_set_zero( mat , 48*48 );
+    return r8;
+}
+
+unsigned gf256mat_prod_inv_32x32( uint8_t * inv_a , const uint8_t * matA , unsigned n_A_width , const uint8_t * b )
+{
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf256mat_prod_inv_32x32_avx2( inv_a , matA , n_A_width , b );
+    if( blas_cpu_has_ssse3() ) return gf256mat_prod_inv_32x32_sse( inv_a , matA , n_A_width , b );
+#endif
+    uint8_t mat[32*32];
+    gf256mat_prod( mat , matA , 32*32 , n_A_width , b );
+    unsigned r8 = gf256mat_inv_32x32( inv_a , mat );
+    gf256v_set_zero( mat , 32*32 );
+    return r8;
+}
+
+
+unsigned gf256mat_prod_solve_linear_eq_64x64( uint8_t * sol , const uint8_t * mat_c , const uint8_t * matA , unsigned n_A_width , const uint8_t * b , const uint8_t * c_terms )
+{
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf256mat_prod_solve_linear_eq_64x64_avx2( sol , mat_c , matA , n_A_width , b , c_terms );
+    if( blas_cpu_has_ssse3() ) return gf256mat_prod_solve_linear_eq_64x64_sse( sol , mat_c , matA , n_A_width , b , c_terms );
+#endif
+    uint8_t mat[64*64];
+    gf256mat_prod( mat , matA , 64*64 , n_A_width , b );
+    gf256v_add( mat , mat_c , 64*64 );
+    unsigned r8 = gf256mat_solve_linear_eq_64x64( sol , mat , c_terms );
+    gf256v_set_zero( mat , 64*64 );
+    return r8;
+}
+
+unsigned gf256mat_prod_inv_36x36( uint8_t * inv_a , const uint8_t * matA , unsigned n_A_width , const uint8_t * b )
+{
+#if defined( _BLAS_RUNTIME_DISPATCH_ )
+    if( blas_cpu_has_avx2() ) return gf256mat_prod_inv_36x36_avx2( inv_a , matA , n_A_width , b );
+    if( blas_cpu_has_ssse3() ) return gf256mat_prod_inv_36x36_sse( inv_a , matA , n_A_width , b );
+#endif
+    uint8_t mat[36*36];
+    gf256mat_prod( mat , matA , 36*36 , n_A_width , b );
+    unsigned r8 = gf256mat_inv_36x36( inv_a , mat );
+    gf256v_set_zero( mat , 36*36 );
+    return r8;
+}
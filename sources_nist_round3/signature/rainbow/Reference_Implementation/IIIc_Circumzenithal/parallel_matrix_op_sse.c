@@ -0,0 +1,359 @@
+///  @file parallel_matrix_op_sse.c
+///  @brief the SSSE3 implementations for functions in parallel_matrix_op.h
+///
+///  The scalars taken from the non-batched matrix (B, A_to_tr or x) are turned into
+///  multiplication tables once, and every batched element is multiplied through PSHUFB.
+///  The loops run column by column of B, so only one column of tables lives on the stack.
+///
+
+#include "blas_comm.h"
+#include "blas_sse.h"
+
+#include "parallel_matrix_op.h"
+#include "parallel_matrix_op_sse.h"
+
+#if defined(_BLAS_SIMD_DISPATCH_)
+
+#include "utils_malloc.h"   // _ALIGN_
+
+/// the maximal number of elements turned into tables at once: a column of B, or x in the eval functions.
+#define MAX_TAB_ELE  256
+
+
+/////////////////  Section: matrix multiplications  ///////////////////////////////
+
+
+
+_BLAS_TARGET_SSE_
+void batch_trimat_madd_gf16_sse( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[16*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Aheight = Bheight;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf16v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        const unsigned char * ptrA = btriA;
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            for(unsigned k=i;k<Bheight;k++) {
+                _gf16v_madd_multab_sse( ptrC , & ptrA[ (k-i)*size_batch ] , &multabs[16*k] , size_batch );
+            }
+            ptrA += (Aheight-i)*size_batch;
+        }
+    }
+}
+
+_BLAS_TARGET_SSE_
+void batch_trimat_madd_gf256_sse( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[32*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Aheight = Bheight;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf256v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        const unsigned char * ptrA = btriA;
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            for(unsigned k=i;k<Bheight;k++) {
+                _gf256v_madd_multab_sse( ptrC , & ptrA[ (k-i)*size_batch ] , &multabs[32*k] , size_batch );
+            }
+            ptrA += (Aheight-i)*size_batch;
+        }
+    }
+}
+
+
+
+
+_BLAS_TARGET_SSE_
+void batch_trimatTr_madd_gf16_sse( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[16*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Aheight = Bheight;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf16v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            for(unsigned k=0;k<=i;k++) {
+                _gf16v_madd_multab_sse( ptrC , & btriA[ size_batch*(idx_of_trimat(k,i,Aheight)) ] , &multabs[16*k] , size_batch );
+            }
+        }
+    }
+}
+
+_BLAS_TARGET_SSE_
+void batch_trimatTr_madd_gf256_sse( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[32*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Aheight = Bheight;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf256v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            for(unsigned k=0;k<=i;k++) {
+                _gf256v_madd_multab_sse( ptrC , & btriA[ size_batch*(idx_of_trimat(k,i,Aheight)) ] , &multabs[32*k] , size_batch );
+            }
+        }
+    }
+}
+
+
+
+
+_BLAS_TARGET_SSE_
+void batch_2trimat_madd_gf16_sse( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[16*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Aheight = Bheight;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf16v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            for(unsigned k=0;k<Bheight;k++) {
+                if(i==k) continue;
+                _gf16v_madd_multab_sse( ptrC , & btriA[ size_batch*(idx_of_2trimat(i,k,Aheight)) ] , &multabs[16*k] , size_batch );
+            }
+        }
+    }
+}
+
+_BLAS_TARGET_SSE_
+void batch_2trimat_madd_gf256_sse( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[32*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Aheight = Bheight;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf256v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            for(unsigned k=0;k<Bheight;k++) {
+                if(i==k) continue;
+                _gf256v_madd_multab_sse( ptrC , & btriA[ size_batch*(idx_of_2trimat(i,k,Aheight)) ] , &multabs[32*k] , size_batch );
+            }
+        }
+    }
+}
+
+
+
+
+_BLAS_TARGET_SSE_
+void batch_matTr_madd_gf16_sse( unsigned char * bC , const unsigned char* A_to_tr , unsigned Aheight, unsigned size_Acolvec, unsigned Awidth,
+        const unsigned char* bB, unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[16*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Atr_height = Awidth;
+    unsigned Atr_width  = Aheight;
+    for(unsigned i=0;i<Atr_height;i++) {
+        gf16v_generate_multabs_sse( multabs , &A_to_tr[size_Acolvec*i] , Atr_width );
+        for(unsigned j=0;j<Atr_width;j++) {
+            _gf16v_madd_multab_sse( bC , & bB[ j*Bwidth*size_batch ] , &multabs[16*j] , size_batch*Bwidth );
+        }
+        bC += size_batch*Bwidth;
+    }
+}
+
+_BLAS_TARGET_SSE_
+void batch_matTr_madd_gf256_sse( unsigned char * bC , const unsigned char* A_to_tr , unsigned Aheight, unsigned size_Acolvec, unsigned Awidth,
+        const unsigned char* bB, unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[32*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Atr_height = Awidth;
+    unsigned Atr_width  = Aheight;
+    for(unsigned i=0;i<Atr_height;i++) {
+        gf256v_generate_multabs_sse( multabs , &A_to_tr[size_Acolvec*i] , Atr_width );
+        for(unsigned j=0;j<Atr_width;j++) {
+            _gf256v_madd_multab_sse( bC , & bB[ j*Bwidth*size_batch ] , &multabs[32*j] , size_batch*Bwidth );
+        }
+        bC += size_batch*Bwidth;
+    }
+}
+
+
+
+
+_BLAS_TARGET_SSE_
+void batch_bmatTr_madd_gf16_sse( unsigned char *bC , const unsigned char *bA_to_tr, unsigned Awidth_before_tr,
+        const unsigned char *B, unsigned Bheight, unsigned size_Bcolvec, unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[16*MAX_TAB_ELE] _ALIGN_(32);
+    const unsigned char *bA = bA_to_tr;
+    unsigned Aheight = Awidth_before_tr;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf16v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            for(unsigned k=0;k<Bheight;k++) {
+                _gf16v_madd_multab_sse( ptrC , & bA[ size_batch*(i+k*Aheight) ] , &multabs[16*k] , size_batch );
+            }
+        }
+    }
+}
+
+_BLAS_TARGET_SSE_
+void batch_bmatTr_madd_gf256_sse( unsigned char *bC , const unsigned char *bA_to_tr, unsigned Awidth_before_tr,
+        const unsigned char *B, unsigned Bheight, unsigned size_Bcolvec, unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[32*MAX_TAB_ELE] _ALIGN_(32);
+    const unsigned char *bA = bA_to_tr;
+    unsigned Aheight = Awidth_before_tr;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf256v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            for(unsigned k=0;k<Bheight;k++) {
+                _gf256v_madd_multab_sse( ptrC , & bA[ size_batch*(i+k*Aheight) ] , &multabs[32*k] , size_batch );
+            }
+        }
+    }
+}
+
+
+
+
+_BLAS_TARGET_SSE_
+void batch_mat_madd_gf16_sse( unsigned char * bC , const unsigned char* bA , unsigned Aheight,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[16*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Awidth = Bheight;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf16v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            const unsigned char * ptrA = bA + i*Awidth*size_batch;
+            for(unsigned k=0;k<Bheight;k++) {
+                _gf16v_madd_multab_sse( ptrC , & ptrA[ k*size_batch ] , &multabs[16*k] , size_batch );
+            }
+        }
+    }
+}
+
+_BLAS_TARGET_SSE_
+void batch_mat_madd_gf256_sse( unsigned char * bC , const unsigned char* bA , unsigned Aheight,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
+{
+    uint8_t multabs[32*MAX_TAB_ELE] _ALIGN_(32);
+    unsigned Awidth = Bheight;
+    for(unsigned j=0;j<Bwidth;j++) {
+        gf256v_generate_multabs_sse( multabs , &B[j*size_Bcolvec] , Bheight );
+        for(unsigned i=0;i<Aheight;i++) {
+            unsigned char * ptrC = bC + (i*Bwidth+j)*size_batch;
+            const unsigned char * ptrA = bA + i*Awidth*size_batch;
+            for(unsigned k=0;k<Bheight;k++) {
+                _gf256v_madd_multab_sse( ptrC , & ptrA[ k*size_batch ] , &multabs[32*k] , size_batch );
+            }
+        }
+    }
+}
+
+
+
+
+////////////////////  Section: "quadratric" matrix evaluation  ///////////////////////////////
+
+
+
+
+_BLAS_TARGET_SSE_
+void batch_quad_trimat_eval_gf16_sse( unsigned char * y, const unsigned char * trimat, const unsigned char * x, unsigned dim , unsigned size_batch )
+{
+///
+///    assert( dim <= 256 );
+///    assert( size_batch <= 256 );
+    unsigned char tmp[256];
+    uint8_t multabs[16*MAX_TAB_ELE] _ALIGN_(32);
+    gf16v_generate_multabs_sse( multabs , x , dim );
+
+    gf256v_set_zero( y , size_batch );
+    for(unsigned i=0;i<dim;i++) {
+        gf256v_set_zero( tmp , size_batch );
+        for(unsigned j=i;j<dim;j++) {
+           _gf16v_madd_multab_sse( tmp , trimat , &multabs[16*j] , size_batch );
+           trimat += size_batch;
+        }
+        _gf16v_madd_multab_sse( y , tmp , &multabs[16*i] , size_batch );
+    }
+}
+
+_BLAS_TARGET_SSE_
+void batch_quad_trimat_eval_gf256_sse( unsigned char * y, const unsigned char * trimat, const unsigned char * x, unsigned dim , unsigned size_batch )
+{
+///
+///    assert( dim <= 256 );
+///    assert( size_batch <= 256 );
+    unsigned char tmp[256];
+    uint8_t multabs[32*MAX_TAB_ELE] _ALIGN_(32);
+    gf256v_generate_multabs_sse( multabs , x , dim );
+
+    gf256v_set_zero( y , size_batch );
+    for(unsigned i=0;i<dim;i++) {
+        gf256v_set_zero( tmp , size_batch );
+        for(unsigned j=i;j<dim;j++) {
+           _gf256v_madd_multab_sse( tmp , trimat , &multabs[32*j] , size_batch );
+           trimat += size_batch;
+        }
+        _gf256v_madd_multab_sse( y , tmp , &multabs[32*i] , size_batch );
+    }
+}
+
+
+
+
+_BLAS_TARGET_SSE_
+void batch_quad_recmat_eval_gf16_sse( unsigned char * z, const unsigned char * y, unsigned dim_y, const unsigned char * mat,
+        const unsigned char * x, unsigned dim_x , unsigned size_batch )
+{
+///
+///    assert( dim_x <= 128 );
+///    assert( dim_y <= 128 );
+///    assert( size_batch <= 128 );
+    unsigned char tmp[128];
+    uint8_t multabs_x[16*MAX_TAB_ELE] _ALIGN_(32);
+    uint8_t multabs_y[16*MAX_TAB_ELE] _ALIGN_(32);
+    gf16v_generate_multabs_sse( multabs_x , x , dim_x );
+    gf16v_generate_multabs_sse( multabs_y , y , dim_y );
+
+    gf256v_set_zero( z , size_batch );
+    for(unsigned i=0;i<dim_y;i++) {
+        gf256v_set_zero( tmp , size_batch );
+        for(unsigned j=0;j<dim_x;j++) {
+           _gf16v_madd_multab_sse( tmp , mat , &multabs_x[16*j] , size_batch );
+           mat += size_batch;
+        }
+        _gf16v_madd_multab_sse( z , tmp , &multabs_y[16*i] , size_batch );
+    }
+}
+
+_BLAS_TARGET_SSE_
+void batch_quad_recmat_eval_gf256_sse( unsigned char * z, const unsigned char * y, unsigned dim_y, const unsigned char * mat,
+        const unsigned char * x, unsigned dim_x , unsigned size_batch )
+{
+///
+///    assert( dim_x <= 128 );
+///    assert( dim_y <= 128 );
+///    assert( size_batch <= 128 );
+    unsigned char tmp[128];
+    uint8_t multabs_x[32*MAX_TAB_ELE] _ALIGN_(32);
+    uint8_t multabs_y[32*MAX_TAB_ELE] _ALIGN_(32);
+    gf256v_generate_multabs_sse( multabs_x , x , dim_x );
+    gf256v_generate_multabs_sse( multabs_y , y , dim_y );
+
+    gf256v_set_zero( z , size_batch );
+    for(unsigned i=0;i<dim_y;i++) {
+        gf256v_set_zero( tmp , size_batch );
+        for(unsigned j=0;j<dim_x;j++) {
+           _gf256v_madd_multab_sse( tmp , mat , &multabs_x[32*j] , size_batch );
+           mat += size_batch;
+        }
+        _gf256v_madd_multab_sse( z , tmp , &multabs_y[32*i] , size_batch );
+    }
+}
+
+
+#endif // defined(_BLAS_SIMD_DISPATCH_)
+
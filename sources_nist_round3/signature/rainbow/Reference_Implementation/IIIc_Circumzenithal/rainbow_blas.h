@@ -59,16 +59,22 @@
 
 #define gfmat_inv       gf16mat_inv_32x32
 #define gfmat_solve_linear_eq       gf16mat_solve_linear_eq_32x32
+#define gfmat_prod_inv  gf16mat_prod_inv_32x32
+#define gfmat_prod_solve_linear_eq  gf16mat_prod_solve_linear_eq_32x32
 
 #elif defined( _RAINBOW256_68_32_48 )
 
 #define gfmat_inv       gf256mat_inv_32x32
 #define gfmat_solve_linear_eq       gf256mat_solve_linear_eq_48x48
+#define gfmat_prod_inv  gf256mat_prod_inv_32x32
+#define gfmat_prod_solve_linear_eq  gf256mat_prod_solve_linear_eq_48x48
 
 #elif defined( _RAINBOW256_96_36_64 )
 
 #define gfmat_inv       gf256mat_inv_36x36
 #define gfmat_solve_linear_eq       gf256mat_solve_linear_eq_64x64
+#define gfmat_prod_inv  gf256mat_prod_inv_36x36
+#define gfmat_prod_solve_linear_eq  gf256mat_prod_solve_linear_eq_64x64
 
 #else
 error here.
@@ -0,0 +1,145 @@
+/// @file rainbow_verifier.c
+/// @brief Implementations for functions in rainbow_verifier.h
+///
+
+// for posix_memalign() under -std=c99/c11.
+#define _POSIX_C_SOURCE 200112L
+
+#include "rainbow_config.h"
+
+#include "rainbow_keypair.h"
+
+#include "rainbow.h"
+
+#include "rainbow_verifier.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "utils_hash.h"
+
+
+
+/////////////////////////////  verifier  ////////////////////////////////
+
+
+rainbow_verifier_t * rainbow_verifier_new( const cpk_t * cpk )
+{
+    // not adapted_alloc(), which falls back to an unaligned malloc() unless _HAS_ALIGNED_ALLOC_ is set.
+    void * mem = NULL;
+    if( 0 != posix_memalign( &mem , RAINBOW_VERIFIER_ALIGN , sizeof(rainbow_verifier_t) ) ) return NULL;
+    rainbow_verifier_t * vf = (rainbow_verifier_t *)mem;
+
+    if( 0 != cpk_to_pk( &vf->pk , cpk ) ) {
+        free( vf );
+        return NULL;
+    }
+    return vf;
+}
+
+
+void rainbow_verifier_free( rainbow_verifier_t * vf )
+{
+    free( vf );
+}
+
+
+int rainbow_verifier_verify( const uint8_t * digest , const uint8_t * signature , const rainbow_verifier_t * vf )
+{
+    return rainbow_verify( digest , signature , &vf->pk );
+}
+
+
+
+/////////////////////////////  LRU cache  ////////////////////////////////
+
+
+typedef
+struct rainbow_verifier_cache_entry {
+    unsigned char key[_HASH_LEN];   ///< hash of the compressed public key
+    unsigned long long last_use;    ///< value of the cache clock at the last lookup
+    rainbow_verifier_t * vf;        ///< NULL for an empty slot
+} cache_entry_t;
+
+
+struct rainbow_verifier_cache {
+    unsigned capacity;
+    unsigned long long clock;
+    unsigned long long misses;
+    cache_entry_t * entries;
+};
+
+
+rainbow_verifier_cache_t * rainbow_verifier_cache_new( unsigned capacity )
+{
+    if( 0 == capacity ) return NULL;
+    rainbow_verifier_cache_t * cache = (rainbow_verifier_cache_t *)malloc( sizeof(rainbow_verifier_cache_t) );
+    if( NULL == cache ) return NULL;
+    cache->entries = (cache_entry_t *)calloc( capacity , sizeof(cache_entry_t) );
+    if( NULL == cache->entries ) {
+        free( cache );
+        return NULL;
+    }
+    cache->capacity = capacity;
+    cache->clock = 0;
+    cache->misses = 0;
+    return cache;
+}
+
+
+void rainbow_verifier_cache_free( rainbow_verifier_cache_t * cache )
+{
+    if( NULL == cache ) return;
+    for(unsigned i=0;i<cache->capacity;i++) rainbow_verifier_free( cache->entries[i].vf );
+    free( cache->entries );
+    free( cache );
+}
+
+
+const rainbow_verifier_t * rainbow_verifier_cache_get( rainbow_verifier_cache_t * cache , const cpk_t * cpk )
+{
+    unsigned char key[_HASH_LEN];
+    hash_msg( key , _HASH_LEN , (const unsigned char *)cpk , sizeof(cpk_t) );
+
+    // look up the key, and find the slot to refill on a miss: an empty one or the least recently used one.
+    unsigned victim = 0;
+    for(unsigned i=0;i<cache->capacity;i++) {
+        cache_entry_t * e = &cache->entries[i];
+        if( NULL == e->vf ) {
+            if( NULL != cache->entries[victim].vf ) victim = i;
+            continue;
+        }
+        if( 0 == memcmp( e->key , key , _HASH_LEN ) ) {
+            e->last_use = ++cache->clock;
+            return e->vf;
+        }
+        if( NULL != cache->entries[victim].vf && e->last_use < cache->entries[victim].last_use ) victim = i;
+    }
+
+    cache->misses++;
+    rainbow_verifier_t * vf = rainbow_verifier_new( cpk );
+    if( NULL == vf ) return NULL;
+
+    cache_entry_t * e = &cache->entries[victim];
+    rainbow_verifier_free( e->vf );
+    memcpy( e->key , key , _HASH_LEN );
+    e->last_use = ++cache->clock;
+    e->vf = vf;
+    return vf;
+}
+
+
+unsigned long long rainbow_verifier_cache_misses( const rainbow_verifier_cache_t * cache )
+{
+    return cache->misses;
+}
+
+
+int rainbow_verify_cyclic_cached( rainbow_verifier_cache_t * cache , const uint8_t * digest , const uint8_t * signature , const cpk_t * cpk )
+{
+    const rainbow_verifier_t * vf = rainbow_verifier_cache_get( cache , cpk );
+    if( NULL == vf ) return rainbow_verify_cyclic( digest , signature , cpk );
+    return rainbow_verifier_verify( digest , signature , vf );
+}
+
@@ -0,0 +1,147 @@
+/// @file blas_avx2.h
+/// @brief Inlined functions for implementing basic linear algebra functions for avx2 arch.
+///
+///  Same interface and table formats as blas_sse.h. Lengths which are not multiples of 32
+///  finish with one 16-byte step and a padded partial block.
+///
+
+#ifndef _BLAS_AVX2_H_
+#define _BLAS_AVX2_H_
+
+#include "gf16_avx2.h"
+#include "blas_sse.h"
+#include "blas_comm.h"
+
+#if defined(_BLAS_SIMD_DISPATCH_)
+
+#include <string.h>
+#include <stdint.h>
+
+
+static inline _BLAS_TARGET_AVX2_
+void _gf256v_add_avx2(uint8_t *accu_b, const uint8_t *a, unsigned _num_byte) {
+    unsigned n_32 = _num_byte >> 5;
+    for (unsigned i = 0; i < n_32; i++) {
+        __m256i b = _mm256_loadu_si256( (const __m256i*)(accu_b+32*i) );
+        __m256i x = _mm256_loadu_si256( (const __m256i*)(a+32*i) );
+        _mm256_storeu_si256( (__m256i*)(accu_b+32*i) , _mm256_xor_si256(b,x) );
+    }
+    unsigned rem = _num_byte & 31;
+    if( rem ) _gf256v_add_sse( accu_b + (n_32<<5) , a + (n_32<<5) , rem );
+}
+
+static inline _BLAS_TARGET_AVX2_
+void _gf256v_conditional_add_avx2(uint8_t *accu_b, uint8_t condition, const uint8_t *a, unsigned _num_byte) {
+    uint8_t pr_u8 = 0 - condition;
+    __m256i mask = _mm256_set1_epi8( (char)pr_u8 );
+    unsigned n_32 = _num_byte >> 5;
+    for (unsigned i = 0; i < n_32; i++) {
+        __m256i b = _mm256_loadu_si256( (const __m256i*)(accu_b+32*i) );
+        __m256i x = _mm256_loadu_si256( (const __m256i*)(a+32*i) );
+        _mm256_storeu_si256( (__m256i*)(accu_b+32*i) , _mm256_xor_si256(b,_mm256_and_si256(x,mask)) );
+    }
+    unsigned rem = _num_byte & 31;
+    if( rem ) _gf256v_conditional_add_sse( accu_b + (n_32<<5) , condition , a + (n_32<<5) , rem );
+}
+
+
+///////////////////////////////////////////////////
+
+
+static inline _BLAS_TARGET_AVX2_
+void _gf16v_madd_tab_avx2(uint8_t *accu_c, const uint8_t *a, __m256i multab, unsigned _num_byte) {
+    __m256i mask_f = _mm256_set1_epi8( 0xf );
+    unsigned n_32 = _num_byte >> 5;
+    for (unsigned i = 0; i < n_32; i++) {
+        __m256i c = _mm256_loadu_si256( (const __m256i*)(accu_c+32*i) );
+        __m256i x = _mm256_loadu_si256( (const __m256i*)(a+32*i) );
+        _mm256_storeu_si256( (__m256i*)(accu_c+32*i) , _mm256_xor_si256(c,gf16v_mul_multab_avx2(x,multab,mask_f)) );
+    }
+    unsigned rem = _num_byte & 31;
+    if( rem ) _gf16v_madd_tab_sse( accu_c + (n_32<<5) , a + (n_32<<5) , _mm256_castsi256_si128(multab) , rem );
+}
+
+static inline _BLAS_TARGET_AVX2_
+void _gf256v_madd_tab_avx2(uint8_t *accu_c, const uint8_t *a, __m256i tab_l, __m256i tab_h, unsigned _num_byte) {
+    __m256i mask_f = _mm256_set1_epi8( 0xf );
+    unsigned n_32 = _num_byte >> 5;
+    for (unsigned i = 0; i < n_32; i++) {
+        __m256i c = _mm256_loadu_si256( (const __m256i*)(accu_c+32*i) );
+        __m256i x = _mm256_loadu_si256( (const __m256i*)(a+32*i) );
+        _mm256_storeu_si256( (__m256i*)(accu_c+32*i) , _mm256_xor_si256(c,gf256v_mul_multab_avx2(x,tab_l,tab_h,mask_f)) );
+    }
+    unsigned rem = _num_byte & 31;
+    if( rem ) _gf256v_madd_tab_sse( accu_c + (n_32<<5) , a + (n_32<<5) ,
+                    _mm256_castsi256_si128(tab_l) , _mm256_castsi256_si128(tab_h) , rem );
+}
+
+
+///////////////////////////////////////////////////
+
+
+static inline _BLAS_TARGET_AVX2_
+void _gf16v_madd_multab_avx2(uint8_t *accu_c, const uint8_t *a, const uint8_t *multab, unsigned _num_byte) {
+    __m256i tab = _mm256_broadcastsi128_si256( _mm_loadu_si128((const __m128i*)multab) );
+    _gf16v_madd_tab_avx2( accu_c , a , tab , _num_byte );
+}
+
+static inline _BLAS_TARGET_AVX2_
+void _gf256v_madd_multab_avx2(uint8_t *accu_c, const uint8_t *a, const uint8_t *multab, unsigned _num_byte) {
+    __m256i tab_l = _mm256_broadcastsi128_si256( _mm_loadu_si128((const __m128i*)multab) );
+    __m256i tab_h = _mm256_broadcastsi128_si256( _mm_loadu_si128((const __m128i*)(multab+16)) );
+    _gf256v_madd_tab_avx2( accu_c , a , tab_l , tab_h , _num_byte );
+}
+
+static inline _BLAS_TARGET_AVX2_
+void _gf16v_madd_avx2(uint8_t *accu_c, const uint8_t *a, uint8_t gf16_b, unsigned _num_byte) {
+    _gf16v_madd_tab_avx2( accu_c , a , gf16_multab_avx2(gf16_b) , _num_byte );
+}
+
+static inline _BLAS_TARGET_AVX2_
+void _gf256v_madd_avx2(uint8_t *accu_c, const uint8_t *a, uint8_t b, unsigned _num_byte) {
+    __m256i tab[2];
+    gf256_multab_avx2( tab , b );
+    _gf256v_madd_tab_avx2( accu_c , a , tab[0] , tab[1] , _num_byte );
+}
+
+
+///////////////////////////////////////////////////
+
+
+// a*b = a + a*(b+1) in characteristic 2, so the scaling is an in-place madd.
+
+static inline _BLAS_TARGET_AVX2_
+void _gf16v_mul_scalar_avx2(uint8_t *a, uint8_t gf16_b, unsigned _num_byte) {
+    _gf16v_madd_avx2( a , a , gf16_b^1 , _num_byte );
+}
+
+static inline _BLAS_TARGET_AVX2_
+void _gf256v_mul_scalar_avx2(uint8_t *a, uint8_t b, unsigned _num_byte) {
+    _gf256v_madd_avx2( a , a , b^1 , _num_byte );
+}
+
+
+///////////////////////////////////////////////////
+
+
+/// @brief multabs[16*i..16*i+15] = the table of the i-th element of the GF(16) vector v.
+static inline _BLAS_TARGET_AVX2_
+void gf16v_generate_multabs_avx2(uint8_t *multabs, const uint8_t *v, unsigned n_ele) {
+    gf16v_generate_multabs_sse( multabs , v , n_ele );
+}
+
+/// @brief multabs[32*i..32*i+31] = the tables of the i-th element of the GF(256) vector v.
+static inline _BLAS_TARGET_AVX2_
+void gf256v_generate_multabs_avx2(uint8_t *multabs, const uint8_t *v, unsigned n_ele) {
+    __m256i tab[2];
+    for (unsigned i = 0; i < n_ele; i++) {
+        gf256_multab_avx2( tab , v[i] );
+        _mm256_storeu_si256( (__m256i*)(multabs+32*i) , _mm256_permute2x128_si256( tab[0] , tab[1] , 0x20 ) );
+    }
+}
+
+
+#endif // defined(_BLAS_SIMD_DISPATCH_)
+
+#endif // _BLAS_AVX2_H_
+
@@ -0,0 +1,58 @@
+/// @file blas_matrix_avx2.h
+/// @brief linear algebra functions for matrix op, for avx2 instruction set.
+///
+///  The same interfaces as blas_matrix_ref.h. Available only when _BLAS_SIMD_DISPATCH_ is defined.
+///
+#ifndef _BLAS_MATRIX_AVX2_H_
+#define _BLAS_MATRIX_AVX2_H_
+
+#include <stdint.h>
+
+#include "blas_config.h"
+
+#if defined(_BLAS_SIMD_DISPATCH_)
+
+
+#ifdef  __cplusplus
+extern  "C" {
+#endif
+
+
+///////////////// Section: multiplications  ////////////////////////////////
+
+void gf16mat_prod_avx2(uint8_t *c, const uint8_t *matA, unsigned n_A_vec_byte, unsigned n_A_width, const uint8_t *b);
+
+void gf256mat_prod_avx2(uint8_t *c, const uint8_t *matA, unsigned n_A_vec_byte, unsigned n_A_width, const uint8_t *b);
+
+
+/////////////////////////////////////////////////////
+
+unsigned gf16mat_solve_linear_eq_32x32_avx2(uint8_t *sol, const uint8_t *inp_mat, const uint8_t *c_terms );
+
+unsigned gf16mat_inv_32x32_avx2(uint8_t *inv_a, const uint8_t *a );
+
+unsigned gf256mat_solve_linear_eq_48x48_avx2( uint8_t * sol , const uint8_t * inp_mat , const uint8_t * c_terms );
+
+unsigned gf256mat_inv_32x32_avx2( uint8_t * inv_a , const uint8_t * a );
+
+unsigned gf256mat_solve_linear_eq_64x64_avx2( uint8_t * sol , const uint8_t * inp_mat , const uint8_t * c_terms );
+
+unsigned gf256mat_inv_36x36_avx2( uint8_t * inv_a , const uint8_t * a );
+
+unsigned gf256mat_prod_solve_linear_eq_48x48_avx2( uint8_t * sol , const uint8_t * mat_c , const uint8_t * matA , unsigned n_A_width , const uint8_t * b , const uint8_t * c_terms );
+
+unsigned gf256mat_prod_inv_32x32_avx2( uint8_t * inv_a , const uint8_t * matA , unsigned n_A_width , const uint8_t * b );
+
+unsigned gf256mat_prod_solve_linear_eq_64x64_avx2( uint8_t * sol , const uint8_t * mat_c , const uint8_t * matA , unsigned n_A_width , const uint8_t * b , const uint8_t * c_terms );
+
+unsigned gf256mat_prod_inv_36x36_avx2( uint8_t * inv_a , const uint8_t * matA , unsigned n_A_width , const uint8_t * b );
+
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif // defined(_BLAS_SIMD_DISPATCH_)
+
+#endif  // _BLAS_MATRIX_AVX2_H_
+
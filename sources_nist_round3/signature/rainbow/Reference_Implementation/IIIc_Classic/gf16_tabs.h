@@ -0,0 +1,42 @@
+/// @file gf16_tabs.h
+/// @brief Constant tables for the table-lookup (PSHUFB) arithmetic in GF(16) and GF(256).
+///
+
+#ifndef _GF16_TABS_H_
+#define _GF16_TABS_H_
+
+#include <stdint.h>
+
+/// __gf16_mulbase[16*k+i] = gf16_mul( 1<<k , i ),  k = 0..3.
+/// The table of a*i for a scalar a is the XOR of the rows selected by the bits of a.
+static const unsigned char __gf16_mulbase[64] __attribute__((aligned(32))) = {
+    0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,
+    0x00,0x02,0x03,0x01,0x08,0x0a,0x0b,0x09,0x0c,0x0e,0x0f,0x0d,0x04,0x06,0x07,0x05,
+    0x00,0x04,0x08,0x0c,0x06,0x02,0x0e,0x0a,0x0b,0x0f,0x03,0x07,0x0d,0x09,0x05,0x01,
+    0x00,0x08,0x0c,0x04,0x0b,0x03,0x07,0x0f,0x0d,0x05,0x01,0x09,0x06,0x0e,0x0a,0x02
+};
+
+/// __gf256_mulbase[32*k+i]    = gf256_mul( 1<<k , i ),
+/// __gf256_mulbase[32*k+16+i] = gf256_mul( 1<<k , i<<4 ),  k = 0..7.
+/// The low/high-nibble tables of a*x for a scalar a are the XOR of the rows selected by the bits of a.
+static const unsigned char __gf256_mulbase[256] __attribute__((aligned(32))) = {
+    0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,
+    0x00,0x10,0x20,0x30,0x40,0x50,0x60,0x70,0x80,0x90,0xa0,0xb0,0xc0,0xd0,0xe0,0xf0,
+    0x00,0x02,0x03,0x01,0x08,0x0a,0x0b,0x09,0x0c,0x0e,0x0f,0x0d,0x04,0x06,0x07,0x05,
+    0x00,0x20,0x30,0x10,0x80,0xa0,0xb0,0x90,0xc0,0xe0,0xf0,0xd0,0x40,0x60,0x70,0x50,
+    0x00,0x04,0x08,0x0c,0x06,0x02,0x0e,0x0a,0x0b,0x0f,0x03,0x07,0x0d,0x09,0x05,0x01,
+    0x00,0x40,0x80,0xc0,0x60,0x20,0xe0,0xa0,0xb0,0xf0,0x30,0x70,0xd0,0x90,0x50,0x10,
+    0x00,0x08,0x0c,0x04,0x0b,0x03,0x07,0x0f,0x0d,0x05,0x01,0x09,0x06,0x0e,0x0a,0x02,
+    0x00,0x80,0xc0,0x40,0xb0,0x30,0x70,0xf0,0xd0,0x50,0x10,0x90,0x60,0xe0,0xa0,0x20,
+    0x00,0x10,0x20,0x30,0x40,0x50,0x60,0x70,0x80,0x90,0xa0,0xb0,0xc0,0xd0,0xe0,0xf0,
+    0x00,0x18,0x2c,0x34,0x4b,0x53,0x67,0x7f,0x8d,0x95,0xa1,0xb9,0xc6,0xde,0xea,0xf2,
+    0x00,0x20,0x30,0x10,0x80,0xa0,0xb0,0x90,0xc0,0xe0,0xf0,0xd0,0x40,0x60,0x70,0x50,
+    0x00,0x2c,0x34,0x18,0x8d,0xa1,0xb9,0x95,0xc6,0xea,0xf2,0xde,0x4b,0x67,0x7f,0x53,
+    0x00,0x40,0x80,0xc0,0x60,0x20,0xe0,0xa0,0xb0,0xf0,0x30,0x70,0xd0,0x90,0x50,0x10,
+    0x00,0x4b,0x8d,0xc6,0x67,0x2c,0xea,0xa1,0xb9,0xf2,0x34,0x7f,0xde,0x95,0x53,0x18,
+    0x00,0x80,0xc0,0x40,0xb0,0x30,0x70,0xf0,0xd0,0x50,0x10,0x90,0x60,0xe0,0xa0,0x20,
+    0x00,0x8d,0xc6,0x4b,0xb9,0x34,0x7f,0xf2,0xde,0x53,0x18,0x95,0x67,0xea,0xa1,0x2c
+};
+
+#endif // _GF16_TABS_H_
+
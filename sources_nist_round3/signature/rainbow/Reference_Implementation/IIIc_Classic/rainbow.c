@@ -32,7 +32,7 @@
 
 
 
-int rainbow_sign( uint8_t * signature , const sk_t * sk , const uint8_t * _digest )
+int rainbow_sign_with_stat( uint8_t * signature , const sk_t * sk , const uint8_t * _digest , rainbow_sign_stat_t * stat )
 {
     // allocate temporary storage.
     uint8_t mat_l1[_O1*_O1_BYTE];
@@ -56,10 +56,11 @@ int rainbow_sign( uint8_t * signature , const sk_t * sk , const uint8_t * _diges
     while( !l1_succ ) {
         if( MAX_ATTEMPT_FRMAT <= n_attempt ) break;
         prng_gen( &prng_sign , vinegar , _V1_BYTE );                       // generating vinegars
-        gfmat_prod( mat_l1 , sk->l1_F2 , _O1*_O1_BYTE , _V1 , vinegar );   // generating the linear equations for layer 1
-        l1_succ = gfmat_inv( mat_l1 , mat_l1 );         // check if the linear equation solvable
+        // generating the linear equations for layer 1 and check if they are solvable
+        l1_succ = gfmat_prod_inv( mat_l1 , sk->l1_F2 , _V1 , vinegar );
         n_attempt ++;
     }
+    unsigned n_l1_attempt = n_attempt;
 
     // Given the vinegars, pre-compute variables needed for layer 2
     uint8_t r_l1_F1[_O1_BYTE] = {0};
@@ -110,11 +111,8 @@ int rainbow_sign( uint8_t * signature , const sk_t * sk , const uint8_t * _diges
         gf256v_add( temp_o , r_l2_F1 , _O2_BYTE );                      // F1
         gf256v_add( temp_o , y + _O1_BYTE , _O2_BYTE );
 
-        // generate the linear equations of the 2nd layer
-        gfmat_prod( mat_l2 , sk->l2_F6 , _O2*_O2_BYTE , _O1 , x_o1 );   // F6
-        gf256v_add( mat_l2 , mat_l2_F3 , _O2*_O2_BYTE);                 // F3
-
-        succ = gfmat_solve_linear_eq( x_o2 , mat_l2 , temp_o );
+        // generate the linear equations of the 2nd layer ( F3 + F6*x_o1 ) and solve them
+        succ = gfmat_prod_solve_linear_eq( x_o2 , mat_l2_F3 , sk->l2_F6 , _O1 , x_o1 , temp_o );
 
         n_attempt ++;
     };
@@ -150,6 +148,10 @@ int rainbow_sign( uint8_t * signature , const sk_t * sk , const uint8_t * _diges
     memset( x_o2 , 0 , _O2_BYTE );
     memset( temp_o , 0 , sizeof(temp_o) );
 
+    if( stat ) {
+        stat->n_l1_attempt = n_l1_attempt;
+        stat->n_l2_attempt = n_attempt - n_l1_attempt;
+    }
     // return: copy w and salt to the signature.
     if( MAX_ATTEMPT_FRMAT <= n_attempt ) return -1;
     gf256v_add( signature , w , _PUB_N_BYTE );
@@ -158,6 +160,12 @@ int rainbow_sign( uint8_t * signature , const sk_t * sk , const uint8_t * _diges
 }
 
 
+int rainbow_sign( uint8_t * signature , const sk_t * sk , const uint8_t * _digest )
+{
+    return rainbow_sign_with_stat( signature , sk , _digest , NULL );
+}
+
+
 static
 int _rainbow_verify( const uint8_t * digest , const uint8_t * salt , const unsigned char * digest_ck )
 {
@@ -25,6 +25,26 @@ extern  "C" {
 ///
 int rainbow_sign( uint8_t * signature , const sk_t * sk , const uint8_t * digest );
 
+
+///
+/// @brief The numbers of attempts spent in one signing.
+///
+typedef struct rainbow_sign_stat {
+    unsigned n_l1_attempt;    ///< vinegars rolled until the layer-1 linear equations are solvable.
+    unsigned n_l2_attempt;    ///< salts tried until the layer-2 linear equations are solvable.
+} rainbow_sign_stat_t;
+
+///
+/// @brief Signing function for classical secret key, reporting the numbers of attempts.
+///
+/// @param[out] signature - the signature.
+/// @param[in]  sk        - the secret key.
+/// @param[in]  digest    - the digest.
+/// @param[out] stat      - the numbers of attempts. Can be NULL.
+/// @return 0 for success. -1 otherwise.
+///
+int rainbow_sign_with_stat( uint8_t * signature , const sk_t * sk , const uint8_t * digest , rainbow_sign_stat_t * stat );
+
 ///
 /// @brief Verifying function.
 ///
@@ -108,6 +108,97 @@ unsigned gf256mat_inv_32x32(uint8_t *inv_a, const uint8_t *a );
 unsigned gf256mat_inv_36x36(uint8_t *inv_a, const uint8_t *a );
 
 
+///////////////////////////////////////////////////////
+
+
+/// @brief Building and solving linear equations, in GF(16)
+///
+///  Solving ( mat_c + sum_k b[k]*matA_k ) * sol = c_terms with the linear system kept in a
+///  stack buffer. The same as gf16mat_prod() followed by gf16mat_solve_linear_eq_32x32().
+///
+/// @param[out]  sol       - the solutions.
+/// @param[in]   mat_c     - the constant part of the matrix.
+/// @param[in]   matA      - n_A_width column-major matrices, stored one after another.
+/// @param[in]   n_A_width - the number of matrices in matA.
+/// @param[in]   b         - the vector b.
+/// @param[in]   c_terms   - the constant terms of the input equations.
+/// @return   1(true) if success. 0(false) if the matrix is singular.
+///
+unsigned gf16mat_prod_solve_linear_eq_32x32(uint8_t *sol, const uint8_t *mat_c, const uint8_t *matA, unsigned n_A_width, const uint8_t *b, const uint8_t *c_terms );
+
+
+/// @brief Building and solving linear equations, in GF(256)
+///
+///  Solving ( mat_c + sum_k b[k]*matA_k ) * sol = c_terms with the linear system kept in a
+///  stack buffer. The same as gf256mat_prod() followed by gf256mat_solve_linear_eq_48x48().
+///
+/// @param[out]  sol       - the solutions.
+/// @param[in]   mat_c     - the constant part of the matrix.
+/// @param[in]   matA      - n_A_width column-major matrices, stored one after another.
+/// @param[in]   n_A_width - the number of matrices in matA.
+/// @param[in]   b         - the vector b.
+/// @param[in]   c_terms   - the constant terms of the input equations.
+/// @return   1(true) if success. 0(false) if the matrix is singular.
+///
+unsigned gf256mat_prod_solve_linear_eq_48x48(uint8_t *sol, const uint8_t *mat_c, const uint8_t *matA, unsigned n_A_width, const uint8_t *b, const uint8_t *c_terms );
+
+
+/// @brief Building and solving linear equations, in GF(256)
+///
+///  Solving ( mat_c + sum_k b[k]*matA_k ) * sol = c_terms with the linear system kept in a
+///  stack buffer. The same as gf256mat_prod() followed by gf256mat_solve_linear_eq_64x64().
+///
+/// @param[out]  sol       - the solutions.
+/// @param[in]   mat_c     - the constant part of the matrix.
+/// @param[in]   matA      - n_A_width column-major matrices, stored one after another.
+/// @param[in]   n_A_width - the number of matrices in matA.
+/// @param[in]   b         - the vector b.
+/// @param[in]   c_terms   - the constant terms of the input equations.
+/// @return   1(true) if success. 0(false) if the matrix is singular.
+///
+unsigned gf256mat_prod_solve_linear_eq_64x64(uint8_t *sol, const uint8_t *mat_c, const uint8_t *matA, unsigned n_A_width, const uint8_t *b, const uint8_t *c_terms );
+
+
+
+/// @brief Computing the inverse of sum_k b[k]*matA_k, in GF(16)
+///
+///  The same as gf16mat_prod() followed by gf16mat_inv_32x32().
+///
+/// @param[out]  inv_a     - the inverse matrix.
+/// @param[in]   matA      - n_A_width matrices, stored one after another.
+/// @param[in]   n_A_width - the number of matrices in matA.
+/// @param[in]   b         - the vector b.
+/// @return   1(true) if success. 0(false) if the matrix is singular.
+///
+unsigned gf16mat_prod_inv_32x32(uint8_t *inv_a, const uint8_t *matA, unsigned n_A_width, const uint8_t *b );
+
+
+/// @brief Computing the inverse of sum_k b[k]*matA_k, in GF(256)
+///
+///  The same as gf256mat_prod() followed by gf256mat_inv_32x32().
+///
+/// @param[out]  inv_a     - the inverse matrix.
+/// @param[in]   matA      - n_A_width matrices, stored one after another.
+/// @param[in]   n_A_width - the number of matrices in matA.
+/// @param[in]   b         - the vector b.
+/// @return   1(true) if success. 0(false) if the matrix is singular.
+///
+unsigned gf256mat_prod_inv_32x32(uint8_t *inv_a, const uint8_t *matA, unsigned n_A_width, const uint8_t *b );
+
+
+/// @brief Computing the inverse of sum_k b[k]*matA_k, in GF(256)
+///
+///  The same as gf256mat_prod() followed by gf256mat_inv_36x36().
+///
+/// @param[out]  inv_a     - the inverse matrix.
+/// @param[in]   matA      - n_A_width matrices, stored one after another.
+/// @param[in]   n_A_width - the number of matrices in matA.
+/// @param[in]   b         - the vector b.
+/// @return   1(true) if success. 0(false) if the matrix is singular.
+///
+unsigned gf256mat_prod_inv_36x36(uint8_t *inv_a, const uint8_t *matA, unsigned n_A_width, const uint8_t *b );
+
+
 
 #ifdef  __cplusplus
 }
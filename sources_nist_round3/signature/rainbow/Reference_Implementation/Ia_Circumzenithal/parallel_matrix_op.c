@@ -2,6 +2,8 @@
 ///  @brief the standard implementations for functions in parallel_matrix_op.h
 ///
 ///  the standard implementations for functions in parallel_matrix_op.h
+///  On x86 the batched functions dispatch at run time to parallel_matrix_op_avx2.c or
+///  parallel_matrix_op_sse.c ( see blas_config.h ).
 ///
 
 #include "blas_comm.h"
@@ -9,6 +11,12 @@
 
 #include "parallel_matrix_op.h"
 
+#include "blas_config.h"
+#if defined(_BLAS_SIMD_DISPATCH_)
+#include "parallel_matrix_op_avx2.h"
+#include "parallel_matrix_op_sse.h"
+#endif
+
 
 ////////////////    Section: triangle matrix <-> rectangle matrix   ///////////////////////////////////
 
@@ -37,6 +45,10 @@ void UpperTrianglize( unsigned char * btriC , const unsigned char * bA , unsigne
 void batch_trimat_madd_gf16( unsigned char * bC , const unsigned char* btriA ,
         const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_trimat_madd_gf16_avx2( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_trimat_madd_gf16_sse( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     unsigned Awidth = Bheight;
     unsigned Aheight = Awidth;
     for(unsigned i=0;i<Aheight;i++) {
@@ -54,6 +66,10 @@ void batch_trimat_madd_gf16( unsigned char * bC , const unsigned char* btriA ,
 void batch_trimat_madd_gf256( unsigned char * bC , const unsigned char* btriA ,
         const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_trimat_madd_gf256_avx2( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_trimat_madd_gf256_sse( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     unsigned Awidth = Bheight;
     unsigned Aheight = Awidth;
     for(unsigned i=0;i<Aheight;i++) {
@@ -75,6 +91,10 @@ void batch_trimat_madd_gf256( unsigned char * bC , const unsigned char* btriA ,
 void batch_trimatTr_madd_gf16( unsigned char * bC , const unsigned char* btriA ,
         const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_trimatTr_madd_gf16_avx2( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_trimatTr_madd_gf16_sse( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     unsigned Aheight = Bheight;
     for(unsigned i=0;i<Aheight;i++) {
         for(unsigned j=0;j<Bwidth;j++) {
@@ -90,6 +110,10 @@ void batch_trimatTr_madd_gf16( unsigned char * bC , const unsigned char* btriA ,
 void batch_trimatTr_madd_gf256( unsigned char * bC , const unsigned char* btriA ,
         const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_trimatTr_madd_gf256_avx2( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_trimatTr_madd_gf256_sse( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     unsigned Aheight = Bheight;
     for(unsigned i=0;i<Aheight;i++) {
         for(unsigned j=0;j<Bwidth;j++) {
@@ -108,6 +132,10 @@ void batch_trimatTr_madd_gf256( unsigned char * bC , const unsigned char* btriA
 void batch_2trimat_madd_gf16( unsigned char * bC , const unsigned char* btriA ,
         const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_2trimat_madd_gf16_avx2( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_2trimat_madd_gf16_sse( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     unsigned Aheight = Bheight;
     for(unsigned i=0;i<Aheight;i++) {
         for(unsigned j=0;j<Bwidth;j++) {
@@ -123,6 +151,10 @@ void batch_2trimat_madd_gf16( unsigned char * bC , const unsigned char* btriA ,
 void batch_2trimat_madd_gf256( unsigned char * bC , const unsigned char* btriA ,
         const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_2trimat_madd_gf256_avx2( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_2trimat_madd_gf256_sse( bC , btriA , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     unsigned Aheight = Bheight;
     for(unsigned i=0;i<Aheight;i++) {
         for(unsigned j=0;j<Bwidth;j++) {
@@ -141,6 +173,10 @@ void batch_2trimat_madd_gf256( unsigned char * bC , const unsigned char* btriA ,
 void batch_matTr_madd_gf16( unsigned char * bC , const unsigned char* A_to_tr , unsigned Aheight, unsigned size_Acolvec, unsigned Awidth,
         const unsigned char* bB, unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_matTr_madd_gf16_avx2( bC , A_to_tr , Aheight , size_Acolvec , Awidth , bB , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_matTr_madd_gf16_sse( bC , A_to_tr , Aheight , size_Acolvec , Awidth , bB , Bwidth , size_batch ); return; }
+#endif
     unsigned Atr_height = Awidth;
     unsigned Atr_width  = Aheight;
     for(unsigned i=0;i<Atr_height;i++) {
@@ -154,6 +190,10 @@ void batch_matTr_madd_gf16( unsigned char * bC , const unsigned char* A_to_tr ,
 void batch_matTr_madd_gf256( unsigned char * bC , const unsigned char* A_to_tr , unsigned Aheight, unsigned size_Acolvec, unsigned Awidth,
         const unsigned char* bB, unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_matTr_madd_gf256_avx2( bC , A_to_tr , Aheight , size_Acolvec , Awidth , bB , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_matTr_madd_gf256_sse( bC , A_to_tr , Aheight , size_Acolvec , Awidth , bB , Bwidth , size_batch ); return; }
+#endif
     unsigned Atr_height = Awidth;
     unsigned Atr_width  = Aheight;
     for(unsigned i=0;i<Atr_height;i++) {
@@ -170,6 +210,10 @@ void batch_matTr_madd_gf256( unsigned char * bC , const unsigned char* A_to_tr ,
 void batch_bmatTr_madd_gf16( unsigned char *bC , const unsigned char *bA_to_tr, unsigned Awidth_before_tr,
         const unsigned char *B, unsigned Bheight, unsigned size_Bcolvec, unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_bmatTr_madd_gf16_avx2( bC , bA_to_tr , Awidth_before_tr , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_bmatTr_madd_gf16_sse( bC , bA_to_tr , Awidth_before_tr , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     const unsigned char *bA = bA_to_tr;
     unsigned Aheight = Awidth_before_tr;
     for(unsigned i=0;i<Aheight;i++) {
@@ -185,6 +229,10 @@ void batch_bmatTr_madd_gf16( unsigned char *bC , const unsigned char *bA_to_tr,
 void batch_bmatTr_madd_gf256( unsigned char *bC , const unsigned char *bA_to_tr, unsigned Awidth_before_tr,
         const unsigned char *B, unsigned Bheight, unsigned size_Bcolvec, unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_bmatTr_madd_gf256_avx2( bC , bA_to_tr , Awidth_before_tr , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_bmatTr_madd_gf256_sse( bC , bA_to_tr , Awidth_before_tr , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     const unsigned char *bA = bA_to_tr;
     unsigned Aheight = Awidth_before_tr;
     for(unsigned i=0;i<Aheight;i++) {
@@ -204,6 +252,10 @@ void batch_bmatTr_madd_gf256( unsigned char *bC , const unsigned char *bA_to_tr,
 void batch_mat_madd_gf16( unsigned char * bC , const unsigned char* bA , unsigned Aheight,
         const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_mat_madd_gf16_avx2( bC , bA , Aheight , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_mat_madd_gf16_sse( bC , bA , Aheight , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     unsigned Awidth = Bheight;
     for(unsigned i=0;i<Aheight;i++) {
         for(unsigned j=0;j<Bwidth;j++) {
@@ -219,6 +271,10 @@ void batch_mat_madd_gf16( unsigned char * bC , const unsigned char* bA , unsigne
 void batch_mat_madd_gf256( unsigned char * bC , const unsigned char* bA , unsigned Aheight,
         const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_mat_madd_gf256_avx2( bC , bA , Aheight , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_mat_madd_gf256_sse( bC , bA , Aheight , B , Bheight , size_Bcolvec , Bwidth , size_batch ); return; }
+#endif
     unsigned Awidth = Bheight;
     for(unsigned i=0;i<Aheight;i++) {
         for(unsigned j=0;j<Bwidth;j++) {
@@ -242,6 +298,10 @@ void batch_mat_madd_gf256( unsigned char * bC , const unsigned char* bA , unsign
 
 void batch_quad_trimat_eval_gf16( unsigned char * y, const unsigned char * trimat, const unsigned char * x, unsigned dim , unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_quad_trimat_eval_gf16_avx2( y , trimat , x , dim , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_quad_trimat_eval_gf16_sse( y , trimat , x , dim , size_batch ); return; }
+#endif
 ///
 ///    assert( dim <= 128 );
 ///    assert( size_batch <= 128 );
@@ -263,6 +323,10 @@ void batch_quad_trimat_eval_gf16( unsigned char * y, const unsigned char * trima
 
 void batch_quad_trimat_eval_gf256( unsigned char * y, const unsigned char * trimat, const unsigned char * x, unsigned dim , unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_quad_trimat_eval_gf256_avx2( y , trimat , x , dim , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_quad_trimat_eval_gf256_sse( y , trimat , x , dim , size_batch ); return; }
+#endif
 ///
 ///    assert( dim <= 256 );
 ///    assert( size_batch <= 256 );
@@ -291,6 +355,10 @@ void batch_quad_trimat_eval_gf256( unsigned char * y, const unsigned char * trim
 void batch_quad_recmat_eval_gf16( unsigned char * z, const unsigned char * y, unsigned dim_y, const unsigned char * mat,
         const unsigned char * x, unsigned dim_x , unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_quad_recmat_eval_gf16_avx2( z , y , dim_y , mat , x , dim_x , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_quad_recmat_eval_gf16_sse( z , y , dim_y , mat , x , dim_x , size_batch ); return; }
+#endif
 ///
 ///    assert( dim_x <= 128 );
 ///    assert( dim_y <= 128 );
@@ -317,6 +385,10 @@ void batch_quad_recmat_eval_gf16( unsigned char * z, const unsigned char * y, un
 void batch_quad_recmat_eval_gf256( unsigned char * z, const unsigned char * y, unsigned dim_y, const unsigned char * mat,
         const unsigned char * x, unsigned dim_x , unsigned size_batch )
 {
+#if defined(_BLAS_SIMD_DISPATCH_)
+    if( blas_cpu_has_avx2() ) { batch_quad_recmat_eval_gf256_avx2( z , y , dim_y , mat , x , dim_x , size_batch ); return; }
+    if( blas_cpu_has_ssse3() ) { batch_quad_recmat_eval_gf256_sse( z , y , dim_y , mat , x , dim_x , size_batch ); return; }
+#endif
 ///
 ///    assert( dim_x <= 128 );
 ///    assert( dim_y <= 128 );
@@ -0,0 +1,69 @@
+/// @file gf16_avx2.h
+/// @brief Library for arithmetics in GF(16) and GF(256), for avx2 instruction set.
+///
+///  Same table-lookup method as gf16_sse.h, with the 16-byte tables broadcast to both lanes.
+///
+
+#ifndef _GF16_AVX2_H_
+#define _GF16_AVX2_H_
+
+#include "gf16_sse.h"
+
+#if defined(_BLAS_SIMD_DISPATCH_)
+
+
+/// @brief the table of b*i, i=0..15, in GF(16), in both lanes.
+static inline _BLAS_TARGET_AVX2_
+__m256i gf16_multab_avx2( uint8_t b )
+{
+    __m256i r = _mm256_setzero_si256();
+    for(unsigned k=0;k<4;k++) {
+        __m256i mask = _mm256_set1_epi8( (char)(0-((b>>k)&1)) );
+        __m256i base = _mm256_broadcastsi128_si256( _mm_load_si128( (const __m128i*)(__gf16_mulbase+16*k) ) );
+        r = _mm256_xor_si256( r , _mm256_and_si256( mask , base ) );
+    }
+    return r;
+}
+
+/// @brief the tables of b*i and b*(i<<4), i=0..15, in GF(256), in both lanes.
+///
+///  The bit masks are taken from a broadcast copy of b and the two 16-byte tables are
+///  accumulated in the two lanes of one register, so only the final split uses the shuffle port.
+static inline _BLAS_TARGET_AVX2_
+void gf256_multab_avx2( __m256i * tab , uint8_t b )
+{
+    __m256i bb = _mm256_set1_epi8( (char)b );
+    __m256i t = _mm256_setzero_si256();
+    for(unsigned k=0;k<8;k++) {
+        __m256i bit = _mm256_set1_epi8( (char)(1<<k) );
+        __m256i mask = _mm256_cmpeq_epi8( _mm256_and_si256( bb , bit ) , bit );
+        t = _mm256_xor_si256( t , _mm256_and_si256( mask , _mm256_load_si256( (const __m256i*)(__gf256_mulbase+32*k) ) ) );
+    }
+    tab[0] = _mm256_permute2x128_si256( t , t , 0x00 );
+    tab[1] = _mm256_permute2x128_si256( t , t , 0x11 );
+}
+
+
+/// @brief 64 packed GF(16) elements in a times the scalar whose table is multab.
+static inline _BLAS_TARGET_AVX2_
+__m256i gf16v_mul_multab_avx2( __m256i a , __m256i multab , __m256i mask_f )
+{
+    __m256i r_lo = _mm256_shuffle_epi8( multab , _mm256_and_si256( a , mask_f ) );
+    __m256i r_hi = _mm256_shuffle_epi8( multab , _mm256_and_si256( _mm256_srli_epi16( a , 4 ) , mask_f ) );
+    return _mm256_xor_si256( r_lo , _mm256_slli_epi16( r_hi , 4 ) );
+}
+
+/// @brief 32 GF(256) elements in a times the scalar whose tables are tab_l, tab_h.
+static inline _BLAS_TARGET_AVX2_
+__m256i gf256v_mul_multab_avx2( __m256i a , __m256i tab_l , __m256i tab_h , __m256i mask_f )
+{
+    __m256i r_lo = _mm256_shuffle_epi8( tab_l , _mm256_and_si256( a , mask_f ) );
+    __m256i r_hi = _mm256_shuffle_epi8( tab_h , _mm256_and_si256( _mm256_srli_epi16( a , 4 ) , mask_f ) );
+    return _mm256_xor_si256( r_lo , r_hi );
+}
+
+
+#endif // defined(_BLAS_SIMD_DISPATCH_)
+
+#endif // _GF16_AVX2_H_
+
@@ -0,0 +1,73 @@
+///  @file  parallel_matrix_op_avx2.h
+///  @brief Librarys for operations of batched matrixes, for avx2 instruction set.
+///
+///  The same interfaces as parallel_matrix_op.h. Available only when _BLAS_SIMD_DISPATCH_ is defined.
+///
+
+#ifndef _P_MATRIX_OP_AVX2_H_
+#define _P_MATRIX_OP_AVX2_H_
+
+#include "blas_config.h"
+
+#if defined(_BLAS_SIMD_DISPATCH_)
+
+#ifdef  __cplusplus
+extern  "C" {
+#endif
+
+
+void batch_trimat_madd_gf16_avx2( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch );
+
+void batch_trimat_madd_gf256_avx2( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch );
+
+void batch_trimatTr_madd_gf16_avx2( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch );
+
+void batch_trimatTr_madd_gf256_avx2( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch );
+
+void batch_2trimat_madd_gf16_avx2( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch );
+
+void batch_2trimat_madd_gf256_avx2( unsigned char * bC , const unsigned char* btriA ,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch );
+
+void batch_matTr_madd_gf16_avx2( unsigned char * bC , const unsigned char* A_to_tr , unsigned Aheight, unsigned size_Acolvec, unsigned Awidth,
+        const unsigned char* bB, unsigned Bwidth, unsigned size_batch );
+
+void batch_matTr_madd_gf256_avx2( unsigned char * bC , const unsigned char* A_to_tr , unsigned Aheight, unsigned size_Acolvec, unsigned Awidth,
+        const unsigned char* bB, unsigned Bwidth, unsigned size_batch );
+
+void batch_bmatTr_madd_gf16_avx2( unsigned char *bC , const unsigned char *bA_to_tr, unsigned Awidth_before_tr,
+        const unsigned char *B, unsigned Bheight, unsigned size_Bcolvec, unsigned Bwidth, unsigned size_batch );
+
+void batch_bmatTr_madd_gf256_avx2( unsigned char *bC , const unsigned char *bA_to_tr, unsigned Awidth_before_tr,
+        const unsigned char *B, unsigned Bheight, unsigned size_Bcolvec, unsigned Bwidth, unsigned size_batch );
+
+void batch_mat_madd_gf16_avx2( unsigned char * bC , const unsigned char* bA , unsigned Aheight,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch );
+
+void batch_mat_madd_gf256_avx2( unsigned char * bC , const unsigned char* bA , unsigned Aheight,
+        const unsigned char* B , unsigned Bheight, unsigned size_Bcolvec , unsigned Bwidth, unsigned size_batch );
+
+void batch_quad_trimat_eval_gf16_avx2( unsigned char * y, const unsigned char * trimat, const unsigned char * x, unsigned dim , unsigned size_batch );
+
+void batch_quad_trimat_eval_gf256_avx2( unsigned char * y, const unsigned char * trimat, const unsigned char * x, unsigned dim , unsigned size_batch );
+
+void batch_quad_recmat_eval_gf16_avx2( unsigned char * z, const unsigned char * y, unsigned dim_y, const unsigned char * mat,
+        const unsigned char * x, unsigned dim_x , unsigned size_batch );
+
+void batch_quad_recmat_eval_gf256_avx2( unsigned char * z, const unsigned char * y, unsigned dim_y, const unsigned char * mat,
+        const unsigned char * x, unsigned dim_x , unsigned size_batch );
+
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif // defined(_BLAS_SIMD_DISPATCH_)
+
+#endif // _P_MATRIX_OP_AVX2_H_
+
@@ -0,0 +1,116 @@
+/// @file rainbow_verifier.h
+/// @brief Verifiers holding an expanded public key, and an LRU cache of them.
+///
+///  rainbow_verify_cyclic() expands the compressed key on every call. A verifier
+///  runs cpk_to_pk() once and verifies against the full public map afterwards.
+///  The cache is keyed by the hash of the compressed key. It is not thread-safe.
+///
+
+#ifndef _RAINBOW_VERIFIER_H_
+#define _RAINBOW_VERIFIER_H_
+
+#include "rainbow_config.h"
+#include "rainbow_keypair.h"
+
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern  "C" {
+#endif
+
+
+/// @brief the alignment of the expanded public key in a verifier.
+#define RAINBOW_VERIFIER_ALIGN  32
+
+
+///
+/// @brief A verifier for one public key.
+///
+typedef
+struct rainbow_verifier {
+    pk_t pk;    ///< the full public map, in the trimat layout of rainbow_publicmap().
+} rainbow_verifier_t;
+
+
+///
+/// @brief Create a verifier by expanding a compressed public key.
+///
+/// @param[in]  cpk       - the public key of cyclic rainbow.
+/// @return the verifier. NULL if the allocation fails.
+///
+rainbow_verifier_t * rainbow_verifier_new( const cpk_t * cpk );
+
+///
+/// @brief Free a verifier.
+///
+/// @param[in]  vf        - the verifier. May be NULL.
+///
+void rainbow_verifier_free( rainbow_verifier_t * vf );
+
+///
+/// @brief Verifying function with a verifier. Same result as rainbow_verify_cyclic() with the original key.
+///
+/// @param[in]  digest    - the digest.
+/// @param[in]  signature - the signature.
+/// @param[in]  vf        - the verifier.
+/// @return 0 for successful verified. -1 for failed verification.
+///
+int rainbow_verifier_verify( const uint8_t * digest , const uint8_t * signature , const rainbow_verifier_t * vf );
+
+
+
+///
+/// @brief An LRU cache of verifiers.
+///
+typedef struct rainbow_verifier_cache rainbow_verifier_cache_t;
+
+///
+/// @brief Create an empty cache.
+///
+/// @param[in]  capacity  - the maximal number of verifiers kept. Must be positive.
+/// @return the cache. NULL if the allocation fails.
+///
+rainbow_verifier_cache_t * rainbow_verifier_cache_new( unsigned capacity );
+
+///
+/// @brief Free a cache and all verifiers in it.
+///
+/// @param[in]  cache     - the cache. May be NULL.
+///
+void rainbow_verifier_cache_free( rainbow_verifier_cache_t * cache );
+
+///
+/// @brief Find the verifier of a compressed key, creating it and evicting the least recently used one if needed.
+///
+/// @param[in,out]  cache - the cache.
+/// @param[in]  cpk       - the public key of cyclic rainbow.
+/// @return the verifier, owned by the cache and valid until it is evicted. NULL if the allocation fails.
+///
+const rainbow_verifier_t * rainbow_verifier_cache_get( rainbow_verifier_cache_t * cache , const cpk_t * cpk );
+
+///
+/// @brief The number of lookups that did not find their key in the cache.
+///
+/// @param[in]  cache     - the cache.
+/// @return the number of misses since the cache was created.
+///
+unsigned long long rainbow_verifier_cache_misses( const rainbow_verifier_cache_t * cache );
+
+///
+/// @brief Verifying function for cyclic public keys through a cache of verifiers.
+///
+/// @param[in,out]  cache - the cache.
+/// @param[in]  digest    - the digest.
+/// @param[in]  signature - the signature.
+/// @param[in]  cpk       - the public key of cyclic rainbow.
+/// @return 0 for successful verified. -1 for failed verification.
+///
+int rainbow_verify_cyclic_cached( rainbow_verifier_cache_t * cache , const uint8_t * digest , const uint8_t * signature , const cpk_t * cpk );
+
+
+#ifdef  __cplusplus
+}
+#endif
+
+
+#endif // _RAINBOW_VERIFIER_H_
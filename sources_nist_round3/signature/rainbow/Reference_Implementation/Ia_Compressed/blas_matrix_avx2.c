@@ -0,0 +1,294 @@
+/// @file blas_matrix_avx2.c
+/// @brief Implementations for blas_matrix_avx2.h
+///
+///  The same algorithms as blas_matrix_ref.c with the row operations done by PSHUFB.
+///
+
+#include "blas_comm.h"
+#include "blas.h"
+#include "blas_avx2.h"
+
+#include "blas_matrix_avx2.h"
+
+#if defined(_BLAS_SIMD_DISPATCH_)
+
+#include <stdint.h>
+#include <string.h>
+
+
+
+///////////  matrix-vector  multiplications  ////////////////////////////////
+
+_BLAS_TARGET_AVX2_
+void gf16mat_prod_avx2(uint8_t *c, const uint8_t *matA, unsigned n_A_vec_byte, unsigned n_A_width, const uint8_t *b) {
+    gf256v_set_zero(c, n_A_vec_byte);
+    for (unsigned i = 0; i < n_A_width; i++) {
+        uint8_t bb = gf16v_get_ele(b, i);
+        _gf16v_madd_avx2(c, matA, bb, n_A_vec_byte);
+        matA += n_A_vec_byte;
+    }
+}
+
+_BLAS_TARGET_AVX2_
+void gf256mat_prod_avx2(uint8_t *c, const uint8_t *matA, unsigned n_A_vec_byte, unsigned n_A_width, const uint8_t *b) {
+    gf256v_set_zero(c, n_A_vec_byte);
+    for (unsigned i = 0; i < n_A_width; i++) {
+        _gf256v_madd_avx2(c, matA, b[i], n_A_vec_byte);
+        matA += n_A_vec_byte;
+    }
+}
+
+
+
+
+
+
+
+/////////////////   algorithms:  gaussian elim  //////////////////
+////////////  private functions  /////////////////////////////
+
+
+
+static _BLAS_TARGET_AVX2_
+unsigned gf16mat_gauss_elim_avx2(uint8_t *mat, unsigned h, unsigned w) {
+    const unsigned w_byte = (w+1)>>1;
+
+    unsigned r8 = 1;
+    for (unsigned i = 0; i < h; i++) {
+        unsigned i_start = (i>>1);
+        uint8_t *ai = mat + i*w_byte;
+        for (unsigned j = i + 1; j < h; j++) {
+            uint8_t *aj = mat + j*w_byte;
+            _gf256v_conditional_add_avx2(ai + i_start, !gf16_is_nonzero(gf16v_get_ele(ai, i)), aj + i_start, w_byte - i_start );
+        }
+        uint8_t pivot = gf16v_get_ele(ai, i);
+        r8 &= gf16_is_nonzero(pivot);
+        pivot = gf16_inv(pivot);
+        _gf16v_mul_scalar_avx2(ai + i_start, pivot, w_byte - i_start );
+        for (unsigned j = 0; j < h; j++) {
+            if (i == j) continue;
+            uint8_t *aj = mat + j*w_byte;
+            _gf16v_madd_avx2(aj + i_start, ai + i_start, gf16v_get_ele(aj, i), w_byte-i_start);
+        }
+    }
+    return r8;
+}
+
+
+/////////////////////////////////////////////////
+
+
+// The rows have n_blk*32 bytes. The pivot row stays in registers while the other rows are reduced.
+// The columns before the block of the pivot are zeros in the rows being added and are skipped.
+#define _GAUSS_MAX_BLK_  3
+
+static inline _BLAS_TARGET_AVX2_
+unsigned gf256mat_gauss_elim_avx2( uint8_t * mat , unsigned h , unsigned n_blk )
+{
+    const unsigned w = n_blk*32;
+    __m256i mask_f = _mm256_set1_epi8( 0xf );
+    __m256i tab[2];
+    unsigned r8 = 1;
+
+    for(unsigned i=0;i<h;i++) {
+        uint8_t * ai = mat + w*i;
+        unsigned st = i>>5;
+        __m256i pr[_GAUSS_MAX_BLK_];
+        for(unsigned b=0;b<n_blk;b++) pr[b] = (b>=st)? _mm256_loadu_si256( (const __m256i*)(ai+32*b) ) : _mm256_setzero_si256();
+
+        uint8_t pivot = ai[i];
+        for(unsigned j=i+1;j<h;j++) {
+            const uint8_t * aj = mat + w*j;
+            uint8_t m8 = gf256_is_nonzero(pivot) - 1;
+            __m256i mask = _mm256_set1_epi8( (char)m8 );
+            pivot ^= aj[i] & m8;
+            for(unsigned b=0;b<n_blk;b++) if(b>=st) pr[b] = _mm256_xor_si256( pr[b] , _mm256_and_si256( mask , _mm256_loadu_si256( (const __m256i*)(aj+32*b) ) ) );
+        }
+        r8 &= gf256_is_nonzero(pivot);
+
+        gf256_multab_avx2( tab , gf256_inv(pivot) );
+        for(unsigned b=0;b<n_blk;b++) if(b>=st) {
+            pr[b] = gf256v_mul_multab_avx2( pr[b] , tab[0] , tab[1] , mask_f );
+            _mm256_storeu_si256( (__m256i*)(ai+32*b) , pr[b] );
+        }
+        for(unsigned j=0;j<h;j++) {
+            if(i==j) continue;
+            uint8_t * aj = mat + w*j;
+            gf256_multab_avx2( tab , aj[i] );
+            for(unsigned b=0;b<n_blk;b++) if(b>=st) {
+                __m256i x = _mm256_loadu_si256( (const __m256i*)(aj+32*b) );
+                _mm256_storeu_si256( (__m256i*)(aj+32*b) , _mm256_xor_si256( x , gf256v_mul_multab_avx2( pr[b] , tab[0] , tab[1] , mask_f ) ) );
+            }
+        }
+    }
+
+    return r8;
+}
+
+
+/// n x n equations with column-major inp_mat. The rows are n+1 elements padded to n_blk*32 bytes.
+static inline _BLAS_TARGET_AVX2_
+unsigned gf256mat_solve_linear_eq_avx2( uint8_t * sol , const uint8_t * inp_mat , const uint8_t * c_terms , unsigned n , unsigned n_blk )
+{
+    const unsigned w = n_blk*32;
+    uint8_t mat[ 64*_GAUSS_MAX_BLK_*32 ];
+    gf256mat_augment_rows_sse( mat , w , inp_mat , n , c_terms );
+    unsigned r8 = gf256mat_gauss_elim_avx2( mat , n , n_blk );
+    for(unsigned i=0;i<n;i++) sol[i] = mat[i*w+n];
+    gf256v_set_zero(mat,n*w); // clean
+    return r8;
+}
+
+/// The rows are [a|I] padded to n_blk*32 bytes.
+static inline _BLAS_TARGET_AVX2_
+unsigned gf256mat_inv_avx2( uint8_t * inv_a , const uint8_t * a , unsigned H , unsigned n_blk )
+{
+    const unsigned w = n_blk*32;
+    uint8_t mat[ 36*_GAUSS_MAX_BLK_*32 ];
+    for(unsigned i=0;i<H;i++) {
+        uint8_t * ai = mat + i*w;
+        gf256v_set_zero( ai , w );
+        _gf256v_add_avx2( ai , a + i*H , H );
+        ai[H+i] = 1;
+    }
+    unsigned r8 = gf256mat_gauss_elim_avx2( mat , H , n_blk );
+    for(unsigned i=0;i<H;i++) memcpy( inv_a + i*H , mat + i*w + H , H );
+    gf256v_set_zero(mat,H*w);
+    return r8;
+}
+
+/// c = mat_c + sum_k b[k]*matA_k, for n_A_width matrices of len bytes. mat_c can be NULL for zero.
+static inline _BLAS_TARGET_AVX2_
+void gf256mat_prod_add_avx2( uint8_t * c , const uint8_t * mat_c , const uint8_t * matA , unsigned len , unsigned n_A_width , const uint8_t * b )
+{
+    if( mat_c ) memcpy( c , mat_c , len );
+    else gf256v_set_zero( c , len );
+    for(unsigned k=0;k<n_A_width;k++) _gf256v_madd_avx2( c , matA + k*len , b[k] , len );
+}
+
+
+
+////////////  public functions  /////////////////////////////
+
+
+
+
+_BLAS_TARGET_AVX2_
+unsigned gf16mat_solve_linear_eq_32x32_avx2(uint8_t *sol, const uint8_t *inp_mat, const uint8_t *c_terms ) {
+    const unsigned vec_len = 16+_BLAS_UNIT_LEN_;
+    uint8_t mat[32*vec_len];
+    const unsigned n=32;
+    const unsigned n_2 = n/2;
+    for(unsigned i=0;i<n;i++) {
+        uint8_t *mi = mat+i*vec_len;
+        for(unsigned j=0;j<n;j++) gf16v_set_ele( mi , j , gf16v_get_ele( inp_mat+j*16 , i ) );
+        mi[n_2] = gf16v_get_ele(c_terms,i);
+    }
+    uint8_t r8 = gf16mat_gauss_elim_avx2(mat,n,vec_len*2);
+    for(unsigned i=0;i<n;i++) gf16v_set_ele( sol , i , mat[i*vec_len+n_2] );
+    return r8;
+}
+
+
+
+static inline
+void gf16mat_submat(uint8_t *mat2, unsigned w2, unsigned st, const uint8_t *mat, unsigned w, unsigned h) {
+    unsigned n_byte_w1 = (w + 1) / 2;
+    unsigned n_byte_w2 = (w2 + 1) / 2;
+    unsigned st_2 = st / 2;
+    for (unsigned i = 0; i < h; i++) {
+        for (unsigned j = 0; j < n_byte_w2; j++) mat2[i * n_byte_w2 + j] = mat[i * n_byte_w1 + st_2 + j];
+    }
+}
+
+
+
+_BLAS_TARGET_AVX2_
+unsigned gf16mat_inv_32x32_avx2(uint8_t *inv_a, const uint8_t *a ) {
+    const unsigned H=32;
+    uint8_t mat[32*32];
+    for (unsigned i = 0; i < H; i++) {
+        uint8_t *ai = mat + i * 32;
+        gf256v_set_zero(ai, 32 );
+        _gf256v_add_avx2(ai, a + i * 16, 16);
+        gf16v_set_ele(ai + 16, i, 1);
+    }
+    uint8_t r8 = gf16mat_gauss_elim_avx2(mat, H, 2*H);
+    gf16mat_submat(inv_a, H, H, mat, 2 * H, H);
+    return r8;
+}
+
+
+/////////////////////////////////////////////////
+
+
+_BLAS_TARGET_AVX2_
+unsigned gf256mat_solve_linear_eq_48x48_avx2( uint8_t * sol , const uint8_t * inp_mat , const uint8_t * c_terms )
+{
+    return gf256mat_solve_linear_eq_avx2( sol , inp_mat , c_terms , 48 , 2 );
+}
+
+_BLAS_TARGET_AVX2_
+unsigned gf256mat_inv_32x32_avx2( uint8_t * inv_a , const uint8_t * a )
+{
+    return gf256mat_inv_avx2( inv_a , a , 32 , 2 );
+}
+
+_BLAS_TARGET_AVX2_
+unsigned gf256mat_prod_solve_linear_eq_48x48_avx2( uint8_t * sol , const uint8_t * mat_c , const uint8_t * matA , unsigned n_A_width , const uint8_t * b , const uint8_t * c_terms )
+{
+    uint8_t mat[48*48];
+    gf256mat_prod_add_avx2( mat , mat_c , matA , 48*48 , n_A_width , b );
+    unsigned r8 = gf256mat_solve_linear_eq_avx2( sol , mat , c_terms , 48 , 2 );
+    gf256v_set_zero(mat,48*48);
+    return r8;
+}
+
+_BLAS_TARGET_AVX2_
+unsigned gf256mat_prod_inv_32x32_avx2( uint8_t * inv_a , const uint8_t * matA , unsigned n_A_width , const uint8_t * b )
+{
+    uint8_t mat[32*32];
+    gf256mat_prod_add_avx2( mat , NULL , matA , 32*32 , n_A_width , b );
+    unsigned r8 = gf256mat_inv_avx2( inv_a , mat , 32 , 2 );
+    gf256v_set_zero(mat,32*32);
+    return r8;
+}
+
+
+//////////////////////////////////////////////////////
+
+
+_BLAS_TARGET_AVX2_
+unsigned gf256mat_solve_linear_eq_64x64_avx2( uint8_t * sol , const uint8_t * inp_mat , const uint8_t * c_terms )
+{
+    return gf256mat_solve_linear_eq_avx2( sol , inp_mat , c_terms , 64 , 3 );
+}
+
+_BLAS_TARGET_AVX2_
+unsigned gf256mat_inv_36x36_avx2( uint8_t * inv_a , const uint8_t * a )
+{
+    return gf256mat_inv_avx2( inv_a , a , 36 , 3 );
+}
+
+_BLAS_TARGET_AVX2_
+unsigned gf256mat_prod_solve_linear_eq_64x64_avx2( uint8_t * sol , const uint8_t * mat_c , const uint8_t * matA , unsigned n_A_width , const uint8_t * b , const uint8_t * c_terms )
+{
+    uint8_t mat[64*64];
+    gf256mat_prod_add_avx2( mat , mat_c , matA , 64*64 , n_A_width , b );
+    unsigned r8 = gf256mat_solve_linear_eq_avx2( sol , mat , c_terms , 64 , 3 );
+    gf256v_set_zero(mat,64*64);
+    return r8;
+}
+
+_BLAS_TARGET_AVX2_
+unsigned gf256mat_prod_inv_36x36_avx2( uint8_t * inv_a , const uint8_t * matA , unsigned n_A_width , const uint8_t * b )
+{
+    uint8_t mat[36*36];
+    gf256mat_prod_add_avx2( mat , NULL , matA , 36*36 , n_A_width , b );
+    unsigned r8 = gf256mat_inv_avx2( inv_a , mat , 36 , 3 );
+    gf256v_set_zero(mat,36*36);
+    return r8;
+}
+
+
+#endif // defined(_BLAS_SIMD_DISPATCH_)
@@ -0,0 +1,200 @@
+/// @file blas_sse.h
+/// @brief Inlined functions for implementing basic linear algebra functions for ssse3 arch.
+///
+///  Scalars are given either as field elements or as precomputed tables:
+///  16 bytes per element for GF(16) and 32 bytes (low-, high-nibble table) per element for GF(256).
+///
+
+#ifndef _BLAS_SSE_H_
+#define _BLAS_SSE_H_
+
+#include "gf16_sse.h"
+#include "blas_comm.h"
+
+#if defined(_BLAS_SIMD_DISPATCH_)
+
+#include <string.h>
+#include <stdint.h>
+
+
+static inline _BLAS_TARGET_SSE_
+void _gf256v_add_sse(uint8_t *accu_b, const uint8_t *a, unsigned _num_byte) {
+    unsigned n_16 = _num_byte >> 4;
+    for (unsigned i = 0; i < n_16; i++) {
+        __m128i b = _mm_loadu_si128( (const __m128i*)(accu_b+16*i) );
+        __m128i x = _mm_loadu_si128( (const __m128i*)(a+16*i) );
+        _mm_storeu_si128( (__m128i*)(accu_b+16*i) , _mm_xor_si128(b,x) );
+    }
+    for (unsigned i = n_16<<4; i < _num_byte; i++) accu_b[i] ^= a[i];
+}
+
+static inline _BLAS_TARGET_SSE_
+void _gf256v_conditional_add_sse(uint8_t *accu_b, uint8_t condition, const uint8_t *a, unsigned _num_byte) {
+    uint8_t pr_u8 = 0 - condition;
+    __m128i mask = _mm_set1_epi8( (char)pr_u8 );
+    unsigned n_16 = _num_byte >> 4;
+    for (unsigned i = 0; i < n_16; i++) {
+        __m128i b = _mm_loadu_si128( (const __m128i*)(accu_b+16*i) );
+        __m128i x = _mm_loadu_si128( (const __m128i*)(a+16*i) );
+        _mm_storeu_si128( (__m128i*)(accu_b+16*i) , _mm_xor_si128(b,_mm_and_si128(x,mask)) );
+    }
+    for (unsigned i = n_16<<4; i < _num_byte; i++) accu_b[i] ^= (a[i] & pr_u8);
+}
+
+
+///////////////////////////////////////////////////
+
+
+static inline _BLAS_TARGET_SSE_
+void _gf16v_madd_tab_sse(uint8_t *accu_c, const uint8_t *a, __m128i multab, unsigned _num_byte) {
+    __m128i mask_f = _mm_set1_epi8( 0xf );
+    unsigned n_16 = _num_byte >> 4;
+    for (unsigned i = 0; i < n_16; i++) {
+        __m128i c = _mm_loadu_si128( (const __m128i*)(accu_c+16*i) );
+        __m128i x = _mm_loadu_si128( (const __m128i*)(a+16*i) );
+        _mm_storeu_si128( (__m128i*)(accu_c+16*i) , _mm_xor_si128(c,gf16v_mul_multab_sse(x,multab,mask_f)) );
+    }
+    unsigned rem = _num_byte & 15;
+    if( !rem ) return;
+    uint8_t tc[16];
+    uint8_t ta[16] = {0};
+    accu_c += (n_16<<4);
+    memcpy( tc , accu_c , rem );
+    memcpy( ta , a + (n_16<<4) , rem );
+    __m128i r = _mm_xor_si128( _mm_loadu_si128((const __m128i*)tc) ,
+                    gf16v_mul_multab_sse( _mm_loadu_si128((const __m128i*)ta) , multab , mask_f ) );
+    _mm_storeu_si128( (__m128i*)tc , r );
+    memcpy( accu_c , tc , rem );
+}
+
+static inline _BLAS_TARGET_SSE_
+void _gf256v_madd_tab_sse(uint8_t *accu_c, const uint8_t *a, __m128i tab_l, __m128i tab_h, unsigned _num_byte) {
+    __m128i mask_f = _mm_set1_epi8( 0xf );
+    unsigned n_16 = _num_byte >> 4;
+    for (unsigned i = 0; i < n_16; i++) {
+        __m128i c = _mm_loadu_si128( (const __m128i*)(accu_c+16*i) );
+        __m128i x = _mm_loadu_si128( (const __m128i*)(a+16*i) );
+        _mm_storeu_si128( (__m128i*)(accu_c+16*i) , _mm_xor_si128(c,gf256v_mul_multab_sse(x,tab_l,tab_h,mask_f)) );
+    }
+    unsigned rem = _num_byte & 15;
+    if( !rem ) return;
+    uint8_t tc[16];
+    uint8_t ta[16] = {0};
+    accu_c += (n_16<<4);
+    memcpy( tc , accu_c , rem );
+    memcpy( ta , a + (n_16<<4) , rem );
+    __m128i r = _mm_xor_si128( _mm_loadu_si128((const __m128i*)tc) ,
+                    gf256v_mul_multab_sse( _mm_loadu_si128((const __m128i*)ta) , tab_l , tab_h , mask_f ) );
+    _mm_storeu_si128( (__m128i*)tc , r );
+    memcpy( accu_c , tc , rem );
+}
+
+
+///////////////////////////////////////////////////
+
+
+static inline _BLAS_TARGET_SSE_
+void _gf16v_madd_multab_sse(uint8_t *accu_c, const uint8_t *a, const uint8_t *multab, unsigned _num_byte) {
+    _gf16v_madd_tab_sse( accu_c , a , _mm_loadu_si128((const __m128i*)multab) , _num_byte );
+}
+
+static inline _BLAS_TARGET_SSE_
+void _gf256v_madd_multab_sse(uint8_t *accu_c, const uint8_t *a, const uint8_t *multab, unsigned _num_byte) {
+    _gf256v_madd_tab_sse( accu_c , a , _mm_loadu_si128((const __m128i*)multab) , _mm_loadu_si128((const __m128i*)(multab+16)) , _num_byte );
+}
+
+static inline _BLAS_TARGET_SSE_
+void _gf16v_madd_sse(uint8_t *accu_c, const uint8_t *a, uint8_t gf16_b, unsigned _num_byte) {
+    _gf16v_madd_tab_sse( accu_c , a , gf16_multab_sse(gf16_b) , _num_byte );
+}
+
+static inline _BLAS_TARGET_SSE_
+void _gf256v_madd_sse(uint8_t *accu_c, const uint8_t *a, uint8_t b, unsigned _num_byte) {
+    __m128i tab[2];
+    gf256_multab_sse( tab , b );
+    _gf256v_madd_tab_sse( accu_c , a , tab[0] , tab[1] , _num_byte );
+}
+
+
+///////////////////////////////////////////////////
+
+
+// a*b = a + a*(b+1) in characteristic 2, so the scaling is an in-place madd.
+
+static inline _BLAS_TARGET_SSE_
+void _gf16v_mul_scalar_sse(uint8_t *a, uint8_t gf16_b, unsigned _num_byte) {
+    _gf16v_madd_sse( a , a , gf16_b^1 , _num_byte );
+}
+
+static inline _BLAS_TARGET_SSE_
+void _gf256v_mul_scalar_sse(uint8_t *a, uint8_t b, unsigned _num_byte) {
+    _gf256v_madd_sse( a , a , b^1 , _num_byte );
+}
+
+
+///////////////////////////////////////////////////
+
+
+/// @brief multabs[16*i..16*i+15] = the table of the i-th element of the GF(16) vector v.
+static inline _BLAS_TARGET_SSE_
+void gf16v_generate_multabs_sse(uint8_t *multabs, const uint8_t *v, unsigned n_ele) {
+    for (unsigned i = 0; i < n_ele; i++) {
+        _mm_storeu_si128( (__m128i*)(multabs+16*i) , gf16_multab_sse( gf16v_get_ele(v,i) ) );
+    }
+}
+
+/// @brief multabs[32*i..32*i+31] = the tables of the i-th element of the GF(256) vector v.
+static inline _BLAS_TARGET_SSE_
+void gf256v_generate_multabs_sse(uint8_t *multabs, const uint8_t *v, unsigned n_ele) {
+    __m128i tab[2];
+    for (unsigned i = 0; i < n_ele; i++) {
+        gf256_multab_sse( tab , v[i] );
+        _mm_storeu_si128( (__m128i*)(multabs+32*i) , tab[0] );
+        _mm_storeu_si128( (__m128i*)(multabs+32*i+16) , tab[1] );
+    }
+}
+
+
+///////////////////////////////////////////////////
+
+
+/// @brief r[t*r_len+k] = a[k*a_len+t], k,t = 0..15. Transposing a 16x16 block of bytes.
+static inline _BLAS_TARGET_SSE_
+void gf256mat_transpose_16x16_sse(uint8_t *r, unsigned r_len, const uint8_t *a, unsigned a_len) {
+    __m128i x[16];
+    __m128i y[16];
+    for (unsigned k = 0; k < 16; k++) x[k] = _mm_loadu_si128( (const __m128i*)(a+k*a_len) );
+    // interleaving the k-th and (k+8)-th rows 4 times is a transposition.
+    for (unsigned rd = 0; rd < 2; rd++) {
+        for (unsigned k = 0; k < 8; k++) {
+            y[2*k]   = _mm_unpacklo_epi8( x[k] , x[k+8] );
+            y[2*k+1] = _mm_unpackhi_epi8( x[k] , x[k+8] );
+        }
+        for (unsigned k = 0; k < 8; k++) {
+            x[2*k]   = _mm_unpacklo_epi8( y[k] , y[k+8] );
+            x[2*k+1] = _mm_unpackhi_epi8( y[k] , y[k+8] );
+        }
+    }
+    for (unsigned t = 0; t < 16; t++) _mm_storeu_si128( (__m128i*)(r+t*r_len) , x[t] );
+}
+
+/// @brief Rows of the augmented matrix of linear equations.
+///
+///  Row i of mat (w bytes) = [ row i of the column-major n x n matrix inp_mat | c_terms[i] | 0 ... ].
+///  n has to be a multiple of 16 and w > n.
+static inline _BLAS_TARGET_SSE_
+void gf256mat_augment_rows_sse(uint8_t *mat, unsigned w, const uint8_t *inp_mat, unsigned n, const uint8_t *c_terms) {
+    for (unsigned i = 0; i < n; i++) {
+        memset( mat + i*w + n , 0 , w - n );
+        mat[i*w+n] = c_terms[i];
+    }
+    for (unsigned i = 0; i < n; i += 16) {
+        for (unsigned j = 0; j < n; j += 16) gf256mat_transpose_16x16_sse( mat + i*w + j , w , inp_mat + j*n + i , n );
+    }
+}
+
+
+#endif // defined(_BLAS_SIMD_DISPATCH_)
+
+#endif // _BLAS_SSE_H_
+
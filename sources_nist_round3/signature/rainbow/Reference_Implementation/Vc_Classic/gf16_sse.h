@@ -0,0 +1,74 @@
+/// @file gf16_sse.h
+/// @brief Library for arithmetics in GF(16) and GF(256), for ssse3 instruction set.
+///
+///  A multiplication by a fixed scalar b is a 16-entry table lookup (PSHUFB) per nibble.
+///  The tables are built from gf16_tabs.h with masks derived from the bits of b,
+///  so building them takes the same time for every b.
+///
+
+#ifndef _GF16_SSE_H_
+#define _GF16_SSE_H_
+
+#include "blas_config.h"
+
+#if defined(_BLAS_SIMD_DISPATCH_)
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "gf16_tabs.h"
+
+
+/// @brief the table of b*i, i=0..15, in GF(16).
+static inline _BLAS_TARGET_SSE_
+__m128i gf16_multab_sse( uint8_t b )
+{
+    __m128i r = _mm_setzero_si128();
+    for(unsigned k=0;k<4;k++) {
+        __m128i mask = _mm_set1_epi8( (char)(0-((b>>k)&1)) );
+        r = _mm_xor_si128( r , _mm_and_si128( mask , _mm_load_si128( (const __m128i*)(__gf16_mulbase+16*k) ) ) );
+    }
+    return r;
+}
+
+/// @brief the tables of b*i and b*(i<<4), i=0..15, in GF(256). tab[0] for the low nibbles, tab[1] for the high nibbles.
+static inline _BLAS_TARGET_SSE_
+void gf256_multab_sse( __m128i * tab , uint8_t b )
+{
+    __m128i bb = _mm_set1_epi8( (char)b );
+    __m128i tl = _mm_setzero_si128();
+    __m128i th = _mm_setzero_si128();
+    for(unsigned k=0;k<8;k++) {
+        __m128i bit = _mm_set1_epi8( (char)(1<<k) );
+        __m128i mask = _mm_cmpeq_epi8( _mm_and_si128( bb , bit ) , bit );
+        tl = _mm_xor_si128( tl , _mm_and_si128( mask , _mm_load_si128( (const __m128i*)(__gf256_mulbase+32*k) ) ) );
+        th = _mm_xor_si128( th , _mm_and_si128( mask , _mm_load_si128( (const __m128i*)(__gf256_mulbase+32*k+16) ) ) );
+    }
+    tab[0] = tl;
+    tab[1] = th;
+}
+
+
+/// @brief 32 packed GF(16) elements in a times the scalar whose table is multab.
+static inline _BLAS_TARGET_SSE_
+__m128i gf16v_mul_multab_sse( __m128i a , __m128i multab , __m128i mask_f )
+{
+    __m128i r_lo = _mm_shuffle_epi8( multab , _mm_and_si128( a , mask_f ) );
+    __m128i r_hi = _mm_shuffle_epi8( multab , _mm_and_si128( _mm_srli_epi16( a , 4 ) , mask_f ) );
+    return _mm_xor_si128( r_lo , _mm_slli_epi16( r_hi , 4 ) );
+}
+
+/// @brief 16 GF(256) elements in a times the scalar whose tables are tab_l, tab_h.
+static inline _BLAS_TARGET_SSE_
+__m128i gf256v_mul_multab_sse( __m128i a , __m128i tab_l , __m128i tab_h , __m128i mask_f )
+{
+    __m128i r_lo = _mm_shuffle_epi8( tab_l , _mm_and_si128( a , mask_f ) );
+    __m128i r_hi = _mm_shuffle_epi8( tab_h , _mm_and_si128( _mm_srli_epi16( a , 4 ) , mask_f ) );
+    return _mm_xor_si128( r_lo , r_hi );
+}
+
+
+#endif // defined(_BLAS_SIMD_DISPATCH_)
+
+#endif // _GF16_SSE_H_
+
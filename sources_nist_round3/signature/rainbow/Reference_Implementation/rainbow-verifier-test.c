@@ -0,0 +1,136 @@
+///  @file rainbow-verifier-test.c
+///  @brief Checks verifiers and the LRU cache of rainbow_verifier.h: alignment, hits, evictions, and several keys.
+///
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "rainbow_config.h"
+
+#include "rainbow_keypair.h"
+
+#include "rainbow.h"
+
+#include "rainbow_verifier.h"
+
+#include "rng.h"
+
+
+#define N_KEYS 3
+
+
+static cpk_t * cpks[N_KEYS];
+static unsigned char digests[N_KEYS][_HASH_LEN];
+static unsigned char signatures[N_KEYS][_SIGNATURE_BYTE];
+
+static int fail = 0;
+
+
+// verify every signature under key k through the cache, and check the number of cache misses afterwards.
+static void check_cached( rainbow_verifier_cache_t * cache , unsigned k , unsigned long long expected_misses )
+{
+	for(unsigned i=0;i<N_KEYS;i++) {
+		int expect = (i==k)? 0 : -1;
+		if( expect != rainbow_verify_cyclic_cached( cache , digests[i] , signatures[i] , cpks[k] ) ) {
+			printf("cached verification of signature %u under key %u wrong.\n", i , k );
+			fail = 1;
+		}
+	}
+	if( expected_misses != rainbow_verifier_cache_misses( cache ) ) {
+		printf("key %u: %llu cache misses, expected %llu.\n", k , rainbow_verifier_cache_misses( cache ) , expected_misses );
+		fail = 1;
+	}
+}
+
+
+int main( void )
+{
+	printf( "%s\n", _S_NAME );
+
+	unsigned char rnd_seed[48] = {0};
+	randombytes_init( rnd_seed , NULL , 256 );
+
+	sk_t * sk = (sk_t *) malloc( sizeof(sk_t) );
+	if( NULL == sk ) {
+		printf("alloc memory for keys fail.\n");
+		return -1;
+	}
+	for(unsigned k=0;k<N_KEYS;k++) {
+		cpks[k] = (cpk_t *) malloc( sizeof(cpk_t) );
+		if( NULL == cpks[k] ) {
+			printf("alloc memory for keys fail.\n");
+			return -1;
+		}
+		unsigned char pk_seed[LEN_PKSEED];
+		unsigned char sk_seed[LEN_SKSEED];
+		randombytes( pk_seed , LEN_PKSEED );
+		randombytes( sk_seed , LEN_SKSEED );
+		if( 0 != generate_keypair_cyclic( cpks[k] , sk , pk_seed , sk_seed ) ) {
+			printf("generate keypair fail.\n");
+			return -1;
+		}
+		randombytes( digests[k] , _HASH_LEN );
+		if( 0 != rainbow_sign( signatures[k] , sk , digests[k] ) ) {
+			printf("sign fail.\n");
+			return -1;
+		}
+	}
+	free( sk );
+
+	// verifiers, without the cache.
+	for(unsigned k=0;k<N_KEYS;k++) {
+		rainbow_verifier_t * vf = rainbow_verifier_new( cpks[k] );
+		if( NULL == vf ) {
+			printf("rainbow_verifier_new() fail.\n");
+			return -1;
+		}
+		if( 0 != ((uintptr_t)vf) % RAINBOW_VERIFIER_ALIGN ) {
+			printf("verifier not aligned to %d bytes.\n", RAINBOW_VERIFIER_ALIGN );
+			fail = 1;
+		}
+		for(unsigned i=0;i<N_KEYS;i++) {
+			int expect = (i==k)? 0 : -1;
+			if( expect != rainbow_verifier_verify( digests[i] , signatures[i] , vf )
+				|| expect != rainbow_verify_cyclic( digests[i] , signatures[i] , cpks[k] ) ) {
+				printf("verification of signature %u under key %u wrong.\n", i , k );
+				fail = 1;
+			}
+		}
+		rainbow_verifier_free( vf );
+	}
+
+	// a cache of two verifiers for three keys.
+	rainbow_verifier_cache_t * cache = rainbow_verifier_cache_new( 2 );
+	if( NULL == cache ) {
+		printf("rainbow_verifier_cache_new() fail.\n");
+		return -1;
+	}
+	check_cached( cache , 0 , 1 );     // miss
+	check_cached( cache , 0 , 1 );     // hit
+	check_cached( cache , 1 , 2 );     // miss, fills the second slot
+	check_cached( cache , 0 , 2 );     // hit, key 1 is now the least recently used
+	check_cached( cache , 2 , 3 );     // miss, evicts key 1
+	check_cached( cache , 0 , 3 );     // hit
+	check_cached( cache , 2 , 3 );     // hit, key 0 is now the least recently used
+	check_cached( cache , 1 , 4 );     // miss, evicts key 0
+	check_cached( cache , 2 , 4 );     // hit
+	check_cached( cache , 0 , 5 );     // miss, evicts key 1
+
+	const rainbow_verifier_t * vf0 = rainbow_verifier_cache_get( cache , cpks[0] );
+	if( vf0 != rainbow_verifier_cache_get( cache , cpks[0] ) || vf0 == rainbow_verifier_cache_get( cache , cpks[2] ) ) {
+		printf("rainbow_verifier_cache_get() returned a wrong verifier.\n");
+		fail = 1;
+	}
+	rainbow_verifier_cache_free( cache );
+
+	for(unsigned k=0;k<N_KEYS;k++) free( cpks[k] );
+
+	if( fail ) {
+		printf("rainbow_verifier test FAIL.\n");
+		return -1;
+	}
+	printf("rainbow_verifier test PASS.\n");
+	return 0;
+}
@@ -30,7 +30,9 @@ libkeccak_state_initialise(struct libkeccak_state *restrict state, const struct
 	for (x = 0; x < 25; x++)
 		state->S[x] = 0;
 	state->mptr = 0;
-	state->mlen = (size_t)(state->r * state->b) >> 2;
+	/* Whole blocks are absorbed straight from the caller's buffer, so `M`
+	 * only holds a partial block, plus the padding spilling into one more */
+	state->mlen = (size_t)(state->r >> 3) << 1;
 
 	state->M = malloc(state->mlen * sizeof(char));
 	return state->M == NULL ? -1 : 0;
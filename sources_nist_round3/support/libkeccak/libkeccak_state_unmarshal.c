@@ -31,7 +31,7 @@ libkeccak_state_unmarshal(struct libkeccak_state *restrict state, const void *re
 	data += sizeof(state->S) / sizeof(char);
 	get(size_t, mptr);
 	get(size_t, mlen);
-	state->M = malloc(state->mptr * sizeof(char));
+	state->M = malloc(state->mlen * sizeof(char));
 	if (!state->M)
 		return 0;
 	memcpy(state->M, data, state->mptr * sizeof(char));